@@ -42,7 +42,8 @@ cbuffer PerMaterialBuffer : register(b1)
     float  gBumpScale;
     float  gParallaxScale;
     float  gAlphaThreshold;
-    float  gPadding3;
+    uint   gUsePrefilteredEnvironment;
+    float4 gIrradiance[9];
 };
 
 static const float4 LightColor = float4(1.0f, 0.9f, 0.8f, 0.6f);
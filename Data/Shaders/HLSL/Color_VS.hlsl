@@ -18,9 +18,15 @@ cbuffer PerCameraBuffer : register(b0)
 
 cbuffer PerInstanceBuffer : register(b1)
 {
-    PerInstanceData gInstanceData[STANDARD_FORWARD_MAX_INSTANCED_BLOCK];
+    uint   gInstanceOffset;
+    uint3  gInstancePadding;
 }
 
+// Records of all instanced objects are stored in a single persistent buffer. A draw finds the records of its instances
+// through a per-frame list of indices, starting at gInstanceOffset
+StructuredBuffer<PerInstanceData> gInstanceData;
+Buffer<uint> gInstanceIndices;
+
 cbuffer PerObjectBuffer : register(b2)
 {
     matrix gMatWorld;
@@ -31,7 +37,12 @@ cbuffer PerObjectBuffer : register(b2)
     uint   gLayer;
     uint   gHasAnimation;
     uint   gWriteVelocity;
-    float gPadding3;
+    uint   gBoneOffset;
+    uint   gPrevBoneOffset;
+    uint   gQuantized;
+    float2 gPadding3;
+    float4 gPositionScale;
+    float4 gPositionOffset;
 }
 
 cbuffer PerFrameBuffer : register(b3)
@@ -51,13 +62,13 @@ VS_OUTPUT main( VS_INPUT IN )
 
     if(gHasAnimation)
     {
-        blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
-        prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices);
+        blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices, gBoneOffset);
+        prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices, gPrevBoneOffset);
     }
 
     if(IN.Instanceid == 0)
     {
-        OUT.Position = float4(IN.Position, 1.0f);
+        OUT.Position = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.Position = mul(blendMatrix, OUT.Position);
         OUT.Position = mul(gMatWorld, OUT.Position);
@@ -78,7 +89,7 @@ VS_OUTPUT main( VS_INPUT IN )
         OUT.Tangent = normalize(mul(gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
         OUT.BiTangent = normalize(mul(gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
 
-        OUT.PositionWS = float4(IN.Position, 1.0f);
+        OUT.PositionWS = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
         OUT.PositionWS = mul(gMatWorld, OUT.PositionWS);
@@ -88,10 +99,12 @@ VS_OUTPUT main( VS_INPUT IN )
     }
     else
     {
-        OUT.Position = float4(IN.Position, 1.0f);
+        PerInstanceData instance = gInstanceData[gInstanceIndices[gInstanceOffset + IN.Instanceid]];
+
+        OUT.Position = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.Position = mul(blendMatrix, OUT.Position);
-        OUT.Position = mul(gInstanceData[IN.Instanceid].gMatWorld, OUT.Position);
+        OUT.Position = mul(instance.gMatWorld, OUT.Position);
         OUT.Position = mul(gMatViewProj, OUT.Position);
 
         OUT.Normal = IN.Normal;
@@ -105,14 +118,14 @@ VS_OUTPUT main( VS_INPUT IN )
             OUT.BiTangent = mul(blendMatrix, float4(OUT.BiTangent, 0.0f)).xyz;
         }
 
-        OUT.Normal = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
-        OUT.Tangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
-        OUT.BiTangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
+        OUT.Normal = normalize(mul(instance.gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
+        OUT.Tangent = normalize(mul(instance.gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
+        OUT.BiTangent = normalize(mul(instance.gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
 
-        OUT.PositionWS = float4(IN.Position, 1.0f);
+        OUT.PositionWS = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
-        OUT.PositionWS = mul(gInstanceData[IN.Instanceid].gMatWorld, OUT.PositionWS);
+        OUT.PositionWS = mul(instance.gMatWorld, OUT.PositionWS);
 
         OUT.ViewDirectionWS = normalize(OUT.PositionWS.xyz - gViewOrigin);
         OUT.Color = IN.Color;
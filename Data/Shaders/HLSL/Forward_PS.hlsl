@@ -42,7 +42,8 @@ cbuffer PerMaterialBuffer : register(b1)
     float  gBumpScale;
     float  gParallaxScale;
     float  gAlphaThreshold;
-    float  gPadding3;
+    uint   gUsePrefilteredEnvironment;
+    float4 gIrradiance[9];
 };
 
 cbuffer PerLightsBuffer : register(b2)
@@ -60,6 +61,39 @@ cbuffer PerFrameBuffer : register(b3)
     float4 gSceneLightColor;
 }
 
+// Permutation keys. Variations of this program are compiled with the keys defined to 0 or 1, which removes the
+// branches (and texture fetches) of disabled maps. Without a variation, fall back to the per material flags.
+#ifndef USE_DIFFUSE_MAP
+    #define USE_DIFFUSE_MAP (gUseDiffuseMap == 1)
+#endif
+#ifndef USE_EMISSIVE_MAP
+    #define USE_EMISSIVE_MAP (gUseEmissiveMap == 1)
+#endif
+#ifndef USE_NORMAL_MAP
+    #define USE_NORMAL_MAP (gUseNormalMap == 1)
+#endif
+#ifndef USE_SPECULAR_MAP
+    #define USE_SPECULAR_MAP (gUseSpecularMap == 1)
+#endif
+#ifndef USE_BUMP_MAP
+    #define USE_BUMP_MAP (gUseBumpMap == 1)
+#endif
+#ifndef USE_PARALLAX_MAP
+    #define USE_PARALLAX_MAP (gUseParallaxMap == 1)
+#endif
+#ifndef USE_TRANSPARENCY_MAP
+    #define USE_TRANSPARENCY_MAP (gUseTransparencyMap == 1)
+#endif
+#ifndef USE_REFLECTION_MAP
+    #define USE_REFLECTION_MAP (gUseReflectionMap == 1)
+#endif
+#ifndef USE_OCCLUSION_MAP
+    #define USE_OCCLUSION_MAP (gUseOcclusionMap == 1)
+#endif
+#ifndef USE_ENVIRONMENT_MAP
+    #define USE_ENVIRONMENT_MAP (gUseEnvironmentMap == 1)
+#endif
+
 SamplerState AnisotropicSampler : register(s0);
 
 Texture2D DiffuseMap : register(t0);
@@ -265,8 +299,36 @@ float3 DoReflection(float3 P, float3 N)
 {
     float3 I = normalize(P - gViewOrigin);
     float3 R = reflect(I, normalize(N));
+    float mip = 0.0;
+
+    if(gUsePrefilteredEnvironment == 1)
+    {
+        // Prefiltered environments store GGX filtered radiance in their mips, roughness increasing linearly with the
+        // mip level. Roughness is derived from the Blinn-Phong exponent (alpha = sqrt(2 / (n + 2)), roughness = sqrt(alpha))
+        uint width, height, numMips;
+        EnvironmentMap.GetDimensions(0, width, height, numMips);
+
+        float roughness = sqrt(sqrt(2.0 / (max(gSpecularPower, 0.0) + 2.0)));
+        mip = roughness * (numMips - 1);
+    }
 
-    return EnvironmentMap.SampleLevel(AnisotropicSampler, R, 0).xyz * gReflection;
+    return EnvironmentMap.SampleLevel(AnisotropicSampler, R, mip).xyz * gReflection;
+}
+
+float3 DoIrradiance(float3 N)
+{
+    // Third order spherical harmonics, coefficients are already convolved with the cosine lobe
+    float3 result = gIrradiance[0].rgb * 0.282095;
+    result += gIrradiance[1].rgb * 0.488603 * N.y;
+    result += gIrradiance[2].rgb * 0.488603 * N.z;
+    result += gIrradiance[3].rgb * 0.488603 * N.x;
+    result += gIrradiance[4].rgb * 1.092548 * N.x * N.y;
+    result += gIrradiance[5].rgb * 1.092548 * N.y * N.z;
+    result += gIrradiance[6].rgb * 0.315392 * (3.0 * N.z * N.z - 1.0);
+    result += gIrradiance[7].rgb * 1.092548 * N.x * N.z;
+    result += gIrradiance[8].rgb * 0.546274 * (N.x * N.x - N.y * N.y);
+
+    return max(result, (float3)0);
 }
 
 float3 DoRefraction(float3 P, float3 N)
@@ -348,7 +410,7 @@ PS_OUTPUT main( PS_INPUT IN )
     float alpha = gTransparency;
     uint writeVelocity = (uint)IN.Other.x;
 
-    if(gUseTransparencyMap == 1)
+    if(USE_TRANSPARENCY_MAP)
         alpha = TransparencyMap.Sample( AnisotropicSampler, IN.Texture ).r;
 
     if(alpha < gAlphaThreshold)
@@ -368,12 +430,13 @@ PS_OUTPUT main( PS_INPUT IN )
         float3 emissive    = gEmissive.rgb;
         float3 specular    = gSpecular.rgb;
         float3 environment = (float3)0;
+        float3 irradiance  = (float3)0;
         float3 normal      = IN.Normal;
         float2 texCoords   = (IN.Texture * gTextureRepeat) + gTextureOffset;
 
         float3x3 TBN = float3x3(IN.Tangent.xyz, IN.BiTangent.xyz, IN.Normal.xyz);
 
-        if(gUseParallaxMap == 1)
+        if(USE_PARALLAX_MAP)
         {
             // Utilize dynamic flow control to change the number of samples per ray 
             // depending on the viewing angle for the surface. Oblique angles require 
@@ -384,33 +447,36 @@ PS_OUTPUT main( PS_INPUT IN )
 
             texCoords = DoParallaxMapping(texCoords, IN.ParallaxOffsetTS, parallaxSteps, gParallaxScale);
         }
-        if(gUseReflectionMap == 1)
+        if(USE_REFLECTION_MAP)
             { /* TODO */ }
-        if(gUseNormalMap == 1)
+        if(USE_NORMAL_MAP)
             normal = DoNormalMapping(TBN, NormalMap, AnisotropicSampler, texCoords);
-        if(gUseBumpMap == 1)
+        if(USE_BUMP_MAP)
             normal = DoBumpMapping(TBN, BumpMap, AnisotropicSampler, texCoords, gBumpScale);
-        if(gUseDiffuseMap == 1)
+        if(USE_DIFFUSE_MAP)
         {
             albedo = DiffuseMap.Sample(AnisotropicSampler, texCoords).rgb;
             ambient = albedo;
         }
-        if(gUseSpecularMap == 1)
+        if(USE_SPECULAR_MAP)
             specular.rgb = SpecularMap.Sample(AnisotropicSampler, texCoords).xyz;
-        if(gUseEmissiveMap == 1)
+        if(USE_EMISSIVE_MAP)
             emissive = emissive * EmissiveMap.Sample(AnisotropicSampler, texCoords).rgb;
-        if(gUseOcclusionMap == 1)
+        if(USE_OCCLUSION_MAP)
             albedo = albedo * OcclusionMap.Sample(AnisotropicSampler, texCoords).rgb;
 
         LightingResult lit = ComputeLighting(IN.PositionWS.xyz, normalize(normal));
 
-        if(gUseEnvironmentMap == 1)
+        if(USE_ENVIRONMENT_MAP)
         {
             if(gIndexOfRefraction != 0.0)
                 environment = DoRefraction(IN.PositionWS.xyz, normal);
             if(gReflection != 0.0)
                 environment = environment + DoReflection(IN.PositionWS.xyz, normal);
 
+            if(gUsePrefilteredEnvironment == 1)
+                irradiance = DoIrradiance(normalize(normal));
+
             float reflectAndRefract = gReflection + gRefraction;
             if(reflectAndRefract > 1.0) reflectAndRefract = 1.0;
             albedo = albedo * (1.0 - reflectAndRefract);
@@ -419,7 +485,12 @@ PS_OUTPUT main( PS_INPUT IN )
         diffuse = diffuse * lit.Diffuse.rgb;
         specular = specular * lit.Specular.rgb;
 
-        OUT.Scene.rgb = (gSceneLightColor.rgb * ambient + emissive + diffuse + specular) * (albedo + environment);
+        // Irradiance of a prefiltered environment replaces the flat ambient term. It is already the light reflected by a
+        // white lambertian surface, so it is only tinted by the albedo
+        if(USE_ENVIRONMENT_MAP && gUsePrefilteredEnvironment == 1)
+            OUT.Scene.rgb = irradiance * albedo + (emissive + diffuse + specular) * (albedo + environment);
+        else
+            OUT.Scene.rgb = (gSceneLightColor.rgb * ambient + emissive + diffuse + specular) * (albedo + environment);
         OUT.Scene.a = alpha;
 
         float3 NDCPos = (IN.CurrPosition / IN.CurrPosition.w).xyz;
@@ -18,9 +18,15 @@ cbuffer PerCameraBuffer : register(b0)
 
 cbuffer PerInstanceBuffer : register(b1)
 {
-    PerInstanceData gInstanceData[STANDARD_FORWARD_MAX_INSTANCED_BLOCK];
+    uint   gInstanceOffset;
+    uint3  gInstancePadding;
 }
 
+// Records of all instanced objects are stored in a single persistent buffer. A draw finds the records of its instances
+// through a per-frame list of indices, starting at gInstanceOffset
+StructuredBuffer<PerInstanceData> gInstanceData;
+Buffer<uint> gInstanceIndices;
+
 cbuffer PerObjectBuffer : register(b2)
 {
     matrix gMatWorld;
@@ -31,7 +37,12 @@ cbuffer PerObjectBuffer : register(b2)
     uint   gLayer;
     uint   gHasAnimation;
     uint   gWriteVelocity;
-    float  gPadding3;
+    uint   gBoneOffset;
+    uint   gPrevBoneOffset;
+    uint   gQuantized;
+    float2 gPadding3;
+    float4 gPositionScale;
+    float4 gPositionOffset;
 }
 
 cbuffer PerFrameBuffer : register(b3)
@@ -52,27 +63,30 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
 
     //uint instanceid = 0;
 
+    if(gQuantized)
+        DecodeQuantizedVertex(IN, gPositionScale.xyz, gPositionOffset.xyz);
+
     if(instanceid == 0)
     {
         if(gHasAnimation)
         {
-            blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
-            prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices);
+            blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices, gBoneOffset);
+            prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices, gPrevBoneOffset);
         }
 
-        OUT.Position = float4(IN.Position, 1.0f);
+        OUT.Position = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.Position = mul(blendMatrix, OUT.Position);
         OUT.Position = mul(gMatWorld, OUT.Position);
         OUT.Position = mul(gMatViewProj, OUT.Position);
 
-        OUT.CurrPosition = float4(IN.Position, 1.0f);
+        OUT.CurrPosition = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.CurrPosition = mul(blendMatrix, OUT.CurrPosition);
         OUT.CurrPosition = mul(gMatWorld, OUT.CurrPosition);
         OUT.CurrPosition = mul(gMatViewProj, OUT.CurrPosition);
 
-        OUT.PrevPosition = float4(IN.Position, 1.0f);
+        OUT.PrevPosition = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.PrevPosition = mul(prevBlendMatrix, OUT.PrevPosition);
         OUT.PrevPosition = mul(gMatPrevWorld, OUT.PrevPosition);
@@ -95,7 +109,7 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
 
         OUT.Texture = FlipUV(IN.Texture);
 
-        OUT.PositionWS = float4(IN.Position, 1.0f);
+        OUT.PositionWS = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
         OUT.PositionWS = mul(gMatWorld, OUT.PositionWS);
@@ -104,28 +118,30 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
     }
     else
     {
-        if(gInstanceData[instanceid].gHasAnimation)
+        PerInstanceData instance = gInstanceData[gInstanceIndices[gInstanceOffset + instanceid]];
+
+        if(instance.gHasAnimation)
         {
-            blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
-            prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices);
+            blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices, gBoneOffset);
+            prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices, gPrevBoneOffset);
         }
 
-        OUT.Position = float4(IN.Position, 1.0f);
+        OUT.Position = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.Position = mul(blendMatrix, OUT.Position);
-        OUT.Position = mul(gInstanceData[instanceid].gMatWorld, OUT.Position);
+        OUT.Position = mul(instance.gMatWorld, OUT.Position);
         OUT.Position = mul(gMatViewProj, OUT.Position);
 
-        OUT.CurrPosition = float4(IN.Position, 1.0f);
+        OUT.CurrPosition = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.CurrPosition = mul(blendMatrix, OUT.CurrPosition);
-        OUT.CurrPosition = mul(gInstanceData[instanceid].gMatWorld, OUT.CurrPosition);
+        OUT.CurrPosition = mul(instance.gMatWorld, OUT.CurrPosition);
         OUT.CurrPosition = mul(gMatViewProj, OUT.CurrPosition);
 
-        OUT.PrevPosition = float4(IN.Position, 1.0f);
+        OUT.PrevPosition = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.PrevPosition = mul(prevBlendMatrix, OUT.PrevPosition);
-        OUT.PrevPosition = mul(gInstanceData[instanceid].gMatPrevWorld, OUT.PrevPosition);
+        OUT.PrevPosition = mul(instance.gMatPrevWorld, OUT.PrevPosition);
         OUT.PrevPosition = mul(gMatViewProj, OUT.PrevPosition);
 
         OUT.Normal = IN.Normal;
@@ -139,18 +155,18 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
             OUT.BiTangent = mul(blendMatrix, float4(OUT.BiTangent, 0.0f)).xyz;
         }
 
-        OUT.Normal = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
-        OUT.Tangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
-        OUT.BiTangent = normalize(mul(gInstanceData[instanceid].gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
+        OUT.Normal = normalize(mul(instance.gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
+        OUT.Tangent = normalize(mul(instance.gMatWorld, float4(OUT.Tangent, 0.0f))).xyz;
+        OUT.BiTangent = normalize(mul(instance.gMatWorld, float4(OUT.BiTangent, 0.0f))).xyz;
 
         OUT.Texture = FlipUV(IN.Texture);
 
-        OUT.PositionWS = float4(IN.Position, 1.0f);
+        OUT.PositionWS = float4(IN.Position.xyz, 1.0f);
         if(gHasAnimation)
             OUT.PositionWS = mul(blendMatrix, OUT.PositionWS);
-        OUT.PositionWS = mul(gInstanceData[instanceid].gMatWorld, OUT.PositionWS);
+        OUT.PositionWS = mul(instance.gMatWorld, OUT.PositionWS);
 
-        OUT.Other.x = (gInstanceData[instanceid].gWriteVelocity == 1) ? 1.0 : 0.0;
+        OUT.Other.x = (instance.gWriteVelocity == 1) ? 1.0 : 0.0;
     }
 
     float3x3 TBN = float3x3(OUT.Tangent, OUT.BiTangent, OUT.Normal);
@@ -1,4 +1,3 @@
-#define STANDARD_FORWARD_MAX_INSTANCED_BLOCK 128
 #define MAX_LIGHTS 16
 
 #define DIRECTIONAL_LIGHT 0.0
@@ -38,7 +37,7 @@ struct LightData
 
 struct VS_INPUT
 {
-    float3 Position      : POSITION;
+    float4 Position      : POSITION;
     float3 Normal        : NORMAL;
     float4 Tangent       : TANGENT;
     float4 BiTangent     : BINORMAL;
@@ -97,6 +96,27 @@ float2 FlipUV(float2 coord)
     return float2(coord.x - 1.0f, coord.y);
 }
 
+// Inverse of EncodeOctahedral() in TeMeshUtility.cpp
+float3 DecodeOctahedral(float2 encoded)
+{
+    float3 value = float3(encoded.xy, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float fold = saturate(-value.z);
+    value.xy += (value.xy >= 0.0f) ? -fold : fold;
+    return normalize(value);
+}
+
+// Expands a vertex quantized by MeshUtility::QuantizeVertices() : position relative to the mesh bounds, with the
+// tangent frame handedness in w, octahedral normal and tangent, and no bitangent
+void DecodeQuantizedVertex(inout VS_INPUT IN, float3 positionScale, float3 positionOffset)
+{
+    float handedness = IN.Position.w < 0.0f ? -1.0f : 1.0f;
+
+    IN.Position = float4(IN.Position.xyz * positionScale + positionOffset, 1.0f);
+    IN.Normal = DecodeOctahedral(IN.Normal.xy);
+    IN.Tangent = float4(DecodeOctahedral(IN.Tangent.xy), handedness);
+    IN.BiTangent = float4(cross(IN.Normal, IN.Tangent.xyz) * handedness, handedness);
+}
+
 float3 ExpandNormal(float3 normal)
 {
     return normal * 2.0f - 1.0f;
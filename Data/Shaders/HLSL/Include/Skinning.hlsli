@@ -1,6 +1,9 @@
 Buffer<float4> BoneMatrices;
 Buffer<float4> PrevBoneMatrices;
 
+// Bone matrices of all skinned objects are packed in the same buffers, each object addresses its own bones starting at
+// an offset provided in its per-object constants
+
 float4x4 GetBoneMatrix(uint idx)
 {
     float4 row0 = BoneMatrices[idx * 4 + 0];
@@ -21,10 +24,12 @@ float4x4 GetPrevBoneMatrix(uint idx)
     return float4x4(row0, row1, row2, row3);
 }
 
-float4x4 GetBlendMatrix(float4 blendWeights, uint4 blendIndices)
+float4x4 GetBlendMatrix(float4 blendWeights, uint4 blendIndices, uint boneOffset)
 {
     float4x4 result = (float4x4)0; 
 
+    blendIndices += boneOffset;
+
     if(blendIndices.x >= 0)
         result += blendWeights.x * GetBoneMatrix(blendIndices.x);
     if(blendIndices.y >= 0)
@@ -37,10 +42,12 @@ float4x4 GetBlendMatrix(float4 blendWeights, uint4 blendIndices)
     return result;
 }
 
-float4x4 GetPrevBlendMatrix(float4 blendWeights, uint4 blendIndices)
+float4x4 GetPrevBlendMatrix(float4 blendWeights, uint4 blendIndices, uint boneOffset)
 {
     float4x4 result = (float4x4)0; 
 
+    blendIndices += boneOffset;
+
     if(blendIndices.x >= 0)
         result += blendWeights.x * GetPrevBoneMatrix(blendIndices.x);
     if(blendIndices.y >= 0)
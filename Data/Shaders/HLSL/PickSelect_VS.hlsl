@@ -12,6 +12,11 @@ cbuffer PerObjectBuffer : register(b1)
     matrix gMatWorld;
     float4 gColor;
     uint   gHasAnimation;
+    uint   gBoneOffset;
+    uint   gQuantized;
+    uint   gPadding;
+    float4 gPositionScale;
+    float4 gPositionOffset;
 }
 
 struct VS_INPUT
@@ -34,9 +39,12 @@ VS_OUTPUT main( VS_INPUT IN )
     float4x4 blendMatrix = (float4x4)0;
 
     if(gHasAnimation)
-        blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
+        blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices, gBoneOffset);
 
+    // Quantized positions are relative to the mesh bounds, see MeshUtility::QuantizeVertices()
     OUT.Position = float4(IN.Position, 1.0f);
+    if(gQuantized)
+        OUT.Position.xyz = OUT.Position.xyz * gPositionScale.xyz + gPositionOffset.xyz;
         if(gHasAnimation)
             OUT.Position = mul(blendMatrix, OUT.Position);
     OUT.Position = mul(gMatWorld, OUT.Position);
@@ -2,6 +2,7 @@
 
 #include "Components/TeCRenderable.h"
 #include "Components/TeCCamera.h"
+#include "Mesh/TeMesh.h"
 
 namespace te
 {
@@ -28,5 +29,15 @@ namespace te
     {
         _perObjectParamDef.gMatWorld.Set(_perObjectParamBuffer, renderable->GetMatrix());
         _perObjectParamDef.gColor.Set(_perObjectParamBuffer, renderable->GetGameObjectColor().GetAsVector4());
+
+        // Quantized meshes are decoded by the vertex shader, see MeshUtility::QuantizeVertices()
+        const SPtr<Mesh> mesh = renderable->GetMesh();
+        const bool quantized = mesh && mesh->GetProperties().IsQuantized();
+        const Vector3 scale = quantized ? mesh->GetProperties().GetPositionScale() : Vector3::ONE;
+        const Vector3 offset = quantized ? mesh->GetProperties().GetPositionOffset() : Vector3::ZERO;
+
+        _perObjectParamDef.gQuantized.Set(_perObjectParamBuffer, quantized ? 1 : 0);
+        _perObjectParamDef.gPositionScale.Set(_perObjectParamBuffer, Vector4(scale.x, scale.y, scale.z, 0.0f));
+        _perObjectParamDef.gPositionOffset.Set(_perObjectParamBuffer, Vector4(offset.x, offset.y, offset.z, 0.0f));
     }
 }
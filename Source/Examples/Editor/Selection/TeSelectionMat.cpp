@@ -2,6 +2,7 @@
 
 #include "Components/TeCRenderable.h"
 #include "Components/TeCCamera.h"
+#include "Mesh/TeMesh.h"
 
 namespace te
 {
@@ -28,7 +29,23 @@ namespace te
     {
         _perObjectParamDef.gMatWorld.Set(_perObjectParamBuffer, renderable->GetMatrix());
         _perObjectParamDef.gColor.Set(_perObjectParamBuffer, renderable->GetGameObjectColor().GetAsVector4());
-        _perObjectParamDef.gHasAnimation.Set(_perObjectParamBuffer, renderable->IsAnimated() ? 1 : 0);
+
+        // Quantized meshes are decoded by the vertex shader, see MeshUtility::QuantizeVertices()
+        const SPtr<Mesh> mesh = renderable->GetMesh();
+        const bool quantized = mesh && mesh->GetProperties().IsQuantized();
+        const Vector3 scale = quantized ? mesh->GetProperties().GetPositionScale() : Vector3::ONE;
+        const Vector3 offset = quantized ? mesh->GetProperties().GetPositionOffset() : Vector3::ZERO;
+
+        _perObjectParamDef.gQuantized.Set(_perObjectParamBuffer, quantized ? 1 : 0);
+        _perObjectParamDef.gPositionScale.Set(_perObjectParamBuffer, Vector4(scale.x, scale.y, scale.z, 0.0f));
+        _perObjectParamDef.gPositionOffset.Set(_perObjectParamBuffer, Vector4(offset.x, offset.y, offset.z, 0.0f));
+
+        // Bone palette offset is refreshed by the renderer, every frame the renderable is visible
+        const UINT32 boneOffset = renderable->_getInternal()->GetBoneMatrixOffset();
+        const bool hasAnimation = renderable->IsAnimated() && boneOffset != (UINT32)-1;
+
+        _perObjectParamDef.gHasAnimation.Set(_perObjectParamBuffer, hasAnimation ? 1 : 0);
+        _perObjectParamDef.gBoneOffset.Set(_perObjectParamBuffer, hasAnimation ? boneOffset : 0);
 
         if (_params->HasBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices"))
             _params->SetBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices", renderable->_getInternal()->GetBoneMatrixBuffer());
@@ -64,6 +64,10 @@ namespace te
             TE_PARAM_BLOCK_ENTRY(Matrix4, gMatWorld)
             TE_PARAM_BLOCK_ENTRY(Vector4, gColor)
             TE_PARAM_BLOCK_ENTRY(UINT32, gHasAnimation)
+            TE_PARAM_BLOCK_ENTRY(UINT32, gBoneOffset)
+            TE_PARAM_BLOCK_ENTRY(UINT32, gQuantized)
+            TE_PARAM_BLOCK_ENTRY(Vector4, gPositionScale)
+            TE_PARAM_BLOCK_ENTRY(Vector4, gPositionOffset)
         TE_PARAM_BLOCK_END
 
         TE_PARAM_BLOCK_BEGIN(PerHudInstanceParamDef)
@@ -0,0 +1,9 @@
+set (TE_EVENTBENCHMARK_SRC_NOFILTER
+    "Main.cpp"
+)
+
+source_group ("" FILES ${TE_EVENTBENCHMARK_SRC_NOFILTER})
+
+set (TE_EVENTBENCHMARK_SRC
+    ${TE_EVENTBENCHMARK_SRC_NOFILTER}
+)
@@ -0,0 +1,101 @@
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Utility/TeEvent.h"
+
+#include <chrono>
+#include <cstdio>
+
+// Compares the trigger cost of the mutex based Event with LockFreeEvent. Build in release and run without arguments.
+
+namespace
+{
+    using namespace te;
+
+    constexpr UINT32 NUM_CONNECTIONS = 4;
+    constexpr UINT32 NUM_TRIGGERS = 10000000;
+    constexpr UINT32 NUM_CONCURRENT_THREADS = 4;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    /**
+     * Sink for callback results so the compiler can't drop the calls. Per thread, so callbacks don't contend with each
+     * other and only the cost of the event itself is measured.
+     */
+    thread_local UINT64 gCallbackSink = 0;
+
+    /** Connects NUM_CONNECTIONS cheap callbacks to the event. Returned handles must stay alive during the benchmark. */
+    template<class EventType>
+    Vector<HEvent> ConnectCallbacks(EventType& event)
+    {
+        Vector<HEvent> connections;
+        for (UINT32 i = 0; i < NUM_CONNECTIONS; i++)
+        {
+            connections.push_back(event.Connect([](UINT32 value)
+            {
+                gCallbackSink += value;
+            }));
+        }
+
+        return connections;
+    }
+
+    /** Triggers the event @p numTriggers times from each of @p numThreads threads, returns nanoseconds per trigger. */
+    template<class EventType>
+    double MeasureTrigger(EventType& event, UINT32 numThreads, UINT32 numTriggers)
+    {
+        auto triggerLoop = [&event, numTriggers]()
+        {
+            for (UINT32 i = 0; i < numTriggers; i++)
+                event(i);
+        };
+
+        const auto start = Clock::now();
+
+        if (numThreads == 1)
+            triggerLoop();
+        else
+        {
+            Vector<std::thread> threads;
+            for (UINT32 i = 0; i < numThreads; i++)
+                threads.emplace_back(triggerLoop);
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        const auto end = Clock::now();
+        const double elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        return elapsedNs / ((double)numTriggers * numThreads);
+    }
+
+    template<class EventType>
+    void RunBenchmark(const char* name)
+    {
+        EventType event;
+        Vector<HEvent> connections = ConnectCallbacks(event);
+
+        // Warm up caches and the allocator before measuring
+        MeasureTrigger(event, 1, NUM_TRIGGERS / 10);
+
+        const double single = MeasureTrigger(event, 1, NUM_TRIGGERS);
+        const double concurrent = MeasureTrigger(event, NUM_CONCURRENT_THREADS, NUM_TRIGGERS / NUM_CONCURRENT_THREADS);
+
+        printf("%-14s %10.2f %16.2f\n", name, single, concurrent);
+
+        for (auto& connection : connections)
+            connection.Disconnect();
+    }
+}
+
+int main()
+{
+    printf("%u connections, %u triggers, ns per trigger\n\n", NUM_CONNECTIONS, NUM_TRIGGERS);
+    printf("%-14s %10s %13s(%u)\n", "", "1 thread", "threads", NUM_CONCURRENT_THREADS);
+
+    RunBenchmark<te::Event<void(te::UINT32)>>("Event");
+    RunBenchmark<te::LockFreeEvent<void(te::UINT32)>>("LockFreeEvent");
+
+    printf("\nsink: %llu\n", (unsigned long long)gCallbackSink);
+
+    return 0;
+}
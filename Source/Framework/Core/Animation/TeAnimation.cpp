@@ -67,6 +67,9 @@ namespace te
         _skeleton = skeleton;
         _skeletonMask = mask;
 
+        _lodMaskLevel = (UINT32)-1;
+        _lodNumPoses = 0;
+
         if (skeleton != nullptr)
             _skeletonPose = LocalSkeletonPose(skeleton->GetNumBones());
 
@@ -215,6 +215,15 @@ namespace te
         UINT32 _numGenericCurves = 0;
         float* _genericCurveOutputs = nullptr;
         bool _wasCulled = false;
+
+        // Level of detail
+        UINT32 _lodLevel = 0; /**< Index of the AnimationLodLevel currently used. */
+        UINT32 _lodMaskLevel = (UINT32)-1; /**< Level @p _lodMask was built for. */
+        SkeletonMask _lodMask; /**< Skeleton mask combined with the bone depth limit of the current level. */
+        bool _lodSkipPose = false; /**< If true pose is interpolated from @p _lodPoses instead of being evaluated. */
+        float _lodBlend = 0.0f; /**< Interpolation factor between the two stored poses, when skipping evaluation. */
+        UINT32 _lodNumPoses = 0; /**< Number of valid poses in @p _lodPoses. */
+        Vector<Matrix4> _lodPoses[2]; /**< Last two evaluated poses, older first. */
     };
 
     /**
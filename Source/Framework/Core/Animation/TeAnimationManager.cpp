@@ -6,6 +6,9 @@
 #include "Renderer/TeCamera.h"
 #include "Mesh/TeMeshData.h"
 #include "Mesh/TeMeshUtility.h"
+#include "Threading/TeTaskScheduler.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "Utility/TeBitwise.h"
 
 namespace te
 {
@@ -33,6 +36,40 @@ namespace te
         _paused = !_paused;
     }
 
+    void AnimationManager::SetInstancingEnabled(bool enabled)
+    {
+        _instancingEnabled = enabled;
+    }
+
+    void AnimationManager::SetInstancingTimeQuantization(float seconds)
+    {
+        _instancingTimeQuantization = std::max(0.0f, seconds);
+    }
+
+    void AnimationManager::SetLodLevels(const Vector<AnimationLodLevel>& levels)
+    {
+        _lodLevels = levels;
+
+        // Keep the most detailed levels first
+        std::stable_sort(_lodLevels.begin(), _lodLevels.end(),
+            [](const AnimationLodLevel& lhs, const AnimationLodLevel& rhs)
+            {
+                return lhs.MinScreenSize > rhs.MinScreenSize;
+            });
+
+        for (auto& level : _lodLevels)
+            level.UpdateInterval = std::max(1U, level.UpdateInterval);
+
+        for (auto& anim : _animations)
+        {
+            if (anim.second->_animProxy == nullptr)
+                continue;
+
+            anim.second->_animProxy->_lodMaskLevel = (UINT32)-1;
+            anim.second->_animProxy->_lodNumPoses = 0;
+        }
+    }
+
     void AnimationManager::SetUpdateRate(UINT32 fps)
     {
         if (fps == 0) fps = 1;
@@ -42,17 +79,24 @@ namespace te
     const EvaluatedAnimationData* AnimationManager::Update()
     {
         if (_paused)
+        {
+            SyncPrevBonePalette();
             return &_animData;
+        }
 
         _animationTime += gTime().GetFrameDelta();
         if (_animationTime < _nextAnimationUpdateTime)
+        {
+            SyncPrevBonePalette();
             return &_animData;
+        }
 
         _nextAnimationUpdateTime = Math::Floor(_animationTime / _updateRate) * _updateRate + _updateRate;
 
         float timeDelta = _animationTime - _lastAnimationUpdateTime;
         _lastAnimationUpdateTime = _animationTime;
         _lastAnimationDeltaTime  = timeDelta;
+        _updateCount++;
 
         // Update animation proxies from the latest data
         _proxies.clear();
@@ -67,6 +111,7 @@ namespace te
 
         // Build frustums for culling
         _cullFrustums.clear();
+        _lodCameras.clear();
 
         auto& allCameras = gSceneManager().GetAllCameras();
         for (auto& entry : allCameras)
@@ -88,30 +133,168 @@ namespace te
             }
 
             _cullFrustums.push_back(entry.second->GetWorldFrustum());
+
+            if (!_lodLevels.empty())
+            {
+                LodCamera lodCamera;
+                lodCamera.Position = entry.second->GetTransform().GetPosition();
+                lodCamera.Ortho = entry.second->GetProjectionType() == PT_ORTHOGRAPHIC;
+
+                if (lodCamera.Ortho)
+                {
+                    lodCamera.ProjScale = 1.0f / std::max(entry.second->GetOrthoWindowHeight(), 0.0001f);
+                }
+                else
+                {
+                    float tanHalfHorzFOV = Math::Tan(entry.second->GetHorzFOV() * 0.5f);
+                    float tanHalfVertFOV = tanHalfHorzFOV / std::max(entry.second->GetAspectRatio(), 0.0001f);
+                    lodCamera.ProjScale = 1.0f / std::max(tanHalfVertFOV, 0.0001f);
+                }
+
+                _lodCameras.push_back(lodCamera);
+            }
+        }
+
+        UINT32 numProxies = (UINT32)_proxies.size();
+        _proxyBoneOffsets.resize(numProxies);
+        _proxySharedWith.resize(numProxies);
+        _proxyInfos.resize(numProxies);
+        _proxyHasInfo.resize(numProxies);
+
+        // Cull animations and find those that can share an already evaluated pose
+        _poseStateLookup.clear();
+        for (UINT32 i = 0; i < numProxies; i++)
+        {
+            AnimationProxy* anim = _proxies[i].get();
+            _proxySharedWith[i] = (UINT32)-1;
+
+            anim->_wasCulled = IsCulled(anim);
+            if (anim->_wasCulled)
+            {
+                // History is stale by the time the animation becomes visible again
+                anim->_lodNumPoses = 0;
+                continue;
+            }
+
+            UpdateLod(anim);
+
+            if (!_instancingEnabled || !CanSharePose(anim))
+                continue;
+
+            size_t hash = GetPoseStateHash(anim);
+            auto range = _poseStateLookup.equal_range(hash);
+            for (auto iter = range.first; iter != range.second; ++iter)
+            {
+                if (IsPoseStateEqual(anim, _proxies[iter->second].get()))
+                {
+                    _proxySharedWith[i] = iter->second;
+                    break;
+                }
+            }
+
+            if (_proxySharedWith[i] == (UINT32)-1)
+                _poseStateLookup.insert(std::make_pair(hash, i));
         }
 
-        // Prepare the write buffer
+        // Prepare the write buffer. Each evaluated pose gets its own disjoint range of bones so they can be evaluated in
+        // parallel, while shared poses just point to the range of the animation they share with.
         UINT32 totalNumBones = 0;
-        for (auto& anim : _proxies)
+        for (UINT32 i = 0; i < numProxies; i++)
         {
-            if (anim->_skeleton != nullptr)
+            const AnimationProxy* anim = _proxies[i].get();
+            if (_proxySharedWith[i] != (UINT32)-1)
+            {
+                _proxyBoneOffsets[i] = _proxyBoneOffsets[_proxySharedWith[i]];
+                continue;
+            }
+
+            _proxyBoneOffsets[i] = totalNumBones;
+
+            if (anim->_skeleton != nullptr && !anim->_wasCulled)
                 totalNumBones += anim->_skeleton->GetNumBones();
         }
 
-        // Prepare the write buffer
         _animData.Transforms.resize(totalNumBones);
+
+        // Keep last update's infos around, so we can tell where each pose lives in the previous bone palette
+        _prevAnimInfos.swap(_animData.Infos);
         _animData.Infos.clear();
 
-        UINT32 curBoneIdx = 0;
-        for (auto& anim : _proxies)
+        // Split proxies into batches of roughly equal bone count, so a single heavy skeleton doesn't stall the others
+        UINT32 concurrency = TaskScheduler::IsStarted() ? gTaskScheduler().GetConcurrency() : 1;
+        UINT32 bonesPerBatch = std::max(MIN_BONES_PER_BATCH, totalNumBones / (concurrency * BATCHES_PER_THREAD) + 1);
+
+        _evaluationBatches.clear();
+        UINT32 curBatchBones = 0;
+        for (UINT32 i = 0; i < numProxies; i++)
+        {
+            if (i == 0 || curBatchBones >= bonesPerBatch)
+            {
+                _evaluationBatches.push_back(i);
+                curBatchBones = 0;
+            }
+
+            // Proxies without an evaluated skeleton still evaluate scene object and generic curves
+            const AnimationProxy* anim = _proxies[i].get();
+            bool evaluatesPose = anim->_skeleton != nullptr && !anim->_wasCulled && !anim->_lodSkipPose &&
+                _proxySharedWith[i] == (UINT32)-1;
+            curBatchBones += evaluatesPose ? std::max(1U, anim->_skeleton->GetNumBones()) : 1;
+        }
+
+        auto evaluateBatch = [this, numProxies](UINT32 batchIdx)
+        {
+            UINT32 start = _evaluationBatches[batchIdx];
+            UINT32 end = (batchIdx + 1) < (UINT32)_evaluationBatches.size() ? _evaluationBatches[batchIdx + 1] : numProxies;
+
+            for (UINT32 i = start; i < end; i++)
+            {
+                AnimationProxy* anim = _proxies[i].get();
+                if (anim->_wasCulled)
+                {
+                    _proxyHasInfo[i] = 0;
+                    continue;
+                }
+
+                bool sharedPose = _proxySharedWith[i] != (UINT32)-1;
+                _proxyHasInfo[i] = EvaluateAnimation(anim, _proxyBoneOffsets[i], !sharedPose, _proxyInfos[i]) ? 1 : 0;
+            }
+        };
+
+        if (concurrency > 1)
         {
-            UINT32 boneIdx = curBoneIdx;
-            EvaluateAnimation(anim.get(), boneIdx);
+            gTaskScheduler().ParallelFor((UINT32)_evaluationBatches.size(), evaluateBatch);
+        }
+        else
+        {
+            for (UINT32 i = 0; i < (UINT32)_evaluationBatches.size(); i++)
+                evaluateBatch(i);
+        }
+
+        // Publish results in proxy order, so output doesn't depend on how the work was scheduled
+        _numSharedPoses = 0;
+        for (UINT32 i = 0; i < numProxies; i++)
+        {
+            if (!_proxyHasInfo[i])
+                continue;
+
+            if (_proxySharedWith[i] != (UINT32)-1)
+                _numSharedPoses++;
 
-            if (anim->_skeleton != nullptr)
-                curBoneIdx += anim->_skeleton->GetNumBones();
+            EvaluatedAnimationData::AnimInfo& animInfo = _animData.Infos[_proxies[i]->Id];
+            animInfo = _proxyInfos[i];
+
+            auto iterFind = _prevAnimInfos.find(_proxies[i]->Id);
+            if (iterFind != _prevAnimInfos.end() && iterFind->second.PoseInfos.NumBones == animInfo.PoseInfos.NumBones)
+                animInfo.PoseInfos.PrevStartIdx = iterFind->second.PoseInfos.StartIdx;
+            else
+                animInfo.PoseInfos.PrevStartIdx = (UINT32)-1;
         }
 
+        // Upload all the poses at once. The palette we're replacing becomes the previous frame's palette.
+        _bonePaletteIdx ^= 1;
+        UploadBonePalette(_bonePaletteIdx);
+        _bonePalettesInSync = false;
+
         // Trigger events and update attachments (for the data we just evaluated)
         for (auto& anim : _animations)
         {
@@ -122,31 +305,308 @@ namespace te
         return &_animData;
     }
 
-    void AnimationManager::EvaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx)
+    void AnimationManager::UploadBonePalette(UINT32 paletteIdx)
+    {
+        UINT32 numBones = (UINT32)_animData.Transforms.size();
+        if (numBones == 0)
+            return;
+
+        SPtr<GpuBuffer>& palette = _bonePalettes[paletteIdx];
+        if (palette == nullptr || palette->GetProperties().GetElementCount() < numBones * 4)
+        {
+            // Round up, so crowds that change size slightly don't reallocate every update
+            GPU_BUFFER_DESC desc;
+            desc.ElementCount = std::max(MIN_BONE_PALETTE_SIZE, Bitwise::NextPow2(numBones)) * 4;
+            desc.ElementSize = 0;
+            desc.Type = GBT_STANDARD;
+            desc.Format = BF_32X4F;
+            desc.Usage = GBU_DYNAMIC;
+
+            palette = GpuBuffer::Create(desc);
+        }
+
+        // Transforms are stored in the same row-major layout the shaders expect
+        UINT32 size = numBones * 16 * sizeof(float);
+        void* dest = palette->Lock(0, size, GBL_WRITE_ONLY_DISCARD);
+        memcpy(dest, _animData.Transforms.data(), size);
+        palette->Unlock();
+    }
+
+    void AnimationManager::SyncPrevBonePalette()
+    {
+        if (_bonePalettesInSync)
+            return;
+
+        UploadBonePalette(_bonePaletteIdx ^ 1);
+
+        for (auto& entry : _animData.Infos)
+            entry.second.PoseInfos.PrevStartIdx = entry.second.PoseInfos.StartIdx;
+
+        _bonePalettesInSync = true;
+    }
+
+    bool AnimationManager::IsCulled(const AnimationProxy* anim) const
     {
-        // Culling
-        if (anim->_cullEnabled)
+        if (!anim->_cullEnabled)
+            return false;
+
+        for (auto& frustum : _cullFrustums)
+        {
+            if (frustum.Intersects(anim->_bounds))
+                return false;
+        }
+
+        return true;
+    }
+
+    void AnimationManager::UpdateLod(AnimationProxy* anim)
+    {
+        anim->_lodSkipPose = false;
+        anim->_lodBlend = 0.0f;
+
+        float radius = anim->_bounds.GetRadius();
+        if (_lodLevels.empty() || anim->_skeleton == nullptr || _lodCameras.empty() || radius <= 0.0f)
+        {
+            anim->_lodLevel = 0;
+            anim->_lodNumPoses = 0;
+            return;
+        }
+
+        // Find the largest size on screen out of all cameras
+        Vector3 center = anim->_bounds.GetCenter();
+        float screenSize = 0.0f;
+        for (auto& camera : _lodCameras)
         {
-            bool isVisible = false;
-            for (auto& frustum : _cullFrustums)
+            float size;
+            if (camera.Ortho)
             {
-                if (frustum.Intersects(anim->_bounds))
+                size = 2.0f * radius * camera.ProjScale;
+            }
+            else
+            {
+                float distance = (center - camera.Position).Length();
+                if (distance <= radius)
                 {
-                    isVisible = true;
+                    screenSize = std::numeric_limits<float>::max();
                     break;
                 }
+
+                size = radius * camera.ProjScale / distance;
+            }
+
+            screenSize = std::max(screenSize, size);
+        }
+
+        UINT32 level = (UINT32)_lodLevels.size() - 1;
+        for (UINT32 i = 0; i < (UINT32)_lodLevels.size(); i++)
+        {
+            if (screenSize >= _lodLevels[i].MinScreenSize)
+            {
+                level = i;
+                break;
+            }
+        }
+
+        const AnimationLodLevel& lod = _lodLevels[level];
+        anim->_lodLevel = level;
+
+        // Combine the user provided mask with the bone depth limit of this level
+        if (anim->_lodMaskLevel != level)
+        {
+            anim->_lodMaskLevel = level;
+
+            if (lod.MaxBoneDepth != std::numeric_limits<UINT32>::max())
+            {
+                const SPtr<Skeleton>& skeleton = anim->_skeleton;
+                SkeletonMaskBuilder maskBuilder(skeleton, anim->_skeletonMask);
+
+                UINT32 numBones = skeleton->GetNumBones();
+                for (UINT32 i = 0; i < numBones; i++)
+                {
+                    UINT32 depth = 0;
+                    UINT32 parent = skeleton->GetBoneInfo(i).Parent;
+                    while (parent != (UINT32)-1 && depth <= lod.MaxBoneDepth)
+                    {
+                        depth++;
+                        parent = skeleton->GetBoneInfo(parent).Parent;
+                    }
+
+                    if (depth > lod.MaxBoneDepth)
+                        maskBuilder.SetBoneState(i, false);
+                }
+
+                anim->_lodMask = maskBuilder.GetMask();
+            }
+            else
+            {
+                anim->_lodMask = anim->_skeletonMask;
+            }
+        }
+
+        if (lod.UpdateInterval <= 1)
+        {
+            anim->_lodNumPoses = 0;
+            return;
+        }
+
+        // Offset the update phase by animation ID, so updates of different animations are spread across frames
+        if (anim->_lodNumPoses == 2)
+        {
+            UINT32 phase = (UINT32)((_updateCount + anim->Id) % lod.UpdateInterval);
+            if (phase != 0)
+            {
+                anim->_lodSkipPose = true;
+                anim->_lodBlend = phase / (float)lod.UpdateInterval;
+            }
+        }
+    }
+
+    bool AnimationManager::IsLodReduced(const AnimationProxy* anim) const
+    {
+        if (_lodLevels.empty())
+            return false;
+
+        const AnimationLodLevel& lod = _lodLevels[anim->_lodLevel];
+        return lod.UpdateInterval > 1 || lod.MaxLayers < anim->_numLayers ||
+            lod.MaxBoneDepth != std::numeric_limits<UINT32>::max();
+    }
+
+    void AnimationManager::ApplyLodPose(AnimationProxy* anim, Matrix4* bones, UINT32 numBones)
+    {
+        if (anim->_lodSkipPose)
+        {
+            const Matrix4* from = anim->_lodPoses[0].data();
+            const Matrix4* to = anim->_lodPoses[1].data();
+            float t = anim->_lodBlend;
+
+            // Blend decomposed transforms, component-wise matrix blending shears and shrinks rotating bones
+            for (UINT32 i = 0; i < numBones; i++)
+            {
+                Vector3 fromPosition, toPosition, fromScale, toScale;
+                Quaternion fromRotation, toRotation;
+                from[i].Decomposition(fromPosition, fromRotation, fromScale);
+                to[i].Decomposition(toPosition, toRotation, toScale);
+
+                bones[i].SetTRS(Vector3::Lerp(t, fromPosition, toPosition), Quaternion::Slerp(t, fromRotation, toRotation),
+                    Vector3::Lerp(t, fromScale, toScale));
+            }
+
+            return;
+        }
+
+        if (_lodLevels.empty() || _lodLevels[anim->_lodLevel].UpdateInterval <= 1)
+            return;
+
+        // Output lags one interval behind evaluation, so skipped updates can interpolate towards a known pose
+        if (anim->_lodNumPoses == 0)
+        {
+            anim->_lodPoses[0].assign(bones, bones + numBones);
+            anim->_lodPoses[1].assign(bones, bones + numBones);
+            anim->_lodNumPoses = 2;
+        }
+        else
+        {
+            std::swap(anim->_lodPoses[0], anim->_lodPoses[1]);
+            anim->_lodPoses[1].assign(bones, bones + numBones);
+            memcpy(bones, anim->_lodPoses[0].data(), sizeof(Matrix4) * numBones);
+        }
+    }
+
+    bool AnimationManager::CanSharePose(const AnimationProxy* anim) const
+    {
+        if (anim->_skeleton == nullptr || IsLodReduced(anim))
+            return false;
+
+        // Bones overriden or read back by scene objects make the pose unique to this animation
+        for (UINT32 i = 0; i < anim->_numSceneObjects; i++)
+        {
+            if (anim->_sceneObjectInfos[i].BoneIdx != -1)
+                return false;
+        }
+
+        return true;
+    }
+
+    INT64 AnimationManager::GetTimeBucket(float time) const
+    {
+        if (_instancingTimeQuantization <= 0.0f)
+        {
+            INT32 bits;
+            memcpy(&bits, &time, sizeof(bits));
+            return bits;
+        }
+
+        return (INT64)Math::Floor(time / _instancingTimeQuantization);
+    }
+
+    size_t AnimationManager::GetPoseStateHash(const AnimationProxy* anim) const
+    {
+        size_t hash = 0;
+        te_hash_combine(hash, anim->_skeleton.get());
+        te_hash_combine(hash, anim->_numLayers);
+
+        for (UINT32 i = 0; i < anim->_numLayers; i++)
+        {
+            const AnimationStateLayer& layer = anim->_layers[i];
+            te_hash_combine(hash, layer.NumStates);
+            te_hash_combine(hash, layer.Additive);
+
+            for (UINT32 j = 0; j < layer.NumStates; j++)
+            {
+                const AnimationState& state = layer.States[j];
+                if (state.Disabled)
+                    continue;
+
+                te_hash_combine(hash, state.Curves.get());
+                te_hash_combine(hash, GetTimeBucket(state.Time));
+                te_hash_combine(hash, state.Weight);
             }
+        }
+
+        return hash;
+    }
+
+    bool AnimationManager::IsPoseStateEqual(const AnimationProxy* a, const AnimationProxy* b) const
+    {
+        if (a->_skeleton != b->_skeleton || a->_numLayers != b->_numLayers)
+            return false;
+
+        if (a->_skeletonMask != b->_skeletonMask)
+            return false;
+
+        for (UINT32 i = 0; i < a->_numLayers; i++)
+        {
+            const AnimationStateLayer& layerA = a->_layers[i];
+            const AnimationStateLayer& layerB = b->_layers[i];
+
+            if (layerA.NumStates != layerB.NumStates || layerA.Additive != layerB.Additive)
+                return false;
 
-            if (!isVisible)
+            for (UINT32 j = 0; j < layerA.NumStates; j++)
             {
-                anim->_wasCulled = true;
-                return;
+                const AnimationState& stateA = layerA.States[j];
+                const AnimationState& stateB = layerB.States[j];
+
+                if (stateA.Disabled != stateB.Disabled)
+                    return false;
+
+                if (stateA.Disabled)
+                    continue;
+
+                if (stateA.Curves != stateB.Curves || stateA.Weight != stateB.Weight)
+                    return false;
+
+                if (GetTimeBucket(stateA.Time) != GetTimeBucket(stateB.Time))
+                    return false;
             }
         }
 
-        anim->_wasCulled = false;
+        return true;
+    }
 
-        EvaluatedAnimationData::AnimInfo animInfo;
+    bool AnimationManager::EvaluateAnimation(AnimationProxy* anim, UINT32 curBoneIdx, bool evaluatePose,
+        EvaluatedAnimationData::AnimInfo& animInfo)
+    {
         bool hasAnimInfo = false;
 
         // Evaluate skeletal animation
@@ -159,27 +619,44 @@ namespace te
             poseInfo.StartIdx = curBoneIdx;
             poseInfo.NumBones = numBones;
 
-            memset(anim->_skeletonPose.HasOverride, 0, sizeof(bool) * anim->_skeletonPose.NumBones);
-            Matrix4* boneDst = _animData.Transforms.data() + curBoneIdx;
-
-            // Copy transforms from mapped scene objects
-            UINT32 boneTfrmIdx = 0;
-            for (UINT32 i = 0; i < anim->_numSceneObjects; i++)
+            // Shared poses are written once, by the animation that owns the bone range
+            if (evaluatePose && anim->_lodSkipPose)
+            {
+                ApplyLodPose(anim, _animData.Transforms.data() + curBoneIdx, numBones);
+            }
+            else if (evaluatePose)
             {
-                const AnimatedSceneObjectInfo& soInfo = anim->_sceneObjectInfos[i];
+                memset(anim->_skeletonPose.HasOverride, 0, sizeof(bool) * anim->_skeletonPose.NumBones);
+                Matrix4* boneDst = _animData.Transforms.data() + curBoneIdx;
 
-                if (soInfo.BoneIdx == -1)
-                    continue;
+                // Copy transforms from mapped scene objects
+                UINT32 boneTfrmIdx = 0;
+                for (UINT32 i = 0; i < anim->_numSceneObjects; i++)
+                {
+                    const AnimatedSceneObjectInfo& soInfo = anim->_sceneObjectInfos[i];
 
-                boneDst[soInfo.BoneIdx] = anim->_sceneObjectTransforms[boneTfrmIdx];
-                anim->_skeletonPose.HasOverride[soInfo.BoneIdx] = true;
-                boneTfrmIdx++;
-            }
+                    if (soInfo.BoneIdx == -1)
+                        continue;
 
-            // Animate bones
-            anim->_skeleton->GetPose(boneDst, anim->_skeletonPose, anim->_skeletonMask, anim->_layers, anim->_numLayers);
+                    boneDst[soInfo.BoneIdx] = anim->_sceneObjectTransforms[boneTfrmIdx];
+                    anim->_skeletonPose.HasOverride[soInfo.BoneIdx] = true;
+                    boneTfrmIdx++;
+                }
+
+                // Animate bones
+                UINT32 numLayers = anim->_numLayers;
+                const SkeletonMask* mask = &anim->_skeletonMask;
+                if (!_lodLevels.empty())
+                {
+                    numLayers = std::min(numLayers, _lodLevels[anim->_lodLevel].MaxLayers);
+                    if (anim->_lodMaskLevel == anim->_lodLevel)
+                        mask = &anim->_lodMask;
+                }
+
+                anim->_skeleton->GetPose(boneDst, anim->_skeletonPose, *mask, anim->_layers, numLayers);
+                ApplyLodPose(anim, boneDst, numBones);
+            }
 
-            curBoneIdx += numBones;
             hasAnimInfo = true;
         }
         else
@@ -265,8 +742,7 @@ namespace te
             }
         }
 
-        if (hasAnimInfo)
-            _animData.Infos[anim->Id] = animInfo;
+        return hasAnimInfo;
     }
 
     AnimationManager& gAnimationManager()
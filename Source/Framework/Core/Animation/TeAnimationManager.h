@@ -11,12 +11,22 @@ namespace te
     /** Contains skeleton poses for all animations evaluated on a single frame. */
     struct EvaluatedAnimationData
     {
-        /** Contains meta-data about a calculated skeleton pose. Actual data maps to the @p transforms buffer. */
+        /**
+         * Contains meta-data about a calculated skeleton pose. Actual data maps to the @p transforms buffer. Multiple
+         * animations in an identical state may point to the same range of the buffer (see
+         * AnimationManager::SetInstancingEnabled).
+         */
         struct PoseInfo
         {
             UINT64 AnimId;
             UINT32 StartIdx;
             UINT32 NumBones;
+
+            /**
+             * Start of the same animation's pose in the previous bone palette (see
+             * AnimationManager::GetPrevBonePalette), or -1 if the animation wasn't evaluated during the previous update.
+             */
+            UINT32 PrevStartIdx = (UINT32)-1;
         };
 
         /** Contains meta-data about where calculated animation data is stored. */
@@ -34,6 +44,31 @@ namespace te
         Vector<Matrix4> Transforms;
     };
 
+    /**
+     * Describes how animations are evaluated depending on their size on screen. Smaller (usually distant) animations can
+     * be updated less often, evaluate fewer layers and skip bones deep in the hierarchy (fingers, face...).
+     */
+    struct AnimationLodLevel
+    {
+        /**
+         * Minimum projected size of the animation bounds, relative to the viewport height, at which this level is used.
+         * Animations smaller than every level's threshold use the last level.
+         */
+        float MinScreenSize = 0.0f;
+
+        /**
+         * Skeleton pose is evaluated once every this many animation updates. Poses are interpolated in between. Updates
+         * of different animations are staggered across frames.
+         */
+        UINT32 UpdateInterval = 1;
+
+        /** Maximum number of animation layers to evaluate. */
+        UINT32 MaxLayers = std::numeric_limits<UINT32>::max();
+
+        /** Bones deeper than this in the skeleton hierarchy are not animated and stay in their bind pose. */
+        UINT32 MaxBoneDepth = std::numeric_limits<UINT32>::max();
+    };
+
     /**
      * Keeps track of all active animations, queues animation thread tasks and synchronizes data between simulation, core
      * and animation threads.
@@ -65,6 +100,49 @@ namespace te
          */
         void SetUpdateRate(UINT32 fps);
 
+        /**
+         * Enables or disables pose sharing. When enabled, animations using the same skeleton, mask, clips and weights,
+         * whose clip times fall in the same time bucket, are evaluated only once and share the resulting range of bone
+         * matrices. Animations with bone attachments or bone overrides are never shared. Disabled by default.
+         */
+        void SetInstancingEnabled(bool enabled);
+
+        /** Checks is pose sharing enabled. */
+        bool GetInstancingEnabled() const { return _instancingEnabled; }
+
+        /**
+         * Determines the size of the time buckets (in seconds) used when looking for animations in identical states. Larger
+         * values allow more sharing at the cost of precision. Zero means clip times must match exactly. Default is
+         * 1/60th of a second.
+         */
+        void SetInstancingTimeQuantization(float seconds);
+
+        /** Returns the number of animations that used a shared pose during the last update. */
+        UINT32 GetNumSharedPoses() const { return _numSharedPoses; }
+
+        /**
+         * Sets up level of detail for skeletal animations. Levels are chosen per animation, every update, from the
+         * largest projected size of the animation bounds in any active camera. Provide an empty list to disable (default).
+         * Animations with empty bounds are always evaluated at full detail.
+         */
+        void SetLodLevels(const Vector<AnimationLodLevel>& levels);
+
+        /** @copydoc SetLodLevels */
+        const Vector<AnimationLodLevel>& GetLodLevels() const { return _lodLevels; }
+
+        /**
+         * Returns a GPU buffer containing all the bone transforms from the most recent update, laid out exactly like
+         * EvaluatedAnimationData::Transforms (four float4 rows per bone). Skinned objects address their bones using
+         * PoseInfo::StartIdx as an offset. Null until the first update that produced any bones.
+         */
+        const SPtr<GpuBuffer>& GetBonePalette() const { return _bonePalettes[_bonePaletteIdx]; }
+
+        /**
+         * Returns the bone palette from the update before the most recent one, addressed using PoseInfo::PrevStartIdx.
+         * If no new update happened since, the palette contains the same data as GetBonePalette().
+         */
+        const SPtr<GpuBuffer>& GetPrevBonePalette() const { return _bonePalettes[_bonePaletteIdx ^ 1]; }
+
     private:
         friend class Animation;
 
@@ -77,13 +155,68 @@ namespace te
         void UnregisterAnimation(UINT64 id);
 
         /**
-         * Evaluates animation for a single object and writes the result in the currently active write buffer.
+         * Evaluates animation for a single object and writes the result in the currently active write buffer. Only
+         * touches data owned by the proxy and its own range of the output buffer, so different proxies can be evaluated
+         * concurrently.
          *
-         * @param[in]	anim		Proxy representing the animation to evaluate.
-         * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information. This will be
-         *							automatically advanced by the number of written bone transforms.
+         * @param[in]	anim			Proxy representing the animation to evaluate.
+         * @param[in]	boneIdx			Index in the output buffer in which to write evaluated bone information.
+         * @param[in]	evaluatePose	If false, the skeleton pose is assumed to be written to @p boneIdx by another
+         *								animation in an identical state, and only non-skeletal curves are evaluated.
+         * @param[out]	animInfo		Information about where the evaluated data was written.
+         * @return						True if @p animInfo was populated and should be published.
+         */
+        bool EvaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, bool evaluatePose,
+            EvaluatedAnimationData::AnimInfo& animInfo);
+
+        /** Checks is the animation outside of all the active camera frustums. */
+        bool IsCulled(const AnimationProxy* anim) const;
+
+        /**
+         * Picks the level of detail for the animation and determines whether its pose should be evaluated this update,
+         * or interpolated from previous updates.
          */
-        void EvaluateAnimation(AnimationProxy* anim, UINT32& boneIdx);
+        void UpdateLod(AnimationProxy* anim);
+
+        /** Checks is the animation using a level of detail that deviates from the full quality pose. */
+        bool IsLodReduced(const AnimationProxy* anim) const;
+
+        /**
+         * Handles pose history for animations that aren't evaluated every update. Stores the freshly evaluated pose in
+         * @p bones, or replaces it with an interpolated one when evaluation was skipped.
+         */
+        void ApplyLodPose(AnimationProxy* anim, Matrix4* bones, UINT32 numBones);
+
+        /** Checks can the skeleton pose of the provided animation be shared with other animations. */
+        bool CanSharePose(const AnimationProxy* anim) const;
+
+        /** Maps a clip time to the bucket used for identifying identical animation states. */
+        INT64 GetTimeBucket(float time) const;
+
+        /** Generates a hash from all the animation state that influences the evaluated skeleton pose. */
+        size_t GetPoseStateHash(const AnimationProxy* anim) const;
+
+        /** Checks would the two animations evaluate to the same skeleton pose. */
+        bool IsPoseStateEqual(const AnimationProxy* a, const AnimationProxy* b) const;
+
+        /** Copies all evaluated bone transforms into the bone palette with the provided index, using a single lock. */
+        void UploadBonePalette(UINT32 paletteIdx);
+
+        /**
+         * Makes the previous bone palette match the current one, once no new update happened for a frame, so objects
+         * that aren't animating don't report skinned motion.
+         */
+        void SyncPrevBonePalette();
+
+    private:
+        /** Minimum number of bones evaluated by a single worker batch. Smaller batches aren't worth the dispatch. */
+        static constexpr UINT32 MIN_BONES_PER_BATCH = 256;
+
+        /** Number of batches to generate per available thread, to balance uneven skeleton evaluation costs. */
+        static constexpr UINT32 BATCHES_PER_THREAD = 4;
+
+        /** Minimum number of bones the bone palette is allocated for. */
+        static constexpr UINT32 MIN_BONE_PALETTE_SIZE = 256;
 
     private:
         UINT64 _nextId = 1;
@@ -96,9 +229,36 @@ namespace te
         float _lastAnimationDeltaTime = 0.0f;
         bool  _paused = true;
 
+        bool _instancingEnabled = false;
+        float _instancingTimeQuantization = 1.0f / 60.0f;
+        UINT32 _numSharedPoses = 0;
+
         Vector<SPtr<AnimationProxy>> _proxies;
+        Vector<UINT32> _proxyBoneOffsets;
+        Vector<UINT32> _proxySharedWith;
+        UnorderedMultimap<size_t, UINT32> _poseStateLookup;
+        Vector<EvaluatedAnimationData::AnimInfo> _proxyInfos;
+        Vector<UINT8> _proxyHasInfo;
+        Vector<UINT32> _evaluationBatches;
         Vector<ConvexVolume> _cullFrustums;
+
+        /** Information about a camera required for calculating projected size of animation bounds. */
+        struct LodCamera
+        {
+            Vector3 Position;
+            float ProjScale; /**< Inverse of tangent of half the vertical FOV, or inverse of ortho height. */
+            bool Ortho;
+        };
+
+        Vector<AnimationLodLevel> _lodLevels;
+        Vector<LodCamera> _lodCameras;
+        UINT64 _updateCount = 0;
         EvaluatedAnimationData _animData;
+        UnorderedMap<UINT64, EvaluatedAnimationData::AnimInfo> _prevAnimInfos;
+
+        SPtr<GpuBuffer> _bonePalettes[2];
+        UINT32 _bonePaletteIdx = 0;
+        bool _bonePalettesInSync = true;
     };
 
     /** Provides easier access to AnimationManager. */
@@ -146,8 +146,12 @@ namespace te
             localPose.Scales[i] = Vector3::ONE;
         }
 
-        bool* hasAnimCurve = te_newN<bool>(_numBones);
-        te_zero_out(hasAnimCurve, _numBones);
+        // Scratch data lives in the per-thread frame allocator, as poses are evaluated from multiple threads every frame
+        te_frame_mark();
+
+        bool* hasAnimCurve = (bool*)te_frame_allocate(sizeof(bool) * _numBones * 2);
+        bool* isGlobal = hasAnimCurve + _numBones;
+        memset(hasAnimCurve, 0, sizeof(bool) * _numBones * 2);
 
         for (UINT32 i = 0; i < numLayers; i++)
         {
@@ -257,10 +261,6 @@ namespace te
         }
 
         // Calculate local pose matrices
-        UINT32 isGlobalBytes = sizeof(bool) * _numBones;
-        bool* isGlobal = (bool*)te_allocate(isGlobalBytes);
-        memset(isGlobal, 0, isGlobalBytes);
-
         for (UINT32 i = 0; i < _numBones; i++)
         {
             bool isAssigned = localPose.Rotations[i].w != 0.0f;
@@ -306,8 +306,8 @@ namespace te
         for (UINT32 i = 0; i < _numBones; i++)
             pose[i] = pose[i] * _invBindPoses[i];
 
-        te_delete(isGlobal);
-        te_deleteN<bool>(hasAnimCurve, _numBones);
+        te_frame_free(hasAnimCurve);
+        te_frame_clear();
     }
 
     SPtr<Skeleton> Skeleton::Create(BONE_DESC* bones, UINT32 numBones)
@@ -20,6 +20,14 @@ namespace te
         , _mask(skeleton->GetNumBones())
     { }
 
+    SkeletonMaskBuilder::SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton, const SkeletonMask& mask)
+        : _skeleton(skeleton)
+        , _mask(mask)
+    {
+        // Default constructed masks have all bones enabled
+        _mask._isDisabled.resize(skeleton->GetNumBones(), false);
+    }
+
     void SkeletonMaskBuilder::SetBoneState(const String& name, bool enabled)
     {
         UINT32 numBones = _skeleton->GetNumBones();
@@ -32,4 +40,10 @@ namespace te
             }
         }
     }
+
+    void SkeletonMaskBuilder::SetBoneState(UINT32 boneIdx, bool enabled)
+    {
+        if (boneIdx < (UINT32)_mask._isDisabled.size())
+            _mask._isDisabled[boneIdx] = !enabled;
+    }
 }
@@ -20,6 +20,9 @@ namespace te
          */
         bool IsEnabled(UINT32 boneIdx) const;
 
+        bool operator== (const SkeletonMask& rhs) const { return _isDisabled == rhs._isDisabled; }
+        bool operator!= (const SkeletonMask& rhs) const { return !(*this == rhs); }
+
     private:
         friend class SkeletonMaskBuilder;
 
@@ -32,9 +35,15 @@ namespace te
     public:
         SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton);
 
+        /** Creates a builder starting from an existing mask built for the same skeleton. */
+        SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton, const SkeletonMask& mask);
+
         /** Enables or disables a bone with the specified name. */
         void SetBoneState(const String& name, bool enabled);
 
+        /** Enables or disables a bone with the specified index. */
+        void SetBoneState(UINT32 boneIdx, bool enabled);
+
         /** Teturns the built skeleton mask. */
         SkeletonMask GetMask() const { return _mask; }
 
@@ -20,6 +20,7 @@ set (TE_CORE_INC_RENDERAPI
     "Core/RenderAPI/TeHardwareBuffer.h"
     "Core/RenderAPI/TeRenderTexture.h"
     "Core/RenderAPI/TeGpuProgram.h"
+    "Core/RenderAPI/TeGpuProgramCache.h"
     "Core/RenderAPI/TeGpuBuffer.h"
     "Core/RenderAPI/TeGpuParamDesc.h"
     "Core/RenderAPI/TeGpuProgramManager.h"
@@ -29,6 +30,7 @@ set (TE_CORE_INC_RENDERAPI
     "Core/RenderAPI/TeGpuParam.h"
     "Core/RenderAPI/TeGpuParamBlockBuffer.h"
     "Core/RenderAPI/TeVertexData.h"
+    "Core/RenderAPI/TeCommandBuffer.h"
 )
 set (TE_CORE_SRC_RENDERAPI
     "Core/RenderAPI/TeRenderAPI.cpp"
@@ -48,6 +50,7 @@ set (TE_CORE_SRC_RENDERAPI
     "Core/RenderAPI/TeTextureView.cpp"
     "Core/RenderAPI/TeRenderTexture.cpp"
     "Core/RenderAPI/TeGpuProgram.cpp"
+    "Core/RenderAPI/TeGpuProgramCache.cpp"
     "Core/RenderAPI/TeGpuBuffer.cpp"
     "Core/RenderAPI/TeGpuProgramManager.cpp"
     "Core/RenderAPI/TeHardwareBufferManager.cpp"
@@ -56,6 +59,7 @@ set (TE_CORE_SRC_RENDERAPI
     "Core/RenderAPI/TeGpuParam.cpp"
     "Core/RenderAPI/TeGpuParamBlockBuffer.cpp"
     "Core/RenderAPI/TeVertexData.cpp"
+    "Core/RenderAPI/TeCommandBuffer.cpp"
 )
 
 set (TE_CORE_INC_RENDERER
@@ -233,6 +237,7 @@ set (TE_CORE_INC_IMAGE
     "Core/Image/TeTextureManager.h"
     "Core/Image/TePixelData.h"
     "Core/Image/TePixelUtil.h"
+    "Core/Image/TeIBLUtility.h"
     "Core/Image/TePixelVolume.h"
     "Core/Image/TeColor.h"
 )
@@ -241,6 +246,7 @@ set (TE_CORE_SRC_IMAGE
     "Core/Image/TeTextureManager.cpp"
     "Core/Image/TePixelData.cpp"
     "Core/Image/TePixelUtil.cpp"
+    "Core/Image/TeIBLUtility.cpp"
     "Core/Image/TeColor.cpp"
 )
 
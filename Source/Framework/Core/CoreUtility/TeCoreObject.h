@@ -96,8 +96,13 @@ namespace te
         void SetIsDestroyed(bool destroyed) { _flags = destroyed ? _flags | CGO_DESTROYED : _flags & ~CGO_DESTROYED; }
 
     private:
+        friend class CoreObjectManager;
+
+        static constexpr UINT32 NOT_IN_DIRTY_LIST = (UINT32)-1;
+
         volatile UINT8 _flags;
         UINT32 _coreDirtyFlags;
+        UINT32 _dirtyListIdx = NOT_IN_DIRTY_LIST; /**< Index in CoreObjectManager's dirty list, if queued for sync. */
         UINT64 _internalID; // ID == 0 is not a valid ID
         WPtr<CoreObject> _this;
     };
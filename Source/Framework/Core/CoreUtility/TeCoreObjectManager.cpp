@@ -1,4 +1,4 @@
- #include "TeCoreObjectManager.h"
+#include "TeCoreObjectManager.h"
 #include "TeCoreObject.h"
 
 namespace te
@@ -40,31 +40,50 @@ namespace te
         UINT64 internalId = object->GetInternalID();
         _objects.erase(internalId);
 
-        bool isDirty = object->IsCoreDirty() || (_dirtyObjects.find(internalId) != _dirtyObjects.end());
-
-        if (isDirty)
+        if (object->_dirtyListIdx != CoreObject::NOT_IN_DIRTY_LIST)
         {
-            _dirtyObjects.erase(object->GetInternalID());
+            _dirtyObjects[object->_dirtyListIdx] = nullptr;
+            object->_dirtyListIdx = CoreObject::NOT_IN_DIRTY_LIST;
         }
     }
 
     void CoreObjectManager::NotifyCoreDirty(CoreObject* object)
     {
-        UINT64 id = object->GetInternalID();
-        _dirtyObjects[id] = object;
+        if (object->_dirtyListIdx != CoreObject::NOT_IN_DIRTY_LIST)
+            return;
+
+        object->_dirtyListIdx = (UINT32)_dirtyObjects.size();
+        _dirtyObjects.push_back(object);
+    }
+
+    void CoreObjectManager::SyncObject(CoreObject* object)
+    {
+        object->FrameSync();
+        object->MarkCoreClean();
+        object->_dirtyListIdx = CoreObject::NOT_IN_DIRTY_LIST;
     }
 
     void CoreObjectManager::FrameSync()
     {
+        _frameSyncStats.NumSynced = 0;
+        _frameSyncStats.NumSyncedPerType.clear();
+
         if (_dirtyObjects.size() == 0)
             return;
 
-        auto it = _dirtyObjects.begin();
-        while (it != _dirtyObjects.end())
+        // Syncing an object can dirty or destroy others, so index the list every iteration and skip removed entries
+        for (UINT32 i = 0; i < (UINT32)_dirtyObjects.size(); i++)
         {
-            it->second->FrameSync();
-            it->second->MarkCoreClean();
-            _dirtyObjects.erase(it++);
+            CoreObject* object = _dirtyObjects[i];
+            if (object == nullptr)
+                continue;
+
+            _frameSyncStats.NumSyncedPerType[std::type_index(typeid(*object))]++;
+            _frameSyncStats.NumSynced++;
+
+            SyncObject(object);
         }
+
+        _dirtyObjects.clear();
     }
 }
@@ -2,9 +2,17 @@
 
 #include "TeCorePrerequisites.h"
 #include "Utility/TeModule.h"
+#include <typeindex>
 
 namespace te
 {
+    /** Information about objects synchronized during the last call to CoreObjectManager::FrameSync(). */
+    struct CoreObjectSyncStats
+    {
+        UINT32 NumSynced = 0; /**< Total number of synced objects. */
+        UnorderedMap<std::type_index, UINT32> NumSyncedPerType; /**< Number of synced objects per object type. */
+    };
+
     class TE_CORE_EXPORT CoreObjectManager : public Module<CoreObjectManager>
     {
     public:
@@ -23,12 +31,26 @@ namespace te
         /**	Notifies the system that a CoreObject is dirty and needs to be synced with the core thread. */
         void NotifyCoreDirty(CoreObject* object);
 
-        /** Synchronize all dirty objects once per frame */
+        /** Synchronize all dirty objects once per frame, in the order they were marked dirty. */
         void FrameSync();
 
+        /** Returns information about objects synced during the last FrameSync() call. */
+        const CoreObjectSyncStats& GetFrameSyncStats() const { return _frameSyncStats; }
+
+    private:
+        /** Calls FrameSync() on the object and removes it from the dirty list. */
+        static void SyncObject(CoreObject* object);
+
     private:
         UINT64 _nextAvailableID;
         UnorderedMap<UINT64, CoreObject*> _objects;
-        UnorderedMap<UINT64, CoreObject*> _dirtyObjects;
+
+        /**
+         * Objects marked dirty since the last sync. Destroyed objects leave a null entry behind. Cleared but never
+         * shrunk, so a frame normally doesn't allocate.
+         */
+        Vector<CoreObject*> _dirtyObjects;
+
+        CoreObjectSyncStats _frameSyncStats;
     };
 }
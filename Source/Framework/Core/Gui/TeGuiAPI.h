@@ -45,6 +45,9 @@ namespace te
         /** Before using ImGui somewhere, we want to be sure that gui context is initialized */
         inline bool IsGuiInitialized() { return _guiInitialized; };
 
+        /** Return true if a frame has been started with BeginFrame() and is still waiting for EndFrame() */
+        inline bool IsGuiStarted() { return _guiStarted; };
+
     public:
         /** Called from the message loop to notify user has entered a character. */
         virtual void CharInput(UINT32 character) = 0;
@@ -0,0 +1,511 @@
+#include "Image/TeIBLUtility.h"
+#include "Image/TePixelUtil.h"
+#include "Math/TeMath.h"
+#include "Math/TeVector3.h"
+#include "Threading/TeTaskScheduler.h"
+
+#if TE_SIMD_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace te
+{
+    namespace
+    {
+        /** Number of texel rows processed by a single job when filtering cubemaps. */
+        static constexpr UINT32 FILTER_ROWS_PER_JOB = 8;
+
+        /** Largest face size used when projecting a cubemap onto spherical harmonics. */
+        static constexpr UINT32 IRRADIANCE_FACE_SIZE = 64;
+
+#if TE_SIMD_SSE2
+        typedef __m128 Float4;
+
+        Float4 Zero4() { return _mm_setzero_ps(); }
+        Float4 Load4(const float* data) { return _mm_loadu_ps(data); }
+        void Store4(float* data, Float4 value) { _mm_storeu_ps(data, value); }
+        Float4 MulAdd4(Float4 sum, Float4 value, float weight) { return _mm_add_ps(sum, _mm_mul_ps(value, _mm_set1_ps(weight))); }
+        Float4 Mul4(Float4 value, float scale) { return _mm_mul_ps(value, _mm_set1_ps(scale)); }
+#else
+        struct Float4 { float V[4]; };
+
+        Float4 Zero4() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+        Float4 Load4(const float* data) { return { { data[0], data[1], data[2], data[3] } }; }
+        void Store4(float* data, Float4 value) { memcpy(data, value.V, sizeof(value.V)); }
+
+        Float4 MulAdd4(Float4 sum, Float4 value, float weight)
+        {
+            for (UINT32 i = 0; i < 4; i++)
+                sum.V[i] += value.V[i] * weight;
+
+            return sum;
+        }
+
+        Float4 Mul4(Float4 value, float scale)
+        {
+            for (UINT32 i = 0; i < 4; i++)
+                value.V[i] *= scale;
+
+            return value;
+        }
+#endif
+
+        /** Runs the jobs on the task scheduler, or on the calling thread when the scheduler isn't running. */
+        template<class Job>
+        void RunFilterJobs(UINT32 numJobs, Job job)
+        {
+            if (TaskScheduler::IsStarted())
+                RunFilterJobs(numJobs, job);
+            else
+            {
+                for (UINT32 i = 0; i < numJobs; i++)
+                    job(i);
+            }
+        }
+
+        float SRGBToLinear(float value)
+        {
+            return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        float LinearToSRGB(float value)
+        {
+            return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        }
+
+        /**
+         * Returns the direction pointing towards a point on a cubemap face, using the D3D cubemap conventions. Face
+         * coordinates are in [-1, 1] range. Returned direction is not normalized.
+         */
+        Vector3 FaceToDirection(UINT32 face, float u, float v)
+        {
+            switch (face)
+            {
+            case CF_PositiveX: return Vector3(1.0f, -v, -u);
+            case CF_NegativeX: return Vector3(-1.0f, -v, u);
+            case CF_PositiveY: return Vector3(u, 1.0f, v);
+            case CF_NegativeY: return Vector3(u, -1.0f, -v);
+            case CF_PositiveZ: return Vector3(u, -v, 1.0f);
+            default: return Vector3(-u, -v, -1.0f);
+            }
+        }
+
+        /** Inverse of FaceToDirection(). Returns the face the direction points to, and coordinates on it in [0, 1] range. */
+        UINT32 DirectionToFace(const Vector3& dir, float& u, float& v)
+        {
+            const float absX = std::abs(dir.x);
+            const float absY = std::abs(dir.y);
+            const float absZ = std::abs(dir.z);
+
+            if (absX >= absY && absX >= absZ)
+            {
+                const float scale = 0.5f / absX;
+                v = -dir.y * scale + 0.5f;
+                u = (dir.x > 0.0f ? -dir.z : dir.z) * scale + 0.5f;
+                return dir.x > 0.0f ? CF_PositiveX : CF_NegativeX;
+            }
+
+            if (absY >= absZ)
+            {
+                const float scale = 0.5f / absY;
+                u = dir.x * scale + 0.5f;
+                v = (dir.y > 0.0f ? dir.z : -dir.z) * scale + 0.5f;
+                return dir.y > 0.0f ? CF_PositiveY : CF_NegativeY;
+            }
+
+            const float scale = 0.5f / absZ;
+            u = (dir.z > 0.0f ? dir.x : -dir.x) * scale + 0.5f;
+            v = -dir.y * scale + 0.5f;
+            return dir.z > 0.0f ? CF_PositiveZ : CF_NegativeZ;
+        }
+
+        /** Samples a cubemap level in the provided direction with bilinear filtering. Filtering doesn't cross faces. */
+        Float4 SampleBilinear(const IBLCubemap::Level& level, const Vector3& dir)
+        {
+            float u, v;
+            const UINT32 face = DirectionToFace(dir, u, v);
+            const float* data = level.Faces[face].data();
+
+            const float x = u * level.Size - 0.5f;
+            const float y = v * level.Size - 0.5f;
+            const float floorX = std::floor(x);
+            const float floorY = std::floor(y);
+            const float fracX = x - floorX;
+            const float fracY = y - floorY;
+
+            const INT32 maxCoord = (INT32)level.Size - 1;
+            const UINT32 x0 = (UINT32)Math::Clamp((INT32)floorX, 0, maxCoord);
+            const UINT32 x1 = (UINT32)Math::Clamp((INT32)floorX + 1, 0, maxCoord);
+            const UINT32 y0 = (UINT32)Math::Clamp((INT32)floorY, 0, maxCoord);
+            const UINT32 y1 = (UINT32)Math::Clamp((INT32)floorY + 1, 0, maxCoord);
+
+            Float4 sum = Zero4();
+            sum = MulAdd4(sum, Load4(data + (y0 * level.Size + x0) * 4), (1.0f - fracX) * (1.0f - fracY));
+            sum = MulAdd4(sum, Load4(data + (y0 * level.Size + x1) * 4), fracX * (1.0f - fracY));
+            sum = MulAdd4(sum, Load4(data + (y1 * level.Size + x0) * 4), (1.0f - fracX) * fracY);
+            sum = MulAdd4(sum, Load4(data + (y1 * level.Size + x1) * 4), fracX * fracY);
+
+            return sum;
+        }
+
+        /** Returns the i-th point of a Hammersley sequence of @p count points. */
+        void Hammersley(UINT32 i, UINT32 count, float& x, float& y)
+        {
+            UINT32 bits = i;
+            bits = (bits << 16) | (bits >> 16);
+            bits = ((bits & 0x55555555) << 1) | ((bits & 0xAAAAAAAA) >> 1);
+            bits = ((bits & 0x33333333) << 2) | ((bits & 0xCCCCCCCC) >> 2);
+            bits = ((bits & 0x0F0F0F0F) << 4) | ((bits & 0xF0F0F0F0) >> 4);
+            bits = ((bits & 0x00FF00FF) << 8) | ((bits & 0xFF00FF00) >> 8);
+
+            x = (float)i / (float)count;
+            y = (float)bits * 2.3283064365386963e-10f; // 1 / 2^32
+        }
+
+        /** Importance sample of the GGX lobe, in tangent space of the reflected direction. */
+        struct RadianceSample
+        {
+            Vector3 Direction;
+            float Weight;
+            UINT32 SourceMip;
+        };
+
+        /**
+         * Generates importance samples of the GGX lobe for the provided roughness. The view direction is assumed equal
+         * to the normal and the reflected direction, and every sample picks the source mip whose texels roughly cover
+         * the solid angle it represents.
+         */
+        Vector<RadianceSample> GenerateRadianceSamples(float roughness, UINT32 numSamples, const IBLCubemap& source)
+        {
+            const float alpha = roughness * roughness;
+            const float alpha2 = alpha * alpha;
+            const UINT32 topSize = source.Levels[0].Size;
+            const float texelSolidAngle = 4.0f * Math::PI / (6.0f * topSize * topSize);
+
+            Vector<RadianceSample> samples;
+            float totalWeight = 0.0f;
+            for (UINT32 i = 0; i < numSamples; i++)
+            {
+                float xiX, xiY;
+                Hammersley(i, numSamples, xiX, xiY);
+
+                const float phi = Math::TWO_PI * xiX;
+                const float cosTheta = std::sqrt((1.0f - xiY) / (1.0f + (alpha2 - 1.0f) * xiY));
+                const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+
+                // Reflect the view direction (0, 0, 1) around the half vector
+                const Vector3 halfVector(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+                const Vector3 direction = halfVector * (2.0f * cosTheta) - Vector3(0.0f, 0.0f, 1.0f);
+
+                const float NoL = direction.z;
+                if (NoL <= 0.0f)
+                    continue;
+
+                // pdf = D * NoH / (4 * VoH), where NoH == VoH
+                const float d = cosTheta * cosTheta * (alpha2 - 1.0f) + 1.0f;
+                const float pdf = alpha2 / (Math::PI * d * d) * 0.25f;
+                const float sampleSolidAngle = 1.0f / (numSamples * pdf + 1e-6f);
+
+                float mip = 0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f;
+                mip = Math::Clamp(mip, 0.0f, (float)(source.Levels.size() - 1));
+
+                samples.push_back({ direction, NoL, (UINT32)(mip + 0.5f) });
+                totalWeight += NoL;
+            }
+
+            for (auto& sample : samples)
+                sample.Weight /= totalWeight;
+
+            return samples;
+        }
+
+        /** Evaluates the real spherical harmonics basis functions, up to the third order, in the provided direction. */
+        void EvaluateSHBasis(const Vector3& dir, float (&basis)[9])
+        {
+            basis[0] = 0.282095f;
+            basis[1] = 0.488603f * dir.y;
+            basis[2] = 0.488603f * dir.z;
+            basis[3] = 0.488603f * dir.x;
+            basis[4] = 1.092548f * dir.x * dir.y;
+            basis[5] = 1.092548f * dir.y * dir.z;
+            basis[6] = 0.315392f * (3.0f * dir.z * dir.z - 1.0f);
+            basis[7] = 1.092548f * dir.x * dir.z;
+            basis[8] = 0.546274f * (dir.x * dir.x - dir.y * dir.y);
+        }
+    }
+
+    SPtr<IBLCubemap> IBLUtility::CreateCubemap(const Vector<SPtr<PixelData>>& faces, bool isSRGB)
+    {
+        if (faces.size() != 6)
+        {
+            TE_DEBUG("IBL cubemap creation failed. Cubemap must have six faces.");
+            return nullptr;
+        }
+
+        SPtr<IBLCubemap> cubemap = te_shared_ptr_new<IBLCubemap>();
+        cubemap->Format = faces[0]->GetFormat();
+        cubemap->IsSRGB = isSRGB;
+        cubemap->Levels.push_back(IBLCubemap::Level());
+
+        IBLCubemap::Level& top = cubemap->Levels.back();
+        top.Size = faces[0]->GetWidth();
+
+        RunFilterJobs(6, [&](UINT32 face)
+        {
+            Vector<float>& data = top.Faces[face];
+            data.resize((size_t)top.Size * top.Size * 4);
+
+            PixelData floatData(top.Size, top.Size, 1, PF_RGBA32F);
+            floatData.SetExternalBuffer((UINT8*)data.data());
+            PixelUtil::BulkPixelConversion(*faces[face], floatData);
+
+            if (isSRGB)
+            {
+                for (size_t i = 0; i < data.size(); i += 4)
+                {
+                    data[i + 0] = SRGBToLinear(data[i + 0]);
+                    data[i + 1] = SRGBToLinear(data[i + 1]);
+                    data[i + 2] = SRGBToLinear(data[i + 2]);
+                }
+            }
+        });
+
+        while (cubemap->Levels.back().Size > 1)
+        {
+            cubemap->Levels.push_back(IBLCubemap::Level());
+
+            const IBLCubemap::Level& src = cubemap->Levels[cubemap->Levels.size() - 2];
+            IBLCubemap::Level& dst = cubemap->Levels.back();
+            dst.Size = std::max(1U, src.Size / 2);
+
+            RunFilterJobs(6, [&](UINT32 face)
+            {
+                const float* srcData = src.Faces[face].data();
+                Vector<float>& dstData = dst.Faces[face];
+                dstData.resize((size_t)dst.Size * dst.Size * 4);
+
+                for (UINT32 y = 0; y < dst.Size; y++)
+                {
+                    const UINT32 y0 = std::min(y * 2, src.Size - 1);
+                    const UINT32 y1 = std::min(y * 2 + 1, src.Size - 1);
+
+                    for (UINT32 x = 0; x < dst.Size; x++)
+                    {
+                        const UINT32 x0 = std::min(x * 2, src.Size - 1);
+                        const UINT32 x1 = std::min(x * 2 + 1, src.Size - 1);
+
+                        Float4 sum = Zero4();
+                        sum = MulAdd4(sum, Load4(srcData + (y0 * src.Size + x0) * 4), 0.25f);
+                        sum = MulAdd4(sum, Load4(srcData + (y0 * src.Size + x1) * 4), 0.25f);
+                        sum = MulAdd4(sum, Load4(srcData + (y1 * src.Size + x0) * 4), 0.25f);
+                        sum = MulAdd4(sum, Load4(srcData + (y1 * src.Size + x1) * 4), 0.25f);
+
+                        Store4(&dstData[((size_t)y * dst.Size + x) * 4], sum);
+                    }
+                }
+            });
+        }
+
+        return cubemap;
+    }
+
+    Vector<Vector<SPtr<PixelData>>> IBLUtility::FilterRadiance(const IBLCubemap& source, UINT32 numMips,
+        UINT32 numSamples)
+    {
+        Vector<Vector<SPtr<PixelData>>> output;
+        if (source.Levels.empty())
+        {
+            TE_DEBUG("Radiance filtering failed. Source cubemap is empty.");
+            return output;
+        }
+
+        const UINT32 topSize = source.Levels[0].Size;
+
+        struct FilterJob
+        {
+            UINT32 Mip;
+            UINT32 Face;
+            UINT32 Top;
+        };
+
+        // All levels of all faces are filtered at once, split into groups of rows, so small levels don't leave cores idle
+        Vector<IBLCubemap::Level> filtered(numMips + 1);
+        Vector<Vector<RadianceSample>> samples(numMips + 1);
+        Vector<FilterJob> jobs;
+        for (UINT32 mip = 1; mip <= numMips; mip++)
+        {
+            IBLCubemap::Level& level = filtered[mip];
+            level.Size = std::max(1U, topSize >> mip);
+            for (UINT32 face = 0; face < 6; face++)
+            {
+                level.Faces[face].resize((size_t)level.Size * level.Size * 4);
+                for (UINT32 top = 0; top < level.Size; top += FILTER_ROWS_PER_JOB)
+                    jobs.push_back({ mip, face, top });
+            }
+
+            samples[mip] = GenerateRadianceSamples(MipToRoughness(mip, numMips), numSamples, source);
+        }
+
+        RunFilterJobs((UINT32)jobs.size(), [&](UINT32 jobIdx)
+        {
+            const FilterJob& job = jobs[jobIdx];
+            const Vector<RadianceSample>& mipSamples = samples[job.Mip];
+            IBLCubemap::Level& level = filtered[job.Mip];
+
+            const float invSize = 1.0f / level.Size;
+            const UINT32 bottom = std::min(level.Size, job.Top + FILTER_ROWS_PER_JOB);
+            for (UINT32 y = job.Top; y < bottom; y++)
+            {
+                for (UINT32 x = 0; x < level.Size; x++)
+                {
+                    const float u = (x + 0.5f) * invSize * 2.0f - 1.0f;
+                    const float v = (y + 0.5f) * invSize * 2.0f - 1.0f;
+                    const Vector3 normal = Vector3::Normalize(FaceToDirection(job.Face, u, v));
+
+                    const Vector3 up = std::abs(normal.z) < 0.999f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(1.0f, 0.0f, 0.0f);
+                    const Vector3 tangent = Vector3::Normalize(Vector3::Cross(up, normal));
+                    const Vector3 bitangent = Vector3::Cross(normal, tangent);
+
+                    Float4 sum = Zero4();
+                    for (const RadianceSample& sample : mipSamples)
+                    {
+                        const Vector3 dir = tangent * sample.Direction.x + bitangent * sample.Direction.y +
+                            normal * sample.Direction.z;
+
+                        sum = MulAdd4(sum, SampleBilinear(source.Levels[sample.SourceMip], dir), sample.Weight);
+                    }
+
+                    Store4(&level.Faces[job.Face][((size_t)y * level.Size + x) * 4], sum);
+                }
+            }
+        });
+
+        output.resize(6);
+        for (UINT32 mip = 0; mip <= numMips; mip++)
+        {
+            // Top level is a perfect mirror, the source is used as is
+            const IBLCubemap::Level& level = mip == 0 ? source.Levels[0] : filtered[mip];
+            for (UINT32 face = 0; face < 6; face++)
+            {
+                // Source data is copied as the cubemap can be shared with other filters, filtered data isn't needed anymore
+                Vector<float> data;
+                if (mip == 0)
+                    data = level.Faces[face];
+                else
+                    data = std::move(filtered[mip].Faces[face]);
+
+                if (source.IsSRGB)
+                {
+                    for (size_t i = 0; i < data.size(); i += 4)
+                    {
+                        data[i + 0] = LinearToSRGB(std::max(data[i + 0], 0.0f));
+                        data[i + 1] = LinearToSRGB(std::max(data[i + 1], 0.0f));
+                        data[i + 2] = LinearToSRGB(std::max(data[i + 2], 0.0f));
+                    }
+                }
+
+                PixelData floatData(level.Size, level.Size, 1, PF_RGBA32F);
+                floatData.SetExternalBuffer((UINT8*)data.data());
+
+                SPtr<PixelData> mipData = te_shared_ptr_new<PixelData>(level.Size, level.Size, 1, source.Format);
+                mipData->AllocateInternalBuffer();
+                PixelUtil::BulkPixelConversion(floatData, *mipData);
+
+                output[face].push_back(mipData);
+            }
+        }
+
+        return output;
+    }
+
+    IrradianceSH IBLUtility::FilterIrradiance(const IBLCubemap& source)
+    {
+        IrradianceSH output;
+        for (UINT32 i = 0; i < 9; i++)
+            output.Coefficients[i] = Vector4::ZERO;
+
+        if (source.Levels.empty())
+        {
+            TE_DEBUG("Irradiance filtering failed. Source cubemap is empty.");
+            return output;
+        }
+
+        // Irradiance is very low frequency, a small level of the source is enough
+        const IBLCubemap::Level* level = &source.Levels.back();
+        for (const IBLCubemap::Level& entry : source.Levels)
+        {
+            if (entry.Size <= IRRADIANCE_FACE_SIZE)
+            {
+                level = &entry;
+                break;
+            }
+        }
+
+        float faceCoefficients[6][9][3] = {};
+        float faceWeights[6] = {};
+
+        RunFilterJobs(6, [&](UINT32 face)
+        {
+            const float* data = level->Faces[face].data();
+            const float invSize = 1.0f / level->Size;
+
+            for (UINT32 y = 0; y < level->Size; y++)
+            {
+                for (UINT32 x = 0; x < level->Size; x++)
+                {
+                    const float u = (x + 0.5f) * invSize * 2.0f - 1.0f;
+                    const float v = (y + 0.5f) * invSize * 2.0f - 1.0f;
+
+                    // Solid angle covered by the texel
+                    const float distance2 = 1.0f + u * u + v * v;
+                    const float weight = 4.0f * invSize * invSize / (distance2 * std::sqrt(distance2));
+
+                    float basis[9];
+                    EvaluateSHBasis(Vector3::Normalize(FaceToDirection(face, u, v)), basis);
+
+                    const float* color = data + ((size_t)y * level->Size + x) * 4;
+                    for (UINT32 i = 0; i < 9; i++)
+                    {
+                        for (UINT32 c = 0; c < 3; c++)
+                            faceCoefficients[face][i][c] += color[c] * basis[i] * weight;
+                    }
+
+                    faceWeights[face] += weight;
+                }
+            }
+        });
+
+        float totalWeight = 0.0f;
+        for (UINT32 face = 0; face < 6; face++)
+            totalWeight += faceWeights[face];
+
+        // Normalize the solid angles so they add up to the whole sphere, then convolve with the clamped cosine lobe
+        // (PI, 2 * PI / 3 and PI / 4 per band) and divide by PI for lambertian reflection
+        static constexpr float BAND_FACTORS[9] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+        const float normalization = 4.0f * Math::PI / totalWeight;
+
+        for (UINT32 i = 0; i < 9; i++)
+        {
+            Vector4& coefficient = output.Coefficients[i];
+            for (UINT32 face = 0; face < 6; face++)
+            {
+                coefficient.x += faceCoefficients[face][i][0];
+                coefficient.y += faceCoefficients[face][i][1];
+                coefficient.z += faceCoefficients[face][i][2];
+            }
+
+            coefficient *= normalization * BAND_FACTORS[i];
+            coefficient.w = 0.0f;
+        }
+
+        return output;
+    }
+
+    float IBLUtility::MipToRoughness(UINT32 mip, UINT32 numMips)
+    {
+        if (numMips == 0)
+            return 0.0f;
+
+        return std::min(1.0f, (float)mip / (float)numMips);
+    }
+}
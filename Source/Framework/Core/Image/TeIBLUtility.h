@@ -0,0 +1,84 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Image/TePixelData.h"
+#include "Math/TeVector4.h"
+
+namespace te
+{
+    /**
+     * Third order spherical harmonics (9 coefficients per channel) describing the diffuse irradiance of an environment.
+     * Coefficients are already convolved with the clamped cosine lobe and divided by PI, evaluating them for a normal
+     * directly gives the light reflected by a white lambertian surface.
+     */
+    struct TE_CORE_EXPORT IrradianceSH
+    {
+        /** RGB coefficients in xyz, w is unused. Layout matches the float4 array used by shaders. */
+        Vector4 Coefficients[9];
+    };
+
+    /**
+     * Source cubemap of the IBL filters, converted to linear RGBA floats, with a box filtered mip chain down to 1x1.
+     * Create it once with IBLUtility::CreateCubemap() and pass it to every filter, converting a large cubemap is
+     * expensive both in time and memory.
+     */
+    struct TE_CORE_EXPORT IBLCubemap
+    {
+        /** Single mip level, faces are in the order of the CubemapFace enum and stored as tightly packed RGBA floats. */
+        struct Level
+        {
+            UINT32 Size = 0;
+            Vector<float> Faces[6];
+        };
+
+        /** Mip levels, top level first. */
+        Vector<Level> Levels;
+
+        /** Format of the faces the cubemap was created from. Filtered data is output in this format. */
+        PixelFormat Format = PF_UNKNOWN;
+
+        /** Determines is the source data gamma corrected. Filtered data is gamma corrected again on output. */
+        bool IsSRGB = false;
+    };
+
+    /** Offline filtering of cubemaps used for image based lighting. */
+    class TE_CORE_EXPORT IBLUtility
+    {
+    public:
+        /** Default number of importance samples taken per texel when prefiltering radiance. */
+        static constexpr UINT32 DEFAULT_RADIANCE_SAMPLES = 64;
+
+        /**
+         * Converts the faces of a cubemap to the source used by the filtering methods.
+         *
+         * @param[in]	faces		Six faces of the source cubemap, in the order of the CubemapFace enum. Faces must be
+         *							square, of the same size and in a format accessible by PixelUtil.
+         * @param[in]	isSRGB		Determines is the source data gamma corrected. Filtering is done in linear space.
+         * @return					Converted cubemap, or null if the faces are not a valid cubemap.
+         */
+        static SPtr<IBLCubemap> CreateCubemap(const Vector<SPtr<PixelData>>& faces, bool isSRGB = false);
+
+        /**
+         * Prefilters a cubemap for specular image based lighting. Every mip level is convolved with the GGX distribution,
+         * with roughness increasing linearly from 0 at the top level to 1 at the last level (see MipToRoughness()). Samples
+         * are importance sampled, reading lower resolution levels of the source for wider lobes.
+         *
+         * @param[in]	source		Cubemap created by CreateCubemap().
+         * @param[in]	numMips		Number of mip levels to generate, not counting the top level.
+         * @param[in]	numSamples	Number of importance samples taken per texel.
+         * @return					Mip chain for each face, top level first, in the format of the source faces.
+         */
+        static Vector<Vector<SPtr<PixelData>>> FilterRadiance(const IBLCubemap& source, UINT32 numMips,
+            UINT32 numSamples = DEFAULT_RADIANCE_SAMPLES);
+
+        /**
+         * Projects the diffuse irradiance of a cubemap onto third order spherical harmonics.
+         *
+         * @param[in]	source		Cubemap created by CreateCubemap().
+         */
+        static IrradianceSH FilterIrradiance(const IBLCubemap& source);
+
+        /** Returns the GGX roughness a mip level generated by FilterRadiance() was filtered with. */
+        static float MipToRoughness(UINT32 mip, UINT32 numMips);
+    };
+}
@@ -3,8 +3,17 @@
 #include "Math/TeMath.h"
 #include "Image/TeTexture.h"
 #include "Utility/TeBitwise.h"
+#include "Threading/TeTaskScheduler.h"
 #include <nvtt.h>
 
+#if TE_SIMD_SSE2
+#   include <emmintrin.h>
+#endif
+
+#if TE_SIMD_F16C
+#   include <immintrin.h>
+#endif
+
 namespace te
 {
     /**
@@ -1217,43 +1226,6 @@ namespace te
         UINT8* bufferEnd;
     };
 
-    /**	Handles output from NVTT library for a mip-map chain. */
-    struct NVTTMipmapOutputHandler : public nvtt::OutputHandler
-    {
-        NVTTMipmapOutputHandler(const Vector<SPtr<PixelData>>& buffers)
-            :buffers(buffers), bufferWritePos(nullptr), bufferEnd(nullptr)
-        { }
-
-        void beginImage(int size, int width, int height, int depth, int face, int miplevel) override
-        {
-            assert(miplevel >= 0 && miplevel < (int)buffers.size());
-            assert((UINT32)size == buffers[miplevel]->GetConsecutiveSize());
-
-            activeBuffer = buffers[miplevel];
-
-            bufferWritePos = activeBuffer->GetData();
-            bufferEnd = bufferWritePos + activeBuffer->GetConsecutiveSize();
-        }
-
-        bool writeData(const void* data, int size) override
-        {
-            assert((bufferWritePos + size) <= bufferEnd);
-            memcpy(bufferWritePos, data, size);
-            bufferWritePos += size;
-
-            return true;
-        }
-
-        void endImage() override
-        { }
-
-        Vector<SPtr<PixelData>> buffers;
-        SPtr<PixelData> activeBuffer;
-
-        UINT8* bufferWritePos;
-        UINT8* bufferEnd;
-    };
-
     nvtt::Format toNVTTFormat(PixelFormat format)
     {
         switch (format)
@@ -1313,20 +1285,664 @@ namespace te
         return nvtt::AlphaMode_None;
     }
 
-    nvtt::WrapMode toNVTTWrapMode(MipMapWrapMode wrapMode)
+    namespace
     {
-        switch (wrapMode)
+        /** Layout of a 4 byte, 8 bits per channel pixel format, as understood by the fast conversion paths. */
+        struct PixelLayout8
+        {
+            bool SwapRB; /*< Red is stored in the third byte and blue in the first. */
+            bool HasAlpha; /*< Fourth byte contains alpha. If false the fourth byte is unused. */
+        };
+
+        /** Kinds of pixel formats that have dedicated row conversion paths. */
+        enum class FastPixelKind
         {
-        case MipMapWrapMode::Clamp:
-            return nvtt::WrapMode_Clamp;
-        case MipMapWrapMode::Mirror:
-            return nvtt::WrapMode_Mirror;
-        case MipMapWrapMode::Repeat:
-            return nvtt::WrapMode_Repeat;
+            None,
+            Byte4,
+            Half4,
+            Float4
+        };
+
+        FastPixelKind GetFastPixelKind(PixelFormat format, PixelLayout8& layout)
+        {
+            switch (format)
+            {
+            case PF_RGBA8:
+                layout = { false, true };
+                return FastPixelKind::Byte4;
+            case PF_BGRA8:
+                layout = { true, true };
+                return FastPixelKind::Byte4;
+            case PF_RGB8:
+                layout = { false, false };
+                return FastPixelKind::Byte4;
+            case PF_BGR8:
+                layout = { true, false };
+                return FastPixelKind::Byte4;
+            case PF_RGBA16F:
+                layout = { false, true };
+                return FastPixelKind::Half4;
+            case PF_RGBA32F:
+                layout = { false, true };
+                return FastPixelKind::Float4;
+            default:
+                return FastPixelKind::None;
+            }
         }
 
-        // Unknown alpha mode
-        return nvtt::WrapMode_Mirror;
+        /** Re-orders and masks 8-bit pixels when converting from one 8-bit layout to another. */
+        struct PixelSwizzle8
+        {
+            PixelSwizzle8(const PixelLayout8& src, const PixelLayout8& dst)
+                : Swap(src.SwapRB != dst.SwapRB)
+                , AndMask(dst.HasAlpha ? 0xFFFFFFFF : 0x00FFFFFF)
+                , OrMask((!src.HasAlpha && dst.HasAlpha) ? 0xFF000000 : 0)
+            { }
+
+            UINT32 Apply(UINT32 pixel) const
+            {
+                if (Swap)
+                    pixel = (pixel & 0xFF00FF00) | ((pixel & 0x000000FF) << 16) | ((pixel & 0x00FF0000) >> 16);
+
+                return (pixel & AndMask) | OrMask;
+            }
+
+    #if TE_SIMD_SSE2
+            __m128i Apply(__m128i pixels) const
+            {
+                if (Swap)
+                {
+                    const __m128i rb = _mm_and_si128(pixels, _mm_set1_epi32(0x00FF00FF));
+                    pixels = _mm_or_si128(_mm_and_si128(pixels, _mm_set1_epi32((int)0xFF00FF00)),
+                        _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16)));
+                }
+
+                return _mm_or_si128(_mm_and_si128(pixels, _mm_set1_epi32((int)AndMask)), _mm_set1_epi32((int)OrMask));
+            }
+    #endif
+
+            bool Swap;
+            UINT32 AndMask;
+            UINT32 OrMask;
+        };
+
+        /** Converts a row of pixels between two 4 byte, 8 bits per channel formats. */
+        void ConvertRowByteToByte(const UINT8* src, UINT8* dst, UINT32 count, const PixelSwizzle8& swizzle)
+        {
+            UINT32 i = 0;
+    #if TE_SIMD_SSE2
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i pixels = _mm_loadu_si128((const __m128i*)(src + i * 4));
+                _mm_storeu_si128((__m128i*)(dst + i * 4), swizzle.Apply(pixels));
+            }
+    #endif
+
+            for (; i < count; i++)
+            {
+                UINT32 pixel;
+                memcpy(&pixel, src + i * 4, sizeof(pixel));
+                pixel = swizzle.Apply(pixel);
+                memcpy(dst + i * 4, &pixel, sizeof(pixel));
+            }
+        }
+
+        /** Converts a row of 4 byte, 8 bits per channel pixels to RGBA floats. */
+        void ConvertRowByteToFloat(const UINT8* src, float* dst, UINT32 count, const PixelLayout8& layout)
+        {
+            const PixelSwizzle8 swizzle(layout, { false, true });
+
+            UINT32 i = 0;
+    #if TE_SIMD_SSE2
+            const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i pixels = swizzle.Apply(_mm_loadu_si128((const __m128i*)(src + i * 4)));
+                const __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+                const __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+                float* out = dst + i * 4;
+                _mm_storeu_ps(out + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+                _mm_storeu_ps(out + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+                _mm_storeu_ps(out + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+                _mm_storeu_ps(out + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+            }
+    #endif
+
+            for (; i < count; i++)
+            {
+                UINT32 pixel;
+                memcpy(&pixel, src + i * 4, sizeof(pixel));
+                pixel = swizzle.Apply(pixel);
+
+                for (UINT32 c = 0; c < 4; c++)
+                    dst[i * 4 + c] = (float)((pixel >> (c * 8)) & 0xFF) * (1.0f / 255.0f);
+            }
+        }
+
+        /** Converts a row of RGBA floats to 4 byte, 8 bits per channel pixels. Values are clamped to [0, 1] range. */
+        void ConvertRowFloatToByte(const float* src, UINT8* dst, UINT32 count, const PixelLayout8& layout)
+        {
+            const PixelSwizzle8 swizzle({ false, true }, layout);
+
+            UINT32 i = 0;
+    #if TE_SIMD_SSE2
+            const __m128 scale = _mm_set1_ps(255.0f);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i values[4];
+                for (UINT32 j = 0; j < 4; j++)
+                {
+                    // Operand order makes NaNs resolve to zero
+                    __m128 value = _mm_max_ps(_mm_loadu_ps(src + (i + j) * 4), zero);
+                    value = _mm_min_ps(value, one);
+                    values[j] = _mm_cvtps_epi32(_mm_mul_ps(value, scale));
+                }
+
+                const __m128i lo = _mm_packs_epi32(values[0], values[1]);
+                const __m128i hi = _mm_packs_epi32(values[2], values[3]);
+                _mm_storeu_si128((__m128i*)(dst + i * 4), swizzle.Apply(_mm_packus_epi16(lo, hi)));
+            }
+    #endif
+
+            for (; i < count; i++)
+            {
+                UINT32 pixel = 0;
+                for (UINT32 c = 0; c < 4; c++)
+                {
+                    const float value = src[i * 4 + c];
+                    const float clamped = value > 0.0f ? std::min(value, 1.0f) : 0.0f;
+                    pixel |= (UINT32)(clamped * 255.0f + 0.5f) << (c * 8);
+                }
+
+                pixel = swizzle.Apply(pixel);
+                memcpy(dst + i * 4, &pixel, sizeof(pixel));
+            }
+        }
+
+        /** Converts an array of half floats to floats. */
+        void ConvertHalfToFloat(const UINT16* src, float* dst, UINT32 count)
+        {
+            UINT32 i = 0;
+    #if TE_SIMD_F16C
+            for (; i + 4 <= count; i += 4)
+                _mm_storeu_ps(dst + i, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(src + i))));
+    #endif
+
+            for (; i < count; i++)
+                dst[i] = Bitwise::HalfToFloat(src[i]);
+        }
+
+        /** Converts an array of floats to half floats. */
+        void ConvertFloatToHalf(const float* src, UINT16* dst, UINT32 count)
+        {
+            UINT32 i = 0;
+    #if TE_SIMD_F16C
+            for (; i + 4 <= count; i += 4)
+                _mm_storel_epi64((__m128i*)(dst + i), _mm_cvtps_ph(_mm_loadu_ps(src + i), 0));
+    #endif
+
+            for (; i < count; i++)
+                dst[i] = Bitwise::FloatToHalf(src[i]);
+        }
+
+        /**
+         * Converts a row of pixels between two formats with a dedicated conversion path. Conversions between 8-bit and
+         * half formats go through a small intermediate float buffer.
+         */
+        void ConvertRowFast(const UINT8* src, FastPixelKind srcKind, const PixelLayout8& srcLayout,
+            UINT8* dst, FastPixelKind dstKind, const PixelLayout8& dstLayout, UINT32 count)
+        {
+            if (srcKind == FastPixelKind::Byte4 && dstKind == FastPixelKind::Byte4)
+                ConvertRowByteToByte(src, dst, count, PixelSwizzle8(srcLayout, dstLayout));
+            else if (srcKind == FastPixelKind::Byte4 && dstKind == FastPixelKind::Float4)
+                ConvertRowByteToFloat(src, (float*)dst, count, srcLayout);
+            else if (srcKind == FastPixelKind::Float4 && dstKind == FastPixelKind::Byte4)
+                ConvertRowFloatToByte((const float*)src, dst, count, dstLayout);
+            else if (srcKind == FastPixelKind::Half4 && dstKind == FastPixelKind::Float4)
+                ConvertHalfToFloat((const UINT16*)src, (float*)dst, count * 4);
+            else if (srcKind == FastPixelKind::Float4 && dstKind == FastPixelKind::Half4)
+                ConvertFloatToHalf((const float*)src, (UINT16*)dst, count * 4);
+            else
+            {
+                static constexpr UINT32 CHUNK_SIZE = 64;
+                float temp[CHUNK_SIZE * 4];
+
+                for (UINT32 i = 0; i < count; i += CHUNK_SIZE)
+                {
+                    const UINT32 chunkSize = std::min(CHUNK_SIZE, count - i);
+                    if (srcKind == FastPixelKind::Byte4)
+                    {
+                        ConvertRowByteToFloat(src + i * 4, temp, chunkSize, srcLayout);
+                        ConvertFloatToHalf(temp, (UINT16*)dst + i * 4, chunkSize * 4);
+                    }
+                    else
+                    {
+                        ConvertHalfToFloat((const UINT16*)src + i * 4, temp, chunkSize * 4);
+                        ConvertRowFloatToByte(temp, dst + i * 4, chunkSize, dstLayout);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Attempts to convert pixels between two formats using the dedicated row conversion paths. Returns false if
+         * no such path exists for the provided formats.
+         */
+        bool BulkPixelConversionFast(const PixelData& src, PixelData& dst)
+        {
+            PixelLayout8 srcLayout, dstLayout;
+            const FastPixelKind srcKind = GetFastPixelKind(src.GetFormat(), srcLayout);
+            const FastPixelKind dstKind = GetFastPixelKind(dst.GetFormat(), dstLayout);
+
+            if (srcKind == FastPixelKind::None || dstKind == FastPixelKind::None ||
+                (srcKind == dstKind && srcKind != FastPixelKind::Byte4))
+            {
+                return false;
+            }
+
+            const UINT32 srcPixelSize = PixelUtil::GetNumElemBytes(src.GetFormat());
+            const UINT32 dstPixelSize = PixelUtil::GetNumElemBytes(dst.GetFormat());
+            const UINT8* srcSlice = static_cast<UINT8*>(src.GetData())
+                + src.GetLeft() * srcPixelSize + src.GetTop() * src.GetRowPitch() + src.GetFront() * src.GetSlicePitch();
+            UINT8* dstSlice = static_cast<UINT8*>(dst.GetData())
+                + dst.GetLeft() * dstPixelSize + dst.GetTop() * dst.GetRowPitch() + dst.GetFront() * dst.GetSlicePitch();
+
+            for (UINT32 z = 0; z < src.GetDepth(); z++)
+            {
+                const UINT8* srcRow = srcSlice;
+                UINT8* dstRow = dstSlice;
+                for (UINT32 y = 0; y < src.GetHeight(); y++)
+                {
+                    ConvertRowFast(srcRow, srcKind, srcLayout, dstRow, dstKind, dstLayout, src.GetWidth());
+
+                    srcRow += src.GetRowPitch();
+                    dstRow += dst.GetRowPitch();
+                }
+
+                srcSlice += src.GetSlicePitch();
+                dstSlice += dst.GetSlicePitch();
+            }
+
+            return true;
+        }
+
+        /** Converts a single sRGB encoded value in [0, 1] range to linear space. */
+        float SRGBToLinear(float value)
+        {
+            return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        /** Converts a single linear value in [0, 1] range to sRGB encoding. */
+        float LinearToSRGB(float value)
+        {
+            return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        }
+
+        /** Returns a table mapping 8-bit sRGB encoded values to linear values. */
+        const float* GetSRGBToLinearTable()
+        {
+            static float table[256];
+            static const bool initialized = []()
+            {
+                for (UINT32 i = 0; i < 256; i++)
+                    table[i] = SRGBToLinear(i / 255.0f);
+
+                return true;
+            }();
+
+            (void)initialized;
+            return table;
+        }
+
+        /** Number of entries in the table returned by GetLinearToSRGBTable(). */
+        static constexpr UINT32 LINEAR_TO_SRGB_TABLE_SIZE = 4096;
+
+        /**
+         * Returns a table mapping linear values, quantized to LINEAR_TO_SRGB_TABLE_SIZE steps, to 8-bit sRGB encoded values.
+         * The resolution is high enough to keep the error under one 8-bit step along the whole curve.
+         */
+        const UINT8* GetLinearToSRGBTable()
+        {
+            static UINT8 table[LINEAR_TO_SRGB_TABLE_SIZE];
+            static const bool initialized = []()
+            {
+                for (UINT32 i = 0; i < LINEAR_TO_SRGB_TABLE_SIZE; i++)
+                {
+                    const float encoded = LinearToSRGB(i / (float)(LINEAR_TO_SRGB_TABLE_SIZE - 1));
+                    table[i] = (UINT8)(Math::Clamp01(encoded) * 255.0f + 0.5f);
+                }
+
+                return true;
+            }();
+
+            (void)initialized;
+            return table;
+        }
+
+        /** Decodes tightly packed sRGB RGBA8 pixels into linear RGBA floats. Alpha is not gamma encoded. */
+        void DecodeSRGB(const UINT8* src, float* dst, UINT32 count)
+        {
+            const float* table = GetSRGBToLinearTable();
+            for (UINT32 i = 0; i < count; i++)
+            {
+                dst[i * 4 + 0] = table[src[i * 4 + 0]];
+                dst[i * 4 + 1] = table[src[i * 4 + 1]];
+                dst[i * 4 + 2] = table[src[i * 4 + 2]];
+                dst[i * 4 + 3] = src[i * 4 + 3] * (1.0f / 255.0f);
+            }
+        }
+
+        /** Encodes linear RGBA floats into tightly packed sRGB RGBA8 pixels. Alpha is not gamma encoded. */
+        void EncodeSRGB(const float* src, UINT8* dst, UINT32 count)
+        {
+            const UINT8* table = GetLinearToSRGBTable();
+            const float tableScale = (float)(LINEAR_TO_SRGB_TABLE_SIZE - 1);
+            for (UINT32 i = 0; i < count; i++)
+            {
+                for (UINT32 c = 0; c < 3; c++)
+                    dst[i * 4 + c] = table[(UINT32)(Math::Clamp01(src[i * 4 + c]) * tableScale + 0.5f)];
+
+                dst[i * 4 + 3] = (UINT8)(Math::Clamp01(src[i * 4 + 3]) * 255.0f + 0.5f);
+            }
+        }
+
+        /**
+         * Converts tightly packed RGBA floats between sRGB encoding and linear space, in place. Slower than the lookup
+         * tables, used for sources with more than 8 bits per channel. Alpha is not gamma encoded.
+         */
+        void ConvertSRGB(float* data, UINT32 count, bool toLinear)
+        {
+            for (UINT32 i = 0; i < count; i++)
+            {
+                for (UINT32 c = 0; c < 3; c++)
+                {
+                    float& value = data[i * 4 + c];
+                    value = toLinear ? SRGBToLinear(Math::Clamp01(value)) : LinearToSRGB(Math::Clamp01(value));
+                }
+            }
+        }
+
+        /** Evaluates the zeroth order modified Bessel function of the first kind. */
+        float Bessel0(float x)
+        {
+            const float quarterX2 = x * x * 0.25f;
+
+            float sum = 1.0f;
+            float term = 1.0f;
+            for (UINT32 k = 1; k < 32 && term > sum * 1e-7f; k++)
+            {
+                term *= quarterX2 / (float)(k * k);
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        /** Evaluates the normalized sinc function. */
+        float Sinc(float x)
+        {
+            if (std::abs(x) < 1e-5f)
+                return 1.0f;
+
+            return std::sin(Math::PI * x) / (Math::PI * x);
+        }
+
+        /** Returns the radius of a mip map filter, in destination pixels. */
+        float GetFilterRadius(MipMapFilter filter)
+        {
+            switch (filter)
+            {
+            case MipMapFilter::Box:
+                return 0.5f;
+            case MipMapFilter::Triangle:
+                return 1.0f;
+            case MipMapFilter::Kaiser:
+            case MipMapFilter::Lanczos:
+                return 3.0f;
+            }
+
+            return 0.5f;
+        }
+
+        /** Evaluates a mip map filter at the provided distance from its center, in destination pixels. */
+        float EvaluateFilter(MipMapFilter filter, float x)
+        {
+            x = std::abs(x);
+
+            switch (filter)
+            {
+            case MipMapFilter::Box:
+                return x <= 0.5f ? 1.0f : 0.0f;
+            case MipMapFilter::Triangle:
+                return std::max(0.0f, 1.0f - x);
+            case MipMapFilter::Kaiser:
+            {
+                // Same parameters NVTT uses for its mip map Kaiser filter (width 3, alpha 4, stretch 1)
+                static constexpr float WIDTH = 3.0f;
+                static constexpr float ALPHA = 4.0f;
+                if (x >= WIDTH)
+                    return 0.0f;
+
+                const float t = x / WIDTH;
+                return Sinc(x) * Bessel0(ALPHA * std::sqrt(1.0f - t * t)) / Bessel0(ALPHA);
+            }
+            case MipMapFilter::Lanczos:
+                return x < 3.0f ? Sinc(x) * Sinc(x / 3.0f) : 0.0f;
+            }
+
+            return 0.0f;
+        }
+
+        /** Maps a source sample index outside of the image onto a valid index, according to the wrap mode. */
+        UINT32 WrapSampleIndex(INT32 index, INT32 size, MipMapWrapMode wrapMode)
+        {
+            switch (wrapMode)
+            {
+            case MipMapWrapMode::Clamp:
+                return (UINT32)Math::Clamp(index, 0, size - 1);
+            case MipMapWrapMode::Repeat:
+                return (UINT32)(((index % size) + size) % size);
+            case MipMapWrapMode::Mirror:
+            {
+                const INT32 period = size * 2;
+                INT32 wrapped = ((index % period) + period) % period;
+                if (wrapped >= size)
+                    wrapped = period - 1 - wrapped;
+
+                return (UINT32)wrapped;
+            }
+            }
+
+            return (UINT32)Math::Clamp(index, 0, size - 1);
+        }
+
+        /**
+         * Source samples and weights contributing to each destination sample, along a single axis. Every destination
+         * sample uses the same number of taps, unused taps have zero weight.
+         */
+        struct FilterKernel
+        {
+            UINT32 NumTaps = 0;
+            Vector<UINT32> Indices;
+            Vector<float> Weights;
+        };
+
+        /**
+         * Builds the filter kernel for resampling a single axis from @p srcSize to @p dstSize samples. When upsampling the
+         * filter keeps its unit radius, so a triangle filter interpolates linearly between neighbours.
+         */
+        FilterKernel BuildFilterKernel(UINT32 srcSize, UINT32 dstSize, const MipMapGenOptions& options)
+        {
+            const float scale = (float)srcSize / (float)dstSize;
+            const float support = GetFilterRadius(options.filter) * std::max(scale, 1.0f);
+
+            FilterKernel kernel;
+            kernel.NumTaps = (UINT32)std::ceil(support * 2.0f) + 1;
+            kernel.Indices.resize((size_t)dstSize * kernel.NumTaps);
+            kernel.Weights.resize((size_t)dstSize * kernel.NumTaps);
+
+            for (UINT32 i = 0; i < dstSize; i++)
+            {
+                UINT32* indices = &kernel.Indices[(size_t)i * kernel.NumTaps];
+                float* weights = &kernel.Weights[(size_t)i * kernel.NumTaps];
+
+                const float center = (i + 0.5f) * scale;
+                const INT32 first = (INT32)std::floor(center - support);
+
+                float totalWeight = 0.0f;
+                for (UINT32 j = 0; j < kernel.NumTaps; j++)
+                {
+                    const INT32 sample = first + (INT32)j;
+
+                    indices[j] = WrapSampleIndex(sample, (INT32)srcSize, options.wrapMode);
+                    weights[j] = EvaluateFilter(options.filter, (sample + 0.5f - center) / std::max(scale, 1.0f));
+                    totalWeight += weights[j];
+                }
+
+                if (totalWeight == 0.0f)
+                {
+                    // Filter is narrower than the sample spacing, fall back to the nearest sample
+                    indices[0] = WrapSampleIndex((INT32)center, (INT32)srcSize, options.wrapMode);
+                    weights[0] = 1.0f;
+                    for (UINT32 j = 1; j < kernel.NumTaps; j++)
+                        weights[j] = 0.0f;
+                }
+                else
+                {
+                    for (UINT32 j = 0; j < kernel.NumTaps; j++)
+                        weights[j] /= totalWeight;
+                }
+            }
+
+            return kernel;
+        }
+
+        /** Number of rows processed by a single job when resampling images. */
+        static constexpr UINT32 RESAMPLE_ROWS_PER_JOB = 16;
+
+        /**
+         * Runs @p job for every index in [0, @p numJobs), on the task scheduler if it is running and on the calling thread
+         * otherwise.
+         */
+        template<class Job>
+        void RunJobs(UINT32 numJobs, Job job)
+        {
+            if (TaskScheduler::IsStarted())
+                gTaskScheduler().ParallelFor(numJobs, job);
+            else
+            {
+                for (UINT32 i = 0; i < numJobs; i++)
+                    job(i);
+            }
+        }
+
+        /**
+         * Resamples an image made of tightly packed RGBA floats using a separable filter. Supports arbitrary source and
+         * destination sizes, smaller or larger. Rows are filtered in parallel.
+         */
+        void ResampleRGBA32F(const float* src, UINT32 srcWidth, UINT32 srcHeight, float* dst, UINT32 dstWidth,
+            UINT32 dstHeight, const MipMapGenOptions& options)
+        {
+            const FilterKernel kernelX = BuildFilterKernel(srcWidth, dstWidth, options);
+            const FilterKernel kernelY = BuildFilterKernel(srcHeight, dstHeight, options);
+
+            // Horizontal pass, from source rows into the intermediate buffer
+            Vector<float> temp((size_t)dstWidth * srcHeight * 4);
+            RunJobs(Math::DivideAndRoundUp(srcHeight, RESAMPLE_ROWS_PER_JOB), [&](UINT32 job)
+            {
+                const UINT32 end = std::min(srcHeight, (job + 1) * RESAMPLE_ROWS_PER_JOB);
+                for (UINT32 y = job * RESAMPLE_ROWS_PER_JOB; y < end; y++)
+                {
+                    const float* srcRow = src + (size_t)y * srcWidth * 4;
+                    float* dstRow = &temp[(size_t)y * dstWidth * 4];
+
+                    for (UINT32 x = 0; x < dstWidth; x++)
+                    {
+                        const UINT32* indices = &kernelX.Indices[(size_t)x * kernelX.NumTaps];
+                        const float* weights = &kernelX.Weights[(size_t)x * kernelX.NumTaps];
+
+    #if TE_SIMD_SSE2
+                        __m128 sum = _mm_setzero_ps();
+                        for (UINT32 t = 0; t < kernelX.NumTaps; t++)
+                            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(srcRow + indices[t] * 4), _mm_set1_ps(weights[t])));
+
+                        _mm_storeu_ps(dstRow + x * 4, sum);
+    #else
+                        float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                        for (UINT32 t = 0; t < kernelX.NumTaps; t++)
+                        {
+                            for (UINT32 c = 0; c < 4; c++)
+                                sum[c] += srcRow[indices[t] * 4 + c] * weights[t];
+                        }
+
+                        memcpy(dstRow + x * 4, sum, sizeof(sum));
+    #endif
+                    }
+                }
+            });
+
+            // Vertical pass, accumulating whole intermediate rows into the destination
+            RunJobs(Math::DivideAndRoundUp(dstHeight, RESAMPLE_ROWS_PER_JOB), [&](UINT32 job)
+            {
+                const UINT32 rowSize = dstWidth * 4;
+                const UINT32 end = std::min(dstHeight, (job + 1) * RESAMPLE_ROWS_PER_JOB);
+                for (UINT32 y = job * RESAMPLE_ROWS_PER_JOB; y < end; y++)
+                {
+                    const UINT32* indices = &kernelY.Indices[(size_t)y * kernelY.NumTaps];
+                    const float* weights = &kernelY.Weights[(size_t)y * kernelY.NumTaps];
+
+                    float* dstRow = dst + (size_t)y * rowSize;
+                    memset(dstRow, 0, rowSize * sizeof(float));
+
+                    for (UINT32 t = 0; t < kernelY.NumTaps; t++)
+                    {
+                        if (weights[t] == 0.0f)
+                            continue;
+
+                        const float* srcRow = &temp[(size_t)indices[t] * rowSize];
+
+                        UINT32 i = 0;
+    #if TE_SIMD_SSE2
+                        const __m128 weight = _mm_set1_ps(weights[t]);
+                        for (; i < rowSize; i += 4)
+                        {
+                            const __m128 value = _mm_mul_ps(_mm_loadu_ps(srcRow + i), weight);
+                            _mm_storeu_ps(dstRow + i, _mm_add_ps(_mm_loadu_ps(dstRow + i), value));
+                        }
+    #endif
+
+                        for (; i < rowSize; i++)
+                            dstRow[i] += srcRow[i] * weights[t];
+                    }
+                }
+            });
+        }
+
+        /** Re-normalizes normals encoded in [0, 1] range in the RGB channels of tightly packed RGBA floats. */
+        void NormalizeNormals(float* data, UINT32 count)
+        {
+            for (UINT32 i = 0; i < count; i++)
+            {
+                float* pixel = data + i * 4;
+
+                const float x = pixel[0] * 2.0f - 1.0f;
+                const float y = pixel[1] * 2.0f - 1.0f;
+                const float z = pixel[2] * 2.0f - 1.0f;
+
+                const float length = std::sqrt(x * x + y * y + z * z);
+                if (length <= 1e-6f)
+                    continue;
+
+                const float invLength = 0.5f / length;
+                pixel[0] = x * invLength + 0.5f;
+                pixel[1] = y * invLength + 0.5f;
+                pixel[2] = z * invLength + 0.5f;
+            }
+        }
     }
 
     UINT32 PixelUtil::GetBlockSize(PixelFormat format)
@@ -2000,6 +2616,10 @@ namespace te
             }
         }
 
+        // Common formats are converted a row at a time, using SIMD where available
+        if (BulkPixelConversionFast(src, dst))
+            return;
+
         UINT32 srcPixelSize = GetNumElemBytes(src.GetFormat());
         UINT32 dstPixelSize = GetNumElemBytes(dst.GetFormat());
         UINT8 *srcptr = static_cast<UINT8*>(src.GetData())
@@ -2233,107 +2853,96 @@ namespace te
             return outputMipBuffers;
         }
 
-        if (!Bitwise::IsPow2(src.GetWidth()) || !Bitwise::IsPow2(src.GetHeight()))
-        {
-            TE_DEBUG("Mipmap generation failed. Texture width & height must be powers of 2.");
-            return outputMipBuffers;
-        }
-
-        PixelFormat interimFormat = IsFloatingPoint(src.GetFormat()) ? PF_RGBA32F : PF_BGRA8;
-
-        PixelData interimData(src.GetWidth(), src.GetHeight(), 1, interimFormat);
-        interimData.AllocateInternalBuffer();
-        BulkPixelConversion(src, interimData);
-
-        if (interimFormat != PF_RGBA32F)
-        {
-            FlipComponentOrder(interimData);
-        }
-
         UINT32 numMips = GetMaxMipmaps(src.GetWidth(), src.GetHeight(), 1, src.GetFormat());
         if (maxMip > 0)
             numMips = std::min(numMips, maxMip);
 
-        nvtt::InputOptions io;
-        io.setTextureLayout(nvtt::TextureType_2D, src.GetWidth(), src.GetHeight());
-        io.setMipmapGeneration(true, numMips);
-        io.setNormalMap(options.isNormalMap);
-        io.setNormalizeMipmaps(options.normalizeMipmaps);
-        io.setWrapMode(toNVTTWrapMode(options.wrapMode));
+        // Filtering happens on linear RGBA floats. 8-bit sRGB data is decoded and encoded through lookup tables, sRGB
+        // data with more bits per channel is converted exactly, while normal maps and floating point data are assumed to
+        // be linear already.
+        const bool gammaCorrect = options.isSRGB && !options.isNormalMap && !IsFloatingPoint(src.GetFormat());
 
-        if (interimFormat == PF_RGBA32F)
-            io.setFormat(nvtt::InputFormat_RGBA_32F);
-        else
-            io.setFormat(nvtt::InputFormat_BGRA_8UB);
+        int bitDepths[4];
+        GetBitDepths(src.GetFormat(), bitDepths);
+        const bool useSRGBTables = gammaCorrect &&
+            std::max(std::max(bitDepths[0], bitDepths[1]), std::max(bitDepths[2], bitDepths[3])) <= 8;
 
-        if (options.isSRGB)
-            io.setGamma(2.2f, 2.2f);
-        else
-            io.setGamma(1.0f, 1.0f);
-
-        io.setMipmapData(interimData.GetData(), src.GetWidth(), src.GetHeight());
-
-        nvtt::CompressionOptions co;
-        co.setFormat(nvtt::Format_RGBA);
+        UINT32 curWidth = src.GetWidth();
+        UINT32 curHeight = src.GetHeight();
 
-        if (interimFormat == PF_RGBA32F)
+        Vector<float> curLevel((size_t)curWidth * curHeight * 4);
+        if (useSRGBTables)
         {
-            co.setPixelType(nvtt::PixelType_Float);
-            co.setPixelFormat(32, 32, 32, 32);
+            PixelData srgbData(curWidth, curHeight, 1, PF_RGBA8);
+            srgbData.AllocateInternalBuffer();
+            BulkPixelConversion(src, srgbData);
+
+            DecodeSRGB(srgbData.GetData(), curLevel.data(), curWidth * curHeight);
+            srgbData.FreeInternalBuffer();
         }
         else
         {
-            co.setPixelType(nvtt::PixelType_UnsignedNorm);
-            co.setPixelFormat(32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF);
+            PixelData floatData(curWidth, curHeight, 1, PF_RGBA32F);
+            floatData.SetExternalBuffer((UINT8*)curLevel.data());
+            BulkPixelConversion(src, floatData);
+
+            if (gammaCorrect)
+                ConvertSRGB(curLevel.data(), curWidth * curHeight, true);
         }
 
-        Vector<SPtr<PixelData>> rgbaMipBuffers;
+        // Top level is the source itself
+        SPtr<PixelData> topLevel = te_shared_ptr_new<PixelData>(curWidth, curHeight, 1, src.GetFormat());
+        topLevel->AllocateInternalBuffer();
+        BulkPixelConversion(src, *topLevel);
+        outputMipBuffers.push_back(topLevel);
 
-        // Note: This can be done more effectively without creating so many temp buffers
-        // and working with the original formats directly, but it would complicate the code
-        // too much at the moment.
-        UINT32 curWidth = src.GetWidth();
-        UINT32 curHeight = src.GetHeight();
+        // Every level is filtered from the previous one. Sizes are rounded down, same as GPU mip chains.
+        Vector<float> nextLevel;
         for (UINT32 i = 0; i < numMips; i++)
         {
-            rgbaMipBuffers.push_back(te_shared_ptr_new<PixelData>(curWidth, curHeight, 1, interimFormat));
-            rgbaMipBuffers.back()->AllocateInternalBuffer();
-
-            if (curWidth > 1)
-                curWidth = curWidth / 2;
-
-            if (curHeight > 1)
-                curHeight = curHeight / 2;
-        }
-
-        rgbaMipBuffers.push_back(te_shared_ptr_new<PixelData>(curWidth, curHeight, 1, interimFormat));
-        rgbaMipBuffers.back()->AllocateInternalBuffer();
+            const UINT32 nextWidth = std::max(1U, curWidth / 2);
+            const UINT32 nextHeight = std::max(1U, curHeight / 2);
 
-        NVTTMipmapOutputHandler outputHandler(rgbaMipBuffers);
+            nextLevel.resize((size_t)nextWidth * nextHeight * 4);
+            ResampleRGBA32F(curLevel.data(), curWidth, curHeight, nextLevel.data(), nextWidth, nextHeight, options);
 
-        nvtt::OutputOptions oo;
-        oo.setOutputHeader(false);
-        oo.setOutputHandler(&outputHandler);
+            if (options.isNormalMap && options.normalizeMipmaps)
+                NormalizeNormals(nextLevel.data(), nextWidth * nextHeight);
 
-        nvtt::Compressor compressor;
-        if (!compressor.process(io, co, oo))
-        {
-            TE_DEBUG("Mipmap generation failed. Internal error.");
-            return outputMipBuffers;
-        }
+            SPtr<PixelData> outputBuffer = te_shared_ptr_new<PixelData>(nextWidth, nextHeight, 1, src.GetFormat());
+            outputBuffer->AllocateInternalBuffer();
 
-        interimData.FreeInternalBuffer();
+            if (useSRGBTables)
+            {
+                PixelData srgbData(nextWidth, nextHeight, 1, PF_RGBA8);
+                srgbData.AllocateInternalBuffer();
+                EncodeSRGB(nextLevel.data(), srgbData.GetData(), nextWidth * nextHeight);
 
-        for (UINT32 i = 0; i < (UINT32)rgbaMipBuffers.size(); i++)
-        {
-            SPtr<PixelData> argbBuffer = rgbaMipBuffers[i];
-            SPtr<PixelData> outputBuffer = te_shared_ptr_new<PixelData>(argbBuffer->GetWidth(), argbBuffer->GetHeight(), 1, src.GetFormat());
-            outputBuffer->AllocateInternalBuffer();
+                BulkPixelConversion(srgbData, *outputBuffer);
+                srgbData.FreeInternalBuffer();
+            }
+            else if (gammaCorrect)
+            {
+                // Keep the next level linear, it is the source of the following one
+                Vector<float> encoded = nextLevel;
+                ConvertSRGB(encoded.data(), nextWidth * nextHeight, false);
 
-            BulkPixelConversion(*argbBuffer, *outputBuffer);
-            argbBuffer->FreeInternalBuffer();
+                PixelData floatData(nextWidth, nextHeight, 1, PF_RGBA32F);
+                floatData.SetExternalBuffer((UINT8*)encoded.data());
+                BulkPixelConversion(floatData, *outputBuffer);
+            }
+            else
+            {
+                PixelData floatData(nextWidth, nextHeight, 1, PF_RGBA32F);
+                floatData.SetExternalBuffer((UINT8*)nextLevel.data());
+                BulkPixelConversion(floatData, *outputBuffer);
+            }
 
             outputMipBuffers.push_back(outputBuffer);
+
+            std::swap(curLevel, nextLevel);
+            curWidth = nextWidth;
+            curHeight = nextHeight;
         }
 
         return outputMipBuffers;
@@ -2476,6 +3085,34 @@ namespace te
             break;
 
         case FILTER_LINEAR:
+            if (src.GetDepth() == 1 && scaled.GetDepth() == 1)
+            {
+                // 2D images go through the same separable, parallel filter as mip map generation. A triangle filter
+                // interpolates bilinearly when enlarging, and averages all covered pixels when shrinking.
+                MipMapGenOptions options;
+                options.filter = MipMapFilter::Triangle;
+                options.wrapMode = MipMapWrapMode::Clamp;
+
+                const UINT32 srcWidth = src.GetWidth();
+                const UINT32 srcHeight = src.GetHeight();
+                const UINT32 dstWidth = scaled.GetWidth();
+                const UINT32 dstHeight = scaled.GetHeight();
+
+                Vector<float> srcFloats((size_t)srcWidth * srcHeight * 4);
+                PixelData srcFloatData(srcWidth, srcHeight, 1, PF_RGBA32F);
+                srcFloatData.SetExternalBuffer((UINT8*)srcFloats.data());
+                BulkPixelConversion(src, srcFloatData);
+
+                Vector<float> dstFloats((size_t)dstWidth * dstHeight * 4);
+                ResampleRGBA32F(srcFloats.data(), srcWidth, srcHeight, dstFloats.data(), dstWidth, dstHeight, options);
+
+                PixelData dstFloatData(dstWidth, dstHeight, 1, PF_RGBA32F);
+                dstFloatData.SetExternalBuffer((UINT8*)dstFloats.data());
+                BulkPixelConversion(dstFloatData, scaled);
+                break;
+            }
+
+            // Volumes use the scalar resamplers
             switch (src.GetFormat())
             {
             case PF_RG8:
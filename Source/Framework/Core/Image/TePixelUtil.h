@@ -39,7 +39,8 @@ namespace te
     {
         Box,
         Triangle,
-        Kaiser
+        Kaiser,
+        Lanczos
     };
 
     /** Determines on which axes to mirror an image. */
@@ -79,7 +80,7 @@ namespace te
         enum Filter
         {
             FILTER_NEAREST, /*< No filtering is performed and nearest existing value is used. */
-            FILTER_LINEAR /*< Box filter is applied, averaging nearby pixels. */
+            FILTER_LINEAR /*< Triangle filter is applied, interpolating nearby pixels or averaging the covered ones. */
         };
 
         /** Returns the size of a single pixel of the provided pixel format, in bytes. */
@@ -259,7 +260,8 @@ namespace te
 
         /**
          * Generates mip-maps from the provided source data using the specified compression options. Returned list includes
-         * the base level.
+         * the base level. Source dimensions don't need to be powers of two, each level is half the size of the previous
+         * one, rounded down.
          *
          * @return	A list of calculated mip-map data. First entry is the largest mip and other follow in order from
          *			largest to smallest.
@@ -269,7 +271,7 @@ namespace te
         /**
          * Scales pixel data in the source buffer and stores the scaled data in the destination buffer. Provided pixel data
          * objects must have previously allocated buffers of adequate size. You may also provided a filtering method to use
-         * when scaling.
+         * when scaling. Linear filtering of 2D images is separable and split into rows filtered in parallel.
          */
         static void Scale(const PixelData& src, PixelData& dst, Filter filter = FILTER_LINEAR);
 
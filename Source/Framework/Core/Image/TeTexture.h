@@ -4,6 +4,7 @@
 #include "Resources/TeResource.h"
 #include "CoreUtility/TeCoreObject.h"
 #include "TePixelData.h"
+#include "Image/TeIBLUtility.h"
 #include "Math/TeVector3I.h"
 #include "RenderAPI/TeCommonTypes.h"
 #include "RenderAPI/TeTextureView.h"
@@ -290,6 +291,18 @@ namespace te
         /** Calculates the size of the texture, in bytes. */
         UINT32 CalculateSize() const;
 
+        /**
+         * Stores the diffuse irradiance of a cubemap whose mip levels contain prefiltered radiance (see
+         * IBLUtility::FilterRadiance). Set when importing cubemaps with TextureImportOptions::PrefilterEnvironment.
+         */
+        void SetIrradiance(const IrradianceSH& irradiance) { _irradiance = irradiance; _hasIrradiance = true; }
+
+        /** Returns the diffuse irradiance set by SetIrradiance(). Only valid if HasIrradiance() returns true. */
+        const IrradianceSH& GetIrradiance() const { return _irradiance; }
+
+        /** Checks does the texture contain prefiltered environment lighting. */
+        bool HasIrradiance() const { return _hasIrradiance; }
+
         /** Creates a new empty texture. */
         static HTexture Create(const TEXTURE_DESC& desc);
 
@@ -370,5 +383,8 @@ namespace te
         TextureProperties _properties;
         mutable SPtr<PixelData> _initData;
         Vector<SPtr<PixelData>> _CPUSubresourceData;
+
+        IrradianceSH _irradiance;
+        bool _hasIrradiance = false;
     };
 }
@@ -87,6 +87,32 @@ namespace te
         /** Determines if we need to set material properties for this mesh during import */
         bool ImportMaterials = true;
 
+        /**
+         * Reorders triangles and vertices of the imported mesh so it uses the GPU vertex cache efficiently and draws
+         * with less overdraw. Vertices not used by any triangle are removed.
+         */
+        bool OptimizeMesh = true;
+
+        /**
+         * Fraction of the triangles kept by each automatically generated level of detail, from the most to the least
+         * detailed. Levels share the vertices of the full detail mesh and are selected at runtime based on their size on
+         * screen. Leave empty to only import the full detail mesh.
+         */
+        Vector<float> LodReductionRatios = { 0.5f, 0.25f, 0.125f };
+
+        /**
+         * Largest error generated levels of detail may introduce, relative to the radius of the mesh bounds. Levels
+         * stop being simplified once reaching it, even if their reduction ratio isn't met.
+         */
+        float LodMaxError = 0.05f;
+
+        /**
+         * Stores vertices of the imported mesh in compact formats, roughly halving the memory and bandwidth they use.
+         * Positions lose precision on large meshes, as they are stored as 16-bit integers relative to the mesh bounds.
+         * See MeshUtility::QuantizeVertices().
+         */
+        bool QuantizeVertices = false;
+
         /**
          * Enables or disables import of root motion curves. When enabled, any animation curves in imported animations
          * affecting the root bone will be available through a set of separate curves in AnimationClip, and they won't be
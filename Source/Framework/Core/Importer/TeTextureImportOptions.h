@@ -3,6 +3,7 @@
 #include "TeCorePrerequisites.h"
 #include "Importer/TeImportOptions.h"
 #include "Image/TePixelData.h"
+#include "Image/TePixelUtil.h"
 
 namespace te
 {
@@ -12,7 +13,7 @@ namespace te
     public:
         TextureImportOptions();
 
-        /** Pixel format to import as. */
+        /** Pixel format to import as. Block compressed formats compress the texture, see Compress. */
 #if TE_ENDIAN == TE_ENDIAN_BIG
         PixelFormat Format = PF_RGBA8;
 #else
@@ -42,6 +43,26 @@ namespace te
 
         CubemapSourceType CubemapType = CubemapSourceType::Faces;
 
+        /**
+         * Prepares a cubemap for image based lighting. Its mip chain is filled with GGX prefiltered radiance, roughness
+         * increasing with the mip level, and its diffuse irradiance is stored with the texture as spherical harmonics.
+         * Only relevant if IsCubemap is true. Always generates the full mip chain.
+         */
+        bool PrefilterEnvironment = false;
+
+        /**
+         * Compresses the texture to a block compressed format chosen from its content: BC5 for normal maps, BC6H for HDR
+         * images, BC4 for single channel images, and BC1 or BC3 (BC7 at Production quality and above) for color images
+         * without or with transparency. Textures whose width or height isn't a multiple of 4 are left uncompressed.
+         */
+        bool Compress = false;
+
+        /** Determines does the texture represent a tangent space normal map. Selects BC5 when compressing. */
+        bool IsNormalMap = false;
+
+        /** Quality of block compression. Better quality takes longer to import. */
+        CompressionQuality Quality = CompressionQuality::Normal;
+
         /** Creates a new import options object that allows you to customize how are textures imported. */
         static SPtr<TextureImportOptions> Create();
     };
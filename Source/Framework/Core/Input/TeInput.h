@@ -178,37 +178,37 @@ namespace te
 
     public:
         /** Triggered whenever a button is first pressed. */
-        Event<void(const ButtonEvent&)> OnButtonDown;
+        LockFreeEvent<void(const ButtonEvent&)> OnButtonDown;
 
         /**	Triggered whenever a button is first released. */
-        Event<void(const ButtonEvent&)> OnButtonUp;
+        LockFreeEvent<void(const ButtonEvent&)> OnButtonUp;
 
         /**	Triggered whenever user inputs a text character. */
-        Event<void(const TextInputEvent&)> OnCharInput;
+        LockFreeEvent<void(const TextInputEvent&)> OnCharInput;
 
         /**	Triggers when some pointing device (mouse cursor, touch) moves. */
-        Event<void(const PointerEvent&)> OnPointerMoved;
+        LockFreeEvent<void(const PointerEvent&)> OnPointerMoved;
 
         /**	Triggers when some pointing device (mouse cursor, touch) has a relative move. */
-        Event<void(const Vector2I&)> OnPointerRelativeMoved;
+        LockFreeEvent<void(const Vector2I&)> OnPointerRelativeMoved;
 
         /**	Triggers when some pointing device (mouse cursor, touch) button is pressed. */
-        Event<void(const PointerEvent&)> OnPointerPressed;
+        LockFreeEvent<void(const PointerEvent&)> OnPointerPressed;
 
         /**	Triggers when some pointing device (mouse cursor, touch) button is released. */
-        Event<void(const PointerEvent&)> OnPointerReleased;
+        LockFreeEvent<void(const PointerEvent&)> OnPointerReleased;
 
         /**	Triggers when some pointing device (mouse cursor, touch) button is double clicked. */
-        Event<void(const PointerEvent&)> OnPointerDoubleClick;
+        LockFreeEvent<void(const PointerEvent&)> OnPointerDoubleClick;
 
         /**	Triggers on special input commands. */
-        Event<void(InputCommandType)> OnInputCommand;
+        LockFreeEvent<void(InputCommandType)> OnInputCommand;
 
         /**	Triggers when any key up */
-        Event<void(UINT32)> OnKeyUp;
+        LockFreeEvent<void(UINT32)> OnKeyUp;
 
         /**	Triggers when any key down */
-        Event<void(UINT32)> OnKeyDown;
+        LockFreeEvent<void(UINT32)> OnKeyDown;
 
     protected:
         /** Performs platform specific raw input system initialization. */
@@ -95,10 +95,10 @@ namespace te
         float GetAxisValue(const VirtualAxis& axis, UINT32 deviceIdx = 0) const;
 
         /**	Triggered when a virtual button is pressed. */
-        Event<void(const VirtualButton&, UINT32 deviceIdx)> OnButtonDown;
+        LockFreeEvent<void(const VirtualButton&, UINT32 deviceIdx)> OnButtonDown;
 
         /**	Triggered when a virtual button is released. */
-        Event<void(const VirtualButton&, UINT32 deviceIdx)> OnButtonUp;
+        LockFreeEvent<void(const VirtualButton&, UINT32 deviceIdx)> OnButtonUp;
 
         /** @name Internal
          *  @{
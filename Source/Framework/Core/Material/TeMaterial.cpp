@@ -2,9 +2,26 @@
 #include "TeShader.h"
 #include "Resources/TeResourceHandle.h"
 #include "Resources/TeResourceManager.h"
+#include "Renderer/TeRenderer.h"
 
 namespace te
 {
+    /** Permutation keys a shader can declare, and the material property each of them is enabled by. */
+    static const std::pair<const char*, bool MaterialProperties::*> PermutationKeyProperties[] =
+    {
+        { "USE_DIFFUSE_MAP", &MaterialProperties::UseDiffuseMap },
+        { "USE_EMISSIVE_MAP", &MaterialProperties::UseEmissiveMap },
+        { "USE_NORMAL_MAP", &MaterialProperties::UseNormalMap },
+        { "USE_SPECULAR_MAP", &MaterialProperties::UseSpecularMap },
+        { "USE_BUMP_MAP", &MaterialProperties::UseBumpMap },
+        { "USE_PARALLAX_MAP", &MaterialProperties::UseParallaxMap },
+        { "USE_TRANSPARENCY_MAP", &MaterialProperties::UseTransparencyMap },
+        { "USE_REFLECTION_MAP", &MaterialProperties::UseReflectionMap },
+        { "USE_OCCLUSION_MAP", &MaterialProperties::UseOcclusionMap },
+        { "USE_ENVIRONMENT_MAP", &MaterialProperties::UseEnvironmentMap },
+        { "USE_DYNAMIC_ENVIRONMENT_MAP", &MaterialProperties::UseDynamicEnvironmentMap }
+    };
+
     Material::Material()
         : Resource(TID_Material)
     { }
@@ -54,7 +71,7 @@ namespace te
 
         if (_shader != nullptr)
         {
-            _techniques = _shader->GetCompatibleTechniques();
+            _techniques = _shader->GetCompatibleTechniques(GetPermutationMask());
 
             if (_techniques.empty())
                 return;
@@ -100,6 +117,48 @@ namespace te
         InitializeTechniques();
     }
 
+    void Material::SetProperties(const MaterialProperties& properties)
+    {
+        const UINT32 oldPermutationMask = GetPermutationMask();
+        _properties = properties;
+
+        if (GetPermutationMask() != oldPermutationMask)
+        {
+            // Variations are shared between materials, compiling is skipped if another material already did it
+            InitializeTechniques();
+            for (auto& technique : _techniques)
+                technique->Compile();
+
+            _markCoreDirty(MaterialDirtyFlags::Shader);
+        }
+
+        _markCoreDirty(MaterialDirtyFlags::Param);
+    }
+
+    UINT32 Material::GetPermutationMask() const
+    {
+        if (_shader == nullptr)
+            return 0;
+
+        UINT32 mask = 0;
+        const Vector<String>& permutationKeys = _shader->GetPermutationKeys();
+        for (UINT32 i = 0; i < (UINT32)permutationKeys.size(); i++)
+        {
+            for (auto& entry : PermutationKeyProperties)
+            {
+                if (permutationKeys[i] == entry.first)
+                {
+                    if (_properties.*entry.second)
+                        mask |= 1U << i;
+
+                    break;
+                }
+            }
+        }
+
+        return mask;
+    }
+
     UINT32 Material::GetNumPasses(UINT32 techniqueIdx) const
     {
         if (_shader == nullptr)
@@ -251,5 +310,8 @@ namespace te
     }
 
     void Material::FrameSync()
-    { }
+    {
+        if ((GetCoreDirtyFlags() & (UINT32)MaterialDirtyFlags::Shader) != 0)
+            gRenderer()->NotifyMaterialShaderChanged(this);
+    }
 }
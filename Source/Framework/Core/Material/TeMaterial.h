@@ -178,11 +178,20 @@ namespace te
         /** ParamBlockBuffer are sometimes not currently set when creating gpuparams. So we give the ability to set manually gpu params */
         void SetGpuParam(SPtr<GpuParams> outparams);
 
-        void SetProperties(const MaterialProperties& properties) 
-        { 
-            _properties = properties;  
-            _markCoreDirty(MaterialDirtyFlags::Param);
-        }
+        /**
+         * Sets the properties of the material. If the shader declares permutation keys and the properties enable a
+         * different set of them, the material switches to the matching shader variation. The variation is compiled
+         * right away, and renderables using the material rebuild their elements during the next sync.
+         */
+        void SetProperties(const MaterialProperties& properties);
+
+        /**
+         * Returns the permutation mask matching the current properties, for the permutation keys declared by the shader.
+         * Keys are named after the properties they depend on (USE_DIFFUSE_MAP for UseDiffuseMap, ...).
+         *
+         * @see		SHADER_DESC::PermutationKeys
+         */
+        UINT32 GetPermutationMask() const;
 
     public:
         /** Creates a new empty material. */
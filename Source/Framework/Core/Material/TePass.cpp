@@ -4,6 +4,7 @@
 #include "RenderAPI/TeDepthStencilState.h"
 #include "RenderAPI/TeGpuParams.h"
 #include "RenderAPI/TeGpuProgram.h"
+#include "RenderAPI/TeGpuProgramManager.h"
 #include "RenderAPI/TeGpuPipelineState.h"
 #include "Resources/TeResourceHandle.h"
 #include "Resources/TeResourceManager.h"
@@ -73,7 +74,7 @@ namespace te
     {
         if (IsCompute())
         {
-            SPtr<GpuProgram> program = GpuProgram::Create(_data.ComputeProgramDesc);
+            SPtr<GpuProgram> program = CreateProgram(_data.ComputeProgramDesc);
             _computePipelineState = ComputePipelineState::Create(program);
         }
         else
@@ -81,19 +82,19 @@ namespace te
             GpuPipelineStateTypes::StateDescType desc;
 
             if (!_data.VertexProgramDesc.Source.empty() && !desc.vertexProgram)
-                desc.vertexProgram = GpuProgram::Create(_data.VertexProgramDesc);
+                desc.vertexProgram = CreateProgram(_data.VertexProgramDesc);
 
             if (!_data.PixelProgramDesc.Source.empty() && !desc.pixelProgram)
-                desc.pixelProgram = GpuProgram::Create(_data.PixelProgramDesc);
+                desc.pixelProgram = CreateProgram(_data.PixelProgramDesc);
 
             if (!_data.GeometryProgramDesc.Source.empty() && !desc.geometryProgram)
-                desc.geometryProgram = GpuProgram::Create(_data.GeometryProgramDesc);
+                desc.geometryProgram = CreateProgram(_data.GeometryProgramDesc);
 
             if (!_data.HullProgramDesc.Source.empty() && !desc.hullProgram)
-                desc.hullProgram = GpuProgram::Create(_data.HullProgramDesc);
+                desc.hullProgram = CreateProgram(_data.HullProgramDesc);
 
             if (!_data.DomainProgramDesc.Source.empty() && !desc.domainProgram)
-                desc.domainProgram = GpuProgram::Create(_data.DomainProgramDesc);
+                desc.domainProgram = CreateProgram(_data.DomainProgramDesc);
 
             desc.blendState = BlendState::Create(_data.BlendStateDesc);
             desc.rasterizerState = RasterizerState::Create(_data.RasterizerStateDesc);
@@ -104,6 +105,14 @@ namespace te
         }
     }
 
+    SPtr<GpuProgram> Pass::CreateProgram(const GPU_PROGRAM_DESC& desc) const
+    {
+        if (_permutationKeys.empty())
+            return GpuProgram::Create(desc);
+
+        return GpuProgramManager::Instance().GetVariation(desc, _permutationKeys, _permutationMask);
+    }
+
     void Pass::Compile()
     {
         if (_computePipelineState || _graphicsPipelineState)
@@ -113,6 +122,15 @@ namespace te
         MarkCoreDirty();
     }
 
+    SPtr<Pass> Pass::CreateVariation(const Vector<String>& permutationKeys, UINT32 permutationMask) const
+    {
+        SPtr<Pass> variation = CreatePtr(_data);
+        variation->_permutationKeys = permutationKeys;
+        variation->_permutationMask = permutationMask;
+
+        return variation;
+    }
+
     HPass Pass::Create(const PASS_DESC& desc)
     {
         const SPtr<Pass> passPtr = CreatePtr(desc);
@@ -77,6 +77,16 @@ namespace te
          */
         void Compile();
 
+        /**
+         * Creates a copy of this pass whose programs are specialized for the provided permutation mask.
+         *
+         * @see		GpuProgramManager::GetVariation
+         */
+        SPtr<Pass> CreateVariation(const Vector<String>& permutationKeys, UINT32 permutationMask) const;
+
+        /** Returns the permutation mask this pass was specialized for. Only relevant for pass variations. */
+        UINT32 GetPermutationMask() const { return _permutationMask; }
+
         /**	Creates a new empty pass. */
         static HPass Create(const PASS_DESC& desc);
 
@@ -93,8 +103,13 @@ namespace te
         Pass();
         Pass(const PASS_DESC & desc);
 
+        /** Creates the program described by @p desc, or the variation of it this pass was specialized for. */
+        SPtr<GpuProgram> CreateProgram(const GPU_PROGRAM_DESC& desc) const;
+
     protected:
         PASS_DESC _data;
+        Vector<String> _permutationKeys;
+        UINT32 _permutationMask = 0;
         SPtr<GraphicsPipelineState> _graphicsPipelineState;
         SPtr<ComputePipelineState> _computePipelineState;
         SPtr<GpuParams> _gpuParams;
@@ -149,6 +149,25 @@ namespace te
         return _desc.Techniques;
     }
 
+    Vector<SPtr<Technique>> Shader::GetCompatibleTechniques(UINT32 permutationMask) const
+    {
+        if (_desc.PermutationKeys.empty())
+            return GetCompatibleTechniques();
+
+        Lock lock(_variationsMutex);
+
+        auto iterFind = _variations.find(permutationMask);
+        if (iterFind != _variations.end())
+            return iterFind->second;
+
+        Vector<SPtr<Technique>> techniques;
+        for (auto& technique : GetCompatibleTechniques())
+            techniques.push_back(technique->CreateVariation(_desc.PermutationKeys, permutationMask));
+
+        _variations[permutationMask] = techniques;
+        return techniques;
+    }
+
     GpuParamType Shader::GetParamType(const String& name) const
     {
         auto findIterData = _desc.DataParams.find(name);
@@ -5,6 +5,7 @@
 #include "Material/TeTechnique.h"
 #include "Image/TeTexture.h"
 #include "RenderAPI/TeSamplerState.h"
+#include "Threading/TeThreading.h"
 
 namespace te
 {
@@ -194,6 +195,13 @@ namespace te
         /** Techniques to initialize the shader with. */
         Vector<SPtr<Technique>> Techniques;
 
+        /**
+         * Names of the preprocessor defines the programs of the shader can be specialized on (for example
+         * "USE_NORMAL_MAP"). Each key maps to a bit of a permutation mask, in order, and the programs of a variation are
+         * compiled with the key defined to 1 or 0 depending on that bit. At most 32 keys are supported.
+         */
+        Vector<String> PermutationKeys;
+
         Map<String, SHADER_DATA_PARAM_DESC> DataParams;
         Map<String, SHADER_OBJECT_PARAM_DESC> TextureParams;
         Map<String, SHADER_OBJECT_PARAM_DESC> BufferParams;
@@ -260,9 +268,20 @@ namespace te
         /** Returns the list of all supported techniques based on current render API and renderer. */
         Vector<SPtr<Technique>> GetCompatibleTechniques() const;
 
+        /**
+         * Returns the list of all supported techniques, specialized for the provided permutation mask. Variations are
+         * created the first time a mask is requested and shared afterwards. Thread safe.
+         *
+         * @see		SHADER_DESC::PermutationKeys
+         */
+        Vector<SPtr<Technique>> GetCompatibleTechniques(UINT32 permutationMask) const;
+
         /** Returns a list of all techniques in this shader. */
         const Vector<SPtr<Technique>>& GetTechniques() const { return _desc.Techniques; }
 
+        /** Returns the names of the keys the shader can be specialized on. */
+        const Vector<String>& GetPermutationKeys() const { return _desc.PermutationKeys; }
+
         /**	Creates a new shader resource using the provided descriptor and techniques. */
         static HShader Create(const String& name, const SHADER_DESC& desc);
 
@@ -381,6 +400,9 @@ namespace te
         SHADER_DESC _desc;
         UINT32 _id;
 
+        mutable UnorderedMap<UINT32, Vector<SPtr<Technique>>> _variations;
+        mutable Mutex _variationsMutex;
+
         static std::atomic<UINT32> NextShaderId;
     };
 }
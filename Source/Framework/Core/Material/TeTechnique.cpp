@@ -41,6 +41,17 @@ namespace te
             pass->Compile();
     }
 
+    SPtr<Technique> Technique::CreateVariation(const Vector<String>& permutationKeys, UINT32 permutationMask) const
+    {
+        Vector<SPtr<Pass>> passes;
+        passes.reserve(_passes.size());
+
+        for (auto& pass : _passes)
+            passes.push_back(pass->CreateVariation(permutationKeys, permutationMask));
+
+        return CreatePtr(_language, passes);
+    }
+
     SPtr<Pass> Technique::GetPass(UINT32 idx) const
     {
         if (idx >= (UINT32)_passes.size())
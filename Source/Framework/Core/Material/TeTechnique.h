@@ -28,6 +28,13 @@ namespace te
         /** Compiles all the passes in a technique. @see Pass::compile. */
         void Compile();
 
+        /**
+         * Creates a copy of this technique whose passes are specialized for the provided permutation mask.
+         *
+         * @see		Pass::CreateVariation
+         */
+        SPtr<Technique> CreateVariation(const Vector<String>& permutationKeys, UINT32 permutationMask) const;
+
         /**
          * Creates a new technique.
          *
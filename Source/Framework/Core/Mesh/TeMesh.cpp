@@ -150,6 +150,9 @@ namespace te
     void Mesh::UpdateBounds(const MeshData& meshData)
     {
         _properties._bounds = meshData.CalculateBounds();
+        _properties._quantized = meshData.IsQuantized();
+        _properties._positionScale = meshData.GetPositionScale();
+        _properties._positionOffset = meshData.GetPositionOffset();
     }
 
     void Mesh::UpdateCPUBuffer(UINT32 subresourceIdx, const MeshData& meshData)
@@ -194,6 +197,7 @@ namespace te
     {
         SPtr<MeshData> meshData = te_shared_ptr_new<MeshData>(_properties._numVertices, _properties._numIndices,
             _vertexDesc, _indexType);
+        meshData->SetPositionQuantization(_properties._positionScale, _properties._positionOffset);
 
         return meshData;
     }
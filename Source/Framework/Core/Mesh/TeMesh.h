@@ -94,6 +94,15 @@ namespace te
         /** Returns bounds of the geometry contained in the vertex buffers for all sub-meshes. */
         const Bounds& GetBounds() const { return _bounds; }
 
+        /** Checks if the vertex buffers store quantized vertices, see MeshData::IsQuantized(). */
+        bool IsQuantized() const { return _quantized; }
+
+        /** Returns the scale applied to quantized vertex positions when decoding them. */
+        const Vector3& GetPositionScale() const { return _positionScale; }
+
+        /** Returns the offset applied to quantized vertex positions when decoding them. */
+        const Vector3& GetPositionOffset() const { return _positionOffset; }
+
     protected:
         friend class Mesh;
 
@@ -101,6 +110,9 @@ namespace te
         UINT32 _numVertices;
         UINT32 _numIndices;
         Bounds _bounds;
+        bool _quantized = false;
+        Vector3 _positionScale = Vector3::ONE;
+        Vector3 _positionOffset = Vector3::ZERO;
     };
 
     class TE_CORE_EXPORT Mesh : public Resource
@@ -285,7 +297,10 @@ namespace te
     private:
         Mesh();
 
-        /** Updates bounds by calculating them from the vertices in the provided mesh data object. */
+        /**
+         * Updates bounds by calculating them from the vertices in the provided mesh data object, along with the
+         * parameters used to decode quantized vertices.
+         */
         void UpdateBounds(const MeshData& meshData);
 
         /**
@@ -301,22 +301,41 @@ namespace te
         {
             const VertexElement& curElement = vertexDesc->GetElement(i);
 
-            if (curElement.GetSemantic() != VES_POSITION || (curElement.GetType() != VET_FLOAT3 && curElement.GetType() != VET_FLOAT4))
+            if (curElement.GetSemantic() != VES_POSITION || (curElement.GetType() != VET_FLOAT3 &&
+                curElement.GetType() != VET_FLOAT4 && curElement.GetType() != VET_SHORT4_NORM))
+            {
                 continue;
+            }
 
             UINT8* data = GetElementData(curElement.GetSemantic(), curElement.GetSemanticIdx(), curElement.GetStreamIdx());
             UINT32 stride = vertexDesc->GetVertexStride(curElement.GetStreamIdx());
+            bool quantized = curElement.GetType() == VET_SHORT4_NORM;
+
+            auto readPosition = [&](UINT32 idx)
+            {
+                const UINT8* src = data + stride * idx;
+                if (!quantized)
+                    return *(Vector3*)src;
+
+                const INT16* packed = (const INT16*)src;
+                Vector3 position(
+                    std::max(packed[0] / 32767.0f, -1.0f),
+                    std::max(packed[1] / 32767.0f, -1.0f),
+                    std::max(packed[2] / 32767.0f, -1.0f));
+
+                return position * _positionScale + _positionOffset;
+            };
 
             if (GetNumVertices() > 0)
             {
-                Vector3 curPosition = *(Vector3*)data;
+                Vector3 curPosition = readPosition(0);
                 Vector3 accum = curPosition;
                 Vector3 min = curPosition;
                 Vector3 max = curPosition;
 
                 for (UINT32 i = 1; i < GetNumVertices(); i++)
                 {
-                    curPosition = *(Vector3*)(data + stride * i);
+                    curPosition = readPosition(i);
                     accum += curPosition;
                     min = Vector3::Min(min, curPosition);
                     max = Vector3::Max(max, curPosition);
@@ -327,7 +346,7 @@ namespace te
 
                 for (UINT32 i = 0; i < GetNumVertices(); i++)
                 {
-                    curPosition = *(Vector3*)(data + stride * i);
+                    curPosition = readPosition(i);
                     float dist = center.SquaredDistance(curPosition);
 
                     if (dist > radiusSqrd)
@@ -343,4 +362,16 @@ namespace te
 
         return bounds;
     }
+
+    void MeshData::SetPositionQuantization(const Vector3& scale, const Vector3& offset)
+    {
+        _positionScale = scale;
+        _positionOffset = offset;
+    }
+
+    bool MeshData::IsQuantized() const
+    {
+        const VertexElement* positionElement = _vertexData->GetElement(VES_POSITION);
+        return positionElement != nullptr && positionElement->GetType() == VET_SHORT4_NORM;
+    }
 }
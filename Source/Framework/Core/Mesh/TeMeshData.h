@@ -127,6 +127,24 @@ namespace te
         /**	Calculates the bounds of all vertices stored in the internal buffer. */
         Bounds CalculateBounds() const;
 
+        /**
+         * Sets the range positions stored as normalized integers are mapped to, a stored position p in [-1, 1] decodes to
+         * (p * scale + offset). Has no effect on positions stored as floating point values.
+         */
+        void SetPositionQuantization(const Vector3& scale, const Vector3& offset);
+
+        /** Returns the scale applied to positions stored as normalized integers. */
+        const Vector3& GetPositionScale() const { return _positionScale; }
+
+        /** Returns the offset applied to positions stored as normalized integers. */
+        const Vector3& GetPositionOffset() const { return _positionOffset; }
+
+        /**
+         * Checks if vertex positions, normals and tangents are stored in the quantized formats produced by
+         * MeshUtility::QuantizeVertices(), and must be decoded by the vertex shader.
+         */
+        bool IsQuantized() const;
+
         /**
          * Combines a number of submeshes and their mesh data into one large mesh data buffer.
          *
@@ -176,5 +194,8 @@ namespace te
         IndexType _indexType;
 
         SPtr<VertexDataDesc> _vertexData;
+
+        Vector3 _positionScale = Vector3::ONE;
+        Vector3 _positionOffset = Vector3::ZERO;
     };
 }
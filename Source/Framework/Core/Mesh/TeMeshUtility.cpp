@@ -1,10 +1,209 @@
 #include "Mesh/TeMeshUtility.h"
+#include "Mesh/TeMeshData.h"
+#include "RenderAPI/TeSubMesh.h"
+#include "RenderAPI/TeVertexDataDesc.h"
 #include "Math/TeVector4.h"
 #include "Math/TeVector3.h"
 #include "Math/TeVector2.h"
+#include "Utility/TeBitwise.h"
 
 namespace te
 {
+    namespace
+    {
+        /** Size of the LRU cache modeled by the vertex cache optimization. */
+        constexpr UINT32 FORSYTH_CACHE_SIZE = 32;
+        constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+        constexpr float FORSYTH_LAST_TRI_SCORE = 0.75f;
+        constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+        constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+        /** Size of the FIFO cache used when cutting triangle clusters for overdraw optimization. */
+        constexpr UINT32 OVERDRAW_CACHE_SIZE = 16;
+
+        /** Largest number of passes the simplification runs, each one collapsing a set of independent edges. */
+        constexpr UINT32 SIMPLIFY_MAX_PASSES = 100;
+
+        /**
+         * Accumulates squared distances to a set of planes, weighted by the area of the triangles they come from. Only the
+         * upper half of the symmetric 3x3 matrix is stored.
+         */
+        struct Quadric
+        {
+            float A00 = 0.0f, A11 = 0.0f, A22 = 0.0f;
+            float A01 = 0.0f, A02 = 0.0f, A12 = 0.0f;
+            float B0 = 0.0f, B1 = 0.0f, B2 = 0.0f;
+            float C = 0.0f;
+            float Weight = 0.0f;
+
+            /** Adds the plane of a triangle to the quadric. */
+            void AddTriangle(const Vector3& p0, const Vector3& p1, const Vector3& p2)
+            {
+                Vector3 normal = Vector3::Cross(p1 - p0, p2 - p0);
+                const float area = normal.Length();
+                if (area == 0.0f)
+                    return;
+
+                normal /= area;
+                const float d = -normal.Dot(p0);
+
+                A00 += area * normal.x * normal.x;
+                A11 += area * normal.y * normal.y;
+                A22 += area * normal.z * normal.z;
+                A01 += area * normal.x * normal.y;
+                A02 += area * normal.x * normal.z;
+                A12 += area * normal.y * normal.z;
+                B0 += area * normal.x * d;
+                B1 += area * normal.y * d;
+                B2 += area * normal.z * d;
+                C += area * d * d;
+                Weight += area;
+            }
+
+            void Add(const Quadric& other)
+            {
+                A00 += other.A00; A11 += other.A11; A22 += other.A22;
+                A01 += other.A01; A02 += other.A02; A12 += other.A12;
+                B0 += other.B0; B1 += other.B1; B2 += other.B2;
+                C += other.C;
+                Weight += other.Weight;
+            }
+
+            /** Returns the area weighted sum of squared distances from the point to the planes. */
+            float Evaluate(const Vector3& p) const
+            {
+                const float rx = A00 * p.x + A01 * p.y + A02 * p.z + 2.0f * B0;
+                const float ry = A01 * p.x + A11 * p.y + A12 * p.z + 2.0f * B1;
+                const float rz = A02 * p.x + A12 * p.y + A22 * p.z + 2.0f * B2;
+
+                return std::max(0.0f, rx * p.x + ry * p.y + rz * p.z + C);
+            }
+        };
+
+        /** Candidate collapse of vertex From onto vertex To, used by MeshUtility::Simplify. */
+        struct EdgeCollapse
+        {
+            UINT32 From;
+            UINT32 To;
+            float Cost;
+        };
+
+        /** Scores a vertex based on its position in the cache and on the number of triangles still using it. */
+        float VertexCacheScore(INT32 cachePosition, UINT32 numLiveTriangles)
+        {
+            if (numLiveTriangles == 0)
+                return -1.0f;
+
+            float score = 0.0f;
+            if (cachePosition >= 0)
+            {
+                // Vertices of the last triangle get a fixed score, so the same triangle isn't favored in both directions
+                if (cachePosition < 3)
+                    score = FORSYTH_LAST_TRI_SCORE;
+                else
+                {
+                    const float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+                    score = Math::Pow(1.0f - (cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+                }
+            }
+
+            // Boost vertices with few triangles left, so lone triangles don't get stranded
+            score += FORSYTH_VALENCE_BOOST_SCALE * Math::Pow((float)numLiveTriangles, -FORSYTH_VALENCE_BOOST_POWER);
+            return score;
+        }
+
+        /**
+         * Returns the number of cache misses when drawing triangles in order, using a FIFO cache. A vertex is in the
+         * cache if it was pushed less than @p cacheSize misses ago, so @p timestamps must be initialized to 0 and
+         * @p timestamp to more than @p cacheSize. Increasing @p timestamp by @p cacheSize between calls flushes the cache.
+         */
+        UINT32 SimulateFifoCache(const UINT32* indices, UINT32 numIndices, UINT32 cacheSize, Vector<UINT32>& timestamps,
+            UINT32& timestamp, Vector<UINT32>* missesPerTriangle)
+        {
+            UINT32 misses = 0;
+
+            for (UINT32 i = 0; i < numIndices; i += 3)
+            {
+                UINT32 triangleMisses = 0;
+                for (UINT32 j = 0; j < 3; j++)
+                {
+                    const UINT32 idx = indices[i + j];
+                    if (timestamp - timestamps[idx] > cacheSize)
+                    {
+                        timestamps[idx] = timestamp++;
+                        triangleMisses++;
+                    }
+                }
+
+                if (missesPerTriangle)
+                    missesPerTriangle->push_back(triangleMisses);
+
+                misses += triangleMisses;
+            }
+
+            return misses;
+        }
+
+        /**
+         * Renumbers the vertices referenced by a range of indices in order of first use, so the range can be processed in
+         * its own vertex space. @p globalToLocal must hold an entry per mesh vertex, all set to -1, and is left that way.
+         */
+        void RemapToLocalVertices(const UINT32* indices, UINT32 numIndices, Vector<UINT32>& globalToLocal,
+            Vector<UINT32>& localToGlobal, Vector<UINT32>& localIndices)
+        {
+            localToGlobal.clear();
+            localIndices.resize(numIndices);
+
+            for (UINT32 i = 0; i < numIndices; i++)
+            {
+                UINT32& local = globalToLocal[indices[i]];
+                if (local == (UINT32)-1)
+                {
+                    local = (UINT32)localToGlobal.size();
+                    localToGlobal.push_back(indices[i]);
+                }
+
+                localIndices[i] = local;
+            }
+
+            for (auto& vertex : localToGlobal)
+                globalToLocal[vertex] = (UINT32)-1;
+        }
+
+        /** Converts a value in [-1, 1] range to a 16-bit signed normalized integer. */
+        INT16 PackSnorm16(float value)
+        {
+            return (INT16)Math::RoundToInt(Math::Clamp(value, -1.0f, 1.0f) * 32767.0f);
+        }
+
+        /** Converts a value in [0, 1] range to an 8-bit unsigned normalized integer. */
+        UINT8 PackUnorm8(float value)
+        {
+            return (UINT8)Math::RoundToInt(Math::Clamp01(value) * 255.0f);
+        }
+
+        /**
+         * Maps a unit vector onto the octahedron |x| + |y| + |z| = 1, whose lower half is folded over the upper one so
+         * the result fits the [-1, 1] square. Must match DecodeOctahedral() in ForwardBase.hlsli.
+         */
+        Vector2 EncodeOctahedral(const Vector3& value)
+        {
+            const float sum = Math::Abs(value.x) + Math::Abs(value.y) + Math::Abs(value.z);
+            if (sum <= 0.0f)
+                return Vector2(0.0f, 0.0f);
+
+            Vector2 encoded(value.x / sum, value.y / sum);
+            if (value.z < 0.0f)
+            {
+                encoded = Vector2(
+                    (1.0f - Math::Abs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f),
+                    (1.0f - Math::Abs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f));
+            }
+
+            return encoded;
+        }
+    }
+
     void MeshUtility::CalculateNormals(Vector3* vertices, UINT8* indices, UINT32 numVertices,
         UINT32 numIndices, Vector3* normals, UINT32 indexSize)
     {
@@ -136,4 +335,1051 @@ namespace te
         CalculateNormals(vertices, indices, numVertices, numIndices, normals, indexSize);
         CalculateTangents(vertices, normals, uv, indices, numVertices, numIndices, tangents, bitangents, indexSize);
     }
+
+    void MeshUtility::OptimizeVertexCache(UINT32* indices, UINT32 numIndices, UINT32 numVertices)
+    {
+        const UINT32 numTriangles = numIndices / 3;
+        if (numTriangles == 0)
+            return;
+
+        // Build vertex to triangle adjacency. Each vertex keeps its triangles not drawn yet at the start of its list.
+        Vector<UINT32> numLiveTriangles(numVertices, 0);
+        for (UINT32 i = 0; i < numTriangles * 3; i++)
+            numLiveTriangles[indices[i]]++;
+
+        Vector<UINT32> adjacencyOffsets(numVertices + 1, 0);
+        for (UINT32 i = 0; i < numVertices; i++)
+            adjacencyOffsets[i + 1] = adjacencyOffsets[i] + numLiveTriangles[i];
+
+        Vector<UINT32> adjacency(numTriangles * 3);
+        {
+            Vector<UINT32> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (UINT32 i = 0; i < numTriangles; i++)
+            {
+                for (UINT32 j = 0; j < 3; j++)
+                    adjacency[fill[indices[i * 3 + j]]++] = i;
+            }
+        }
+
+        Vector<INT32> cachePositions(numVertices, -1);
+        Vector<float> vertexScores(numVertices);
+        for (UINT32 i = 0; i < numVertices; i++)
+            vertexScores[i] = VertexCacheScore(-1, numLiveTriangles[i]);
+
+        Vector<bool> emitted(numTriangles, false);
+        Vector<UINT32> output;
+        output.reserve(numTriangles * 3);
+
+        UINT32 cache[FORSYTH_CACHE_SIZE + 3];
+        UINT32 newCache[FORSYTH_CACHE_SIZE + 3];
+        UINT32 cacheCount = 0;
+
+        UINT32 nextInputTriangle = 0;
+        INT32 bestTriangle = -1;
+
+        while (true)
+        {
+            // No candidate around the cache, continue from the first triangle not drawn yet
+            if (bestTriangle < 0)
+            {
+                while (nextInputTriangle < numTriangles && emitted[nextInputTriangle])
+                    nextInputTriangle++;
+
+                if (nextInputTriangle == numTriangles)
+                    break;
+
+                bestTriangle = (INT32)nextInputTriangle;
+            }
+
+            const UINT32* triangle = &indices[bestTriangle * 3];
+            emitted[bestTriangle] = true;
+            output.insert(output.end(), triangle, triangle + 3);
+
+            // Remove the triangle from the live lists of its vertices
+            for (UINT32 j = 0; j < 3; j++)
+            {
+                const UINT32 vertex = triangle[j];
+                UINT32* list = &adjacency[adjacencyOffsets[vertex]];
+                UINT32& count = numLiveTriangles[vertex];
+
+                for (UINT32 k = 0; k < count; k++)
+                {
+                    if (list[k] == (UINT32)bestTriangle)
+                    {
+                        std::swap(list[k], list[count - 1]);
+                        count--;
+                        break;
+                    }
+                }
+            }
+
+            // Move vertices of the triangle to the front of the cache, pushing the others back
+            UINT32 newCacheCount = 0;
+            for (UINT32 j = 0; j < 3; j++)
+                newCache[newCacheCount++] = triangle[j];
+
+            for (UINT32 j = 0; j < cacheCount; j++)
+            {
+                const UINT32 vertex = cache[j];
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                    newCache[newCacheCount++] = vertex;
+            }
+
+            // Vertices pushed out of the cache lose their cache score
+            for (UINT32 j = FORSYTH_CACHE_SIZE; j < newCacheCount; j++)
+            {
+                cachePositions[newCache[j]] = -1;
+                vertexScores[newCache[j]] = VertexCacheScore(-1, numLiveTriangles[newCache[j]]);
+            }
+
+            cacheCount = std::min(newCacheCount, FORSYTH_CACHE_SIZE);
+            for (UINT32 j = 0; j < cacheCount; j++)
+            {
+                cache[j] = newCache[j];
+                cachePositions[cache[j]] = (INT32)j;
+                vertexScores[cache[j]] = VertexCacheScore((INT32)j, numLiveTriangles[cache[j]]);
+            }
+
+            // Only triangles using cached vertices changed score, so the next candidate is searched among them
+            bestTriangle = -1;
+            float bestScore = -1.0f;
+            for (UINT32 j = 0; j < cacheCount; j++)
+            {
+                const UINT32 vertex = cache[j];
+                const UINT32* list = &adjacency[adjacencyOffsets[vertex]];
+
+                for (UINT32 k = 0; k < numLiveTriangles[vertex]; k++)
+                {
+                    const UINT32 candidate = list[k];
+                    const float score = vertexScores[indices[candidate * 3 + 0]] +
+                        vertexScores[indices[candidate * 3 + 1]] + vertexScores[indices[candidate * 3 + 2]];
+
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = (INT32)candidate;
+                    }
+                }
+            }
+        }
+
+        memcpy(indices, output.data(), numTriangles * 3 * sizeof(UINT32));
+    }
+
+    void MeshUtility::OptimizeOverdraw(UINT32* indices, UINT32 numIndices, const UINT8* positions, UINT32 numVertices,
+        UINT32 positionStride, float threshold)
+    {
+        const UINT32 numTriangles = numIndices / 3;
+        if (numTriangles == 0)
+            return;
+
+        auto GetPosition = [&](UINT32 idx) -> const Vector3&
+        {
+            return *(const Vector3*)(positions + idx * positionStride);
+        };
+
+        Vector<UINT32> missesPerTriangle;
+        missesPerTriangle.reserve(numTriangles);
+
+        Vector<UINT32> timestamps(numVertices, 0);
+        UINT32 timestamp = OVERDRAW_CACHE_SIZE + 1;
+        const UINT32 totalMisses = SimulateFifoCache(indices, numTriangles * 3, OVERDRAW_CACHE_SIZE, timestamps,
+            timestamp, &missesPerTriangle);
+        const float targetACMR = threshold * (float)totalMisses / numTriangles;
+
+        // Hard boundaries are where the cache had to be entirely refilled, cutting there costs nothing. Between them,
+        // clusters are cut once their miss ratio, starting from an empty cache, is low enough for the split not to
+        // hurt the cache more than allowed.
+        Vector<UINT32> clusterStarts;
+        UINT32 clusterMisses = 0;
+        UINT32 clusterTriangles = 0;
+        for (UINT32 i = 0; i < numTriangles; i++)
+        {
+            const bool hardBoundary = missesPerTriangle[i] == 3;
+            const bool softBoundary = clusterTriangles > 0 && (float)clusterMisses / clusterTriangles <= targetACMR;
+
+            if (i == 0 || hardBoundary || softBoundary)
+            {
+                clusterStarts.push_back(i);
+                clusterMisses = 0;
+                clusterTriangles = 0;
+                timestamp += OVERDRAW_CACHE_SIZE;
+            }
+
+            clusterMisses += SimulateFifoCache(&indices[i * 3], 3, OVERDRAW_CACHE_SIZE, timestamps, timestamp, nullptr);
+            clusterTriangles++;
+        }
+
+        const UINT32 numClusters = (UINT32)clusterStarts.size();
+        if (numClusters <= 1)
+            return;
+
+        clusterStarts.push_back(numTriangles);
+
+        // Mesh centroid, weighted by triangle area
+        Vector3 meshCentroid = Vector3::ZERO;
+        float meshArea = 0.0f;
+        for (UINT32 i = 0; i < numTriangles; i++)
+        {
+            const Vector3& p0 = GetPosition(indices[i * 3 + 0]);
+            const Vector3& p1 = GetPosition(indices[i * 3 + 1]);
+            const Vector3& p2 = GetPosition(indices[i * 3 + 2]);
+
+            const float area = Vector3::Cross(p1 - p0, p2 - p0).Length();
+            meshCentroid += (p0 + p1 + p2) * (area / 3.0f);
+            meshArea += area;
+        }
+
+        if (meshArea > 0.0f)
+            meshCentroid /= meshArea;
+
+        // Clusters facing away from the center of the mesh are likely to occlude the others, so they are drawn first
+        Vector<std::pair<float, UINT32>> sortKeys(numClusters);
+        for (UINT32 i = 0; i < numClusters; i++)
+        {
+            Vector3 centroid = Vector3::ZERO;
+            Vector3 normal = Vector3::ZERO;
+            float area = 0.0f;
+
+            for (UINT32 j = clusterStarts[i]; j < clusterStarts[i + 1]; j++)
+            {
+                const Vector3& p0 = GetPosition(indices[j * 3 + 0]);
+                const Vector3& p1 = GetPosition(indices[j * 3 + 1]);
+                const Vector3& p2 = GetPosition(indices[j * 3 + 2]);
+
+                const Vector3 cross = Vector3::Cross(p1 - p0, p2 - p0);
+                const float triangleArea = cross.Length();
+
+                centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+                normal += cross;
+                area += triangleArea;
+            }
+
+            if (area > 0.0f)
+                centroid /= area;
+
+            sortKeys[i] = std::make_pair(-Vector3::Dot(centroid - meshCentroid, Vector3::Normalize(normal)), i);
+        }
+
+        std::stable_sort(sortKeys.begin(), sortKeys.end(),
+            [](const std::pair<float, UINT32>& a, const std::pair<float, UINT32>& b) { return a.first < b.first; });
+
+        Vector<UINT32> output;
+        output.reserve(numTriangles * 3);
+        for (auto& key : sortKeys)
+        {
+            const UINT32 cluster = key.second;
+            output.insert(output.end(), indices + clusterStarts[cluster] * 3, indices + clusterStarts[cluster + 1] * 3);
+        }
+
+        memcpy(indices, output.data(), numTriangles * 3 * sizeof(UINT32));
+    }
+
+    UINT32 MeshUtility::OptimizeVertexFetch(UINT32* indices, UINT32 numIndices, UINT32 numVertices, UINT32* remap)
+    {
+        for (UINT32 i = 0; i < numVertices; i++)
+            remap[i] = (UINT32)-1;
+
+        UINT32 numUsedVertices = 0;
+        for (UINT32 i = 0; i < numIndices; i++)
+        {
+            UINT32& newIdx = remap[indices[i]];
+            if (newIdx == (UINT32)-1)
+                newIdx = numUsedVertices++;
+
+            indices[i] = newIdx;
+        }
+
+        return numUsedVertices;
+    }
+
+    VertexCacheStatistics MeshUtility::AnalyzeVertexCache(const UINT32* indices, UINT32 numIndices, UINT32 numVertices,
+        UINT32 cacheSize)
+    {
+        VertexCacheStatistics stats;
+
+        const UINT32 numTriangles = numIndices / 3;
+        if (numTriangles == 0)
+            return stats;
+
+        Vector<bool> referenced(numVertices, false);
+        UINT32 numReferenced = 0;
+        for (UINT32 i = 0; i < numTriangles * 3; i++)
+        {
+            if (!referenced[indices[i]])
+            {
+                referenced[indices[i]] = true;
+                numReferenced++;
+            }
+        }
+
+        Vector<UINT32> timestamps(numVertices, 0);
+        UINT32 timestamp = cacheSize + 1;
+        stats.VerticesTransformed = SimulateFifoCache(indices, numTriangles * 3, cacheSize, timestamps, timestamp, nullptr);
+        stats.ACMR = (float)stats.VerticesTransformed / numTriangles;
+        stats.ATVR = (float)stats.VerticesTransformed / numReferenced;
+
+        return stats;
+    }
+
+    SPtr<MeshData> MeshUtility::OptimizeMesh(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+        VertexCacheStatistics* before, VertexCacheStatistics* after)
+    {
+        const UINT32 numVertices = meshData->GetNumVertices();
+        const UINT32 numIndices = meshData->GetNumIndices();
+        const IndexType indexType = meshData->GetIndexType();
+
+        Vector<UINT32> indices(numIndices);
+        if (indexType == IT_32BIT)
+            memcpy(indices.data(), meshData->GetIndices32(), numIndices * sizeof(UINT32));
+        else
+        {
+            const UINT16* src = meshData->GetIndices16();
+            for (UINT32 i = 0; i < numIndices; i++)
+                indices[i] = src[i];
+        }
+
+        // Only triangle lists are reordered, and only if their range doesn't partially overlap another sub-mesh, as
+        // triangles must never change sub-mesh. Levels of detail of a sub-mesh are optimized as separate ranges
+        Vector<std::pair<UINT32, UINT32>> ranges;
+        auto AddRange = [&](UINT32 indexOffset, UINT32 indexCount)
+        {
+            if (indexCount < 3)
+                return;
+
+            const UINT32 start = indexOffset;
+            const UINT32 end = start + (indexCount / 3) * 3;
+            if (end > numIndices)
+                return;
+
+            for (auto& range : ranges)
+            {
+                if (start < range.second && range.first < end)
+                    return;
+            }
+
+            ranges.push_back(std::make_pair(start, end));
+        };
+
+        for (auto& subMesh : subMeshes)
+        {
+            if (subMesh.DrawOp != DOT_TRIANGLE_LIST)
+                continue;
+
+            AddRange(subMesh.IndexOffset, subMesh.IndexCount);
+
+            for (auto& lod : subMesh.Lods)
+                AddRange(lod.IndexOffset, lod.IndexCount);
+        }
+
+        if (ranges.empty())
+            return meshData;
+
+        // Each sub-mesh is drawn separately, so the cache is flushed between them
+        auto Analyze = [&]()
+        {
+            constexpr UINT32 cacheSize = 16;
+
+            VertexCacheStatistics stats;
+            Vector<UINT32> timestamps(numVertices, 0);
+            UINT32 timestamp = cacheSize + 1;
+            UINT32 numTriangles = 0;
+            Vector<bool> referenced(numVertices, false);
+            UINT32 numReferenced = 0;
+
+            for (auto& range : ranges)
+            {
+                stats.VerticesTransformed += SimulateFifoCache(&indices[range.first], range.second - range.first,
+                    cacheSize, timestamps, timestamp, nullptr);
+                timestamp += cacheSize;
+
+                numTriangles += (range.second - range.first) / 3;
+                for (UINT32 i = range.first; i < range.second; i++)
+                {
+                    if (!referenced[indices[i]])
+                    {
+                        referenced[indices[i]] = true;
+                        numReferenced++;
+                    }
+                }
+            }
+
+            stats.ACMR = (float)stats.VerticesTransformed / numTriangles;
+            stats.ATVR = (float)stats.VerticesTransformed / numReferenced;
+            return stats;
+        };
+
+        if (before)
+            *before = Analyze();
+
+        const SPtr<VertexDataDesc>& vertexDesc = meshData->GetVertexDesc();
+        const VertexElement* positionElement = vertexDesc->GetElement(VES_POSITION);
+        const UINT8* positions = nullptr;
+        UINT32 positionStride = 0;
+        if (positionElement && positionElement->GetType() == VET_FLOAT3)
+        {
+            positions = meshData->GetElementData(VES_POSITION, 0, positionElement->GetStreamIdx());
+            positionStride = vertexDesc->GetVertexStride(positionElement->GetStreamIdx());
+        }
+
+        // Sub-meshes usually reference a small part of the vertices, so they are optimized in their own vertex space
+        Vector<UINT32> globalToLocal(numVertices, (UINT32)-1);
+        Vector<UINT32> localToGlobal;
+        Vector<UINT32> localIndices;
+        Vector<Vector3> localPositions;
+
+        for (auto& range : ranges)
+        {
+            RemapToLocalVertices(&indices[range.first], range.second - range.first, globalToLocal, localToGlobal,
+                localIndices);
+
+            const UINT32 numLocalVertices = (UINT32)localToGlobal.size();
+            OptimizeVertexCache(localIndices.data(), (UINT32)localIndices.size(), numLocalVertices);
+
+            if (positions)
+            {
+                localPositions.resize(numLocalVertices);
+                for (UINT32 i = 0; i < numLocalVertices; i++)
+                    localPositions[i] = *(const Vector3*)(positions + localToGlobal[i] * positionStride);
+
+                OptimizeOverdraw(localIndices.data(), (UINT32)localIndices.size(), (const UINT8*)localPositions.data(),
+                    numLocalVertices, sizeof(Vector3));
+            }
+
+            for (UINT32 i = range.first; i < range.second; i++)
+                indices[i] = localToGlobal[localIndices[i - range.first]];
+        }
+
+        if (after)
+            *after = Analyze();
+
+        // Renumber vertices in order of first use, dropping the ones never used
+        Vector<UINT32> remap(numVertices);
+        const UINT32 numUsedVertices = OptimizeVertexFetch(indices.data(), numIndices, numVertices, remap.data());
+
+        SPtr<MeshData> output = MeshData::Create(numUsedVertices, numIndices, vertexDesc, indexType);
+
+        if (indexType == IT_32BIT)
+            memcpy(output->GetIndices32(), indices.data(), numIndices * sizeof(UINT32));
+        else
+        {
+            UINT16* dst = output->GetIndices16();
+            for (UINT32 i = 0; i < numIndices; i++)
+                dst[i] = (UINT16)indices[i];
+        }
+
+        UINT32 numStreams = 0;
+        for (UINT32 i = 0; i < vertexDesc->GetNumElements(); i++)
+            numStreams = std::max(numStreams, (UINT32)vertexDesc->GetElement(i).GetStreamIdx() + 1);
+
+        for (UINT32 stream = 0; stream < numStreams; stream++)
+        {
+            const UINT32 stride = vertexDesc->GetVertexStride(stream);
+            if (stride == 0)
+                continue;
+
+            const UINT8* src = meshData->GetStreamData(stream);
+            UINT8* dst = output->GetStreamData(stream);
+
+            for (UINT32 i = 0; i < numVertices; i++)
+            {
+                if (remap[i] != (UINT32)-1)
+                    memcpy(dst + remap[i] * stride, src + i * stride, stride);
+            }
+        }
+
+        return output;
+    }
+
+    UINT32 MeshUtility::Simplify(UINT32* destination, const UINT32* indices, UINT32 numIndices, const UINT8* positions,
+        UINT32 numVertices, UINT32 positionStride, UINT32 targetIndexCount, float targetError, float* resultError)
+    {
+        numIndices = (numIndices / 3) * 3;
+        memcpy(destination, indices, numIndices * sizeof(UINT32));
+
+        if (resultError)
+            *resultError = 0.0f;
+
+        if (numIndices <= targetIndexCount || numVertices == 0)
+            return numIndices;
+
+        // Positions are normalized to a unit box, so quadrics keep their precision whatever the scale of the mesh is
+        Vector<Vector3> vertices(numVertices);
+        Vector3 min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        Vector3 max = -min;
+
+        for (UINT32 i = 0; i < numVertices; i++)
+        {
+            vertices[i] = *(const Vector3*)(positions + i * positionStride);
+            min = Vector3::Min(min, vertices[i]);
+            max = Vector3::Max(max, vertices[i]);
+        }
+
+        const Vector3 extents = max - min;
+        const float scale = std::max(extents.x, std::max(extents.y, extents.z));
+        if (scale <= 0.0f)
+            return numIndices;
+
+        for (auto& vertex : vertices)
+            vertex = (vertex - min) / scale;
+
+        // Vertices sharing a position are split along an attribute seam. Each of them refers to the first one, which
+        // holds the topology and quadric of the whole group
+        Vector<UINT32> roots(numVertices);
+        Vector<bool> locked(numVertices, false);
+        {
+            Vector<UINT32> sorted(numVertices);
+            for (UINT32 i = 0; i < numVertices; i++)
+                sorted[i] = i;
+
+            auto Less = [&](UINT32 a, UINT32 b)
+            {
+                const Vector3& pa = vertices[a];
+                const Vector3& pb = vertices[b];
+
+                if (pa.x != pb.x) return pa.x < pb.x;
+                if (pa.y != pb.y) return pa.y < pb.y;
+                if (pa.z != pb.z) return pa.z < pb.z;
+                return a < b;
+            };
+
+            std::sort(sorted.begin(), sorted.end(), Less);
+
+            for (UINT32 i = 0; i < numVertices; )
+            {
+                UINT32 end = i + 1;
+                while (end < numVertices && vertices[sorted[end]] == vertices[sorted[i]])
+                    end++;
+
+                for (UINT32 j = i; j < end; j++)
+                    roots[sorted[j]] = sorted[i];
+
+                if (end - i > 1)
+                    locked[sorted[i]] = true;
+
+                i = end;
+            }
+        }
+
+        // Edges without a twin going the other way lie on a border of the mesh
+        {
+            Vector<UINT64> edges;
+            edges.reserve(numIndices);
+
+            for (UINT32 i = 0; i < numIndices; i += 3)
+            {
+                for (UINT32 j = 0; j < 3; j++)
+                {
+                    const UINT32 a = roots[destination[i + j]];
+                    const UINT32 b = roots[destination[i + (j + 1) % 3]];
+                    if (a != b)
+                        edges.push_back(((UINT64)a << 32) | b);
+                }
+            }
+
+            std::sort(edges.begin(), edges.end());
+
+            for (auto& edge : edges)
+            {
+                const UINT32 a = (UINT32)(edge >> 32);
+                const UINT32 b = (UINT32)edge;
+                if (!std::binary_search(edges.begin(), edges.end(), ((UINT64)b << 32) | a))
+                {
+                    locked[a] = true;
+                    locked[b] = true;
+                }
+            }
+        }
+
+        Vector<Quadric> quadrics(numVertices);
+        for (UINT32 i = 0; i < numIndices; i += 3)
+        {
+            const UINT32 a = roots[destination[i + 0]];
+            const UINT32 b = roots[destination[i + 1]];
+            const UINT32 c = roots[destination[i + 2]];
+
+            Quadric quadric;
+            quadric.AddTriangle(vertices[a], vertices[b], vertices[c]);
+
+            quadrics[a].Add(quadric);
+            quadrics[b].Add(quadric);
+            quadrics[c].Add(quadric);
+        }
+
+        auto CollapseCost = [&](UINT32 from, UINT32 to)
+        {
+            const Quadric& qFrom = quadrics[from];
+            const Quadric& qTo = quadrics[to];
+            const float weight = qFrom.Weight + qTo.Weight;
+
+            if (weight == 0.0f)
+                return 0.0f;
+
+            return (qFrom.Evaluate(vertices[to]) + qTo.Evaluate(vertices[to])) / weight;
+        };
+
+        const float normalizedError = targetError / scale;
+        const float maxCost = normalizedError * normalizedError;
+        float maxCollapseCost = 0.0f;
+
+        Vector<UINT32> adjacencyOffsets(numVertices + 1);
+        Vector<UINT32> adjacency;
+        Vector<EdgeCollapse> collapses;
+        Vector<UINT32> collapseTargets(numVertices, (UINT32)-1);
+        Vector<UINT32> collapsed;
+        Vector<bool> touched(numVertices);
+
+        for (UINT32 pass = 0; pass < SIMPLIFY_MAX_PASSES && numIndices > targetIndexCount; pass++)
+        {
+            // Triangles around each vertex
+            std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+            for (UINT32 i = 0; i < numIndices; i++)
+                adjacencyOffsets[roots[destination[i]] + 1]++;
+
+            for (UINT32 i = 0; i < numVertices; i++)
+                adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+            adjacency.resize(numIndices);
+            for (UINT32 i = 0; i < numIndices; i++)
+                adjacency[adjacencyOffsets[roots[destination[i]]]++] = i / 3;
+
+            for (UINT32 i = numVertices; i > 0; i--)
+                adjacencyOffsets[i] = adjacencyOffsets[i - 1];
+
+            adjacencyOffsets[0] = 0;
+
+            // Locked vertices are never removed, but other vertices can still collapse onto them. Unlocked vertices are
+            // never part of a seam, so they are their own root
+            collapses.clear();
+            for (UINT32 i = 0; i < numIndices; i += 3)
+            {
+                for (UINT32 j = 0; j < 3; j++)
+                {
+                    const UINT32 a = destination[i + j];
+                    const UINT32 b = destination[i + (j + 1) % 3];
+                    if (roots[a] == roots[b])
+                        continue;
+
+                    if (!locked[roots[a]])
+                        collapses.push_back({ a, b, CollapseCost(a, roots[b]) });
+
+                    if (!locked[roots[b]])
+                        collapses.push_back({ b, a, CollapseCost(b, roots[a]) });
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(),
+                [](const EdgeCollapse& a, const EdgeCollapse& b) { return a.Cost < b.Cost; });
+
+            // Each collapse removes two triangles on average. Collapses of a pass must not share any triangle, so the
+            // cost and validity of each one stays exact
+            const UINT32 maxCollapses = std::max(1U, (numIndices - targetIndexCount) / 6);
+            std::fill(touched.begin(), touched.end(), false);
+            collapsed.clear();
+
+            for (auto& collapse : collapses)
+            {
+                if (collapse.Cost > maxCost || (UINT32)collapsed.size() >= maxCollapses)
+                    break;
+
+                const UINT32 from = collapse.From;
+                const UINT32 to = roots[collapse.To];
+                if (touched[from] || touched[to])
+                    continue;
+
+                // Reject collapses flipping a remaining triangle, or rotating its normal by more than ~75 degrees
+                bool flips = false;
+                for (UINT32 i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1] && !flips; i++)
+                {
+                    const UINT32* triangle = &destination[adjacency[i] * 3];
+                    Vector3 before[3];
+                    Vector3 after[3];
+                    bool removed = false;
+
+                    for (UINT32 j = 0; j < 3; j++)
+                    {
+                        const UINT32 root = roots[triangle[j]];
+                        removed |= root == to;
+                        before[j] = vertices[root];
+                        after[j] = root == from ? vertices[to] : before[j];
+                    }
+
+                    if (removed)
+                        continue;
+
+                    const Vector3 normalBefore = Vector3::Cross(before[1] - before[0], before[2] - before[0]);
+                    const Vector3 normalAfter = Vector3::Cross(after[1] - after[0], after[2] - after[0]);
+                    flips = normalBefore.Dot(normalAfter) <= 0.25f * normalBefore.Length() * normalAfter.Length();
+                }
+
+                if (flips)
+                    continue;
+
+                collapseTargets[from] = collapse.To;
+                collapsed.push_back(from);
+                quadrics[to].Add(quadrics[from]);
+                maxCollapseCost = std::max(maxCollapseCost, collapse.Cost);
+
+                touched[to] = true;
+                for (UINT32 i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1]; i++)
+                {
+                    const UINT32* triangle = &destination[adjacency[i] * 3];
+                    for (UINT32 j = 0; j < 3; j++)
+                        touched[roots[triangle[j]]] = true;
+                }
+            }
+
+            if (collapsed.empty())
+                break;
+
+            UINT32 numKept = 0;
+            for (UINT32 i = 0; i < numIndices; i += 3)
+            {
+                UINT32 triangle[3];
+                for (UINT32 j = 0; j < 3; j++)
+                {
+                    const UINT32 idx = destination[i + j];
+                    triangle[j] = collapseTargets[idx] != (UINT32)-1 ? collapseTargets[idx] : idx;
+                }
+
+                const UINT32 a = roots[triangle[0]];
+                const UINT32 b = roots[triangle[1]];
+                const UINT32 c = roots[triangle[2]];
+                if (a == b || b == c || a == c)
+                    continue;
+
+                destination[numKept++] = triangle[0];
+                destination[numKept++] = triangle[1];
+                destination[numKept++] = triangle[2];
+            }
+
+            numIndices = numKept;
+
+            for (auto& vertex : collapsed)
+                collapseTargets[vertex] = (UINT32)-1;
+        }
+
+        if (resultError)
+            *resultError = std::sqrt(maxCollapseCost) * scale;
+
+        return numIndices;
+    }
+
+    SPtr<MeshData> MeshUtility::GenerateLods(const SPtr<MeshData>& meshData, Vector<SubMesh>& subMeshes,
+        const Vector<float>& reductionRatios, float maxError)
+    {
+        const SPtr<VertexDataDesc>& vertexDesc = meshData->GetVertexDesc();
+        const VertexElement* positionElement = vertexDesc->GetElement(VES_POSITION);
+        if (reductionRatios.empty() || !positionElement || positionElement->GetType() != VET_FLOAT3)
+            return meshData;
+
+        const UINT32 numVertices = meshData->GetNumVertices();
+        const UINT32 numIndices = meshData->GetNumIndices();
+        const IndexType indexType = meshData->GetIndexType();
+
+        Vector<UINT32> indices(numIndices);
+        if (indexType == IT_32BIT)
+            memcpy(indices.data(), meshData->GetIndices32(), numIndices * sizeof(UINT32));
+        else
+        {
+            const UINT16* src = meshData->GetIndices16();
+            for (UINT32 i = 0; i < numIndices; i++)
+                indices[i] = src[i];
+        }
+
+        const UINT8* positions = meshData->GetElementData(VES_POSITION, 0, positionElement->GetStreamIdx());
+        const UINT32 positionStride = vertexDesc->GetVertexStride(positionElement->GetStreamIdx());
+
+        // Errors are stored relative to the radius of the mesh bounds, so they can be projected on screen without
+        // knowing the scale the mesh is rendered at
+        Vector3 min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        Vector3 max = -min;
+        for (UINT32 i = 0; i < numVertices; i++)
+        {
+            const Vector3& position = *(const Vector3*)(positions + i * positionStride);
+            min = Vector3::Min(min, position);
+            max = Vector3::Max(max, position);
+        }
+
+        const float radius = numVertices > 0 ? (max - min).Length() * 0.5f : 0.0f;
+        if (radius <= 0.0f)
+            return meshData;
+
+        Vector<UINT32> lodIndices;
+        Vector<UINT32> simplified;
+
+        // Sub-meshes usually reference a small part of the vertices, so they are simplified in their own vertex space
+        Vector<UINT32> globalToLocal(numVertices, (UINT32)-1);
+        Vector<UINT32> localToGlobal;
+        Vector<UINT32> localIndices;
+        Vector<Vector3> localPositions;
+
+        for (auto& subMesh : subMeshes)
+        {
+            subMesh.Lods.clear();
+
+            const UINT32 subMeshIndexCount = (subMesh.IndexCount / 3) * 3;
+            if (subMesh.DrawOp != DOT_TRIANGLE_LIST || subMeshIndexCount < 3 ||
+                subMesh.IndexOffset + subMeshIndexCount > numIndices)
+            {
+                continue;
+            }
+
+            RemapToLocalVertices(&indices[subMesh.IndexOffset], subMeshIndexCount, globalToLocal, localToGlobal,
+                localIndices);
+
+            const UINT32 numLocalVertices = (UINT32)localToGlobal.size();
+            localPositions.resize(numLocalVertices);
+            for (UINT32 i = 0; i < numLocalVertices; i++)
+                localPositions[i] = *(const Vector3*)(positions + localToGlobal[i] * positionStride);
+
+            simplified.resize(subMeshIndexCount);
+            UINT32 prevIndexCount = subMeshIndexCount;
+
+            // Each level is simplified from the full detail sub-mesh, so errors don't accumulate from one level to the next
+            for (auto& ratio : reductionRatios)
+            {
+                const UINT32 targetIndexCount = (UINT32)(subMeshIndexCount * Math::Clamp01(ratio)) / 3 * 3;
+
+                float error = 0.0f;
+                const UINT32 count = Simplify(simplified.data(), localIndices.data(), subMeshIndexCount,
+                    (const UINT8*)localPositions.data(), numLocalVertices, sizeof(Vector3), targetIndexCount,
+                    maxError * radius, &error);
+
+                // Stop once the error limit prevents any further reduction
+                if (count == 0 || count >= prevIndexCount)
+                    break;
+
+                SubMeshLod lod;
+                lod.IndexOffset = numIndices + (UINT32)lodIndices.size();
+                lod.IndexCount = count;
+                lod.Error = error / radius;
+                subMesh.Lods.push_back(lod);
+
+                for (UINT32 i = 0; i < count; i++)
+                    lodIndices.push_back(localToGlobal[simplified[i]]);
+
+                prevIndexCount = count;
+            }
+        }
+
+        if (lodIndices.empty())
+            return meshData;
+
+        // Levels reuse the vertices of the full detail mesh, only indices are added
+        const UINT32 numOutputIndices = numIndices + (UINT32)lodIndices.size();
+        SPtr<MeshData> output = MeshData::Create(numVertices, numOutputIndices, vertexDesc, indexType);
+
+        indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+        if (indexType == IT_32BIT)
+            memcpy(output->GetIndices32(), indices.data(), numOutputIndices * sizeof(UINT32));
+        else
+        {
+            UINT16* dst = output->GetIndices16();
+            for (UINT32 i = 0; i < numOutputIndices; i++)
+                dst[i] = (UINT16)indices[i];
+        }
+
+        UINT32 numStreams = 0;
+        for (UINT32 i = 0; i < vertexDesc->GetNumElements(); i++)
+            numStreams = std::max(numStreams, (UINT32)vertexDesc->GetElement(i).GetStreamIdx() + 1);
+
+        for (UINT32 stream = 0; stream < numStreams; stream++)
+        {
+            const UINT32 stride = vertexDesc->GetVertexStride(stream);
+            if (stride == 0)
+                continue;
+
+            memcpy(output->GetStreamData(stream), meshData->GetStreamData(stream), numVertices * stride);
+        }
+
+        return output;
+    }
+
+    SPtr<MeshData> MeshUtility::QuantizeVertices(const SPtr<MeshData>& meshData)
+    {
+        const SPtr<VertexDataDesc>& vertexDesc = meshData->GetVertexDesc();
+        const VertexElement* positionElement = vertexDesc->GetElement(VES_POSITION);
+        const VertexElement* normalElement = vertexDesc->GetElement(VES_NORMAL);
+        const VertexElement* tangentElement = vertexDesc->GetElement(VES_TANGENT);
+        const VertexElement* bitangentElement = vertexDesc->GetElement(VES_BITANGENT);
+
+        // The vertex shader decodes positions, normals and tangents together, so either all of them can be quantized,
+        // or the mesh is left as is
+        if (!positionElement || positionElement->GetType() != VET_FLOAT3)
+            return meshData;
+
+        if (normalElement && normalElement->GetType() != VET_FLOAT3)
+            return meshData;
+
+        if (tangentElement && tangentElement->GetType() != VET_FLOAT3 && tangentElement->GetType() != VET_FLOAT4)
+            return meshData;
+
+        const UINT32 numVertices = meshData->GetNumVertices();
+        const UINT32 numIndices = meshData->GetNumIndices();
+
+        auto GetElementData = [&](const VertexElement* element, UINT32& stride) -> const UINT8*
+        {
+            stride = vertexDesc->GetVertexStride(element->GetStreamIdx());
+            return meshData->GetElementData(element->GetSemantic(), element->GetSemanticIdx(), element->GetStreamIdx());
+        };
+
+        auto GetQuantizedType = [&](const VertexElement& element)
+        {
+            if (&element == positionElement)
+                return VET_SHORT4_NORM;
+
+            if (&element == normalElement || &element == tangentElement)
+                return VET_SHORT2_NORM;
+
+            if (element.GetSemantic() == VES_TEXCOORD && element.GetType() == VET_FLOAT2)
+                return VET_HALF2;
+
+            if ((element.GetSemantic() == VES_COLOR || element.GetSemantic() == VES_BLEND_WEIGHTS) &&
+                element.GetType() == VET_FLOAT4)
+            {
+                return VET_UBYTE4_NORM;
+            }
+
+            return element.GetType();
+        };
+
+        // Bitangents aren't stored, the vertex shader rebuilds them from the normal and tangent, and the handedness stored
+        // in the fourth position component
+        SPtr<VertexDataDesc> outputDesc = VertexDataDesc::Create();
+        for (UINT32 i = 0; i < vertexDesc->GetNumElements(); i++)
+        {
+            const VertexElement& element = vertexDesc->GetElement(i);
+            if (element.GetSemantic() == VES_BITANGENT)
+                continue;
+
+            outputDesc->AddVertElem(GetQuantizedType(element), element.GetSemantic(), element.GetSemanticIdx(),
+                element.GetStreamIdx(), element.GetInstanceStepRate());
+        }
+
+        // Positions are quantized relative to the bounds of the whole mesh, as sub-meshes share a single vertex buffer
+        UINT32 positionStride = 0;
+        const UINT8* positions = GetElementData(positionElement, positionStride);
+
+        Vector3 min = numVertices > 0 ? *(const Vector3*)positions : Vector3::ZERO;
+        Vector3 max = min;
+        for (UINT32 i = 1; i < numVertices; i++)
+        {
+            const Vector3& position = *(const Vector3*)(positions + i * positionStride);
+            min = Vector3::Min(min, position);
+            max = Vector3::Max(max, position);
+        }
+
+        const Vector3 offset = (min + max) * 0.5f;
+        Vector3 scale = (max - min) * 0.5f;
+        for (UINT32 i = 0; i < 3; i++)
+        {
+            if (scale[i] <= 0.0f)
+                scale[i] = 1.0f;
+        }
+
+        SPtr<MeshData> output = MeshData::Create(numVertices, numIndices, outputDesc, meshData->GetIndexType());
+        output->SetPositionQuantization(scale, offset);
+        memcpy(output->GetIndexData(), meshData->GetIndexData(), meshData->GetIndexBufferSize());
+
+        UINT32 normalStride = 0;
+        UINT32 tangentStride = 0;
+        UINT32 bitangentStride = 0;
+        const UINT8* normals = normalElement ? GetElementData(normalElement, normalStride) : nullptr;
+        const UINT8* tangents = tangentElement ? GetElementData(tangentElement, tangentStride) : nullptr;
+        const UINT8* bitangents = bitangentElement ? GetElementData(bitangentElement, bitangentStride) : nullptr;
+
+        for (UINT32 i = 0; i < vertexDesc->GetNumElements(); i++)
+        {
+            const VertexElement& element = vertexDesc->GetElement(i);
+            if (element.GetSemantic() == VES_BITANGENT)
+                continue;
+
+            UINT32 srcStride = 0;
+            const UINT8* src = GetElementData(&element, srcStride);
+
+            const UINT32 dstStride = outputDesc->GetVertexStride(element.GetStreamIdx());
+            UINT8* dst = output->GetElementData(element.GetSemantic(), element.GetSemanticIdx(), element.GetStreamIdx());
+
+            const VertexElementType type = GetQuantizedType(element);
+            for (UINT32 j = 0; j < numVertices; j++, src += srcStride, dst += dstStride)
+            {
+                if (&element == positionElement)
+                {
+                    const Vector3 position = (*(const Vector3*)src - offset) / scale;
+
+                    // Handedness of the tangent frame, from the bitangent if any, or from the tangent's fourth component
+                    float sign = 1.0f;
+                    if (normals && tangents && bitangents)
+                    {
+                        const Vector3& normal = *(const Vector3*)(normals + j * normalStride);
+                        const Vector3& tangent = *(const Vector3*)(tangents + j * tangentStride);
+                        const Vector3& bitangent = *(const Vector3*)(bitangents + j * bitangentStride);
+
+                        if (Vector3::Dot(Vector3::Cross(normal, tangent), bitangent) < 0.0f)
+                            sign = -1.0f;
+                    }
+                    else if (tangents && tangentElement->GetType() == VET_FLOAT4)
+                    {
+                        if (((const Vector4*)(tangents + j * tangentStride))->w < 0.0f)
+                            sign = -1.0f;
+                    }
+
+                    INT16* packed = (INT16*)dst;
+                    packed[0] = PackSnorm16(position.x);
+                    packed[1] = PackSnorm16(position.y);
+                    packed[2] = PackSnorm16(position.z);
+                    packed[3] = PackSnorm16(sign);
+                }
+                else if (type == VET_SHORT2_NORM)
+                {
+                    const Vector2 encoded = EncodeOctahedral(Vector3::Normalize(*(const Vector3*)src));
+
+                    INT16* packed = (INT16*)dst;
+                    packed[0] = PackSnorm16(encoded.x);
+                    packed[1] = PackSnorm16(encoded.y);
+                }
+                else if (type == VET_HALF2)
+                {
+                    const Vector2& uv = *(const Vector2*)src;
+
+                    UINT16* packed = (UINT16*)dst;
+                    packed[0] = Bitwise::FloatToHalf(uv.x);
+                    packed[1] = Bitwise::FloatToHalf(uv.y);
+                }
+                else if (type == VET_UBYTE4_NORM && element.GetSemantic() == VES_BLEND_WEIGHTS)
+                {
+                    const float* weights = (const float*)src;
+                    UINT8* packed = dst;
+
+                    // Rounding errors go to the largest weight, so the weights still add up to one
+                    INT32 sum = 0;
+                    UINT32 largest = 0;
+                    for (UINT32 k = 0; k < 4; k++)
+                    {
+                        packed[k] = PackUnorm8(weights[k]);
+                        sum += packed[k];
+
+                        if (weights[k] > weights[largest])
+                            largest = k;
+                    }
+
+                    if (sum > 0)
+                        packed[largest] = (UINT8)Math::Clamp(packed[largest] + 255 - sum, 0, 255);
+                }
+                else if (type == VET_UBYTE4_NORM)
+                {
+                    const Vector4& color = *(const Vector4*)src;
+                    dst[0] = PackUnorm8(color.x);
+                    dst[1] = PackUnorm8(color.y);
+                    dst[2] = PackUnorm8(color.z);
+                    dst[3] = PackUnorm8(color.w);
+                }
+                else
+                    memcpy(dst, src, element.GetSize());
+            }
+        }
+
+        return output;
+    }
 }
@@ -75,6 +75,19 @@ namespace te
         UINT32* _faces;
     };
 
+    /** Describes how efficiently an index buffer uses the post-transform vertex cache. */
+    struct VertexCacheStatistics
+    {
+        /** Number of vertices the vertex shader has to process. */
+        UINT32 VerticesTransformed = 0;
+
+        /** Average cache miss ratio, number of transformed vertices per triangle. Ranges from 0.5 to 3. */
+        float ACMR = 0.0f;
+
+        /** Average transform to vertex ratio, number of transformed vertices per referenced vertex. 1 is optimal. */
+        float ATVR = 0.0f;
+    };
+
     /** Performs various operations on mesh geometry. */
     class TE_CORE_EXPORT MeshUtility
     {
@@ -149,5 +162,116 @@ namespace te
          */
         static void CalculateTangentSpace(Vector3* vertices, Vector2* uv, UINT8* indices, UINT32 numVertices,
             UINT32 numIndices, Vector3* normals, Vector3* tangents, Vector3* bitangents, UINT32 indexSize = 4);
+
+        /**
+         * Reorders triangles of a triangle list so vertices are reused as much as possible from the post-transform
+         * vertex cache, using Tom Forsyth's linear-speed vertex cache optimisation.
+         *
+         * @param[in, out]	indices		Indices of the triangle list to reorder.
+         * @param[in]	numIndices		Number of indices in the @p indices array. Must be a multiple of three.
+         * @param[in]	numVertices		Number of vertices referenced by @p indices.
+         */
+        static void OptimizeVertexCache(UINT32* indices, UINT32 numIndices, UINT32 numVertices);
+
+        /**
+         * Reorders clusters of triangles so the ones most likely to occlude the rest of the mesh are drawn first,
+         * reducing overdraw. Expects triangles already optimized with OptimizeVertexCache(), as clusters are cut where
+         * vertex cache efficiency allows it.
+         *
+         * @param[in, out]	indices		Indices of the triangle list to reorder.
+         * @param[in]	numIndices		Number of indices in the @p indices array. Must be a multiple of three.
+         * @param[in]	positions		Vertex positions, as three floats.
+         * @param[in]	numVertices		Number of vertices in the @p positions array.
+         * @param[in]	positionStride	Number of bytes between two positions.
+         * @param[in]	threshold		Maximum degradation of the vertex cache miss ratio allowed, relative to the
+         *								input order. Larger values create more clusters and remove more overdraw.
+         */
+        static void OptimizeOverdraw(UINT32* indices, UINT32 numIndices, const UINT8* positions, UINT32 numVertices,
+            UINT32 positionStride, float threshold = 1.05f);
+
+        /**
+         * Renumbers vertices in the order they are first referenced by the indices, so vertex fetches are as linear as
+         * possible. Vertices that are never referenced are removed.
+         *
+         * @param[in, out]	indices		Indices to renumber.
+         * @param[in]	numIndices		Number of indices in the @p indices array.
+         * @param[in]	numVertices		Number of vertices referenced by @p indices.
+         * @param[out]	remap			Pre-allocated buffer of @p numVertices entries, receiving the new index of each
+         *								vertex, or -1 for removed ones.
+         * @return						Number of vertices remaining.
+         */
+        static UINT32 OptimizeVertexFetch(UINT32* indices, UINT32 numIndices, UINT32 numVertices, UINT32* remap);
+
+        /**
+         * Simulates a FIFO post-transform vertex cache of the provided size in order to measure the efficiency of a
+         * triangle list.
+         */
+        static VertexCacheStatistics AnalyzeVertexCache(const UINT32* indices, UINT32 numIndices, UINT32 numVertices,
+            UINT32 cacheSize = 16);
+
+        /**
+         * Runs vertex cache, overdraw and vertex fetch optimizations on all triangle list sub-meshes of the provided
+         * mesh, and on their levels of detail. Triangles never move from one sub-mesh to another, so sub-meshes remain
+         * valid.
+         *
+         * @param[in]	meshData	Mesh to optimize.
+         * @param[in]	subMeshes	Sub-meshes of @p meshData.
+         * @param[out]	before		Optional statistics of the input mesh.
+         * @param[out]	after		Optional statistics of the output mesh.
+         * @return					Optimized mesh, with unused vertices removed.
+         */
+        static SPtr<MeshData> OptimizeMesh(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+            VertexCacheStatistics* before = nullptr, VertexCacheStatistics* after = nullptr);
+
+        /**
+         * Reduces the number of triangles of a triangle list by collapsing edges onto one of their vertices, cheapest
+         * first according to quadric error metrics. Vertices are never moved or created, so the output uses the same
+         * vertex buffer as the input. Vertices on mesh borders and on attribute seams (multiple vertices sharing a
+         * position) are never removed, so the silhouette and texture mapping are preserved.
+         *
+         * @param[out]	destination			Pre-allocated buffer of @p numIndices entries receiving the simplified indices.
+         * @param[in]	indices				Indices of the triangle list to simplify.
+         * @param[in]	numIndices			Number of indices in the @p indices array. Must be a multiple of three.
+         * @param[in]	positions			Vertex positions, as three floats.
+         * @param[in]	numVertices			Number of vertices in the @p positions array.
+         * @param[in]	positionStride		Number of bytes between two positions.
+         * @param[in]	targetIndexCount	Number of indices to reduce the triangle list to.
+         * @param[in]	targetError			Largest distance, in the same unit as @p positions, the simplified surface may
+         *									deviate from the original one. Simplification stops before reaching
+         *									@p targetIndexCount if no collapse within this error remains.
+         * @param[out]	resultError			Optional largest error introduced by the performed collapses.
+         * @return							Number of indices written to @p destination.
+         */
+        static UINT32 Simplify(UINT32* destination, const UINT32* indices, UINT32 numIndices, const UINT8* positions,
+            UINT32 numVertices, UINT32 positionStride, UINT32 targetIndexCount, float targetError,
+            float* resultError = nullptr);
+
+        /**
+         * Generates simplified levels of detail for all triangle list sub-meshes of the provided mesh. Indices of each
+         * level are appended to the index buffer, and the levels are added to SubMesh::Lods, so they are drawn using
+         * the vertices of the full detail mesh.
+         *
+         * @param[in]		meshData		Mesh to generate levels of detail for.
+         * @param[in, out]	subMeshes		Sub-meshes of @p meshData. Receive the generated levels.
+         * @param[in]		reductionRatios	Fraction of the triangles of each sub-mesh kept by each level, from the most
+         *									to the least detailed.
+         * @param[in]		maxError		Largest error a level may introduce, relative to the radius of the mesh bounds.
+         *									Levels that can't be simplified further within it are skipped.
+         * @return							Mesh containing the indices of all levels, or @p meshData if no level could
+         *									be generated.
+         */
+        static SPtr<MeshData> GenerateLods(const SPtr<MeshData>& meshData, Vector<SubMesh>& subMeshes,
+            const Vector<float>& reductionRatios, float maxError);
+
+        /**
+         * Converts the vertices of the provided mesh to compact formats: positions to 16-bit normalized integers relative
+         * to the mesh bounds, normals and tangents to 16-bit octahedral encoding, texture coordinates to half floats, and
+         * colors and bone weights to 8-bit normalized integers. Bitangents are dropped, their handedness is kept in the
+         * fourth position component. The vertex shader decodes the vertices, see MeshData::IsQuantized().
+         *
+         * @param[in]	meshData	Mesh to quantize. Must store positions, normals and tangents as floats.
+         * @return					Quantized mesh, or @p meshData if its vertex format isn't supported.
+         */
+        static SPtr<MeshData> QuantizeVertices(const SPtr<MeshData>& meshData);
     };
 }
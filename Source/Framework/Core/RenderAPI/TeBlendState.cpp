@@ -111,4 +111,25 @@ namespace te
     {
         return RenderStateManager::Instance().CreateBlendState(desc);
     }
+
+    UINT64 BlendState::GenerateHash(const BLEND_STATE_DESC& desc)
+    {
+        size_t hash = 0;
+        te_hash_combine(hash, desc.AlphaToCoverageEnable);
+        te_hash_combine(hash, desc.IndependantBlendEnable);
+
+        for (UINT32 i = 0; i < TE_MAX_MULTIPLE_RENDER_TARGETS; i++)
+        {
+            te_hash_combine(hash, desc.RenderTargetDesc[i].BlendEnable);
+            te_hash_combine(hash, desc.RenderTargetDesc[i].SrcBlend);
+            te_hash_combine(hash, desc.RenderTargetDesc[i].DstBlend);
+            te_hash_combine(hash, desc.RenderTargetDesc[i].BlendOp);
+            te_hash_combine(hash, desc.RenderTargetDesc[i].SrcBlendAlpha);
+            te_hash_combine(hash, desc.RenderTargetDesc[i].DstBlendAlpha);
+            te_hash_combine(hash, desc.RenderTargetDesc[i].BlendOpAlpha);
+            te_hash_combine(hash, desc.RenderTargetDesc[i].RenderTargetWriteMask);
+        }
+
+        return (UINT64)hash;
+    }
 }
@@ -154,6 +154,9 @@ namespace te
         /**	Returns the default blend state that you may use when no other is available. */
         static const SPtr<BlendState>& GetDefault();
 
+        /**	Generates a hash value from a blend state descriptor. */
+        static UINT64 GenerateHash(const BLEND_STATE_DESC& desc);
+
     protected:
         friend class RenderStateManager;
 
@@ -0,0 +1,316 @@
+#include "RenderAPI/TeCommandBuffer.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Alignment of every command in the command memory. */
+        constexpr UINT32 COMMAND_ALIGNMENT = 8;
+
+        struct SetGpuParamsData
+        {
+            UINT32 GpuParamsIdx;
+            UINT32 BindFlags;
+            UINT32 BlockBindFlags;
+            UINT32 ParamBlockListIdx;
+        };
+
+        struct ObjectData
+        {
+            UINT32 ObjectIdx;
+        };
+
+        struct SetViewportData
+        {
+            Rect2 Area;
+        };
+
+        struct SetScissorRectData
+        {
+            UINT32 Left;
+            UINT32 Top;
+            UINT32 Right;
+            UINT32 Bottom;
+        };
+
+        struct ValueData
+        {
+            UINT32 Value;
+        };
+
+        struct SetVertexBuffersData
+        {
+            UINT32 Index;
+            UINT32 FirstBufferIdx;
+            UINT32 NumBuffers;
+        };
+
+        struct DrawData
+        {
+            UINT32 VertexOffset;
+            UINT32 VertexCount;
+            UINT32 InstanceCount;
+        };
+
+        struct DrawIndexedData
+        {
+            UINT32 StartIndex;
+            UINT32 IndexCount;
+            UINT32 VertexOffset;
+            UINT32 VertexCount;
+            UINT32 InstanceCount;
+        };
+
+        struct DispatchComputeData
+        {
+            UINT32 NumGroupsX;
+            UINT32 NumGroupsY;
+            UINT32 NumGroupsZ;
+        };
+
+        constexpr UINT32 AlignCommandSize(UINT32 size)
+        {
+            return (size + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1);
+        }
+    }
+
+    template<class T>
+    T* CommandBuffer::Allocate(CommandType type)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Command data must be trivially copyable.");
+        static_assert(alignof(T) <= COMMAND_ALIGNMENT, "Command data alignment is too large.");
+
+        constexpr UINT32 headerSize = AlignCommandSize((UINT32)sizeof(Command));
+        constexpr UINT32 commandSize = headerSize + AlignCommandSize((UINT32)sizeof(T));
+
+        const size_t offset = _commands.size();
+        _commands.resize(offset + commandSize);
+        _numCommands++;
+
+        UINT8* data = _commands.data() + offset;
+        Command* command = new (data) Command();
+        command->Type = type;
+        command->Size = commandSize;
+
+        return new (data + headerSize) T();
+    }
+
+    void CommandBuffer::SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+        UINT32 gpuParamsBlockBindFlags, const Vector<String>& paramBlocksToBind)
+    {
+        SetGpuParamsData* data = Allocate<SetGpuParamsData>(CommandType::SetGpuParams);
+        data->GpuParamsIdx = (UINT32)_gpuParams.size();
+        data->BindFlags = gpuParamsBindFlags;
+        data->BlockBindFlags = gpuParamsBlockBindFlags;
+        data->ParamBlockListIdx = FindOrAddParamBlockList(paramBlocksToBind);
+
+        _gpuParams.push_back(gpuParams);
+    }
+
+    void CommandBuffer::SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState)
+    {
+        ObjectData* data = Allocate<ObjectData>(CommandType::SetGraphicsPipeline);
+        data->ObjectIdx = (UINT32)_graphicsPipelines.size();
+
+        _graphicsPipelines.push_back(pipelineState);
+    }
+
+    void CommandBuffer::SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState)
+    {
+        ObjectData* data = Allocate<ObjectData>(CommandType::SetComputePipeline);
+        data->ObjectIdx = (UINT32)_computePipelines.size();
+
+        _computePipelines.push_back(pipelineState);
+    }
+
+    void CommandBuffer::SetViewport(const Rect2& area)
+    {
+        SetViewportData* data = Allocate<SetViewportData>(CommandType::SetViewport);
+        data->Area = area;
+    }
+
+    void CommandBuffer::SetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom)
+    {
+        SetScissorRectData* data = Allocate<SetScissorRectData>(CommandType::SetScissorRect);
+        data->Left = left;
+        data->Top = top;
+        data->Right = right;
+        data->Bottom = bottom;
+    }
+
+    void CommandBuffer::SetStencilRef(UINT32 value)
+    {
+        ValueData* data = Allocate<ValueData>(CommandType::SetStencilRef);
+        data->Value = value;
+    }
+
+    void CommandBuffer::SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
+    {
+        SetVertexBuffersData* data = Allocate<SetVertexBuffersData>(CommandType::SetVertexBuffers);
+        data->Index = index;
+        data->FirstBufferIdx = (UINT32)_vertexBuffers.size();
+        data->NumBuffers = numBuffers;
+
+        // Buffers are stored consecutively so replay can hand them over as a single array
+        for (UINT32 i = 0; i < numBuffers; i++)
+            _vertexBuffers.push_back(buffers[i]);
+    }
+
+    void CommandBuffer::SetIndexBuffer(const SPtr<IndexBuffer>& buffer)
+    {
+        ObjectData* data = Allocate<ObjectData>(CommandType::SetIndexBuffer);
+        data->ObjectIdx = (UINT32)_indexBuffers.size();
+
+        _indexBuffers.push_back(buffer);
+    }
+
+    void CommandBuffer::SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration)
+    {
+        ObjectData* data = Allocate<ObjectData>(CommandType::SetVertexDeclaration);
+        data->ObjectIdx = (UINT32)_vertexDeclarations.size();
+
+        _vertexDeclarations.push_back(vertexDeclaration);
+    }
+
+    void CommandBuffer::SetDrawOperation(DrawOperationType op)
+    {
+        ValueData* data = Allocate<ValueData>(CommandType::SetDrawOperation);
+        data->Value = (UINT32)op;
+    }
+
+    void CommandBuffer::Draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount)
+    {
+        DrawData* data = Allocate<DrawData>(CommandType::Draw);
+        data->VertexOffset = vertexOffset;
+        data->VertexCount = vertexCount;
+        data->InstanceCount = instanceCount;
+    }
+
+    void CommandBuffer::DrawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+        UINT32 instanceCount)
+    {
+        DrawIndexedData* data = Allocate<DrawIndexedData>(CommandType::DrawIndexed);
+        data->StartIndex = startIndex;
+        data->IndexCount = indexCount;
+        data->VertexOffset = vertexOffset;
+        data->VertexCount = vertexCount;
+        data->InstanceCount = instanceCount;
+    }
+
+    void CommandBuffer::DispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ)
+    {
+        DispatchComputeData* data = Allocate<DispatchComputeData>(CommandType::DispatchCompute);
+        data->NumGroupsX = numGroupsX;
+        data->NumGroupsY = numGroupsY;
+        data->NumGroupsZ = numGroupsZ;
+    }
+
+    void CommandBuffer::Replay(RenderAPI& rapi) const
+    {
+        constexpr UINT32 headerSize = AlignCommandSize((UINT32)sizeof(Command));
+
+        const UINT8* cur = _commands.data();
+        const UINT8* end = cur + _commands.size();
+        while (cur < end)
+        {
+            const Command* command = reinterpret_cast<const Command*>(cur);
+            const UINT8* data = cur + headerSize;
+
+            switch (command->Type)
+            {
+            case CommandType::SetGpuParams:
+            {
+                const SetGpuParamsData* params = reinterpret_cast<const SetGpuParamsData*>(data);
+                rapi.SetGpuParams(_gpuParams[params->GpuParamsIdx], params->BindFlags, params->BlockBindFlags,
+                    _paramBlockLists[params->ParamBlockListIdx]);
+            }
+            break;
+            case CommandType::SetGraphicsPipeline:
+                rapi.SetGraphicsPipeline(_graphicsPipelines[reinterpret_cast<const ObjectData*>(data)->ObjectIdx]);
+                break;
+            case CommandType::SetComputePipeline:
+                rapi.SetComputePipeline(_computePipelines[reinterpret_cast<const ObjectData*>(data)->ObjectIdx]);
+                break;
+            case CommandType::SetViewport:
+                rapi.SetViewport(reinterpret_cast<const SetViewportData*>(data)->Area);
+                break;
+            case CommandType::SetScissorRect:
+            {
+                const SetScissorRectData* params = reinterpret_cast<const SetScissorRectData*>(data);
+                rapi.SetScissorRect(params->Left, params->Top, params->Right, params->Bottom);
+            }
+            break;
+            case CommandType::SetStencilRef:
+                rapi.SetStencilRef(reinterpret_cast<const ValueData*>(data)->Value);
+                break;
+            case CommandType::SetVertexBuffers:
+            {
+                const SetVertexBuffersData* params = reinterpret_cast<const SetVertexBuffersData*>(data);
+                SPtr<VertexBuffer>* buffers = const_cast<SPtr<VertexBuffer>*>(&_vertexBuffers[params->FirstBufferIdx]);
+                rapi.SetVertexBuffers(params->Index, buffers, params->NumBuffers);
+            }
+            break;
+            case CommandType::SetIndexBuffer:
+                rapi.SetIndexBuffer(_indexBuffers[reinterpret_cast<const ObjectData*>(data)->ObjectIdx]);
+                break;
+            case CommandType::SetVertexDeclaration:
+                rapi.SetVertexDeclaration(_vertexDeclarations[reinterpret_cast<const ObjectData*>(data)->ObjectIdx]);
+                break;
+            case CommandType::SetDrawOperation:
+                rapi.SetDrawOperation((DrawOperationType)reinterpret_cast<const ValueData*>(data)->Value);
+                break;
+            case CommandType::Draw:
+            {
+                const DrawData* params = reinterpret_cast<const DrawData*>(data);
+                rapi.Draw(params->VertexOffset, params->VertexCount, params->InstanceCount);
+            }
+            break;
+            case CommandType::DrawIndexed:
+            {
+                const DrawIndexedData* params = reinterpret_cast<const DrawIndexedData*>(data);
+                rapi.DrawIndexed(params->StartIndex, params->IndexCount, params->VertexOffset, params->VertexCount,
+                    params->InstanceCount);
+            }
+            break;
+            case CommandType::DispatchCompute:
+            {
+                const DispatchComputeData* params = reinterpret_cast<const DispatchComputeData*>(data);
+                rapi.DispatchCompute(params->NumGroupsX, params->NumGroupsY, params->NumGroupsZ);
+            }
+            break;
+            default:
+                TE_ASSERT_ERROR(false, "Unknown command type.");
+                break;
+            }
+
+            cur += command->Size;
+        }
+    }
+
+    void CommandBuffer::Reset()
+    {
+        _commands.clear();
+        _numCommands = 0;
+
+        _gpuParams.clear();
+        _graphicsPipelines.clear();
+        _computePipelines.clear();
+        _vertexBuffers.clear();
+        _indexBuffers.clear();
+        _vertexDeclarations.clear();
+        _paramBlockLists.clear();
+    }
+
+    UINT32 CommandBuffer::FindOrAddParamBlockList(const Vector<String>& paramBlocksToBind)
+    {
+        // Renderers use a handful of distinct lists, so a linear search is cheaper than hashing the names
+        for (UINT32 i = 0; i < (UINT32)_paramBlockLists.size(); i++)
+        {
+            if (_paramBlockLists[i] == paramBlocksToBind)
+                return i;
+        }
+
+        _paramBlockLists.push_back(paramBlocksToBind);
+        return (UINT32)_paramBlockLists.size() - 1;
+    }
+}
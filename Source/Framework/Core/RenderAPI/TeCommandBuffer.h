@@ -0,0 +1,130 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "RenderAPI/TeRenderAPI.h"
+#include "Math/TeRect2.h"
+
+namespace te
+{
+    /**
+     * Records rendering commands for later execution through RenderAPI::ExecuteCommands(). Methods mirror their
+     * RenderAPI counterparts, so code can be written once and used with either of them.
+     *
+     * Commands are stored as small fixed size records in a single linear block of memory. Objects referenced by the
+     * commands are kept alive by the buffer until Reset() is called, so recording does not require any synchronization
+     * and separate buffers can be recorded from separate threads in parallel. The buffer itself is not thread safe.
+     *
+     * @note	Only state and draw commands are supported. Render targets must be bound, and cleared, on the RenderAPI
+     *			before the buffer is executed.
+     */
+    class TE_CORE_EXPORT CommandBuffer
+    {
+    public:
+        CommandBuffer() = default;
+        ~CommandBuffer() = default;
+
+        /** @copydoc RenderAPI::SetGpuParams */
+        void SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags = (UINT32)GPU_BIND_ALL,
+            UINT32 gpuParamsBlockBindFlags = (UINT32)GPU_BIND_PARAM_BLOCK_ALL, const Vector<String>& paramBlocksToBind = {});
+
+        /** @copydoc RenderAPI::SetGraphicsPipeline */
+        void SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState);
+
+        /** @copydoc RenderAPI::SetComputePipeline */
+        void SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState);
+
+        /** @copydoc RenderAPI::SetViewport */
+        void SetViewport(const Rect2& area);
+
+        /** @copydoc RenderAPI::SetScissorRect */
+        void SetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom);
+
+        /** @copydoc RenderAPI::SetStencilRef */
+        void SetStencilRef(UINT32 value);
+
+        /** @copydoc RenderAPI::SetVertexBuffers */
+        void SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers);
+
+        /** @copydoc RenderAPI::SetIndexBuffer */
+        void SetIndexBuffer(const SPtr<IndexBuffer>& buffer);
+
+        /** @copydoc RenderAPI::SetVertexDeclaration */
+        void SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration);
+
+        /** @copydoc RenderAPI::SetDrawOperation */
+        void SetDrawOperation(DrawOperationType op);
+
+        /** @copydoc RenderAPI::Draw */
+        void Draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount = 0);
+
+        /** @copydoc RenderAPI::DrawIndexed */
+        void DrawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount = 0);
+
+        /** @copydoc RenderAPI::DispatchCompute */
+        void DispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1);
+
+        /**
+         * Executes all recorded commands, in recording order, by calling the matching methods on the provided
+         * RenderAPI. This is the default implementation of RenderAPI::ExecuteCommands() and works with any backend.
+         */
+        void Replay(RenderAPI& rapi) const;
+
+        /**
+         * Removes all recorded commands and releases any objects they referenced. Allocated memory is kept, so a
+         * buffer that is reset and recorded every frame doesn't need to allocate once it reaches its working size.
+         */
+        void Reset();
+
+        /** Checks are there any recorded commands. */
+        bool IsEmpty() const { return _numCommands == 0; }
+
+        /** Returns the number of recorded commands. */
+        UINT32 GetNumCommands() const { return _numCommands; }
+
+    private:
+        enum class CommandType : UINT32
+        {
+            SetGpuParams,
+            SetGraphicsPipeline,
+            SetComputePipeline,
+            SetViewport,
+            SetScissorRect,
+            SetStencilRef,
+            SetVertexBuffers,
+            SetIndexBuffer,
+            SetVertexDeclaration,
+            SetDrawOperation,
+            Draw,
+            DrawIndexed,
+            DispatchCompute
+        };
+
+        /** Header shared by all commands. Command specific data follows immediately after it. */
+        struct Command
+        {
+            CommandType Type;
+            UINT32 Size; /**< Size of the full command in bytes, including the header. */
+        };
+
+        /**
+         * Appends a new command of the provided type to the command memory and returns a pointer to it. The pointer is
+         * only valid until the next command is allocated.
+         */
+        template<class T>
+        T* Allocate(CommandType type);
+
+        /** Returns the index of the provided parameter block name list, adding it to the buffer if it isn't present. */
+        UINT32 FindOrAddParamBlockList(const Vector<String>& paramBlocksToBind);
+
+        Vector<UINT8> _commands;
+        UINT32 _numCommands = 0;
+
+        Vector<SPtr<GpuParams>> _gpuParams;
+        Vector<SPtr<GraphicsPipelineState>> _graphicsPipelines;
+        Vector<SPtr<ComputePipelineState>> _computePipelines;
+        Vector<SPtr<VertexBuffer>> _vertexBuffers;
+        Vector<SPtr<IndexBuffer>> _indexBuffers;
+        Vector<SPtr<VertexDeclaration>> _vertexDeclarations;
+        Vector<Vector<String>> _paramBlockLists;
+    };
+}
@@ -197,7 +197,13 @@ namespace te
          */
         GBU_DYNAMIC = 1 << 1,
         /** Siginifies that the buffer can be used for arbitrary load/store operations on the GPU. Implies GBU_STATIC. */
-        GBU_LOADSTORE = GBU_STATIC | 1 << 2
+        GBU_LOADSTORE = GBU_STATIC | 1 << 2,
+        /**
+         * Signifies that the buffer is bound with every draw that uses it, so its contents can be sub-allocated from a
+         * shared upload buffer instead of living in their own buffer. Only relevant for parameter block buffers and
+         * ignored by render APIs that can't bind parts of a buffer. Implies GBU_DYNAMIC.
+         */
+        GBU_TRANSIENT = GBU_DYNAMIC | 1 << 3
     };
 
     /** Different types of GPU views that control how GPU sees a hardware buffer. */
@@ -49,4 +49,25 @@ namespace te
     {
         return RenderStateManager::Instance().CreateDepthStencilState(desc);
     }
+
+    UINT64 DepthStencilState::GenerateHash(const DEPTH_STENCIL_STATE_DESC& desc)
+    {
+        size_t hash = 0;
+        te_hash_combine(hash, desc.DepthReadEnable);
+        te_hash_combine(hash, desc.DepthWriteEnable);
+        te_hash_combine(hash, desc.DepthComparisonFunc);
+        te_hash_combine(hash, desc.StencilEnable);
+        te_hash_combine(hash, desc.StencilReadMask);
+        te_hash_combine(hash, desc.StencilWriteMask);
+        te_hash_combine(hash, desc.FrontStencilFailOp);
+        te_hash_combine(hash, desc.FrontStencilZFailOp);
+        te_hash_combine(hash, desc.FrontStencilPassOp);
+        te_hash_combine(hash, desc.FrontStencilComparisonFunc);
+        te_hash_combine(hash, desc.BackStencilFailOp);
+        te_hash_combine(hash, desc.BackStencilZFailOp);
+        te_hash_combine(hash, desc.BackStencilPassOp);
+        te_hash_combine(hash, desc.BackStencilComparisonFunc);
+
+        return (UINT64)hash;
+    }
 }
@@ -143,6 +143,9 @@ namespace te
 
         /** Returns the default depth stencil state that you may use when no other is available. */
         static const SPtr<DepthStencilState>& GetDefault();
+
+        /**	Generates a hash value from a depth-stencil state descriptor. */
+        static UINT64 GenerateHash(const DEPTH_STENCIL_STATE_DESC& desc);
     
     protected:
         friend class RenderStateManager;
@@ -76,6 +76,36 @@ namespace te
 
     void GpuParamBlockBuffer::FlushToGPU(UINT32 queueIdx)
     {
+        if (IsTransient())
+        {
+            // Regions are only valid until the upload buffer wraps around, after which contents need to be copied again
+            HardwareBufferManager& bufferManager = HardwareBufferManager::Instance();
+            if (!_GPUBufferDirty && _transientAllocation.Buffer != nullptr &&
+                _transientAllocation.Epoch == bufferManager.GetTransientEpoch())
+            {
+                return;
+            }
+
+            if (bufferManager.AllocateTransient(_cachedData, _size, _transientAllocation))
+            {
+                _GPUBufferDirty = false;
+                return;
+            }
+
+            // Falls back to the buffer's own hardware buffer, whose contents are out of date if a region was used before
+            if (_transientAllocation.Buffer != nullptr)
+            {
+                _transientAllocation = TransientAllocation();
+                _GPUBufferDirty = true;
+            }
+
+            if (_buffer == nullptr)
+            {
+                TE_ASSERT_ERROR(false, "Transient parameter block buffer of size " + ToString(_size) + " doesn't fit in the upload buffer.");
+                return;
+            }
+        }
+
         if (_GPUBufferDirty)
         {
             WriteToGPU(_cachedData, queueIdx);
@@ -5,11 +5,24 @@
 
 namespace te
 {
+    /** Region of the shared upload buffer holding the contents of a transient parameter block buffer. */
+    struct TransientAllocation
+    {
+        HardwareBuffer* Buffer = nullptr;
+        UINT32 Offset = 0;
+        UINT32 Size = 0;
+        UINT32 Epoch = 0; /**< Upload buffer epoch the region belongs to. See HardwareBufferManager::GetTransientEpoch(). */
+    };
+
     /**
      * Represents a GPU parameter block buffer. Parameter block buffers are bound to GPU programs which then fetch
      * parameters from those buffers.
      *
      * Writing or reading from this buffer will translate directly to API calls that update the GPU.
+     *
+     * Buffers created with GBU_TRANSIENT usage don't upload into a buffer of their own if the render API supports it.
+     * Their contents are instead copied into the shared upload buffer of the HardwareBufferManager, and the region they
+     * were copied to is bound in place of the buffer.
      */
     class TE_CORE_EXPORT GpuParamBlockBuffer : public CoreObject
     {
@@ -59,6 +72,15 @@ namespace te
         /**	Returns the size of the buffer in bytes. */
         UINT32 GetSize() const { return _size; }
 
+        /** Checks was the buffer created with GBU_TRANSIENT usage. */
+        bool IsTransient() const { return (_usage & GBU_TRANSIENT) == GBU_TRANSIENT; }
+
+        /**
+         * Returns the region of the shared upload buffer holding the most recently flushed contents. Region buffer is
+         * null if the contents live in the buffer's own hardware buffer.
+         */
+        const TransientAllocation& GetTransientAllocation() const { return _transientAllocation; }
+
         /** @copydoc HardwareBufferManager::CreateGpuParamBlockBuffer */
         static SPtr<GpuParamBlockBuffer> Create(UINT32 size, GpuBufferUsage usage = GBU_DYNAMIC,
             GpuDeviceFlags deviceMask = GDF_DEFAULT);
@@ -75,5 +97,6 @@ namespace te
         UINT32 _size;
         UINT8* _cachedData;
         bool _GPUBufferDirty = false;
+        TransientAllocation _transientAllocation;
     };
 }
@@ -17,6 +17,7 @@ namespace te
         String EntryPoint; /**< Name of the entry point function, for example "main". */
         String Language; /**< Language the source is written in, for example "hlsl" or "glsl". */
         String IncludePath; /**< For hlsl, you can specify an include path here */
+        Map<String, String> Defines; /**< Preprocessor defines (name, value) the source is compiled with. */
         GpuProgramType Type = GPT_VERTEX_PROGRAM; /**< Type of the program, for example vertex or pixel. */
         bool RequiresAdjacency = false; /**< If true then adjacency information will be provided when rendering. */
 
@@ -132,6 +133,7 @@ namespace te
         String _entryPoint;
         String _source;
         String _includePath;
+        Map<String, String> _defines;
         bool _needsAdjacencyInfo;
 
         SPtr<GpuParamDesc> _parametersDesc;
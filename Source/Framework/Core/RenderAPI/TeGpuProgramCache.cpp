@@ -0,0 +1,175 @@
+#include "RenderAPI/TeGpuProgramCache.h"
+#include "Utility/TeFileStream.h"
+#include "Utility/TeFileSystem.h"
+#include <filesystem>
+
+namespace te
+{
+    /** Identifies files written by GpuProgramCache. Bump the version whenever the file layout changes. */
+    static constexpr UINT32 CACHE_FILE_MAGIC = 0x43505454; // "TTPC"
+    static constexpr UINT32 CACHE_FILE_VERSION = 1;
+
+    /** Used to give temporary files written by concurrent Save() calls unique names. */
+    static std::atomic<UINT32> sNextTempFileIdx { 0 };
+
+    /** 64-bit FNV-1a. Unlike std::hash the result is stable across runs and standard library implementations. */
+    static UINT64 HashBytes(const void* data, size_t size, UINT64 hash = 0xcbf29ce484222325ULL)
+    {
+        const UINT8* bytes = (const UINT8*)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ULL;
+        }
+
+        return hash;
+    }
+
+    static UINT64 HashString(const String& value, UINT64 hash)
+    {
+        // Hash the length too, so consecutive strings can't be shifted into each other
+        const UINT64 length = (UINT64)value.size();
+        hash = HashBytes(&length, sizeof(length), hash);
+        return HashBytes(value.data(), value.size(), hash);
+    }
+
+    /** Hashes the contents of all files (recursively) included by @p source through #include "file" directives. */
+    static UINT64 HashIncludes(const String& source, const String& includePath, UnorderedSet<String>& visited,
+        UINT64 hash)
+    {
+        size_t pos = 0;
+        while ((pos = source.find("#include", pos)) != String::npos)
+        {
+            pos += 8; // strlen("#include")
+
+            const size_t lineEnd = source.find('\n', pos);
+            const size_t nameStart = source.find_first_of("\"<", pos);
+            if (nameStart == String::npos || (lineEnd != String::npos && nameStart > lineEnd))
+                continue;
+
+            const char closing = source[nameStart] == '"' ? '"' : '>';
+            const size_t nameEnd = source.find(closing, nameStart + 1);
+            if (nameEnd == String::npos || (lineEnd != String::npos && nameEnd > lineEnd))
+                continue;
+
+            const String fileName = source.substr(nameStart + 1, nameEnd - nameStart - 1);
+            if (!visited.insert(fileName).second)
+                continue;
+
+            const String filePath = includePath + fileName;
+            if (!FileSystem::Exists(filePath))
+            {
+                // Still hash the name, so a file appearing later changes the key
+                hash = HashString(fileName, hash);
+                continue;
+            }
+
+            FileStream file(filePath);
+            const String contents = file.GetAsString();
+
+            hash = HashString(fileName, hash);
+            hash = HashString(contents, hash);
+            hash = HashIncludes(contents, includePath, visited, hash);
+        }
+
+        return hash;
+    }
+
+    GpuProgramCache::GpuProgramCache(const String& folder)
+        : _folder(folder)
+    { }
+
+    UINT64 GpuProgramCache::ComputeKey(const GPU_PROGRAM_DESC& desc, const String& compilerSettings) const
+    {
+        UINT64 hash = HashBytes(&CACHE_FILE_VERSION, sizeof(CACHE_FILE_VERSION));
+        hash = HashString(compilerSettings, hash);
+        hash = HashString(desc.Language, hash);
+        hash = HashString(desc.EntryPoint, hash);
+
+        const UINT32 type = (UINT32)desc.Type;
+        hash = HashBytes(&type, sizeof(type), hash);
+        hash = HashString(desc.Source, hash);
+
+        for (auto& define : desc.Defines)
+        {
+            hash = HashString(define.first, hash);
+            hash = HashString(define.second, hash);
+        }
+
+        if (!desc.IncludePath.empty())
+        {
+            UnorderedSet<String> visited;
+            hash = HashIncludes(desc.Source, desc.IncludePath, visited, hash);
+        }
+
+        return hash;
+    }
+
+    bool GpuProgramCache::Load(UINT64 key, Vector<UINT8>& output) const
+    {
+        if (!_enabled)
+            return false;
+
+        const String path = GetPath(key);
+        if (!FileSystem::Exists(path))
+            return false;
+
+        FileStream file(path);
+        if (file.Fail())
+            return false;
+
+        UINT32 header[3];
+        if (file.Read(header, sizeof(header)) != sizeof(header))
+            return false;
+
+        if (header[0] != CACHE_FILE_MAGIC || header[1] != CACHE_FILE_VERSION || header[2] == 0)
+            return false;
+
+        output.resize(header[2]);
+        if (file.Read(output.data(), output.size()) != output.size())
+        {
+            output.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void GpuProgramCache::Save(UINT64 key, const UINT8* data, UINT32 size) const
+    {
+        if (!_enabled || data == nullptr || size == 0)
+            return;
+
+        std::error_code error;
+        std::filesystem::create_directories(_folder, error);
+
+        // Write to a temporary file first so a concurrent Load() (or a crash) never sees a partial binary
+        const String path = GetPath(key);
+        const String tempPath = path + "." + ToString(sNextTempFileIdx.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+
+        {
+            FileStream file(tempPath, FileStream::WRITE);
+            if (file.Fail())
+                return;
+
+            const UINT32 header[3] = { CACHE_FILE_MAGIC, CACHE_FILE_VERSION, size };
+            file.Write(header, sizeof(header));
+            file.Write(data, size);
+        }
+
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+            std::filesystem::remove(tempPath, error);
+    }
+
+    String GpuProgramCache::GetPath(UINT64 key) const
+    {
+        static const char* HEX_DIGITS = "0123456789abcdef";
+
+        String name(16, '0');
+        for (UINT32 i = 0; i < 16; i++)
+            name[15 - i] = HEX_DIGITS[(key >> (i * 4)) & 0xF];
+
+        return _folder + name + ".bin";
+    }
+}
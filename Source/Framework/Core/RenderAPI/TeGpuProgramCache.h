@@ -0,0 +1,53 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "RenderAPI/TeGpuProgram.h"
+
+namespace te
+{
+    /**
+     * Persistent on-disk cache of compiled GPU program binaries, so programs don't need to be recompiled on every launch.
+     * Binaries are keyed by a hash of the program source (including any files it includes) and of compiler settings
+     * provided by the render backend, so modifying a shader automatically invalidates its cached binary.
+     *
+     * @note	Thread safe.
+     */
+    class TE_CORE_EXPORT GpuProgramCache
+    {
+    public:
+        static constexpr const char* CACHE_FOLDER = "Cache/Shaders/";
+
+        GpuProgramCache(const String& folder = CACHE_FOLDER);
+
+        /** Enables or disables the cache. When disabled Load() always fails and Save() does nothing. */
+        void SetEnabled(bool enabled) { _enabled = enabled; }
+
+        /** Checks is the cache enabled. */
+        bool IsEnabled() const { return _enabled; }
+
+        /**
+         * Computes the key under which the binary of the provided program is stored.
+         *
+         * @param[in]	desc				Description of the program. Source, entry point, type and defines are
+         *									hashed, as are files referenced through quoted #include directives,
+         *									resolved relative to the include path.
+         * @param[in]	compilerSettings	Anything else that affects the output of the backend's compiler (compiler id,
+         *									profile, flags...).
+         */
+        UINT64 ComputeKey(const GPU_PROGRAM_DESC& desc, const String& compilerSettings) const;
+
+        /** Attempts to load the binary stored under the provided key. Returns false if there is none. */
+        bool Load(UINT64 key, Vector<UINT8>& output) const;
+
+        /** Stores the binary under the provided key, overwriting any previous binary. */
+        void Save(UINT64 key, const UINT8* data, UINT32 size) const;
+
+    private:
+        /** Returns the path to the file storing the binary with the provided key. */
+        String GetPath(UINT64 key) const;
+
+    private:
+        String _folder;
+        bool _enabled = true;
+    };
+}
@@ -51,6 +51,7 @@ namespace te
 
     GpuProgramManager::~GpuProgramManager()
     {
+        _variations.clear();
         te_delete((NullProgramFactory*)_nullFactory);
     }
 
@@ -106,4 +107,74 @@ namespace te
         GpuProgramFactory* factory = GetFactory(desc.Language);
         return factory->CompileBytecode(desc);
     }
+
+    SPtr<GpuProgram> GpuProgramManager::GetVariation(const GPU_PROGRAM_DESC& desc, const Vector<String>& permutationKeys,
+        UINT32 permutationMask)
+    {
+        TE_ASSERT_ERROR(permutationKeys.size() <= 32, "Programs can't have more than 32 permutation keys");
+
+        // Keys the program never mentions can't change its output, drop them so they don't create duplicate variations
+        UINT32 usedKeysMask = 0;
+        for (UINT32 i = 0; i < (UINT32)permutationKeys.size(); i++)
+        {
+            if (desc.Source.find(permutationKeys[i]) != String::npos)
+                usedKeysMask |= 1U << i;
+        }
+
+        permutationMask &= usedKeysMask;
+
+        GPU_PROGRAM_DESC variationDesc = desc;
+        variationDesc.Bytecode = nullptr;
+
+        for (UINT32 i = 0; i < (UINT32)permutationKeys.size(); i++)
+        {
+            if ((usedKeysMask & (1U << i)) != 0)
+                variationDesc.Defines[permutationKeys[i]] = (permutationMask & (1U << i)) != 0 ? "1" : "0";
+        }
+
+        // The hash only speeds up the lookup, two variations are the same program only if all their inputs are equal
+        VariationKey key = { variationDesc.Source, variationDesc.EntryPoint, variationDesc.Language,
+            variationDesc.IncludePath, variationDesc.Defines, variationDesc.Type, variationDesc.RequiresAdjacency, 0 };
+
+        te_hash_combine(key.Hash, key.Source);
+        te_hash_combine(key.Hash, key.EntryPoint);
+        te_hash_combine(key.Hash, key.Language);
+        te_hash_combine(key.Hash, key.IncludePath);
+        te_hash_combine(key.Hash, (UINT32)key.Type);
+        te_hash_combine(key.Hash, key.RequiresAdjacency);
+
+        for (auto& define : key.Defines)
+        {
+            te_hash_combine(key.Hash, define.first);
+            te_hash_combine(key.Hash, define.second);
+        }
+
+        // Only the first request compiles the variation, requests for it made during compilation wait for the result
+        std::promise<SPtr<GpuProgram>> promise;
+        {
+            Lock lock(_variationsMutex);
+
+            auto iterFind = _variations.find(key);
+            if (iterFind != _variations.end())
+            {
+                std::shared_future<SPtr<GpuProgram>> variation = iterFind->second;
+                lock.unlock();
+
+                return variation.get();
+            }
+
+            _variations[std::move(key)] = promise.get_future().share();
+        }
+
+        SPtr<GpuProgram> program = Create(variationDesc);
+        promise.set_value(program);
+
+        return program;
+    }
+
+    UINT32 GpuProgramManager::GetNumVariations() const
+    {
+        Lock lock(_variationsMutex);
+        return (UINT32)_variations.size();
+    }
 }
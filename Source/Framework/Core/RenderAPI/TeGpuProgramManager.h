@@ -2,7 +2,10 @@
 
 #include "TeCorePrerequisites.h"
 #include "Utility/TeModule.h"
+#include "Threading/TeThreading.h"
 #include "RenderAPI/TeGpuProgram.h"
+#include "RenderAPI/TeGpuProgramCache.h"
+#include <future>
 
 namespace te
 {
@@ -59,6 +62,27 @@ namespace te
         /** @copydoc GpuProgram::compileBytecode */
         SPtr<GpuProgramBytecode> CompileBytecode(const GPU_PROGRAM_DESC& desc);
 
+        /**
+         * Returns a variation of the provided program, specialized by defining each of the permutation keys to 1 if its
+         * bit is set in the permutation mask, and to 0 otherwise. A variation is only built the first time it is
+         * requested, after which it is shared by everyone requesting the same program with the same mask. Keys that
+         * don't appear in the program source are ignored, so programs that don't depend on them aren't duplicated.
+         * Thread safe.
+         *
+         * @param[in]	desc				Description of the program all the variations are created from.
+         * @param[in]	permutationKeys		Names of the permutation keys, the n-th key is controlled by the n-th bit of
+         *									@p permutationMask. At most 32 keys are supported.
+         * @param[in]	permutationMask		Mask of the keys that are enabled in the requested variation.
+         */
+        SPtr<GpuProgram> GetVariation(const GPU_PROGRAM_DESC& desc, const Vector<String>& permutationKeys,
+            UINT32 permutationMask);
+
+        /** Returns the number of program variations built so far. */
+        UINT32 GetNumVariations() const;
+
+        /** Returns the on-disk cache render backends can use to avoid recompiling programs between launches. */
+        GpuProgramCache& GetProgramCache() { return _programCache; }
+
     protected:
         friend class GpuProgram;
 
@@ -72,9 +96,45 @@ namespace te
         /** Attempts to find a factory for the specified language. Returns null if it cannot find one. */
         GpuProgramFactory* GetFactory(const String& language);
 
+        /**
+         * Identifies a single variation of a program by everything its compilation depends on, with the permutation keys
+         * resolved to defines.
+         */
+        struct VariationKey
+        {
+            String Source;
+            String EntryPoint;
+            String Language;
+            String IncludePath;
+            Map<String, String> Defines;
+            GpuProgramType Type;
+            bool RequiresAdjacency;
+            size_t Hash;
+
+            bool operator==(const VariationKey& other) const
+            {
+                return Hash == other.Hash && Type == other.Type && RequiresAdjacency == other.RequiresAdjacency &&
+                    EntryPoint == other.EntryPoint && Language == other.Language && IncludePath == other.IncludePath &&
+                    Defines == other.Defines && Source == other.Source;
+            }
+        };
+
+        struct VariationKeyHash
+        {
+            size_t operator()(const VariationKey& key) const { return key.Hash; }
+        };
+
     protected:
         UnorderedMap<String, GpuProgramFactory*> _factories;
         GpuProgramFactory* _nullFactory; /**< Factory for dealing with GPU programs that can't be created. */
+        GpuProgramCache _programCache;
+
+        /**
+         * Variations built or being built. Entries are inserted before compiling, so other threads requesting the same
+         * variation wait on its future instead of compiling it again, while unrelated variations compile in parallel.
+         */
+        UnorderedMap<VariationKey, std::shared_future<SPtr<GpuProgram>>, VariationKeyHash> _variations;
+        mutable Mutex _variationsMutex;
     };
 
     /**	Factory that creates null GPU programs.  */
@@ -3,6 +3,7 @@
 #include "RenderAPI/TeVertexDataDesc.h"
 #include "RenderAPI/TeGpuParamBlockBuffer.h"
 #include "RenderAPI/TeGpuParams.h"
+#include "RenderAPI/TeHardwareBuffer.h"
 
 namespace te
 {
@@ -142,4 +143,51 @@ namespace te
 
         return paramsPtr;
     }
+
+    bool HardwareBufferManager::IsTransientSupported()
+    {
+        if (!_transientInitialized)
+        {
+            _transientBuffer = CreateTransientBufferInternal(TRANSIENT_BUFFER_SIZE);
+            _transientInitialized = true;
+
+            // Start as full, so the first allocation discards the buffer before anything is appended to it
+            _transientOffset = TRANSIENT_BUFFER_SIZE;
+        }
+
+        return _transientBuffer != nullptr;
+    }
+
+    bool HardwareBufferManager::AllocateTransient(const void* data, UINT32 size, TransientAllocation& allocation)
+    {
+        if (!IsTransientSupported())
+            return false;
+
+        const UINT32 alignment = GetTransientAlignment();
+        const UINT32 alignedSize = (size + alignment - 1) / alignment * alignment;
+        if (alignedSize > TRANSIENT_BUFFER_SIZE)
+            return false;
+
+        // Regions handed out in the current epoch might still be read by draws in flight, so they are never written
+        // again. Once full, the whole buffer is discarded and the driver provides fresh memory for it.
+        GpuLockOptions lockOptions = GBL_WRITE_ONLY_NO_OVERWRITE;
+        if (_transientOffset + alignedSize > TRANSIENT_BUFFER_SIZE)
+        {
+            _transientOffset = 0;
+            _transientEpoch++;
+            lockOptions = GBL_WRITE_ONLY_DISCARD;
+        }
+
+        void* dest = _transientBuffer->Lock(_transientOffset, size, lockOptions);
+        memcpy(dest, data, size);
+        _transientBuffer->Unlock();
+
+        allocation.Buffer = _transientBuffer.get();
+        allocation.Offset = _transientOffset;
+        allocation.Size = alignedSize;
+        allocation.Epoch = _transientEpoch;
+
+        _transientOffset += alignedSize;
+        return true;
+    }
 }
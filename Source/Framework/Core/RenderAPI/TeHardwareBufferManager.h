@@ -6,6 +6,7 @@
 #include "RenderAPI/TeIndexBuffer.h"
 #include "RenderAPI/TeVertexDeclaration.h"
 #include "RenderAPI/TeGpuParams.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
 
 namespace te
 {
@@ -68,6 +69,26 @@ namespace te
         SPtr<GpuParams> CreateGpuParams(const SPtr<GpuPipelineParamInfo>& paramInfo,
             GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
+        /**
+         * Copies data of a transient parameter block buffer into the shared upload buffer, and returns the region it
+         * was copied to. The upload buffer is used as a ring: data is appended without waiting on the GPU, and once
+         * the end is reached the buffer is discarded and filling restarts from its beginning. Discarding doesn't affect
+         * draws that were already issued, but increments the epoch, and regions from older epochs must not be bound
+         * anymore.
+         *
+         * @param[in]	data		Data to copy.
+         * @param[in]	size		Size of the data in bytes.
+         * @param[out]	allocation	Region the data was copied to.
+         * @return					False if the render API can't bind buffer regions, or the data doesn't fit.
+         */
+        bool AllocateTransient(const void* data, UINT32 size, TransientAllocation& allocation);
+
+        /** Returns the number of times the upload buffer used by AllocateTransient() wrapped around. */
+        UINT32 GetTransientEpoch() const { return _transientEpoch; }
+
+        /** Checks can parameter block buffers be sub-allocated from the upload buffer. */
+        bool IsTransientSupported();
+
     protected:
         friend class IndexBuffer;
         friend class VertexBuffer;
@@ -123,10 +144,27 @@ namespace te
         virtual SPtr<GpuParams> CreateGpuParamsInternal(const SPtr<GpuPipelineParamInfo>& paramInfo,
             GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
+        /**
+         * Creates the upload buffer used by AllocateTransient(). Render APIs that can't bind regions of a buffer as
+         * parameter blocks return null, which is the default.
+         */
+        virtual SPtr<HardwareBuffer> CreateTransientBufferInternal(UINT32 /*size*/) { return nullptr; }
+
+        /** Returns the alignment required for offsets of buffer regions bound as parameter blocks, in bytes. */
+        virtual UINT32 GetTransientAlignment() const { return 256; }
+
         typedef UnorderedMap<VertexDeclarationKey, SPtr<VertexDeclaration>,
             VertexDeclarationKey::HashFunction, VertexDeclarationKey::EqualFunction> DeclarationMap;
     
     protected:
+        /** Size of the upload buffer used by AllocateTransient(), in bytes. */
+        static constexpr UINT32 TRANSIENT_BUFFER_SIZE = 4 * 1024 * 1024;
+
         DeclarationMap _cachedDeclarations;
+
+        SPtr<HardwareBuffer> _transientBuffer;
+        UINT32 _transientOffset = 0;
+        UINT32 _transientEpoch = 1;
+        bool _transientInitialized = false;
     };
 }
\ No newline at end of file
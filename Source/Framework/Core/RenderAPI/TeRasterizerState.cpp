@@ -5,7 +5,15 @@ namespace te
 {
     bool RASTERIZER_STATE_DESC::operator == (const RASTERIZER_STATE_DESC& rhs) const
     {
-        return polygonMode == rhs.polygonMode && cullMode == rhs.cullMode;
+        return polygonMode == rhs.polygonMode &&
+            cullMode == rhs.cullMode &&
+            depthBias == rhs.depthBias &&
+            depthBiasClamp == rhs.depthBiasClamp &&
+            slopeScaledDepthBias == rhs.slopeScaledDepthBias &&
+            depthClipEnable == rhs.depthClipEnable &&
+            scissorEnable == rhs.scissorEnable &&
+            multisampleEnable == rhs.multisampleEnable &&
+            antialiasedLineEnable == rhs.antialiasedLineEnable;
     }
 
     RasterizerProperties::RasterizerProperties(const RASTERIZER_STATE_DESC& desc)
@@ -39,4 +47,20 @@ namespace te
     {
         return RenderStateManager::Instance().CreateRasterizerState(desc);
     }
+
+    UINT64 RasterizerState::GenerateHash(const RASTERIZER_STATE_DESC& desc)
+    {
+        size_t hash = 0;
+        te_hash_combine(hash, desc.polygonMode);
+        te_hash_combine(hash, desc.cullMode);
+        te_hash_combine(hash, desc.depthBias);
+        te_hash_combine(hash, desc.depthBiasClamp);
+        te_hash_combine(hash, desc.slopeScaledDepthBias);
+        te_hash_combine(hash, desc.depthClipEnable);
+        te_hash_combine(hash, desc.scissorEnable);
+        te_hash_combine(hash, desc.multisampleEnable);
+        te_hash_combine(hash, desc.antialiasedLineEnable);
+
+        return (UINT64)hash;
+    }
 }
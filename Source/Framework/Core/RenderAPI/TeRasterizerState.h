@@ -126,6 +126,9 @@ namespace te
         /**	Returns the default rasterizer state. */
         static const SPtr<RasterizerState>& GetDefault();
 
+        /**	Generates a hash value from a rasterizer state descriptor. */
+        static UINT64 GenerateHash(const RASTERIZER_STATE_DESC& desc);
+
     protected:
         friend class RenderStateManager;
 
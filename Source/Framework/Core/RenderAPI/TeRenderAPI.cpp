@@ -1,5 +1,17 @@
 #include "TeRenderAPI.h"
 #include "RenderAPI/TeRenderWindow.h"
+#include "RenderAPI/TeCommandBuffer.h"
+#include "RenderAPI/TeGpuParams.h"
+#include "RenderAPI/TeGpuParamDesc.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
+#include "RenderAPI/TeHardwareBufferManager.h"
+#include "RenderAPI/TeGpuPipelineState.h"
+#include "RenderAPI/TeVertexBuffer.h"
+#include "RenderAPI/TeIndexBuffer.h"
+#include "RenderAPI/TeVertexDeclaration.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "RenderAPI/TeSamplerState.h"
+#include "Image/TeTexture.h"
 
 namespace te
 {
@@ -22,6 +34,309 @@ namespace te
     void RenderAPI::Destroy()
     {
         _activeRenderTarget = nullptr;
+        InvalidateStateCache();
+    }
+
+    void RenderAPI::SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+        UINT32 gpuParamsBlockBindFlags, const Vector<String>& paramBlocksToBind)
+    {
+        _filterStats.GpuParams.Calls++;
+
+        if (gpuParams == nullptr)
+        {
+            SetGpuParamsInternal(gpuParams, gpuParamsBindFlags, gpuParamsBlockBindFlags, paramBlocksToBind);
+            return;
+        }
+
+        // Compare everything the backend would bind with what is already bound, and remember the new bindings
+        bool changed = false;
+        bool bindsLoadStore = false;
+        const UINT32 transientEpoch = HardwareBufferManager::Instance().GetTransientEpoch();
+        for (UINT32 i = 0; i < GPT_COUNT; i++)
+        {
+            SPtr<GpuParamDesc> paramDesc = gpuParams->GetParamDesc((GpuProgramType)i);
+            if (paramDesc == nullptr)
+                continue;
+
+            BoundStage& stage = _boundState.Stages[i];
+
+            if (!paramDesc->LoadStoreTextures.empty())
+                bindsLoadStore = true;
+
+            if (gpuParamsBindFlags & (UINT32)GPU_BIND_TEXTURE)
+            {
+                for (auto& entry : paramDesc->Textures)
+                {
+                    const GpuParamObjectDesc& desc = entry.second;
+                    changed |= UpdateBoundObject(stage.Resources, desc.Set, desc.Slot, gpuParams->GetTexture(desc.Set, desc.Slot),
+                        gpuParams->GetTextureSurface(desc.Set, desc.Slot));
+                }
+            }
+
+            if (gpuParamsBindFlags & (UINT32)GPU_BIND_BUFFER)
+            {
+                for (auto& entry : paramDesc->Buffers)
+                {
+                    const GpuParamObjectDesc& desc = entry.second;
+                    if (desc.Type != GPOT_BYTE_BUFFER && desc.Type != GPOT_STRUCTURED_BUFFER)
+                    {
+                        bindsLoadStore = true;
+                        continue;
+                    }
+
+                    changed |= UpdateBoundObject(stage.Resources, desc.Set, desc.Slot, gpuParams->GetBuffer(desc.Set, desc.Slot));
+                }
+            }
+
+            if (gpuParamsBindFlags & (UINT32)GPU_BIND_SAMPLER)
+            {
+                for (auto& entry : paramDesc->Samplers)
+                {
+                    const GpuParamObjectDesc& desc = entry.second;
+                    changed |= UpdateBoundObject(stage.Samplers, desc.Set, desc.Slot, gpuParams->GetSamplerState(desc.Set, desc.Slot));
+                }
+            }
+
+            if (gpuParamsBindFlags & (UINT32)GPU_BIND_PARAM_BLOCK)
+            {
+                for (auto& entry : paramDesc->ParamBlocks)
+                {
+                    const GpuParamBlockDesc& desc = entry.second;
+
+                    if (!(gpuParamsBlockBindFlags & (UINT32)GPU_BIND_PARAM_BLOCK_ALL))
+                    {
+                        bool listed = std::find(paramBlocksToBind.begin(), paramBlocksToBind.end(), desc.Name) != paramBlocksToBind.end();
+                        bool selected = ((gpuParamsBlockBindFlags & (UINT32)GPU_BIND_PARAM_BLOCK_LISTED) && listed) ||
+                            ((gpuParamsBlockBindFlags & (UINT32)GPU_BIND_PARAM_BLOCK_ALL_EXCEPT) && !listed);
+
+                        if (!selected)
+                            continue;
+                    }
+
+                    // Contents can change while the buffer stays bound, so upload them even if the call is filtered out
+                    SPtr<GpuParamBlockBuffer> buffer = gpuParams->GetParamBlockBuffer(desc.Set, desc.Slot);
+                    if (buffer != nullptr)
+                    {
+                        const TransientAllocation previous = buffer->GetTransientAllocation();
+                        buffer->FlushToGPU();
+
+                        // Transient buffers move to a new region of the upload buffer when flushed, which needs a rebind
+                        const TransientAllocation& current = buffer->GetTransientAllocation();
+                        if (current.Buffer != previous.Buffer || current.Offset != previous.Offset ||
+                            current.Epoch != previous.Epoch)
+                        {
+                            changed = true;
+                        }
+                    }
+
+                    changed |= UpdateBoundObject(stage.ParamBlocks, desc.Set, desc.Slot, std::move(buffer));
+                }
+            }
+        }
+
+        // Upload buffer wrapped around while flushing, so blocks flushed before the wrap must be uploaded and bound again
+        if (HardwareBufferManager::Instance().GetTransientEpoch() != transientEpoch)
+            changed = true;
+
+        // Unordered access views are unbound implicitly by backends, so don't try to track them
+        if (bindsLoadStore)
+        {
+            SetGpuParamsInternal(gpuParams, gpuParamsBindFlags, gpuParamsBlockBindFlags, paramBlocksToBind);
+            InvalidateBoundObjects();
+            return;
+        }
+
+        if (!changed)
+        {
+            _filterStats.GpuParams.Filtered++;
+            return;
+        }
+
+        SetGpuParamsInternal(gpuParams, gpuParamsBindFlags, gpuParamsBlockBindFlags, paramBlocksToBind);
+    }
+
+    void RenderAPI::SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState)
+    {
+        _filterStats.GraphicsPipelines.Calls++;
+
+        if (_boundState.GraphicsPipelineValid && _boundState.GraphicsPipeline == pipelineState)
+        {
+            _filterStats.GraphicsPipelines.Filtered++;
+            return;
+        }
+
+        // Switching between graphics and compute changes which stages backends bind parameters to
+        if (_boundState.ComputePipelineValid)
+        {
+            _boundState.ComputePipeline = nullptr;
+            _boundState.ComputePipelineValid = false;
+            InvalidateBoundObjects();
+        }
+
+        SetGraphicsPipelineInternal(pipelineState);
+
+        _boundState.GraphicsPipeline = pipelineState;
+        _boundState.GraphicsPipelineValid = true;
+    }
+
+    void RenderAPI::SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState)
+    {
+        _filterStats.ComputePipelines.Calls++;
+
+        if (_boundState.ComputePipelineValid && _boundState.ComputePipeline == pipelineState)
+        {
+            _filterStats.ComputePipelines.Filtered++;
+            return;
+        }
+
+        if (_boundState.GraphicsPipelineValid)
+        {
+            _boundState.GraphicsPipeline = nullptr;
+            _boundState.GraphicsPipelineValid = false;
+            InvalidateBoundObjects();
+        }
+
+        SetComputePipelineInternal(pipelineState);
+
+        _boundState.ComputePipeline = pipelineState;
+        _boundState.ComputePipelineValid = true;
+    }
+
+    void RenderAPI::SetStencilRef(UINT32 value)
+    {
+        _filterStats.StencilRefs.Calls++;
+
+        if (_boundState.StencilRefValid && _boundState.StencilRef == value)
+        {
+            _filterStats.StencilRefs.Filtered++;
+            return;
+        }
+
+        SetStencilRefInternal(value);
+
+        _boundState.StencilRef = value;
+        _boundState.StencilRefValid = true;
+    }
+
+    void RenderAPI::SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
+    {
+        _filterStats.VertexBuffers.Calls++;
+
+        bool changed = index + numBuffers > TE_MAX_BOUND_VERTEX_BUFFERS;
+        for (UINT32 i = 0; i < numBuffers && !changed; i++)
+        {
+            changed = !_boundState.VertexBuffersValid[index + i] ||
+                _boundState.VertexBuffers[index + i] != buffers[i];
+        }
+
+        if (!changed)
+        {
+            _filterStats.VertexBuffers.Filtered++;
+            return;
+        }
+
+        SetVertexBuffersInternal(index, buffers, numBuffers);
+
+        for (UINT32 i = index; i < std::min(index + numBuffers, (UINT32)TE_MAX_BOUND_VERTEX_BUFFERS); i++)
+        {
+            _boundState.VertexBuffers[i] = buffers[i - index];
+            _boundState.VertexBuffersValid[i] = true;
+        }
+    }
+
+    void RenderAPI::SetIndexBuffer(const SPtr<IndexBuffer>& buffer)
+    {
+        _filterStats.IndexBuffers.Calls++;
+
+        if (_boundState.IndexBufferValid && _boundState.BoundIndexBuffer == buffer)
+        {
+            _filterStats.IndexBuffers.Filtered++;
+            return;
+        }
+
+        SetIndexBufferInternal(buffer);
+
+        _boundState.BoundIndexBuffer = buffer;
+        _boundState.IndexBufferValid = true;
+    }
+
+    void RenderAPI::SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration)
+    {
+        _filterStats.VertexDeclarations.Calls++;
+
+        if (_boundState.VertexDeclarationValid && _boundState.BoundVertexDeclaration == vertexDeclaration)
+        {
+            _filterStats.VertexDeclarations.Filtered++;
+            return;
+        }
+
+        SetVertexDeclarationInternal(vertexDeclaration);
+
+        _boundState.BoundVertexDeclaration = vertexDeclaration;
+        _boundState.VertexDeclarationValid = true;
+    }
+
+    void RenderAPI::SetDrawOperation(DrawOperationType op)
+    {
+        _filterStats.DrawOperations.Calls++;
+
+        if (_boundState.DrawOpValid && _boundState.DrawOp == op)
+        {
+            _filterStats.DrawOperations.Filtered++;
+            return;
+        }
+
+        SetDrawOperationInternal(op);
+
+        _boundState.DrawOp = op;
+        _boundState.DrawOpValid = true;
+    }
+
+    void RenderAPI::SetRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags)
+    {
+        // Backends unbind shader resources that alias the new render target, so we can't rely on them staying bound
+        for (auto& stage : _boundState.Stages)
+            stage.Resources.clear();
+
+        SetRenderTargetInternal(target, readOnlyFlags);
+    }
+
+    void RenderAPI::InvalidateStateCache()
+    {
+        _boundState = BoundState();
+    }
+
+    void RenderAPI::InvalidateBoundObjects()
+    {
+        for (auto& stage : _boundState.Stages)
+            stage = BoundStage();
+    }
+
+    bool RenderAPI::UpdateBoundObject(Vector<BoundObject>& slots, UINT32 set, UINT32 slot, SPtr<void> object,
+        const TextureSurface& surface)
+    {
+        if (slot >= (UINT32)slots.size())
+            slots.resize(slot + 1);
+
+        BoundObject& bound = slots[slot];
+        if (bound.Valid && bound.Object == object && bound.Set == set &&
+            bound.Surface.MipLevel == surface.MipLevel && bound.Surface.NumMipLevels == surface.NumMipLevels &&
+            bound.Surface.Face == surface.Face && bound.Surface.NumFaces == surface.NumFaces)
+        {
+            return false;
+        }
+
+        bound.Object = std::move(object);
+        bound.Set = set;
+        bound.Surface = surface;
+        bound.Valid = true;
+
+        return true;
+    }
+
+    void RenderAPI::ExecuteCommands(const CommandBuffer& commandBuffer)
+    {
+        commandBuffer.Replay(*this);
     }
 
     const RenderAPICapabilities& RenderAPI::GetCapabilities(UINT32 deviceIdx) const
@@ -51,6 +51,37 @@ namespace te
         Conventions Convention;
     };
 
+    /** Number of calls made to a single RenderAPI state setter, and how many of them were filtered out as redundant. */
+    struct RenderAPIFilterCounters
+    {
+        UINT64 Calls = 0;
+        UINT64 Filtered = 0;
+    };
+
+    /** Statistics of the redundant state filtering performed by RenderAPI, per state setter. */
+    struct RenderAPIFilterStats
+    {
+        RenderAPIFilterCounters GraphicsPipelines;
+        RenderAPIFilterCounters ComputePipelines;
+        RenderAPIFilterCounters GpuParams;
+        RenderAPIFilterCounters StencilRefs;
+        RenderAPIFilterCounters VertexBuffers;
+        RenderAPIFilterCounters IndexBuffers;
+        RenderAPIFilterCounters VertexDeclarations;
+        RenderAPIFilterCounters DrawOperations;
+
+        /** Returns the total number of calls that were filtered out. */
+        UINT64 GetNumFiltered() const
+        {
+            return GraphicsPipelines.Filtered + ComputePipelines.Filtered + GpuParams.Filtered + StencilRefs.Filtered +
+                VertexBuffers.Filtered + IndexBuffers.Filtered + VertexDeclarations.Filtered + DrawOperations.Filtered;
+        }
+    };
+
+    /**
+     * Provides access to the underlying render backend. State setters remember the currently bound state and drop calls
+     * that would not change it before they reach the backend, which implements the *Internal() variants.
+     */
     class TE_CORE_EXPORT RenderAPI : public Module<RenderAPI>
     {
     public:
@@ -67,6 +98,16 @@ namespace te
         /** Shuts down the render API system and cleans up all resources. */
         virtual void Destroy();
 
+        /**
+         * Prepares the render API to be used from a thread other than the one it was created on, such as a dedicated
+         * render thread. Resources may then be created from the main thread while rendering, but rendering calls must
+         * still be issued from a single thread at a time.
+         *
+         * @return	True if the backend supports this, false otherwise in which case everything must remain on the
+         *			thread the render API was created on.
+         */
+        virtual bool EnableMultithreadedAccess() { return false; }
+
         /**
          * Applies a set of parameters that control execution of all currently bound GPU programs. These are the uniforms
          * like textures, samplers, or uniform buffers. Caller is expected to ensure the provided parameters actually
@@ -79,8 +120,8 @@ namespace te
          * @param[in]	gpuParamsBlockBindFlags		In case you only want to bind constant buffers, you can specify how there are selected
          * @param[in]	paramBlocksToBind			All constants buffers you want to bind by name. Be careful, buffers must to be consecutive in memory
          */
-        virtual void SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags = (UINT32)GPU_BIND_ALL,
-            UINT32 gpuParamsBlockBindFlags = (UINT32)GPU_BIND_PARAM_BLOCK_ALL, const Vector<String>& paramBlocksToBind = {}) = 0;
+        void SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags = (UINT32)GPU_BIND_ALL,
+            UINT32 gpuParamsBlockBindFlags = (UINT32)GPU_BIND_PARAM_BLOCK_ALL, const Vector<String>& paramBlocksToBind = {});
 
         /**
          * Sets a pipeline state that controls how will subsequent draw commands render primitives.
@@ -89,14 +130,14 @@ namespace te
          *
          * @see		GraphicsPipelineState
          */
-        virtual void SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState) = 0;
+        void SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState);
 
         /**
          * Sets a pipeline state that controls how will subsequent dispatch commands execute.
          *
          * @param[in]	pipelineState		Pipeline state to bind, or null to unbind.
          */
-        virtual void SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState) = 0;
+        void SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState);
 
         /**
          * Sets the active viewport that will be used for all render operations.
@@ -121,7 +162,7 @@ namespace te
          *
          * @param[in]	value			Reference value to set.
          */
-        virtual void SetStencilRef(UINT32 value) = 0;
+        void SetStencilRef(UINT32 value);
 
         /**
          * Sets the provided vertex buffers starting at the specified source index.	Set buffer to nullptr to clear the
@@ -131,7 +172,7 @@ namespace te
          * @param[in]	buffers			A list of buffers to bind to the pipeline.
          * @param[in]	numBuffers		Number of buffers in the @p buffers list.
          */
-        virtual void SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers) = 0;
+        void SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers);
 
         /**
          * Sets an index buffer to use when drawing. Indices in an index buffer reference vertices in the vertex buffer,
@@ -139,7 +180,7 @@ namespace te
          *
          * @param[in]	buffer			Index buffer to bind, null to unbind.
          */
-        virtual void SetIndexBuffer(const SPtr<IndexBuffer>& buffer) = 0;
+        void SetIndexBuffer(const SPtr<IndexBuffer>& buffer);
 
         /**
          * Sets the vertex declaration to use when drawing. Vertex declaration is used to decode contents of a single
@@ -147,14 +188,14 @@ namespace te
          *
          * @param[in]	vertexDeclaration	Vertex declaration to bind.
          */
-        virtual void SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration) = 0;
+        void SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration);
 
         /**
          * Sets the draw operation that determines how to interpret the elements of the index or vertex buffers.
          *
          * @param[in]	op				Draw operation to enable.
          */
-        virtual void SetDrawOperation(DrawOperationType op) = 0;
+        void SetDrawOperation(DrawOperationType op);
         
         /**
          * Draw an object based on currently bound GPU programs, vertex declaration and vertex buffers. Draws directly from
@@ -186,6 +227,15 @@ namespace te
          */
         virtual void DispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1) = 0;
 
+        /**
+         * Executes all commands recorded in the provided command buffer, in recording order. Must be called from the
+         * thread rendering is issued from. Default implementation replays the commands through the immediate
+         * methods of this object, backends with native support for deferred command lists may override it.
+         *
+         * @param[in]	commandBuffer	Command buffer to execute. Contents of the buffer are not modified.
+         */
+        virtual void ExecuteCommands(const CommandBuffer& commandBuffer);
+
         /**
          * Swap the front and back buffer of the specified render target.
          * 
@@ -202,7 +252,7 @@ namespace te
          *										buffers which need to be bound both for depth/stencil tests, as well as
          *										shader reads.
          */
-        virtual void SetRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags = 0) = 0;
+        void SetRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags = 0);
 
         /**
          * Clears the currently active render target.
@@ -259,7 +309,98 @@ namespace te
          */
         virtual GpuParamBlockDesc GenerateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params) = 0;
 
+        /**
+         * Forgets all remembered bound state, so the following state setter calls all reach the backend. Must be called
+         * by any code that modifies the state of the underlying device without going through this object.
+         */
+        void InvalidateStateCache();
+
+        /** Returns statistics about state setter calls that were filtered out as redundant. */
+        const RenderAPIFilterStats& GetFilterStats() const { return _filterStats; }
+
+        /** Resets all statistics returned by GetFilterStats(). */
+        void ResetFilterStats() { _filterStats = RenderAPIFilterStats(); }
+
     protected:
+        /** Backend implementation of SetGpuParams(). Called only if the parameters differ from the bound ones. */
+        virtual void SetGpuParamsInternal(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+            UINT32 gpuParamsBlockBindFlags, const Vector<String>& paramBlocksToBind) = 0;
+
+        /** Backend implementation of SetGraphicsPipeline(). Called only if the pipeline differs from the bound one. */
+        virtual void SetGraphicsPipelineInternal(const SPtr<GraphicsPipelineState>& pipelineState) = 0;
+
+        /** Backend implementation of SetComputePipeline(). Called only if the pipeline differs from the bound one. */
+        virtual void SetComputePipelineInternal(const SPtr<ComputePipelineState>& pipelineState) = 0;
+
+        /** Backend implementation of SetStencilRef(). Called only if the value differs from the bound one. */
+        virtual void SetStencilRefInternal(UINT32 value) = 0;
+
+        /** Backend implementation of SetVertexBuffers(). Called only if the buffers differ from the bound ones. */
+        virtual void SetVertexBuffersInternal(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers) = 0;
+
+        /** Backend implementation of SetIndexBuffer(). Called only if the buffer differs from the bound one. */
+        virtual void SetIndexBufferInternal(const SPtr<IndexBuffer>& buffer) = 0;
+
+        /** Backend implementation of SetVertexDeclaration(). Called only if the declaration differs from the bound one. */
+        virtual void SetVertexDeclarationInternal(const SPtr<VertexDeclaration>& vertexDeclaration) = 0;
+
+        /** Backend implementation of SetDrawOperation(). Called only if the operation differs from the bound one. */
+        virtual void SetDrawOperationInternal(DrawOperationType op) = 0;
+
+        /** Backend implementation of SetRenderTarget(). */
+        virtual void SetRenderTargetInternal(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags) = 0;
+
+        /** Object bound to a single GPU program slot, as remembered by the state filter. */
+        struct BoundObject
+        {
+            SPtr<void> Object; /**< Kept alive, so the address can't be reused by a different object while bound. */
+            UINT32 Set = 0;
+            TextureSurface Surface;
+            bool Valid = false;
+        };
+
+        /** Objects bound to a single GPU program stage, indexed by slot. */
+        struct BoundStage
+        {
+            Vector<BoundObject> ParamBlocks;
+            Vector<BoundObject> Resources; /**< Textures and read-only buffers, which share slots on some backends. */
+            Vector<BoundObject> Samplers;
+        };
+
+        /** State currently bound on the backend, as far as the state filter knows. */
+        struct BoundState
+        {
+            SPtr<GraphicsPipelineState> GraphicsPipeline;
+            SPtr<ComputePipelineState> ComputePipeline;
+            SPtr<VertexBuffer> VertexBuffers[TE_MAX_BOUND_VERTEX_BUFFERS];
+            SPtr<IndexBuffer> BoundIndexBuffer;
+            SPtr<VertexDeclaration> BoundVertexDeclaration;
+            DrawOperationType DrawOp = DOT_TRIANGLE_LIST;
+            UINT32 StencilRef = 0;
+            BoundStage Stages[GPT_COUNT];
+
+            bool GraphicsPipelineValid = false;
+            bool ComputePipelineValid = false;
+            bool VertexBuffersValid[TE_MAX_BOUND_VERTEX_BUFFERS] = { };
+            bool IndexBufferValid = false;
+            bool VertexDeclarationValid = false;
+            bool DrawOpValid = false;
+            bool StencilRefValid = false;
+        };
+
+        /** Forgets all objects remembered as bound to GPU program stages. */
+        void InvalidateBoundObjects();
+
+        /**
+         * Remembers @p object as bound to the provided slot. Returns false if the slot already held the same object
+         * (and the same surface, for textures).
+         */
+        static bool UpdateBoundObject(Vector<BoundObject>& slots, UINT32 set, UINT32 slot, SPtr<void> object,
+            const TextureSurface& surface = TextureSurface());
+
+        BoundState _boundState;
+        RenderAPIFilterStats _filterStats;
+
         SPtr<RenderTarget> _activeRenderTarget;
         bool _activeRenderTargetModified = false;
 
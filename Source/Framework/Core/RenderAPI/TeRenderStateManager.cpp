@@ -3,50 +3,150 @@
 #include "RenderAPI/TeRasterizerState.h"
 #include "RenderAPI/TeSamplerState.h"
 #include "RenderAPI/TeBlendState.h"
+#include "RenderAPI/TeGpuProgram.h"
 
 namespace te
 {
     TE_MODULE_STATIC_MEMBER(RenderStateManager)
 
-    SPtr<SamplerState> RenderStateManager::CreateSamplerState(const SAMPLER_STATE_DESC& desc) const
+    bool RenderStateManager::GraphicsPipelineKey::operator==(const GraphicsPipelineKey& other) const
     {
-        SPtr<SamplerState> state = _createSamplerState(desc);
-        state->Initialize();
+        for (UINT32 i = 0; i < 3; i++)
+        {
+            if (StateIds[i] != other.StateIds[i])
+                return false;
+        }
+
+        for (UINT32 i = 0; i < 5; i++)
+        {
+            if (ProgramIds[i] != other.ProgramIds[i])
+                return false;
+        }
+
+        return DeviceMask == other.DeviceMask;
+    }
+
+    size_t RenderStateManager::GraphicsPipelineKeyHash::operator()(const GraphicsPipelineKey& key) const
+    {
+        size_t hash = 0;
+        for (UINT32 i = 0; i < 3; i++)
+            te_hash_combine(hash, key.StateIds[i]);
+
+        for (UINT32 i = 0; i < 5; i++)
+            te_hash_combine(hash, key.ProgramIds[i]);
+
+        te_hash_combine(hash, (UINT32)key.DeviceMask);
+        return hash;
+    }
+
+    template<class State, class Key, class Cache, class CreateFunc>
+    SPtr<State> RenderStateManager::FindOrCreate(Cache& cache, const Key& key, RenderStateCacheCounters& counters,
+        CreateFunc createState) const
+    {
+        {
+            Lock lock(_cacheMutex);
+
+            auto iterFind = cache.Entries.find(key);
+            if (iterFind != cache.Entries.end())
+            {
+                SPtr<State> existing = iterFind->second.lock();
+                if (existing != nullptr)
+                {
+                    counters.Hits++;
+                    return existing;
+                }
+
+                cache.Entries.erase(iterFind);
+            }
+
+            counters.Misses++;
+        }
+
+        // Backend objects can take a while to create, don't block other threads in the meantime
+        SPtr<State> state = createState();
+
+        Lock lock(_cacheMutex);
+
+        WPtr<State>& entry = cache.Entries[key];
+        SPtr<State> existing = entry.lock();
+        if (existing != nullptr)
+            return existing;
+
+        entry = state;
+        cache.SweepIfNeeded();
 
         return state;
     }
 
+    SPtr<SamplerState> RenderStateManager::CreateSamplerState(const SAMPLER_STATE_DESC& desc) const
+    {
+        return FindOrCreate<SamplerState>(_samplerStates, desc, _cacheStats.SamplerStates, [this, &desc]()
+        {
+            SPtr<SamplerState> state = _createSamplerState(desc);
+            state->Initialize();
+
+            return state;
+        });
+    }
+
     SPtr<DepthStencilState> RenderStateManager::CreateDepthStencilState(const DEPTH_STENCIL_STATE_DESC& desc) const
     {
-        SPtr<DepthStencilState> state = _createDepthStencilState(desc);
-        state->Initialize();
+        return FindOrCreate<DepthStencilState>(_depthStencilStates, desc, _cacheStats.DepthStencilStates, [this, &desc]()
+        {
+            SPtr<DepthStencilState> state = _createDepthStencilState(desc);
+            state->Initialize();
 
-        return state;
+            return state;
+        });
     }
 
     SPtr<RasterizerState> RenderStateManager::CreateRasterizerState(const RASTERIZER_STATE_DESC& desc) const
     {
-        SPtr<RasterizerState> state = _createRasterizerState(desc);
-        state->Initialize();
+        return FindOrCreate<RasterizerState>(_rasterizerStates, desc, _cacheStats.RasterizerStates, [this, &desc]()
+        {
+            SPtr<RasterizerState> state = _createRasterizerState(desc);
+            state->Initialize();
 
-        return state;
+            return state;
+        });
     }
 
     SPtr<BlendState> RenderStateManager::CreateBlendState(const BLEND_STATE_DESC& desc) const
     {
-        SPtr<BlendState> state = _createBlendState(desc);
-        state->Initialize();
+        return FindOrCreate<BlendState>(_blendStates, desc, _cacheStats.BlendStates, [this, &desc]()
+        {
+            SPtr<BlendState> state = _createBlendState(desc);
+            state->Initialize();
 
-        return state;
+            return state;
+        });
     }
 
     SPtr<GraphicsPipelineState> RenderStateManager::CreateGraphicsPipelineState(const PIPELINE_STATE_DESC& desc,
         GpuDeviceFlags deviceMask) const
     {
-        SPtr<GraphicsPipelineState> state = _createGraphicsPipelineState(desc, deviceMask);
-        state->Initialize();
+        // States are themselves cached, so identical pipelines reference the exact same state and program objects
+        auto getId = [](const SPtr<CoreObject>& object) { return object != nullptr ? object->GetInternalID() : 0; };
+
+        GraphicsPipelineKey key;
+        key.StateIds[0] = getId(desc.blendState);
+        key.StateIds[1] = getId(desc.rasterizerState);
+        key.StateIds[2] = getId(desc.depthStencilState);
+        key.ProgramIds[0] = getId(desc.vertexProgram);
+        key.ProgramIds[1] = getId(desc.pixelProgram);
+        key.ProgramIds[2] = getId(desc.geometryProgram);
+        key.ProgramIds[3] = getId(desc.hullProgram);
+        key.ProgramIds[4] = getId(desc.domainProgram);
+        key.DeviceMask = deviceMask;
+
+        return FindOrCreate<GraphicsPipelineState>(_graphicsPipelineStates, key, _cacheStats.GraphicsPipelineStates,
+            [this, &desc, deviceMask]()
+        {
+            SPtr<GraphicsPipelineState> state = _createGraphicsPipelineState(desc, deviceMask);
+            state->Initialize();
 
-        return state;
+            return state;
+        });
     }
 
     SPtr<ComputePipelineState> RenderStateManager::CreateComputePipelineState(const SPtr<GpuProgram>& program,
@@ -195,11 +295,30 @@ namespace te
         return state;
     }
 
+    RenderStateCacheStats RenderStateManager::GetCacheStats() const
+    {
+        Lock lock(_cacheMutex);
+        return _cacheStats;
+    }
+
+    void RenderStateManager::ResetCacheStats()
+    {
+        Lock lock(_cacheMutex);
+        _cacheStats = RenderStateCacheStats();
+    }
+
     void RenderStateManager::OnShutDown()
     {
         _defaultDepthStencilState = nullptr;
         _defaultRasterizerState = nullptr;
         _defaultSamplerState = nullptr;
         _defaultBlendState = nullptr;
+
+        Lock lock(_cacheMutex);
+        _samplerStates.Clear();
+        _depthStencilStates.Clear();
+        _rasterizerStates.Clear();
+        _blendStates.Clear();
+        _graphicsPipelineStates.Clear();
     }
 }
@@ -8,28 +8,54 @@
 #include "RenderAPI/TeBlendState.h"
 #include "RenderAPI/TeSamplerState.h"
 #include "RenderAPI/TeGpuPipelineParamInfo.h"
+#include "Threading/TeThreading.h"
 
 namespace te
 {
-    /** Handles creation of various render states. */
+    /** Number of requests one of the RenderStateManager caches could and couldn't serve with an existing object. */
+    struct RenderStateCacheCounters
+    {
+        UINT64 Hits = 0;
+        UINT64 Misses = 0;
+    };
+
+    /** Statistics about the caches of RenderStateManager. */
+    struct RenderStateCacheStats
+    {
+        RenderStateCacheCounters SamplerStates;
+        RenderStateCacheCounters DepthStencilStates;
+        RenderStateCacheCounters RasterizerStates;
+        RenderStateCacheCounters BlendStates;
+        RenderStateCacheCounters GraphicsPipelineStates;
+    };
+
+    /**
+     * Handles creation of various render states. States and graphics pipeline states are cached: requesting a state
+     * identical to one that is still alive returns the existing object instead of creating a new one.
+     *
+     * @note	Create methods are thread safe.
+     */
     class TE_CORE_EXPORT RenderStateManager : public Module <RenderStateManager>
     {
     public:
         RenderStateManager() = default;
 
-        /** Creates and initializes a new SamplerState. */
+        /** Creates and initializes a new SamplerState, or returns an existing one created from an identical descriptor. */
         SPtr<SamplerState> CreateSamplerState(const SAMPLER_STATE_DESC& desc) const;
 
-        /** Creates and initializes a new DepthStencilState. */
+        /** Creates and initializes a new DepthStencilState, or returns an existing one created from an identical descriptor. */
         SPtr<DepthStencilState> CreateDepthStencilState(const DEPTH_STENCIL_STATE_DESC& desc) const;
 
-        /** Creates and initializes a new RasterizerState. */
+        /** Creates and initializes a new RasterizerState, or returns an existing one created from an identical descriptor. */
         SPtr<RasterizerState> CreateRasterizerState(const RASTERIZER_STATE_DESC& desc) const;
 
-        /** Creates and initializes a new BlendState. */
+        /** Creates and initializes a new BlendState, or returns an existing one created from an identical descriptor. */
         SPtr<BlendState> CreateBlendState(const BLEND_STATE_DESC& desc) const;
 
-        /** Creates and initializes a new GraphicsPipelineState. */
+        /**
+         * Creates and initializes a new GraphicsPipelineState, or returns an existing one using the same states and
+         * programs.
+         */
         SPtr<GraphicsPipelineState> CreateGraphicsPipelineState(const PIPELINE_STATE_DESC& desc,
             GpuDeviceFlags deviceMask = GDF_DEFAULT) const;
 
@@ -81,6 +107,12 @@ namespace te
         /** Gets a blend state initialized with default options. */
         const SPtr<BlendState>& GetDefaultBlendState() const;
 
+        /** Returns the hit and miss counts of the state caches. */
+        RenderStateCacheStats GetCacheStats() const;
+
+        /** Resets the hit and miss counts of the state caches. */
+        void ResetCacheStats();
+
     protected:
         /** @copydoc Module::OnShutDown */
         void OnShutDown() override;
@@ -97,6 +129,79 @@ namespace te
         /** @copydoc CreateDepthStencilState */
         virtual SPtr<BlendState> CreateBlendStateInternal(const BLEND_STATE_DESC& desc) const;
 
+    private:
+        /** Identifies a graphics pipeline state by the objects it was created from. */
+        struct GraphicsPipelineKey
+        {
+            UINT64 StateIds[3];
+            UINT64 ProgramIds[5];
+            GpuDeviceFlags DeviceMask;
+
+            bool operator==(const GraphicsPipelineKey& other) const;
+        };
+
+        struct GraphicsPipelineKeyHash
+        {
+            size_t operator()(const GraphicsPipelineKey& key) const;
+        };
+
+        /** Hashes render state descriptors using the GenerateHash() method of the state they describe. */
+        template<class State, class Desc>
+        struct StateDescHash
+        {
+            size_t operator()(const Desc& desc) const { return (size_t)State::GenerateHash(desc); }
+        };
+
+        /**
+         * Weak references to created states. Entries of destroyed states are erased when their key misses, and the whole
+         * cache is swept of them whenever it doubles in size, as keys built from IDs of destroyed objects never hit again.
+         */
+        template<class State, class Key, class Hash>
+        struct WeakStateCache
+        {
+            /** Minimum number of entries before the cache is swept of destroyed states. */
+            static constexpr size_t MIN_SWEEP_SIZE = 64;
+
+            UnorderedMap<Key, WPtr<State>, Hash> Entries;
+            size_t SweepSize = MIN_SWEEP_SIZE; /**< Number of entries at which the next sweep happens. */
+
+            /** Erases entries of destroyed states, if the cache has grown enough since the last sweep. */
+            void SweepIfNeeded()
+            {
+                if (Entries.size() < SweepSize)
+                    return;
+
+                for (auto iter = Entries.begin(); iter != Entries.end();)
+                {
+                    if (iter->second.expired())
+                        iter = Entries.erase(iter);
+                    else
+                        ++iter;
+                }
+
+                SweepSize = std::max(MIN_SWEEP_SIZE, Entries.size() * 2);
+            }
+
+            /** Removes all entries. */
+            void Clear()
+            {
+                Entries.clear();
+                SweepSize = MIN_SWEEP_SIZE;
+            }
+        };
+
+        template<class State, class Desc>
+        using StateCache = WeakStateCache<State, Desc, StateDescHash<State, Desc>>;
+
+        /**
+         * Returns the live state stored in @p cache for @p key, or creates a new one with @p createState and stores it.
+         * Creation happens outside of the lock, if another thread stores the same state in the meantime its state is
+         * returned instead.
+         */
+        template<class State, class Key, class Cache, class CreateFunc>
+        SPtr<State> FindOrCreate(Cache& cache, const Key& key, RenderStateCacheCounters& counters,
+            CreateFunc createState) const;
+
     private:
         friend class BlendState;
         friend class SamplerState;
@@ -109,5 +214,14 @@ namespace te
         mutable SPtr<SamplerState> _defaultSamplerState;
         mutable SPtr<RasterizerState> _defaultRasterizerState;
         mutable SPtr<DepthStencilState> _defaultDepthStencilState;
+
+        mutable StateCache<SamplerState, SAMPLER_STATE_DESC> _samplerStates;
+        mutable StateCache<DepthStencilState, DEPTH_STENCIL_STATE_DESC> _depthStencilStates;
+        mutable StateCache<RasterizerState, RASTERIZER_STATE_DESC> _rasterizerStates;
+        mutable StateCache<BlendState, BLEND_STATE_DESC> _blendStates;
+        mutable WeakStateCache<GraphicsPipelineState, GraphicsPipelineKey, GraphicsPipelineKeyHash> _graphicsPipelineStates;
+
+        mutable RenderStateCacheStats _cacheStats;
+        mutable Mutex _cacheMutex;
     };
 }
@@ -65,4 +65,26 @@ namespace te
     {
         return RenderStateManager::Instance().CreateSamplerState(desc);
     }
+
+    UINT64 SamplerState::GenerateHash(const SAMPLER_STATE_DESC& desc)
+    {
+        size_t hash = 0;
+        te_hash_combine(hash, desc.AddressMode.u);
+        te_hash_combine(hash, desc.AddressMode.v);
+        te_hash_combine(hash, desc.AddressMode.w);
+        te_hash_combine(hash, desc.MinFilter);
+        te_hash_combine(hash, desc.MagFilter);
+        te_hash_combine(hash, desc.MipFilter);
+        te_hash_combine(hash, desc.MaxAnisotropy);
+        te_hash_combine(hash, desc.MipmapBias);
+        te_hash_combine(hash, desc.MipMin);
+        te_hash_combine(hash, desc.MipMax);
+        te_hash_combine(hash, desc.BorderColor.r);
+        te_hash_combine(hash, desc.BorderColor.g);
+        te_hash_combine(hash, desc.BorderColor.b);
+        te_hash_combine(hash, desc.BorderColor.a);
+        te_hash_combine(hash, desc.ComparisonFunc);
+
+        return (UINT64)hash;
+    }
 }
@@ -125,6 +125,9 @@ namespace te
         /**	Returns the default sampler state. */
         static const SPtr<SamplerState>& GetDefault();
 
+        /**	Generates a hash value from a sampler state descriptor. */
+        static UINT64 GenerateHash(const SAMPLER_STATE_DESC& desc);
+
     protected:
         friend class RenderStateManager;
 
@@ -5,6 +5,16 @@
 
 namespace te
 {
+    /** Index range drawing a simplified version of a sub-mesh. Uses the same vertices as the full detail sub-mesh. */
+    struct SubMeshLod
+    {
+        UINT32 IndexOffset = 0;
+        UINT32 IndexCount = 0;
+
+        /** Largest distance between the simplified and the original surface, relative to the radius of the mesh bounds. */
+        float Error = 0.0f;
+    };
+
     /** Data about a sub-mesh range and the type of primitives contained in the range. */
     struct TE_CORE_EXPORT SubMesh
     {
@@ -25,6 +35,9 @@ namespace te
         UINT32 IndexCount = 0;
         DrawOperationType DrawOp = DOT_TRIANGLE_LIST;
 
+        /** Simplified versions of this sub-mesh, from the most to the least detailed. The sub-mesh itself is LOD 0. */
+        Vector<SubMeshLod> Lods;
+
         /** It's possible to set a material name which will be use if you want to SetMaterial() on a mesh */
         String MaterialName = "";
         /** It's easier to have a name for identification in editor */
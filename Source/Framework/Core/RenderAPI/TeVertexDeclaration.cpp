@@ -52,6 +52,12 @@ namespace te
             return sizeof(INT16) * 2;
         case VET_SHORT4:
             return sizeof(INT16) * 4;
+        case VET_SHORT2_NORM:
+            return sizeof(INT16) * 2;
+        case VET_SHORT4_NORM:
+            return sizeof(INT16) * 4;
+        case VET_HALF2:
+            return sizeof(UINT16) * 2;
         case VET_UINT1:
             return sizeof(UINT32);
         case VET_UINT2:
@@ -93,6 +99,8 @@ namespace te
             return 1;
         case VET_FLOAT2:
         case VET_SHORT2:
+        case VET_SHORT2_NORM:
+        case VET_HALF2:
         case VET_USHORT2:
         case VET_INT2:
         case VET_UINT2:
@@ -103,6 +111,7 @@ namespace te
             return 3;
         case VET_FLOAT4:
         case VET_SHORT4:
+        case VET_SHORT4_NORM:
         case VET_USHORT4:
         case VET_INT4:
         case VET_UINT4:
@@ -57,7 +57,7 @@ namespace te
          * Determines whether this is the main application camera. Main camera controls the final render surface that is
          * displayed to the user.
          */
-        void SetMain(bool main) { _main = main; };
+        void SetMain(bool main) { _main = main; _markCoreDirty(); };
 
         /** @copydoc SetMain() */
         bool IsMain() const { return _main; }
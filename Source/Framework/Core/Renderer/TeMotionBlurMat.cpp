@@ -1,6 +1,5 @@
 #include "TeMotionBlurMat.h"
 #include "TeRendererUtility.h"
-#include "Utility/TeTime.h"
 
 namespace te
 {
@@ -14,7 +13,7 @@ namespace te
     }
 
     void MotionBlurMat::Execute(const SPtr<Texture>& source, const SPtr<RenderTarget>& destination, const SPtr<Texture>& depth, const SPtr<Texture>& velocity,
-        SPtr<GpuParamBlockBuffer> perViewBuffer, const MotionBlurSettings& settings, INT32 MSAACount)
+        SPtr<GpuParamBlockBuffer> perViewBuffer, const MotionBlurSettings& settings, float frameDelta, INT32 MSAACount)
     {
         UINT32 numSamples;
         switch(settings.Quality)
@@ -27,7 +26,7 @@ namespace te
             case MotionBlurQuality::Ultra: numSamples = 32;  break;
         }
 
-        gMotionBlurParamDef.gFrameDelta.Set(_paramBuffer, gTime().GetFrameDelta(), 0);
+        gMotionBlurParamDef.gFrameDelta.Set(_paramBuffer, frameDelta, 0);
         gMotionBlurParamDef.gHalfNumSamples.Set(_paramBuffer, numSamples / 2, 0);
         gMotionBlurParamDef.gMSAACount.Set(_paramBuffer, MSAACount, 0);
 
@@ -32,10 +32,11 @@ namespace te
          * @param[in]	depth			Depth buffer created during first pass
          * @param[in]	perViewBuffer	Camera frame buffer
          * @param[in]	settings		Motion blur settings
+         * @param[in]	frameDelta		Duration of the rendered frame, in seconds
          * @param[in]	MSAACount		How many samples used for input and output textures
          */
         void Execute(const SPtr<Texture>& source, const SPtr<RenderTarget>& destination, const SPtr<Texture>& depth, const SPtr<Texture>& velocity,
-            SPtr<GpuParamBlockBuffer> perViewBuffer, const MotionBlurSettings& settings, INT32 MSAACount = 1);
+            SPtr<GpuParamBlockBuffer> perViewBuffer, const MotionBlurSettings& settings, float frameDelta, INT32 MSAACount = 1);
 
     private:
         SPtr<GpuParamBlockBuffer> _paramBuffer;
@@ -137,7 +137,8 @@ namespace te
 			ParamBlockManager::RegisterBlock(this);																			\
 		}																													\
 																															\
-		SPtr<GpuParamBlockBuffer> CreateBuffer() const { return GpuParamBlockBuffer::Create(_blockSize); }					\
+		SPtr<GpuParamBlockBuffer> CreateBuffer(GpuBufferUsage usage = GBU_DYNAMIC) const									\
+		{ return GpuParamBlockBuffer::Create(_blockSize, usage); }															\
 																															\
 	private:																												\
 		friend class ParamBlockManager;																						\
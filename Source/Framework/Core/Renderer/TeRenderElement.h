@@ -38,8 +38,14 @@ namespace te
         /*  All params used by this element for all passes */
         Vector<SPtr<GpuParams>> GpuParamsElem;
 
-        /** Executes the draw call for the render element. */
-        virtual void Draw() const = 0;
+        /** Executes the draw call for the render element, using the specified level of detail of its sub-mesh. */
+        virtual void Draw(UINT32 lod = 0) const = 0;
+
+        /**
+         * Records the draw call for the render element into a command buffer. Must not modify any state shared with
+         * other render elements, as elements can be recorded from multiple threads in parallel.
+         */
+        virtual void Draw(CommandBuffer& commandBuffer, UINT32 lod = 0) const = 0;
 
     protected:
         RenderElement();
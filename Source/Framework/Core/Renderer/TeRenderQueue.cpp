@@ -16,7 +16,7 @@ namespace te
     RenderQueue::~RenderQueue()
     { }
 
-    void RenderQueue::Add(const RenderElement* element, float distFromCamera, UINT32 techniqueIdx)
+    void RenderQueue::Add(const RenderElement* element, float distFromCamera, UINT32 techniqueIdx, UINT32 lod)
     {
         SPtr<Material> material = element->MaterialElem;
         SPtr<Shader> shader = material->GetShader();
@@ -55,6 +55,7 @@ namespace te
             sortableElem.ShaderId = shaderId;
             sortableElem.TechniqueIdx = techniqueIdx;
             sortableElem.PassIdx = i;
+            sortableElem.Lod = lod;
             sortableElem.DistFromCamera = distFromCamera;
 
             _elements.push_back(element);
@@ -106,6 +107,7 @@ namespace te
                 sortedElem.RenderElem = renderElem;
                 sortedElem.TechniqueIdx = elem.TechniqueIdx;
                 sortedElem.PassIdx = elem.PassIdx;
+                sortedElem.Lod = elem.Lod;
 
                 if (prevShaderId != elem.ShaderId || prevTechniqueIdx != elem.TechniqueIdx || prevPassIdx != elem.PassIdx)
                 {
@@ -128,6 +130,7 @@ namespace te
                     sortedElem.RenderElem = renderElem;
                     sortedElem.TechniqueIdx = elem.TechniqueIdx;
                     sortedElem.PassIdx = j;
+                    sortedElem.Lod = elem.Lod;
 
                     if (prevShaderId != elem.ShaderId || prevTechniqueIdx != elem.TechniqueIdx || prevPassIdx != j)
                     {
@@ -22,6 +22,7 @@ namespace te
         const RenderElement* RenderElem = nullptr;
         UINT32 PassIdx = 0;
         UINT32 TechniqueIdx = 0;
+        UINT32 Lod = 0;
         bool ApplyPass = true;
     };
 
@@ -41,6 +42,7 @@ namespace te
             UINT32 ShaderId;
             UINT32 TechniqueIdx;
             UINT32 PassIdx;
+            UINT32 Lod;
         };
 
     public:
@@ -53,8 +55,9 @@ namespace te
          * @param[in]	element			Renderable element to add to the queue.
          * @param[in]	distFromCamera	Distance of this object from the camera. Used for distance sorting.
          * @param[in]	techniqueIdx	Index of the technique within @p element's material that's to be used to render the element with.
+         * @param[in]	lod				Level of detail of the sub-mesh to draw, 0 being the full detail one.
          */
-        void Add(const RenderElement* element, float distFromCamera, UINT32 techniqueIdx);
+        void Add(const RenderElement* element, float distFromCamera, UINT32 techniqueIdx, UINT32 lod = 0);
         void Sort();
         void Clear();
 
@@ -358,6 +358,13 @@ namespace te
          */
         float CullDistance = 5000.0f;
 
+        /**
+         * Largest error, in pixels, that simplified levels of detail of meshes are allowed to introduce when rendered
+         * through this camera. Higher values switch to less detailed levels closer to the camera. Set to 0 to always
+         * render meshes at full detail.
+         */
+        float LodPixelError = 1.0f;
+
         /** 
          * It's possible to define a scene color which will be used on every object rendered with this camera
          * It's useful to control globally brightness of a scene without using to much lights
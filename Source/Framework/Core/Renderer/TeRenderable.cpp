@@ -3,34 +3,9 @@
 #include "Scene/TeSceneObject.h"
 #include "Animation/TeAnimation.h"
 #include "Animation/TeAnimationManager.h"
-#include "RenderAPI/TeGpuBuffer.h"
 
 namespace te
 {
-    SPtr<GpuBuffer> CreateBoneMatrixBuffer(UINT32 numBones)
-    {
-        GPU_BUFFER_DESC desc;
-        desc.ElementCount = numBones * 4;
-        desc.ElementSize = 0;
-        desc.Type = GBT_STANDARD;
-        desc.Format = BF_32X4F;
-        desc.Usage = GBU_DYNAMIC;
-
-        SPtr<GpuBuffer> buffer = GpuBuffer::Create(desc);
-        UINT8* dest = (UINT8*)buffer->Lock(0, numBones * 4 * sizeof(Vector4), GBL_WRITE_ONLY_DISCARD);
-
-        // Initialize bone transforms to identity, so the object renders properly even if no animation is animating it
-        for (UINT32 i = 0; i < numBones; i++)
-        {
-            memcpy(dest, &Matrix4::IDENTITY, 16 * sizeof(float)); // Assuming row-major format
-            dest += 16 * sizeof(float);
-        }
-
-        buffer->Unlock();
-
-        return buffer;
-    }
-
     Renderable::Renderable()
         : _rendererId(0)
         , _animationId((UINT64)-1)
@@ -389,73 +364,42 @@ namespace te
 
     void Renderable::CreateAnimationBuffers()
     {
-        if (_animType == RenderableAnimType::Skinned)
-        {
-            SPtr<Skeleton> skeleton = _mesh->GetSkeleton();
-            UINT32 numBones = skeleton != nullptr ? skeleton->GetNumBones() : 0;
-
-            if (numBones > 0)
-            {
-                _boneMatrixBuffer = CreateBoneMatrixBuffer(numBones);
-
-                if (_properties.WriteVelocity)
-                    _bonePrevMatrixBuffer = CreateBoneMatrixBuffer(numBones);
-                else
-                    _bonePrevMatrixBuffer = nullptr;
-            }
-            else
-            {
-                _boneMatrixBuffer = nullptr;
-                _bonePrevMatrixBuffer = nullptr;
-            }
-        }
-        else
-        {
-            _boneMatrixBuffer = nullptr;
-            _bonePrevMatrixBuffer = nullptr;
-        }
+        // Bone matrices live in the animation manager's shared bone palette, we only need to forget our offsets into it
+        _boneMatrixOffset = (UINT32)-1;
+        _bonePrevMatrixOffset = (UINT32)-1;
     }
 
     void Renderable::UpdateAnimationBuffers(const EvaluatedAnimationData& animData)
     {
-        if (_animationId == (UINT64)-1)
+        if (_animationId == (UINT64)-1 || _animType != RenderableAnimType::Skinned)
             return;
 
-        const EvaluatedAnimationData::AnimInfo* animInfo = nullptr;
-
         auto iterFind = animData.Infos.find(_animationId);
-        if (iterFind != animData.Infos.end())
-            animInfo = &iterFind->second;
-
-        if (animInfo == nullptr)
-            return;
-
-        if (_animType == RenderableAnimType::Skinned)
+        if (iterFind == animData.Infos.end())
         {
-            const EvaluatedAnimationData::PoseInfo& poseInfo = animInfo->PoseInfos;
-
-            if (_properties.WriteVelocity)
-                std::swap(_boneMatrixBuffer, _bonePrevMatrixBuffer);
+            // Pose wasn't evaluated (e.g. culled), so whatever our old offsets point to now belongs to someone else
+            CreateAnimationBuffers();
+            return;
+        }
 
-            // Note: If multiple elements are using the same animation (not possible atm), this buffer should be shared by
-            // all such elements
-            UINT8* dest = (UINT8*)_boneMatrixBuffer->Lock(0, poseInfo.NumBones * 4 * sizeof(Vector4), GBL_WRITE_ONLY_DISCARD);
-            for (UINT32 j = 0; j < poseInfo.NumBones; j++)
-            {
-                const Matrix4& transform = animData.Transforms[poseInfo.StartIdx + j];
-                memcpy(dest, &transform, 16 * sizeof(float)); // Assuming row-major format
+        const EvaluatedAnimationData::PoseInfo& poseInfo = iterFind->second.PoseInfos;
+        _boneMatrixOffset = poseInfo.StartIdx;
 
-                dest += 16 * sizeof(float);
-            }
+        // If there is no previous pose, reuse the current one so no motion is reported
+        if (_properties.WriteVelocity && poseInfo.PrevStartIdx != (UINT32)-1)
+            _bonePrevMatrixOffset = poseInfo.PrevStartIdx;
+        else
+            _bonePrevMatrixOffset = (UINT32)-1;
+    }
 
-            _boneMatrixBuffer->Unlock();
-        }
+    const SPtr<GpuBuffer>& Renderable::GetBoneMatrixBuffer() const
+    {
+        return gAnimationManager().GetBonePalette();
     }
 
-    void Renderable::UpdatePrevFrameAnimationBuffers()
+    const SPtr<GpuBuffer>& Renderable::GetBonePrevMatrixBuffer() const
     {
-        if (_animType == RenderableAnimType::Skinned)
-            std::swap(_boneMatrixBuffer, _bonePrevMatrixBuffer);
+        return gAnimationManager().GetPrevBonePalette();
     }
 
     SPtr<Renderable> Renderable::Create()
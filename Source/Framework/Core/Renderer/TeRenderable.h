@@ -201,22 +201,32 @@ namespace te
         UINT64 GetAnimationId() const { return _animationId; }
 
         /**
-         * Updates internal animation buffers from the contents of the provided animation data object. Does nothing if
-         * renderable is not affected by animation.
+         * Looks up where the renderable's bones are stored in the animation manager's bone palette, using the provided
+         * animation data. Should be called once per frame before rendering. Does nothing if renderable is not affected by
+         * skeletal animation.
          */
         void UpdateAnimationBuffers(const EvaluatedAnimationData& animData);
 
         /**
-         * Records information about previous frame's animation buffer data. Should be called once per frame, before the
-         * call to UpdateAnimationBuffers().
+         * Returns the GPU buffer containing bone matrices of all skinned objects. Element's bones start at
+         * GetBoneMatrixOffset().
          */
-        void UpdatePrevFrameAnimationBuffers();
+        const SPtr<GpuBuffer>& GetBoneMatrixBuffer() const;
 
-        /** Returns the GPU buffer containing element's bone matrices, if it has any. */
-        const SPtr<GpuBuffer>& GetBoneMatrixBuffer() const { return _boneMatrixBuffer; }
+        /**
+         * Returns the GPU buffer containing bone matrices of all skinned objects for the previous frame. Element's bones
+         * start at GetBonePrevMatrixOffset().
+         */
+        const SPtr<GpuBuffer>& GetBonePrevMatrixBuffer() const;
+
+        /** Returns the index of the first bone in GetBoneMatrixBuffer(), or -1 if the renderable has no evaluated pose. */
+        UINT32 GetBoneMatrixOffset() const { return _boneMatrixOffset; }
 
-        /** Returns the GPU buffer containing element's bone matrices for the previous frame, if it has any. */
-        const SPtr<GpuBuffer>& GetBonePrevMatrixBuffer() const { return _bonePrevMatrixBuffer; }
+        /**
+         * Returns the index of the first bone in GetBonePrevMatrixBuffer(), or -1 if the previous pose is unknown, in
+         * which case the current pose should be used instead.
+         */
+        UINT32 GetBonePrevMatrixOffset() const { return _bonePrevMatrixOffset; }
 
         /**	Sets an ID that can be used for uniquely identifying this object by the renderer. */
         void SetRendererId(UINT32 id) { _rendererId = id; }
@@ -239,7 +249,7 @@ namespace te
         /**	Creates a new renderable instance without initializing it. */
         static SPtr<Renderable> CreateEmpty();
 
-        /** Creates any buffers required for renderable animation. Should be called whenever animation properties change. */
+        /** Resets any state required for renderable animation. Should be called whenever animation properties change. */
         void CreateAnimationBuffers();
 
     protected:
@@ -259,7 +269,7 @@ namespace te
         RenderableAnimType _animType = RenderableAnimType::None;
         SPtr<Animation> _animation;
         UINT64 _animationId;
-        SPtr<GpuBuffer> _boneMatrixBuffer;
-        SPtr<GpuBuffer> _bonePrevMatrixBuffer;
+        UINT32 _boneMatrixOffset = (UINT32)-1;
+        UINT32 _bonePrevMatrixOffset = (UINT32)-1;
     };
 }
@@ -11,6 +11,14 @@ namespace te
     struct PerFrameData
     {
         const EvaluatedAnimationData* Animation = nullptr;
+
+        /**
+         * Timings of the frame, captured when it was synced with the renderer. Rendering may happen on a separate thread
+         * while the next frame is simulated, so the renderer must use these instead of querying Time directly.
+         */
+        float Time = 0.0f;
+        float TimeDelta = 0.0f;
+        UINT64 FrameIdx = 0;
     };
 
     /**	Set of options that can be used for controlling the renderer. */
@@ -47,7 +55,11 @@ namespace te
         /** Name of the renderer. Used by materials to find an appropriate technique for this renderer. */
         virtual const String& GetName() const = 0;
 
-        /** Called in order to render all currently active cameras. */
+        /**
+         * Called in order to render all currently active cameras. Scene objects are synced with the renderer beforehand,
+         * and this may be called from the render thread, so implementations must only read the state captured by the
+         * Notify* methods, never the scene objects themselves.
+         */
         virtual void RenderAll(PerFrameData& perFrameData) = 0;
 
         /**	Sets options used for controlling the rendering. */
@@ -84,6 +96,12 @@ namespace te
          */
         virtual void NotifyRenderableRemoved(Renderable* renderable) { }
 
+        /**
+         * Called whenever the techniques of a material are replaced, for example when it switches to another shader
+         * variation. Renderables using the material must rebuild their elements and gpu params.
+         */
+        virtual void NotifyMaterialShaderChanged(Material* material) { }
+
         /**
          * Called whenever a new light is created.
          */
@@ -75,6 +75,9 @@ namespace te
         {
             if (_metaData.Instance == nullptr)
             {
+                if (_metaData.ShaderElem == nullptr)
+                    RendererMaterialManager::LoadShader(&_metaData);
+
                 RendererMaterialBase* mat = te_allocate<T>();
                 new (mat) T();
 
@@ -9,31 +9,7 @@ namespace te
     TE_MODULE_STATIC_MEMBER(RendererMaterialManager)
 
     RendererMaterialManager::RendererMaterialManager()
-    {
-        BuiltinResources& br = BuiltinResources::Instance();
-
-        // Note: Ideally I want to avoid loading all materials, and instead just load those that are used.
-        Vector<RendererMaterialData>& materials = GetMaterials();
-        Vector<SPtr<Shader>> shaders;
-        for (auto& material : materials)
-        {
-#if TE_PLATFORM == TE_PLATFORM_WIN32 //TODO to remove when OpenGL will be done
-            if (material.ShaderPath.type() == typeid(BuiltinShader))
-            {
-                HShader shader = br.GetBuiltinShader(std::any_cast<BuiltinShader>(material.ShaderPath));
-                shaders.push_back(shader.GetInternalPtr());
-            }
-            else
-            {
-                auto shaderImportOptions = ShaderImportOptions::Create();
-                HShader shader = gResourceManager().Load<Shader>(
-                    std::any_cast<String>(material.ShaderPath), shaderImportOptions);
-            }
-#endif
-        }
-
-        InitMaterials(shaders);
-    }
+    { }
 
     RendererMaterialManager::~RendererMaterialManager()
     { 
@@ -57,30 +33,44 @@ namespace te
 #endif
     }
 
-    void RendererMaterialManager::InitMaterials(const Vector<SPtr<Shader>>& shaders)
+    void RendererMaterialManager::LoadShader(RendererMaterialMetaData* metaData)
     {
+#if TE_PLATFORM == TE_PLATFORM_WIN32 //TODO to remove when OpenGL will be done
         Vector<RendererMaterialData>& materials = GetMaterials();
-        for (UINT32 i = 0; i < materials.size(); i++)
+        auto iterFind = std::find_if(materials.begin(), materials.end(),
+            [metaData](const RendererMaterialData& material) { return material.MetaData == metaData; });
+
+        if (iterFind == materials.end())
+            return;
+
+        HShader shader;
+        if (iterFind->ShaderPath.type() == typeid(BuiltinShader))
         {
-#if TE_PLATFORM == TE_PLATFORM_WIN32 //TODO to remove when OpenGL will be done
-            materials[i].ShaderPath = materials[i].ShaderPath;
-            materials[i].MetaData->ShaderElem = shaders[i];
+            shader = BuiltinResources::Instance().GetBuiltinShader(std::any_cast<BuiltinShader>(iterFind->ShaderPath));
+        }
+        else
+        {
+            auto shaderImportOptions = ShaderImportOptions::Create();
+            shader = gResourceManager().Load<Shader>(std::any_cast<String>(iterFind->ShaderPath), shaderImportOptions);
+        }
 
-            if (!shaders[i])
+        SPtr<Shader> shaderPtr = shader.GetHandleData() != nullptr ? shader.GetInternalPtr() : nullptr;
+        if (!shaderPtr)
+        {
+            if (iterFind->ShaderPath.type() == typeid(String))
             {
-                if (materials[i].ShaderPath.type() == typeid(String))
-                {
-                    TE_DEBUG("Failed to load renderer material: {" + std::any_cast<String>(materials[i].ShaderPath) + "}");
-                }
-                else
-                {
-                    TE_DEBUG("Failed to load renderer material: {" + ToString(std::any_cast<UINT32>(materials[i].ShaderPath)) + "}");
-                }
-
-                continue;
+                TE_DEBUG("Failed to load renderer material: {" + std::any_cast<String>(iterFind->ShaderPath) + "}");
             }
-#endif
+            else
+            {
+                TE_DEBUG("Failed to load renderer material: {" + ToString((UINT32)std::any_cast<BuiltinShader>(iterFind->ShaderPath)) + "}");
+            }
+
+            return;
         }
+
+        metaData->ShaderElem = shaderPtr;
+#endif
     }
 
     void RendererMaterialManager::DestroyMaterials()
@@ -17,7 +17,10 @@ namespace te
         std::any ShaderPath;
     };
 
-    /**	Initializes and handles all renderer materials. */
+    /**
+     * Handles all renderer materials. Shaders of registered materials are only resolved (and compiled) the first time
+     * the material is used, so materials that are never used cost nothing at start-up.
+     */
     class TE_CORE_EXPORT RendererMaterialManager : public Module<RendererMaterialManager>
     {
     public:
@@ -33,8 +36,8 @@ namespace te
         friend class RendererMaterial;
         friend class RendererMaterialBase;
 
-        /**	Initializes all materials on the core thread. */
-        static void InitMaterials(const Vector<SPtr<Shader>>& shaders);
+        /**	Resolves the shader of a registered material and assigns it to its meta-data. */
+        static void LoadShader(RendererMaterialMetaData* metaData);
 
         /**	Destroys all materials */
         static void DestroyMaterials();
@@ -2,6 +2,7 @@
 #include "Renderer/TeBlitMat.h"
 #include "RenderAPI/TeVertexDataDesc.h"
 #include "RenderAPI/TeRenderAPI.h"
+#include "RenderAPI/TeCommandBuffer.h"
 #include "Material/TeMaterial.h"
 #include "Material/TePass.h"
 #include "Mesh/TeMesh.h"
@@ -59,12 +60,102 @@ namespace te
     RendererUtility::~RendererUtility()
     { }
 
+    namespace
+    {
+        /**
+         * Shared implementations of the immediate and recorded rendering helpers. @p Context is either RenderAPI or
+         * CommandBuffer, which expose the same methods.
+         */
+        template<class Context>
+        void SetPassImpl(Context& context, const SPtr<Material>& material, UINT32 passIdx, UINT32 techniqueIdx)
+        {
+            SPtr<Pass> pass = material->GetPass(passIdx, techniqueIdx);
+            context.SetGraphicsPipeline(pass->GetGraphicsPipelineState());
+            context.SetStencilRef(pass->GetStencilRefValue());
+        }
+
+        template<class Context>
+        void SetPassParamsImpl(Context& context, const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags, bool isInstanced)
+        {
+            if (gpuParams == nullptr)
+                return;
+
+            if(isInstanced)
+                context.SetGpuParams(gpuParams, gpuParamsBindFlags, GPU_BIND_PARAM_BLOCK_ALL_EXCEPT, { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer" });
+            else
+                context.SetGpuParams(gpuParams, gpuParamsBindFlags, GPU_BIND_PARAM_BLOCK_ALL_EXCEPT, { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer", "PerInstanceBuffer"});
+        }
+
+        template<class Context>
+        void DrawImpl(Context& context, const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances, UINT32 lod)
+        {
+            SPtr<VertexData> vertexData = mesh->GetVertexData();
+
+            context.SetVertexDeclaration(mesh->GetVertexData()->vertexDeclaration);
+
+            auto& vertexBuffers = vertexData->GetBuffers();
+            if (vertexBuffers.size() > 0)
+            {
+                SPtr<VertexBuffer> buffers[TE_MAX_BOUND_VERTEX_BUFFERS];
+
+                UINT32 endSlot = 0;
+                UINT32 startSlot = TE_MAX_BOUND_VERTEX_BUFFERS;
+                for (auto iter = vertexBuffers.begin(); iter != vertexBuffers.end(); ++iter)
+                {
+                    if (iter->first >= TE_MAX_BOUND_VERTEX_BUFFERS)
+                        TE_ASSERT_ERROR(false, "Buffer index out of range");
+
+                    startSlot = std::min(iter->first, startSlot);
+                    endSlot = std::max(iter->first, endSlot);
+                }
+
+                for (auto iter = vertexBuffers.begin(); iter != vertexBuffers.end(); ++iter)
+                {
+                    buffers[iter->first - startSlot] = iter->second;
+                }
+
+                context.SetVertexBuffers(startSlot, buffers, endSlot - startSlot + 1);
+            }
+
+            SPtr<IndexBuffer> indexBuffer = mesh->GetIndexBuffer();
+            context.SetIndexBuffer(indexBuffer);
+
+            context.SetDrawOperation(subMesh.DrawOp);
+
+            UINT32 indexOffset = subMesh.IndexOffset;
+            UINT32 indexCount = subMesh.IndexCount;
+
+            // Simplified levels share the vertices of the sub-mesh, only the index range changes
+            if (lod > 0 && !subMesh.Lods.empty())
+            {
+                const SubMeshLod& subMeshLod = subMesh.Lods[std::min(lod, (UINT32)subMesh.Lods.size()) - 1];
+                indexOffset = subMeshLod.IndexOffset;
+                indexCount = subMeshLod.IndexCount;
+            }
+
+            if (numInstances > 1)
+            {
+                context.DrawIndexed(indexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
+                    vertexData->vertexCount, numInstances);
+            }
+            else
+            {
+                context.DrawIndexed(indexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
+                    vertexData->vertexCount, 0);
+            }
+
+            // mesh->_notifyUsedOnGPU(); TODO
+        }
+    }
+
     void RendererUtility::SetPass(const SPtr<Material>& material, UINT32 passIdx, UINT32 techniqueIdx)
     {
-        RenderAPI& rapi = RenderAPI::Instance();
-        SPtr<Pass> pass = material->GetPass(passIdx, techniqueIdx);
-        rapi.SetGraphicsPipeline(pass->GetGraphicsPipelineState());
-        rapi.SetStencilRef(pass->GetStencilRefValue());
+        SetPassImpl(RenderAPI::Instance(), material, passIdx, techniqueIdx);
+    }
+
+    void RendererUtility::SetPass(CommandBuffer& commandBuffer, const SPtr<Material>& material, UINT32 passIdx, UINT32 techniqueIdx)
+    {
+        SetPassImpl(commandBuffer, material, passIdx, techniqueIdx);
     }
 
     void RendererUtility::SetComputePass(const SPtr<Material>& material, UINT32 passIdx)
@@ -76,15 +167,13 @@ namespace te
 
     void RendererUtility::SetPassParams(const SPtr<GpuParams> gpuParams, UINT32 gpuParamsBindFlags, bool isInstanced)
     {
-        if (gpuParams == nullptr)
-            return;
-
-        RenderAPI& rapi = RenderAPI::Instance();
+        SetPassParamsImpl(RenderAPI::Instance(), gpuParams, gpuParamsBindFlags, isInstanced);
+    }
 
-        if(isInstanced)
-            rapi.SetGpuParams(gpuParams, gpuParamsBindFlags, GPU_BIND_PARAM_BLOCK_ALL_EXCEPT, { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer" });
-        else
-            rapi.SetGpuParams(gpuParams, gpuParamsBindFlags, GPU_BIND_PARAM_BLOCK_ALL_EXCEPT, { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer", "PerInstanceBuffer"});
+    void RendererUtility::SetPassParams(CommandBuffer& commandBuffer, const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+        bool isInstanced)
+    {
+        SetPassParamsImpl(commandBuffer, gpuParams, gpuParamsBindFlags, isInstanced);
     }
 
     void RendererUtility::Draw(const SPtr<Mesh>& mesh, UINT32 numInstances)
@@ -92,56 +181,15 @@ namespace te
         Draw(mesh, mesh->GetProperties().GetSubMesh(0), numInstances);
     }
 
-    void RendererUtility::Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances)
+    void RendererUtility::Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances, UINT32 lod)
     {
-        RenderAPI& rapi = RenderAPI::Instance();
-        SPtr<VertexData> vertexData = mesh->GetVertexData();
-
-        rapi.SetVertexDeclaration(mesh->GetVertexData()->vertexDeclaration);
-
-        auto& vertexBuffers = vertexData->GetBuffers();
-        if (vertexBuffers.size() > 0)
-        {
-            SPtr<VertexBuffer> buffers[TE_MAX_BOUND_VERTEX_BUFFERS];
-
-            UINT32 endSlot = 0;
-            UINT32 startSlot = TE_MAX_BOUND_VERTEX_BUFFERS;
-            for (auto iter = vertexBuffers.begin(); iter != vertexBuffers.end(); ++iter)
-            {
-                if (iter->first >= TE_MAX_BOUND_VERTEX_BUFFERS)
-                    TE_ASSERT_ERROR(false, "Buffer index out of range");
-
-                startSlot = std::min(iter->first, startSlot);
-                endSlot = std::max(iter->first, endSlot);
-            }
-
-            for (auto iter = vertexBuffers.begin(); iter != vertexBuffers.end(); ++iter)
-            {
-                buffers[iter->first - startSlot] = iter->second;
-            }
-
-            rapi.SetVertexBuffers(startSlot, buffers, endSlot - startSlot + 1);
-        }
-
-        SPtr<IndexBuffer> indexBuffer = mesh->GetIndexBuffer();
-        rapi.SetIndexBuffer(indexBuffer);
-
-        rapi.SetDrawOperation(subMesh.DrawOp);
-
-        UINT32 indexCount = subMesh.IndexCount;
-
-        if (numInstances > 1)
-        {
-            rapi.DrawIndexed(subMesh.IndexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
-                vertexData->vertexCount, numInstances);
-        }
-        else
-        {
-            rapi.DrawIndexed(subMesh.IndexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
-                vertexData->vertexCount, 0);
-        }
+        DrawImpl(RenderAPI::Instance(), mesh, subMesh, numInstances, lod);
+    }
 
-        // mesh->_notifyUsedOnGPU(); TODO
+    void RendererUtility::Draw(CommandBuffer& commandBuffer, const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances,
+        UINT32 lod)
+    {
+        DrawImpl(commandBuffer, mesh, subMesh, numInstances, lod);
     }
 
     void RendererUtility::DrawScreenQuad(const Rect2& uv, const Vector2I& textureSize, UINT32 numInstances, bool flipUV)
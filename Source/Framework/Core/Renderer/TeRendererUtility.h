@@ -29,6 +29,15 @@ namespace te
          */
         void SetPass(const SPtr<Material>& material, UINT32 passIdx, UINT32 techniqueIdx);
 
+        /**
+         * Records activation of the specified material pass into a command buffer.
+         *
+         * @copydetails SetPass(const SPtr<Material>&, UINT32, UINT32)
+         *
+         * @note	Thread safe, as long as the command buffer is not shared between threads.
+         */
+        void SetPass(CommandBuffer& commandBuffer, const SPtr<Material>& material, UINT32 passIdx, UINT32 techniqueIdx);
+
         /**
          * Activates the specified material pass for compute. Any further dispatch calls will be executed using this pass.
          *
@@ -50,6 +59,16 @@ namespace te
          */
         void SetPassParams(const SPtr<GpuParams> gpuParams, UINT32 gpuParamsBindFlags, bool isInstanced);
 
+        /**
+         * Records binding of parameters for the currently active pass into a command buffer.
+         *
+         * @copydetails SetPassParams(const SPtr<GpuParams>, UINT32, bool)
+         *
+         * @note	Thread safe, as long as the command buffer is not shared between threads.
+         */
+        void SetPassParams(CommandBuffer& commandBuffer, const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+            bool isInstanced);
+
         /**
          * Draws the specified mesh.
          *
@@ -66,10 +85,25 @@ namespace te
          * @param[in]	mesh			Mesh to draw.
          * @param[in]	subMesh			Portion of the mesh to draw.
          * @param[in]	numInstances	Number of times to draw the mesh using instanced rendering.
+         * @param[in]	lod				Level of detail of @p subMesh to draw. 0 draws the full detail sub-mesh.
          *
          * @note	Core thread.
          */
-        void Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances = 1);
+        void Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances = 1, UINT32 lod = 0);
+
+        /**
+         * Records a draw of the specified mesh into a command buffer.
+         *
+         * @param[in]	commandBuffer	Command buffer to record the draw into.
+         * @param[in]	mesh			Mesh to draw.
+         * @param[in]	subMesh			Portion of the mesh to draw.
+         * @param[in]	numInstances	Number of times to draw the mesh using instanced rendering.
+         * @param[in]	lod				Level of detail of @p subMesh to draw. 0 draws the full detail sub-mesh.
+         *
+         * @note	Thread safe, as long as the command buffer is not shared between threads.
+         */
+        void Draw(CommandBuffer& commandBuffer, const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances = 1,
+            UINT32 lod = 0);
 
         /**
          * Draws a quad over the entire viewport in normalized device coordinates.
@@ -3,6 +3,7 @@
 #include "Material/TeMaterial.h"
 #include "Material/TeTechnique.h"
 #include "Utility/TeFileStream.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
@@ -33,11 +34,9 @@ namespace te
         InitShaderBloom();
         InitShaderMotionBlur();
         InitShaderGaussianBlur();
-        InitShaderPicking();
-        InitShaderSelection();
-        InitShaderHudPicking();
-        InitShaderHudSelection();
         InitDefaultMaterial();
+
+        // Picking, selection and HUD shaders are only used by tools, they are created on first use by GetBuiltinShader()
 #endif
     }
 
@@ -77,18 +76,44 @@ namespace te
         case BuiltinShader::GaussianBlur:
             shader = _shaderGaussianBlur;
             break;
+#if TE_PLATFORM == TE_PLATFORM_WIN32 //TODO to remove when OpenGL will be done
         case BuiltinShader::Picking:
+            if (_shaderPicking.GetHandleData() == nullptr)
+            {
+                InitPickSelectGpuPrograms();
+                InitShaderPicking();
+            }
+
             shader = _shaderPicking;
             break;
         case BuiltinShader::HudPicking:
+            if (_shaderHudPicking.GetHandleData() == nullptr)
+            {
+                InitHudPickSelectGpuPrograms();
+                InitShaderHudPicking();
+            }
+
             shader = _shaderHudPicking;
             break;
         case BuiltinShader::Selection:
+            if (_shaderSelection.GetHandleData() == nullptr)
+            {
+                InitPickSelectGpuPrograms();
+                InitShaderSelection();
+            }
+
             shader = _shaderSelection;
             break;
         case BuiltinShader::HudSelection:
+            if (_shaderHudSelection.GetHandleData() == nullptr)
+            {
+                InitHudPickSelectGpuPrograms();
+                InitShaderHudSelection();
+            }
+
             shader = _shaderHudSelection;
             break;
+#endif
         default:
             break;
         }
@@ -113,197 +138,86 @@ namespace te
         return nullptr;
     }
 
-    void BuiltinResources::InitGpuPrograms()
+    void BuiltinResources::LoadGpuPrograms(const Vector<GpuProgramSource>& sources)
     {
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/Forward_VS.hlsl"));
-            _vertexShaderForwardDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderForwardDesc.EntryPoint = "main";
-            _vertexShaderForwardDesc.Language = "hlsl";
-            _vertexShaderForwardDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _vertexShaderForwardDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/Forward_PS.hlsl"));
-            _pixelShaderForwardDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderForwardDesc.EntryPoint = "main";
-            _pixelShaderForwardDesc.Language = "hlsl";
-            _pixelShaderForwardDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _pixelShaderForwardDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/Blit_VS.hlsl"));
-            _vertexShaderBlitDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderBlitDesc.EntryPoint = "main";
-            _vertexShaderBlitDesc.Language = "hlsl";
-            _vertexShaderBlitDesc.IncludePath = "";
-            _vertexShaderBlitDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/Blit_PS.hlsl"));
-            _pixelShaderBlitDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderBlitDesc.EntryPoint = "main";
-            _pixelShaderBlitDesc.Language = "hlsl";
-            _pixelShaderBlitDesc.IncludePath = "";
-            _pixelShaderBlitDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/Skybox_VS.hlsl"));
-            _vertexShaderSkyboxDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderSkyboxDesc.EntryPoint = "main";
-            _vertexShaderSkyboxDesc.Language = "hlsl";
-            _vertexShaderSkyboxDesc.IncludePath = "";
-            _vertexShaderSkyboxDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/Skybox_PS.hlsl"));
-            _pixelShaderSkyboxDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderSkyboxDesc.EntryPoint = "main";
-            _pixelShaderSkyboxDesc.Language = "hlsl";
-            _pixelShaderSkyboxDesc.IncludePath = "";
-            _pixelShaderSkyboxDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/FXAA_VS.hlsl"));
-            _vertexShaderFXAADesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderFXAADesc.EntryPoint = "main";
-            _vertexShaderFXAADesc.Language = "hlsl";
-            _vertexShaderFXAADesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _vertexShaderFXAADesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/FXAA_PS.hlsl"));
-            _pixelShaderFXAADesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderFXAADesc.EntryPoint = "main";
-            _pixelShaderFXAADesc.Language = "hlsl";
-            _pixelShaderFXAADesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _pixelShaderFXAADesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/ToneMapping_VS.hlsl"));
-            _vertexShaderToneMappingDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderToneMappingDesc.EntryPoint = "main";
-            _vertexShaderToneMappingDesc.Language = "hlsl";
-            _vertexShaderToneMappingDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _vertexShaderToneMappingDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/ToneMapping_PS.hlsl"));
-            _pixelShaderToneMappingDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderToneMappingDesc.EntryPoint = "main";
-            _pixelShaderToneMappingDesc.Language = "hlsl";
-            _pixelShaderToneMappingDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _pixelShaderToneMappingDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/Bloom_VS.hlsl"));
-            _vertexShaderBloomDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderBloomDesc.EntryPoint = "main";
-            _vertexShaderBloomDesc.Language = "hlsl";
-            _vertexShaderBloomDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _vertexShaderBloomDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/Bloom_PS.hlsl"));
-            _pixelShaderBloomDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderBloomDesc.EntryPoint = "main";
-            _pixelShaderBloomDesc.Language = "hlsl";
-            _pixelShaderBloomDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _pixelShaderBloomDesc.Source = shaderFile.GetAsString();
-        }
-
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/MotionBlur_VS.hlsl"));
-            _vertexShaderMotionBlurDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderMotionBlurDesc.EntryPoint = "main";
-            _vertexShaderMotionBlurDesc.Language = "hlsl";
-            _vertexShaderMotionBlurDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _vertexShaderMotionBlurDesc.Source = shaderFile.GetAsString();
-        }
+#if TE_PLATFORM == TE_PLATFORM_WIN32 //TODO to remove when OpenGL will be done
+        const bool compile = true;
+#else
+        const bool compile = false;
+#endif
 
+        // Reading and compiling programs is independent per program, so do it on all cores. The compiled bytecode is
+        // stored in the descriptor, so creating the programs later on (on this thread) doesn't need to compile again.
+        auto loadProgram = [&sources, compile](UINT32 idx)
         {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/MotionBlur_PS.hlsl"));
-            _pixelShaderMotionBlurDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderMotionBlurDesc.EntryPoint = "main";
-            _pixelShaderMotionBlurDesc.Language = "hlsl";
-            _pixelShaderMotionBlurDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _pixelShaderMotionBlurDesc.Source = shaderFile.GetAsString();
-        }
+            const GpuProgramSource& programSource = sources[idx];
+            GPU_PROGRAM_DESC& desc = *programSource.Desc;
 
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/GaussianBlur_VS.hlsl"));
-            _vertexShaderGaussianBlurDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderGaussianBlurDesc.EntryPoint = "main";
-            _vertexShaderGaussianBlurDesc.Language = "hlsl";
-            _vertexShaderGaussianBlurDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _vertexShaderGaussianBlurDesc.Source = shaderFile.GetAsString();
-        }
+            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/") + programSource.File);
+            desc.Type = programSource.Type;
+            desc.EntryPoint = "main";
+            desc.Language = "hlsl";
+            desc.IncludePath = programSource.UseIncludePath ? SHADERS_FOLDER + String("HLSL/") : "";
+            desc.Source = shaderFile.GetAsString();
 
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/GaussianBlur_PS.hlsl"));
-            _pixelShaderGaussianBlurDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderGaussianBlurDesc.EntryPoint = "main";
-            _pixelShaderGaussianBlurDesc.Language = "hlsl";
-            _pixelShaderGaussianBlurDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _pixelShaderGaussianBlurDesc.Source = shaderFile.GetAsString();
-        }
+            if (compile)
+                desc.Bytecode = GpuProgram::CompileBytecode(desc);
+        };
 
+        if (TaskScheduler::IsStarted())
+            gTaskScheduler().ParallelFor((UINT32)sources.size(), loadProgram);
+        else
         {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/PickSelect_VS.hlsl"));
-            _vertexShaderPickSelectDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderPickSelectDesc.EntryPoint = "main";
-            _vertexShaderPickSelectDesc.Language = "hlsl";
-            _vertexShaderPickSelectDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _vertexShaderPickSelectDesc.Source = shaderFile.GetAsString();
+            for (UINT32 i = 0; i < (UINT32)sources.size(); i++)
+                loadProgram(i);
         }
+    }
 
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/PickSelect_PS.hlsl"));
-            _pixelShaderPickSelectDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderPickSelectDesc.EntryPoint = "main";
-            _pixelShaderPickSelectDesc.Language = "hlsl";
-            _pixelShaderPickSelectDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _pixelShaderPickSelectDesc.Source = shaderFile.GetAsString();
-        }
+    void BuiltinResources::InitGpuPrograms()
+    {
+        LoadGpuPrograms({
+            { &_vertexShaderForwardDesc, "Forward_VS.hlsl", GPT_VERTEX_PROGRAM, true },
+            { &_pixelShaderForwardDesc, "Forward_PS.hlsl", GPT_PIXEL_PROGRAM, true },
+            { &_vertexShaderBlitDesc, "Blit_VS.hlsl", GPT_VERTEX_PROGRAM, false },
+            { &_pixelShaderBlitDesc, "Blit_PS.hlsl", GPT_PIXEL_PROGRAM, false },
+            { &_vertexShaderSkyboxDesc, "Skybox_VS.hlsl", GPT_VERTEX_PROGRAM, false },
+            { &_pixelShaderSkyboxDesc, "Skybox_PS.hlsl", GPT_PIXEL_PROGRAM, false },
+            { &_vertexShaderFXAADesc, "FXAA_VS.hlsl", GPT_VERTEX_PROGRAM, true },
+            { &_pixelShaderFXAADesc, "FXAA_PS.hlsl", GPT_PIXEL_PROGRAM, true },
+            { &_vertexShaderToneMappingDesc, "ToneMapping_VS.hlsl", GPT_VERTEX_PROGRAM, true },
+            { &_pixelShaderToneMappingDesc, "ToneMapping_PS.hlsl", GPT_PIXEL_PROGRAM, true },
+            { &_vertexShaderBloomDesc, "Bloom_VS.hlsl", GPT_VERTEX_PROGRAM, true },
+            { &_pixelShaderBloomDesc, "Bloom_PS.hlsl", GPT_PIXEL_PROGRAM, true },
+            { &_vertexShaderMotionBlurDesc, "MotionBlur_VS.hlsl", GPT_VERTEX_PROGRAM, true },
+            { &_pixelShaderMotionBlurDesc, "MotionBlur_PS.hlsl", GPT_PIXEL_PROGRAM, true },
+            { &_vertexShaderGaussianBlurDesc, "GaussianBlur_VS.hlsl", GPT_VERTEX_PROGRAM, true },
+            { &_pixelShaderGaussianBlurDesc, "GaussianBlur_PS.hlsl", GPT_PIXEL_PROGRAM, true }
+        });
+    }
 
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/HudPickSelect_VS.hlsl"));
-            _vertexShaderHudPickSelectDesc.Type = GPT_VERTEX_PROGRAM;
-            _vertexShaderHudPickSelectDesc.EntryPoint = "main";
-            _vertexShaderHudPickSelectDesc.Language = "hlsl";
-            _vertexShaderHudPickSelectDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _vertexShaderHudPickSelectDesc.Source = shaderFile.GetAsString();
-        }
+    void BuiltinResources::InitPickSelectGpuPrograms()
+    {
+        if (!_vertexShaderPickSelectDesc.Source.empty())
+            return;
 
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/HudPickSelect_GS.hlsl"));
-            _geometryShaderHudPickSelectDesc.Type = GPT_GEOMETRY_PROGRAM;
-            _geometryShaderHudPickSelectDesc.EntryPoint = "main";
-            _geometryShaderHudPickSelectDesc.Language = "hlsl";
-            _geometryShaderHudPickSelectDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _geometryShaderHudPickSelectDesc.Source = shaderFile.GetAsString();
-        }
+        LoadGpuPrograms({
+            { &_vertexShaderPickSelectDesc, "PickSelect_VS.hlsl", GPT_VERTEX_PROGRAM, true },
+            { &_pixelShaderPickSelectDesc, "PickSelect_PS.hlsl", GPT_PIXEL_PROGRAM, true }
+        });
+    }
 
-        {
-            FileStream shaderFile(SHADERS_FOLDER + String("HLSL/HudPickSelect_PS.hlsl"));
-            _pixelShaderHudPickSelectDesc.Type = GPT_PIXEL_PROGRAM;
-            _pixelShaderHudPickSelectDesc.EntryPoint = "main";
-            _pixelShaderHudPickSelectDesc.Language = "hlsl";
-            _pixelShaderHudPickSelectDesc.IncludePath = SHADERS_FOLDER + String("HLSL/");
-            _pixelShaderHudPickSelectDesc.Source = shaderFile.GetAsString();
-        }
+    void BuiltinResources::InitHudPickSelectGpuPrograms()
+    {
+        if (!_vertexShaderHudPickSelectDesc.Source.empty())
+            return;
+
+        LoadGpuPrograms({
+            { &_vertexShaderHudPickSelectDesc, "HudPickSelect_VS.hlsl", GPT_VERTEX_PROGRAM, true },
+            { &_geometryShaderHudPickSelectDesc, "HudPickSelect_GS.hlsl", GPT_GEOMETRY_PROGRAM, true },
+            { &_pixelShaderHudPickSelectDesc, "HudPickSelect_PS.hlsl", GPT_PIXEL_PROGRAM, true }
+        });
     }
+
     void BuiltinResources::InitStates()
     {
         _blendTransparentStateDesc.AlphaToCoverageEnable = false;
@@ -366,6 +280,11 @@ namespace te
             SHADER_DATA_PARAM_DESC gLayerDesc("gLayer", "gLayer", GPDT_INT1);
             SHADER_DATA_PARAM_DESC gHasAnimationDesc("gHasAnimation", "gHasAnimation", GPDT_INT1);
             SHADER_DATA_PARAM_DESC gWriteVelocityDesc("gWriteVelocity", "gWriteVelocity", GPDT_INT1);
+            SHADER_DATA_PARAM_DESC gBoneOffsetDesc("gBoneOffset", "gBoneOffset", GPDT_INT1);
+            SHADER_DATA_PARAM_DESC gPrevBoneOffsetDesc("gPrevBoneOffset", "gPrevBoneOffset", GPDT_INT1);
+            SHADER_DATA_PARAM_DESC gQuantizedDesc("gQuantized", "gQuantized", GPDT_INT1);
+            SHADER_DATA_PARAM_DESC gPositionScaleDesc("gPositionScale", "gPositionScale", GPDT_FLOAT4);
+            SHADER_DATA_PARAM_DESC gPositionOffsetDesc("gPositionOffset", "gPositionOffset", GPDT_FLOAT4);
 
             SHADER_DATA_PARAM_DESC gTime("gTime", "gTime", GPDT_FLOAT1);
             SHADER_DATA_PARAM_DESC gFrameDeltaDesc("gFrameDelta", "gFrameDelta", GPDT_FLOAT1);
@@ -373,8 +292,7 @@ namespace te
 
             SHADER_DATA_PARAM_DESC gMatWorldViewProj("gMatWorldViewProj", "gMatWorldViewProj", GPDT_MATRIX_4X4);
 
-            SHADER_DATA_PARAM_DESC gInstanceData("gInstanceData", "gInstanceData", GPDT_STRUCT);
-            gInstanceData.ElementSize = sizeof(PerInstanceData);
+            SHADER_DATA_PARAM_DESC gInstanceOffsetDesc("gInstanceOffset", "gInstanceOffset", GPDT_INT1);
 
             SHADER_DATA_PARAM_DESC gAmbient("gAmbient", "gAmbient", GPDT_FLOAT4);
             SHADER_DATA_PARAM_DESC gDiffuse("gDiffuse", "gDiffuse", GPDT_FLOAT4);
@@ -401,6 +319,8 @@ namespace te
             SHADER_DATA_PARAM_DESC gBumpScale("gBumScale", "gBumScale", GPDT_FLOAT1);
             SHADER_DATA_PARAM_DESC gParallaxScale("gParallaxScale", "gParallaxScale", GPDT_FLOAT1);
             SHADER_DATA_PARAM_DESC gAlphaThreshold("gAlphaThreshold", "gAlphaThreshold", GPDT_FLOAT1);
+            SHADER_DATA_PARAM_DESC gUsePrefilteredEnvironment("gUsePrefilteredEnvironment", "gUsePrefilteredEnvironment", GPDT_INT1);
+            SHADER_DATA_PARAM_DESC gIrradiance("gIrradiance", "gIrradiance", GPDT_FLOAT4, "", 9);
 
             SHADER_OBJECT_PARAM_DESC anisotropicSamplerDesc("AnisotropicSampler", "AnisotropicSampler", GPOT_SAMPLER2D);
 
@@ -429,7 +349,7 @@ namespace te
             _forwardShaderDesc.AddParameter(gClipToUVScaleOffsetDesc);
             _forwardShaderDesc.AddParameter(gUVToClipScaleOffsetDesc);
 
-            _forwardShaderDesc.AddParameter(gInstanceData);
+            _forwardShaderDesc.AddParameter(gInstanceOffsetDesc);
 
             _forwardShaderDesc.AddParameter(gMatWorldDesc);
             _forwardShaderDesc.AddParameter(gMatInvWorldDesc);
@@ -439,6 +359,11 @@ namespace te
             _forwardShaderDesc.AddParameter(gLayerDesc);
             _forwardShaderDesc.AddParameter(gHasAnimationDesc);
             _forwardShaderDesc.AddParameter(gWriteVelocityDesc);
+            _forwardShaderDesc.AddParameter(gBoneOffsetDesc);
+            _forwardShaderDesc.AddParameter(gPrevBoneOffsetDesc);
+            _forwardShaderDesc.AddParameter(gQuantizedDesc);
+            _forwardShaderDesc.AddParameter(gPositionScaleDesc);
+            _forwardShaderDesc.AddParameter(gPositionOffsetDesc);
             
             _forwardShaderDesc.AddParameter(gAmbient);
             _forwardShaderDesc.AddParameter(gDiffuse);
@@ -465,6 +390,8 @@ namespace te
             _forwardShaderDesc.AddParameter(gBumpScale);
             _forwardShaderDesc.AddParameter(gParallaxScale);
             _forwardShaderDesc.AddParameter(gAlphaThreshold);
+            _forwardShaderDesc.AddParameter(gUsePrefilteredEnvironment);
+            _forwardShaderDesc.AddParameter(gIrradiance);
 
             _forwardShaderDesc.AddParameter(gTime);
             _forwardShaderDesc.AddParameter(gFrameDeltaDesc);
@@ -487,6 +414,12 @@ namespace te
 
             _forwardShaderDesc.AddParameter(gLightsDesc);
             _forwardShaderDesc.AddParameter(gLightsNumberDesc);
+
+            _forwardShaderDesc.PermutationKeys = {
+                "USE_DIFFUSE_MAP", "USE_EMISSIVE_MAP", "USE_NORMAL_MAP", "USE_SPECULAR_MAP", "USE_BUMP_MAP",
+                "USE_PARALLAX_MAP", "USE_TRANSPARENCY_MAP", "USE_REFLECTION_MAP", "USE_OCCLUSION_MAP",
+                "USE_ENVIRONMENT_MAP"
+            };
         }
 
         {
@@ -664,6 +597,10 @@ namespace te
             SHADER_DATA_PARAM_DESC gMatWorldDesc("gMatWorld", "gMatWorld", GPDT_MATRIX_4X4);
             SHADER_DATA_PARAM_DESC gColorDesc("gColor", "gColor", GPDT_FLOAT4);
             SHADER_DATA_PARAM_DESC gHasAnimationDesc("gHasAnimation", "gHasAnimation", GPDT_INT1);
+            SHADER_DATA_PARAM_DESC gBoneOffsetDesc("gBoneOffset", "gBoneOffset", GPDT_INT1);
+            SHADER_DATA_PARAM_DESC gQuantizedDesc("gQuantized", "gQuantized", GPDT_INT1);
+            SHADER_DATA_PARAM_DESC gPositionScaleDesc("gPositionScale", "gPositionScale", GPDT_FLOAT4);
+            SHADER_DATA_PARAM_DESC gPositionOffsetDesc("gPositionOffset", "gPositionOffset", GPDT_FLOAT4);
 
             _pickSelectShaderDesc.AddParameter(gMatViewProjDesc);
             _hudPickSelectShaderDesc.AddParameter(gMatViewOriginDesc);
@@ -672,6 +609,10 @@ namespace te
             _pickSelectShaderDesc.AddParameter(gMatWorldDesc);
             _pickSelectShaderDesc.AddParameter(gColorDesc);
             _pickSelectShaderDesc.AddParameter(gHasAnimationDesc);
+            _pickSelectShaderDesc.AddParameter(gBoneOffsetDesc);
+            _pickSelectShaderDesc.AddParameter(gQuantizedDesc);
+            _pickSelectShaderDesc.AddParameter(gPositionScaleDesc);
+            _pickSelectShaderDesc.AddParameter(gPositionOffsetDesc);
         }
 
         {
@@ -952,17 +893,18 @@ namespace te
 
     void BuiltinResources::InitShaderSelection()
     {
-        _blendTransparentStateDesc.RenderTargetDesc[0].BlendEnable = true;
-        _blendTransparentStateDesc.RenderTargetDesc[0].SrcBlend = BlendFactor::BF_SOURCE_ALPHA;
-        _blendTransparentStateDesc.RenderTargetDesc[0].DstBlend = BlendFactor::BF_INV_SOURCE_ALPHA;
-        _blendTransparentStateDesc.RenderTargetDesc[0].BlendOp = BlendOperation::BO_MAX;
-        _blendTransparentStateDesc.RenderTargetDesc[0].SrcBlendAlpha = BlendFactor::BF_ZERO;
-        _blendTransparentStateDesc.RenderTargetDesc[0].DstBlendAlpha = BlendFactor::BF_ONE;
-        _blendTransparentStateDesc.RenderTargetDesc[0].BlendOpAlpha = BlendOperation::BO_ADD;
-        _blendTransparentStateDesc.RenderTargetDesc[0].RenderTargetWriteMask = 0x0f;
+        BLEND_STATE_DESC blendStateDesc = _blendTransparentStateDesc;
+        blendStateDesc.RenderTargetDesc[0].BlendEnable = true;
+        blendStateDesc.RenderTargetDesc[0].SrcBlend = BlendFactor::BF_SOURCE_ALPHA;
+        blendStateDesc.RenderTargetDesc[0].DstBlend = BlendFactor::BF_INV_SOURCE_ALPHA;
+        blendStateDesc.RenderTargetDesc[0].BlendOp = BlendOperation::BO_MAX;
+        blendStateDesc.RenderTargetDesc[0].SrcBlendAlpha = BlendFactor::BF_ZERO;
+        blendStateDesc.RenderTargetDesc[0].DstBlendAlpha = BlendFactor::BF_ONE;
+        blendStateDesc.RenderTargetDesc[0].BlendOpAlpha = BlendOperation::BO_ADD;
+        blendStateDesc.RenderTargetDesc[0].RenderTargetWriteMask = 0x0f;
 
         PASS_DESC passDesc;
-        passDesc.BlendStateDesc = _blendTransparentStateDesc;
+        passDesc.BlendStateDesc = blendStateDesc;
         passDesc.DepthStencilStateDesc = _depthStencilStateDesc;
         passDesc.RasterizerStateDesc = _rasterizerStateDesc;
         passDesc.VertexProgramDesc = _vertexShaderPickSelectDesc;
@@ -1007,17 +949,18 @@ namespace te
 
     void BuiltinResources::InitShaderHudSelection()
     {
-        _blendTransparentStateDesc.RenderTargetDesc[0].BlendEnable = true;
-        _blendTransparentStateDesc.RenderTargetDesc[0].SrcBlend = BlendFactor::BF_SOURCE_ALPHA;
-        _blendTransparentStateDesc.RenderTargetDesc[0].DstBlend = BlendFactor::BF_INV_SOURCE_ALPHA;
-        _blendTransparentStateDesc.RenderTargetDesc[0].BlendOp = BlendOperation::BO_ADD;
-        _blendTransparentStateDesc.RenderTargetDesc[0].SrcBlendAlpha = BlendFactor::BF_ZERO;
-        _blendTransparentStateDesc.RenderTargetDesc[0].DstBlendAlpha = BlendFactor::BF_ONE;
-        _blendTransparentStateDesc.RenderTargetDesc[0].BlendOpAlpha = BlendOperation::BO_ADD;
-        _blendTransparentStateDesc.RenderTargetDesc[0].RenderTargetWriteMask = 0x0f;
+        BLEND_STATE_DESC blendStateDesc = _blendTransparentStateDesc;
+        blendStateDesc.RenderTargetDesc[0].BlendEnable = true;
+        blendStateDesc.RenderTargetDesc[0].SrcBlend = BlendFactor::BF_SOURCE_ALPHA;
+        blendStateDesc.RenderTargetDesc[0].DstBlend = BlendFactor::BF_INV_SOURCE_ALPHA;
+        blendStateDesc.RenderTargetDesc[0].BlendOp = BlendOperation::BO_ADD;
+        blendStateDesc.RenderTargetDesc[0].SrcBlendAlpha = BlendFactor::BF_ZERO;
+        blendStateDesc.RenderTargetDesc[0].DstBlendAlpha = BlendFactor::BF_ONE;
+        blendStateDesc.RenderTargetDesc[0].BlendOpAlpha = BlendOperation::BO_ADD;
+        blendStateDesc.RenderTargetDesc[0].RenderTargetWriteMask = 0x0f;
 
         PASS_DESC passDesc;
-        passDesc.BlendStateDesc = _blendTransparentStateDesc;
+        passDesc.BlendStateDesc = blendStateDesc;
         passDesc.DepthStencilStateDesc = _depthStencilStateDesc;
         passDesc.RasterizerStateDesc = _rasterizerStateDesc;
         passDesc.VertexProgramDesc = _vertexShaderHudPickSelectDesc;
@@ -75,7 +75,10 @@ namespace te
         /** @copydoc Module::OnShutDown */
         void OnShutDown() override;
 
-        /**	Returns one of the builtin shader types. */
+        /**
+         * Returns one of the builtin shader types. Shaders only used by tools (picking, selection, HUD) are created the
+         * first time they are requested.
+         */
         HShader GetBuiltinShader(BuiltinShader type);
 
         /** If no material has been specified, it's useful to use the default one */
@@ -126,7 +129,21 @@ namespace te
         };
 
     private:
+        /** Information needed to load one of the builtin GPU programs. */
+        struct GpuProgramSource
+        {
+            GPU_PROGRAM_DESC* Desc;
+            const char* File; /**< Name of the file in the HLSL shaders folder. */
+            GpuProgramType Type;
+            bool UseIncludePath;
+        };
+
+        /** Reads the sources of the provided GPU programs, and compiles them if they are going to be used, in parallel. */
+        void LoadGpuPrograms(const Vector<GpuProgramSource>& sources);
+
         void InitGpuPrograms();
+        void InitPickSelectGpuPrograms();
+        void InitHudPickSelectGpuPrograms();
         void InitStates();
         void InitShaderDesc();
 
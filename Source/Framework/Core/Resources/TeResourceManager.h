@@ -105,13 +105,13 @@ namespace te
         Vector<HResource> FindByType(UINT32 type);
 
     public:
-        Event<void(const HResource&)> OnResourceLoaded;
+        LockFreeEvent<void(const HResource&)> OnResourceLoaded;
 
         /** Called when the resource has been destroyed. Provides UUID of the destroyed resource.*/
-        Event<void(const UUID&)> OnResourceDestroyed;
+        LockFreeEvent<void(const UUID&)> OnResourceDestroyed;
 
         /** Called when the internal resource the handle is pointing to has changed. */
-        Event<void(const HResource&)> OnResourceModified;
+        LockFreeEvent<void(const HResource&)> OnResourceModified;
 
     private:
         friend class ResourceHandleBase;
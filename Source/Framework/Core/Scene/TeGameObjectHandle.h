@@ -40,6 +40,10 @@ namespace te
      * This class exists because references between game objects should be quite loose. For example one game object should
      * be able to reference another one without the other one knowing. But if that is the case I also need to handle the
      * case when the other object we're referencing has been deleted, and that is the main purpose of this class.	
+     *
+     * @note
+     * The object is reached through handle data shared by all handles to it, without looking its instance ID up in the
+     * GameObjectManager. Sharing that data is also what allows restoring handles to re-created objects.
      */
     class TE_CORE_EXPORT GameObjectHandleBase
     {
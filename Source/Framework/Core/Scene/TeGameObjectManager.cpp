@@ -12,19 +12,23 @@ namespace te
 
     GameObjectHandleBase GameObjectManager::GetObjectHandle(UINT64 id) const
     {
-        const auto iterFind = _objects.find(id);
-        if (iterFind != _objects.end())
-            return iterFind->second;
+        Lock lock(_slotMutex);
+
+        const ObjectEntry* entry = FindEntry(id);
+        if (entry != nullptr)
+            return entry->Handle;
 
         return nullptr;
     }
 
     bool GameObjectManager::TryGetObjectHandle(UINT64 id, GameObjectHandleBase& object) const
     {
-        const auto iterFind = _objects.find(id);
-        if (iterFind != _objects.end())
+        Lock lock(_slotMutex);
+
+        const ObjectEntry* entry = FindEntry(id);
+        if (entry != nullptr)
         {
-            object = iterFind->second;
+            object = entry->Handle;
             return true;
         }
 
@@ -33,7 +37,8 @@ namespace te
 
     bool GameObjectManager::ObjectExists(UINT64 id) const
     {
-        return _objects.find(id) != _objects.end();
+        Lock lock(_slotMutex);
+        return FindEntry(id) != nullptr;
     }
 
     void GameObjectManager::RemapId(UINT64 oldId, UINT64 newId)
@@ -41,13 +46,29 @@ namespace te
         if (oldId == newId)
             return;
 
-        _objects[newId] = _objects[oldId];
-        _objects.erase(oldId);
+        Lock lock(_slotMutex);
+
+        ObjectEntry entry;
+        ObjectEntry* oldEntry = FindEntry(oldId);
+        if (oldEntry != nullptr)
+        {
+            entry = std::move(*oldEntry);
+            RemoveEntry(oldId);
+        }
+
+        // Live IDs resolve through the slot map, anything else (a reserved ID or a dead object's ID) needs a side entry
+        ObjectEntry* newEntry = _objects.Find(newId);
+        if (newEntry != nullptr)
+            *newEntry = std::move(entry);
+        else
+            _remappedObjects[newId] = std::move(entry);
     }
 
     UINT64 GameObjectManager::ReserveId()
     {
-        return _nextAvailableID.fetch_add(1, std::memory_order_relaxed);
+        // Nothing is stored until an object is remapped to the ID, so unused reservations cost nothing
+        const UINT32 generation = _nextReservedId.fetch_add(1, std::memory_order_relaxed);
+        return ((UINT64)generation << 32) | RESERVED_SLOT_INDEX;
     }
 
     void GameObjectManager::QueueForDestroy(const GameObjectHandleBase& object)
@@ -56,34 +77,99 @@ namespace te
             return;
 
         const UINT64 instanceId = object->GetInstanceId();
-        _queuedForDestroy[instanceId] = object;
+
+        Lock lock(_slotMutex);
+
+        ObjectEntry* entry = FindEntry(instanceId);
+        if (entry == nullptr || entry->QueuedForDestroy)
+            return;
+
+        entry->QueuedForDestroy = true;
+        _queuedForDestroy.push_back(instanceId);
     }
 
     void GameObjectManager::DestroyQueuedObjects()
     {
-        for (auto& objPair : _queuedForDestroy)
-            objPair.second->DestroyInternal(objPair.second, true);
+        // Objects queued while destroying will be handled by the next call
+        Vector<UINT64> queuedForDestroy;
+        {
+            Lock lock(_slotMutex);
+            std::swap(queuedForDestroy, _queuedForDestroy);
+        }
+
+        for (auto& id : queuedForDestroy)
+        {
+            // Copy the handle, as destroying the object removes its entry
+            GameObjectHandleBase handle;
+            {
+                Lock lock(_slotMutex);
+
+                // Might have been destroyed together with an object destroyed earlier in the loop (e.g. its parent)
+                ObjectEntry* entry = FindEntry(id);
+                if (entry == nullptr)
+                    continue;
 
-        _queuedForDestroy.clear();
+                handle = entry->Handle;
+            }
+
+            if (!handle.IsDestroyed())
+                handle->DestroyInternal(handle, true);
+        }
     }
 
     GameObjectHandleBase GameObjectManager::RegisterObject(const SPtr<GameObject>& object)
     {
-        const UINT64 id = _nextAvailableID.fetch_add(1, std::memory_order_relaxed);
+        Lock lock(_slotMutex);
+
+        const UINT64 id = _objects.Insert(ObjectEntry());
         object->Initialize(object, id);
 
         GameObjectHandleBase handle(object);
-        {
-            _objects[id] = handle;
-        }
+        _objects.Find(id)->Handle = handle;
 
         return handle;
     }
 
     void GameObjectManager::UnregisterObject(GameObjectHandleBase& object)
     {
-        _objects.erase(object->GetInstanceId());
+        {
+            Lock lock(_slotMutex);
+            RemoveEntry(object->GetInstanceId());
+        }
+
         OnDestroyed(static_object_cast<GameObject>(object));
         object.Destroy();
     }
+
+    GameObjectManager::ObjectEntry* GameObjectManager::FindEntry(UINT64 id)
+    {
+        ObjectEntry* entry = _objects.Find(id);
+        if (entry != nullptr || _remappedObjects.empty())
+            return entry;
+
+        auto iterFind = _remappedObjects.find(id);
+        if (iterFind != _remappedObjects.end())
+            return &iterFind->second;
+
+        return nullptr;
+    }
+
+    const GameObjectManager::ObjectEntry* GameObjectManager::FindEntry(UINT64 id) const
+    {
+        const ObjectEntry* entry = _objects.Find(id);
+        if (entry != nullptr || _remappedObjects.empty())
+            return entry;
+
+        auto iterFind = _remappedObjects.find(id);
+        if (iterFind != _remappedObjects.end())
+            return &iterFind->second;
+
+        return nullptr;
+    }
+
+    void GameObjectManager::RemoveEntry(UINT64 id)
+    {
+        if (!_objects.Remove(id))
+            _remappedObjects.erase(id);
+    }
 }
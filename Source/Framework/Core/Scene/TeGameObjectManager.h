@@ -4,11 +4,20 @@
 #include "Utility/TeModule.h"
 #include "Scene/TeGameObject.h"
 #include "Utility/TeEvent.h"
+#include "Utility/TeSlotMap.h"
+#include "Threading/TeThreading.h"
 
 namespace te
 {
     /**
      * Tracks GameObject creation and destructions. Also resolves GameObject references from GameObject handles.
+     *
+     * Instance IDs are slot map identifiers (slot index and generation), so looking an object up by ID is a direct array
+     * lookup and IDs of destroyed objects never resolve to objects created later. IDs handed out by ReserveId() live
+     * outside of the slot map and only take up space once an object is remapped to them.
+     *
+     * Dereferencing a GameObjectHandle doesn't go through the manager, handles reach their object through the instance
+     * data shared by all handles to it. The slot map only serves lookups by ID.
      */
     class TE_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
     {
@@ -52,7 +61,8 @@ namespace te
         bool ObjectExists(UINT64 id) const;
 
         /**
-         * Changes the instance ID by which an object can be retrieved by.
+         * Changes the instance ID by which an object can be retrieved by. @p newId can be an ID returned by ReserveId()
+         * or an ID of an object that no longer exists (e.g. when restoring handles to a destroyed object).
          *
          * @note	Caller is required to update the object itself with the new ID.
          * @note	Thread safe.
@@ -60,7 +70,8 @@ namespace te
         void RemapId(UINT64 oldId, UINT64 newId);
 
         /**
-         * Allocates a new unique game object ID.
+         * Allocates a new unique game object ID. The ID doesn't resolve to any object until an object is remapped to it
+         * using RemapId().
          *
          * @note	Thread safe.
          */
@@ -76,8 +87,39 @@ namespace te
         Event<void(const HGameObject&)> OnDestroyed;
 
     private:
-        std::atomic<UINT64> _nextAvailableID = { 1 }; // 0 is not a valid ID
-        Map<UINT64, GameObjectHandleBase> _objects;
-        Map<UINT64, GameObjectHandleBase> _queuedForDestroy;
+        /**
+         * Slot index used by IDs returned from ReserveId(). The slot map never grows that large, so reserved IDs can't
+         * collide with IDs of registered objects.
+         */
+        static constexpr UINT64 RESERVED_SLOT_INDEX = 0xFFFFFFFF;
+
+        /** Information about a single registered GameObject. */
+        struct ObjectEntry
+        {
+            GameObjectHandleBase Handle;
+            bool QueuedForDestroy = false;
+        };
+
+        /**
+         * Returns the entry registered under the provided ID, or null if there is none. Caller must hold _slotMutex and
+         * not use the entry after releasing it, as registering other objects may move it.
+         */
+        ObjectEntry* FindEntry(UINT64 id);
+
+        /** @copydoc FindEntry */
+        const ObjectEntry* FindEntry(UINT64 id) const;
+
+        /** Removes the entry registered under the provided ID, if any. Caller must hold _slotMutex. */
+        void RemoveEntry(UINT64 id);
+
+    private:
+        SlotMap<ObjectEntry> _objects;
+
+        /** Objects remapped to reserved IDs or IDs that no longer belong to a live slot. Rare, so a plain map is fine. */
+        UnorderedMap<UINT64, ObjectEntry> _remappedObjects;
+
+        Vector<UINT64> _queuedForDestroy;
+        std::atomic<UINT32> _nextReservedId = { 1 };
+        mutable Mutex _slotMutex;
     };
 }
@@ -1,6 +1,7 @@
 #include "TeSceneManager.h"
 #include "Renderer/TeCamera.h"
 #include "TeCoreApplication.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
@@ -12,6 +13,9 @@ namespace te
         UninitializedList = 3
     };
 
+    /** Number of components updated by a single job when a component type is updated in parallel. */
+    static constexpr UINT32 PARALLEL_UPDATE_BATCH_SIZE = 256;
+
     struct ScopeToggle
     {
         explicit ScopeToggle(bool& val) : val(val) { val = true; }
@@ -39,7 +43,8 @@ namespace te
 
         _mainCameras.clear();
         _cameras.clear();
-        _components.clear();
+        _componentBuckets.clear();
+        _componentBucketIndices.clear();
         _mainRTResizedConn.Disconnect();
     }
 
@@ -198,10 +203,19 @@ namespace te
         // TODO
     }
 
+    void SceneManager::SetParallelUpdate(UINT32 componentType, bool enabled)
+    {
+        GetOrCreateBucket(componentType).ParallelUpdate = enabled;
+    }
+
     void SceneManager::_notifyComponentCreated(const HComponent& component)
     {
         component->OnCreated();
-        _components.push_back(component);
+
+        ComponentBucket& bucket = GetOrCreateBucket(component->GetCoreType());
+        component->SetSceneManagerId((UINT32)bucket.Handles.size());
+        bucket.Handles.push_back(component);
+        bucket.Objects.push_back(component.Get());
     }
 
     void SceneManager::_notifyComponentActivated(const HComponent& component, bool triggerEvent)
@@ -226,11 +240,36 @@ namespace te
         component->OnDestroyed();
 
         // TODO immediate not used here as every destruction is automatically immediate
-        auto co = std::find(_components.begin(), _components.end(), component);
-        if (co != _components.end())
+        auto iterFind = _componentBucketIndices.find(component->GetCoreType());
+        if (iterFind == _componentBucketIndices.end())
+            return;
+
+        ComponentBucket& bucket = *_componentBuckets[iterFind->second];
+        const UINT32 idx = component->GetSceneManagerId();
+
+        // Components that were never reported as created have no entry
+        if (idx >= (UINT32)bucket.Handles.size() || bucket.Handles[idx] != component)
+            return;
+
+        if (_isUpdatingComponents)
+        {
+            // Don't move components around while they are being iterated over, remove the hole once the update ends
+            bucket.Handles[idx] = HComponent();
+            bucket.Objects[idx] = nullptr;
+            bucket.NumPendingRemovals++;
+            return;
+        }
+
+        const UINT32 lastIdx = (UINT32)bucket.Handles.size() - 1;
+        if (idx != lastIdx)
         {
-            _components.erase(co);
+            bucket.Handles[idx] = std::move(bucket.Handles[lastIdx]);
+            bucket.Objects[idx] = bucket.Objects[lastIdx];
+            bucket.Objects[idx]->SetSceneManagerId(idx);
         }
+
+        bucket.Handles.pop_back();
+        bucket.Objects.pop_back();
     }
 
     bool SceneManager::IsComponentOfType(const HComponent& component, UINT32 id)
@@ -238,10 +277,104 @@ namespace te
         return component->GetCoreType() == id;
     }
 
+    SceneManager::ComponentBucket& SceneManager::GetOrCreateBucket(UINT32 componentType)
+    {
+        auto iterFind = _componentBucketIndices.find(componentType);
+        if (iterFind != _componentBucketIndices.end())
+            return *_componentBuckets[iterFind->second];
+
+        _componentBucketIndices[componentType] = (UINT32)_componentBuckets.size();
+        _componentBuckets.push_back(te_unique_ptr_new<ComponentBucket>());
+
+        ComponentBucket& bucket = *_componentBuckets.back();
+        bucket.Type = componentType;
+
+        return bucket;
+    }
+
+    const SceneManager::ComponentBucket* SceneManager::FindBucket(UINT32 componentType) const
+    {
+        auto iterFind = _componentBucketIndices.find(componentType);
+        if (iterFind != _componentBucketIndices.end())
+            return _componentBuckets[iterFind->second].get();
+
+        return nullptr;
+    }
+
+    void SceneManager::UpdateBucket(ComponentBucket& bucket)
+    {
+        // Components created during the update will get their first update next frame
+        const UINT32 numComponents = (UINT32)bucket.Objects.size();
+
+        if (bucket.ParallelUpdate && numComponents > PARALLEL_UPDATE_BATCH_SIZE && TaskScheduler::IsStarted())
+        {
+            const UINT32 numBatches = (numComponents + PARALLEL_UPDATE_BATCH_SIZE - 1) / PARALLEL_UPDATE_BATCH_SIZE;
+            Component** objects = bucket.Objects.data();
+
+            gTaskScheduler().ParallelFor(numBatches, [objects, numComponents](UINT32 batchIdx)
+            {
+                const UINT32 start = batchIdx * PARALLEL_UPDATE_BATCH_SIZE;
+                const UINT32 end = std::min(start + PARALLEL_UPDATE_BATCH_SIZE, numComponents);
+
+                // Components destroyed earlier in the frame are only removed from the bucket once all buckets updated
+                for (UINT32 i = start; i < end; i++)
+                {
+                    if (objects[i] != nullptr)
+                        objects[i]->Update();
+                }
+            });
+
+            return;
+        }
+
+        // Index every iteration, an update might create a component of the same type and grow the bucket
+        for (UINT32 i = 0; i < numComponents; i++)
+        {
+            Component* component = bucket.Objects[i];
+            if (component != nullptr)
+                component->Update();
+        }
+    }
+
+    void SceneManager::CompactBucket(ComponentBucket& bucket)
+    {
+        UINT32 numLive = 0;
+        for (UINT32 i = 0; i < (UINT32)bucket.Objects.size(); i++)
+        {
+            if (bucket.Objects[i] == nullptr)
+                continue;
+
+            if (i != numLive)
+            {
+                bucket.Handles[numLive] = std::move(bucket.Handles[i]);
+                bucket.Objects[numLive] = bucket.Objects[i];
+                bucket.Objects[numLive]->SetSceneManagerId(numLive);
+            }
+
+            numLive++;
+        }
+
+        bucket.Handles.resize(numLive);
+        bucket.Objects.resize(numLive);
+        bucket.NumPendingRemovals = 0;
+    }
+
     void SceneManager::_update()
     {
-        for (auto& entry : _components)
-            entry->Update();
+        {
+            ScopeToggle updatingToggle(_isUpdatingComponents);
+
+            // Buckets created during the update only contain new components, they'll be updated next frame
+            const UINT32 numBuckets = (UINT32)_componentBuckets.size();
+            for (UINT32 i = 0; i < numBuckets; i++)
+                UpdateBucket(*_componentBuckets[i]);
+        }
+
+        for (auto& bucket : _componentBuckets)
+        {
+            if (bucket->NumPendingRemovals > 0)
+                CompactBucket(*bucket);
+        }
 
         GameObjectManager::Instance().DestroyQueuedObjects();
     }
@@ -25,6 +25,55 @@ namespace te
         HSceneObject So;
     };
 
+    /**
+     * Read-only view over all components of a single type registered with the SceneManager. The view references the
+     * SceneManager's own storage, so it is cheap to create but only valid until components are added or removed.
+     *
+     * @note	Components destroyed immediately while components are being updated show up as empty handles until the
+     *			update finishes.
+     */
+    template<class T>
+    class ComponentView
+    {
+    public:
+        /** Iterates over the components in the view, returning handles of the viewed type. */
+        class Iterator
+        {
+        public:
+            Iterator(const HComponent* entry)
+                : _entry(entry)
+            { }
+
+            GameObjectHandle<T> operator*() const { return static_object_cast<T>(*_entry); }
+            Iterator& operator++() { ++_entry; return *this; }
+            bool operator!=(const Iterator& other) const { return _entry != other._entry; }
+            bool operator==(const Iterator& other) const { return _entry == other._entry; }
+
+        private:
+            const HComponent* _entry;
+        };
+
+        ComponentView() = default;
+        ComponentView(const Vector<HComponent>* components)
+            : _components(components)
+        { }
+
+        /** Returns the number of components in the view. */
+        size_t size() const { return _components != nullptr ? _components->size() : 0; }
+
+        /** Checks is the view empty. */
+        bool empty() const { return size() == 0; }
+
+        /** Returns the component at the specified index. */
+        GameObjectHandle<T> operator[](size_t idx) const { return static_object_cast<T>((*_components)[idx]); }
+
+        Iterator begin() const { return Iterator(_components != nullptr ? _components->data() : nullptr); }
+        Iterator end() const { return Iterator(_components != nullptr ? _components->data() + _components->size() : nullptr); }
+
+    private:
+        const Vector<HComponent>* _components = nullptr;
+    };
+
     /** Contains information about an instantiated scene. */
     class TE_CORE_EXPORT SceneInstance
     {
@@ -74,13 +123,31 @@ namespace te
         bool IsRunning() const { return _componentState == ComponentState::Running; }
 
         /**
-         * Returns a list of all components of the specified type currently in the scene.
+         * Returns all components of the specified type currently in the scene. Only components whose type matches
+         * exactly are returned (derived types are not included).
          *
          * @tparam		T			Type of the component to search for.
-         * @return					A list of all matching components in the scene.
+         * @return					A view over all matching components in the scene. See ComponentView for how long
+         *							the view stays valid.
          */
         template<class T>
-        Vector<GameObjectHandle<T>> FindComponents();
+        ComponentView<T> FindComponents() const;
+
+        /**
+         * Allows components of the specified type to be updated in parallel from multiple threads. Only enable this for
+         * component types whose Update() touches nothing but the component's own data (in particular it must not
+         * create or destroy components or scene objects). Creating or destroying components of the same type is never
+         * allowed from a parallel update, batches read directly from the bucket's storage which would be reallocated.
+         * Components destroyed earlier in the frame, by another bucket's update, are skipped.
+         *
+         * @param[in]	componentType	Type id of the component, as returned by Component::GetCoreType().
+         * @param[in]	enabled			True to update components of this type in parallel, false to update them serially.
+         */
+        void SetParallelUpdate(UINT32 componentType, bool enabled);
+
+        /** @copydoc SetParallelUpdate(UINT32, bool) */
+        template<class T>
+        void SetParallelUpdate(bool enabled) { SetParallelUpdate(T::GetComponentType(), enabled); }
 
         /** Returns all cameras in the scene. */
         const UnorderedMap<Camera*, SPtr<Camera>>& GetAllCameras() const { return _cameras; }
@@ -170,6 +237,31 @@ namespace te
         /** Checks does the specified component type match the provided id. */
         static bool IsComponentOfType(const HComponent& component, UINT32 id);
 
+        /**
+         * All components of a single type. Components are stored contiguously and the index of each component within
+         * the bucket is stored as the component's scene manager id, so removal is a swap with the last element.
+         */
+        struct ComponentBucket
+        {
+            UINT32 Type = 0;
+            Vector<HComponent> Handles;
+            Vector<Component*> Objects; /**< Same components as in Handles, so updates can skip handle indirection. */
+            UINT32 NumPendingRemovals = 0;
+            bool ParallelUpdate = false;
+        };
+
+        /** Returns the bucket storing components of the provided type, creating it if it doesn't exist. */
+        ComponentBucket& GetOrCreateBucket(UINT32 componentType);
+
+        /** Returns the bucket storing components of the provided type, or null if there is none. */
+        const ComponentBucket* FindBucket(UINT32 componentType) const;
+
+        /** Updates all components in the bucket that existed when the update started. */
+        void UpdateBucket(ComponentBucket& bucket);
+
+        /** Removes entries of components that were destroyed while components were being updated. */
+        void CompactBucket(ComponentBucket& bucket);
+
     protected:
         SPtr<SceneInstance> _mainScene;
 
@@ -177,7 +269,9 @@ namespace te
         UnorderedMap<Camera*, SPtr<Camera>> _cameras;
         Vector<SPtr<Camera>> _mainCameras;
 
-        Vector<HComponent> _components;
+        Vector<UPtr<ComponentBucket>> _componentBuckets;
+        UnorderedMap<UINT32, UINT32> _componentBucketIndices;
+        bool _isUpdatingComponents = false;
 
         SPtr<RenderTarget> _mainRenderTarget;
         HEvent _mainRTResizedConn;
@@ -186,18 +280,13 @@ namespace te
     };
 
     template<class T>
-    Vector<GameObjectHandle<T>> SceneManager::FindComponents()
+    ComponentView<T> SceneManager::FindComponents() const
     {
-        UINT32 typeId = T::GetComponentType();
-
-        Vector<GameObjectHandle<T>> output;
-        for (auto& entry : _components)
-        {
-            if (IsComponentOfType(entry, typeId))
-                output.push_back(static_object_cast<T>(entry));
-        }
+        const ComponentBucket* bucket = FindBucket(T::GetComponentType());
+        if (bucket == nullptr)
+            return ComponentView<T>();
 
-        return output;
+        return ComponentView<T>(&bucket->Handles);
     }
 
     /** Provides easy access to the SceneManager. */
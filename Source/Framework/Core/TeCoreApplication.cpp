@@ -4,6 +4,7 @@
 #include "Utility/TeTime.h"
 #include "Utility/TeDynLibManager.h"
 #include "Utility/TeDynLib.h"
+#include "Threading/TeTaskScheduler.h"
 
 #include "Manager/TePluginManager.h"
 #include "Manager/TeRenderAPIManager.h"
@@ -54,6 +55,7 @@ namespace te
         Platform::StartUp();
         Console::StartUp();
         Time::StartUp();
+        TaskScheduler::StartUp();
         DynLibManager::StartUp();
         CoreObjectManager::StartUp();
         RenderAPIManager::StartUp();
@@ -99,11 +101,15 @@ namespace te
             LoadPlugin(importerName);
         }
 
+        StartUpRenderThread();
+
         PostStartUp();
     }
     
     void CoreApplication::OnShutDown()
     {
+        ShutDownRenderThread();
+
         PreShutDown();
 
         _window = nullptr;
@@ -128,6 +134,7 @@ namespace te
         CoreObjectManager::ShutDown();
         Platform::ShutDown();
         DynLibManager::ShutDown();
+        TaskScheduler::ShutDown();
         Time::ShutDown();
         Console::ShutDown();
     }
@@ -143,10 +150,11 @@ namespace te
             gInput().Update();
             gInput().TriggerCallbacks();
             gVirtualInput().Update();
-            _window->TriggerCallback();
 
             if(_pause)
             {
+                WaitUntilFrameRendered();
+                _window->TriggerCallback();
                 TE_SLEEP(100);
                 continue;
             }
@@ -165,16 +173,115 @@ namespace te
             gScriptManager().PostUpdate();
             PostUpdate();
 
+            // Everything above may overlap with the render thread rendering the previous frame. Everything below
+            // modifies state it reads, so from here on that frame must be finished.
+            WaitUntilFrameRendered();
+
+            // Resizing a window resizes its swap chain, which is only safe while nothing renders to it
+            _window->TriggerCallback();
+
             _perFrameData->Animation = AnimationManager::Instance().Update();
+            _perFrameData->Time = gTime().GetTime();
+            _perFrameData->TimeDelta = gTime().GetFrameDelta();
+            _perFrameData->FrameIdx = gTime().GetFrameIdx();
 
             DisplayFrameRate();
 
             RendererManager::Instance().GetRenderer()->Update();
-            RendererManager::Instance().GetRenderer()->RenderAll(*_perFrameData);
+            CoreObjectManager::Instance().FrameSync();
+
+            RenderFrame();
 
             gScriptManager().PostRender();
             PostRender();
         }
+
+        WaitUntilFrameRendered();
+    }
+
+    void CoreApplication::StartUpRenderThread()
+    {
+        if (!_startUpDesc.RenderThread)
+            return;
+
+        if (!RenderAPI::Instance().EnableMultithreadedAccess())
+        {
+            TE_DEBUG("Render thread requested, but the render API doesn't support it. Rendering on the main thread.");
+            return;
+        }
+
+        _renderThreadShutDown = false;
+        _frameInFlight = false;
+        _renderThread = Thread(&CoreApplication::RenderThreadMain, this);
+        _renderThreadId = _renderThread.get_id();
+        _renderThreadActive = true;
+    }
+
+    void CoreApplication::ShutDownRenderThread()
+    {
+        if (!_renderThreadActive)
+            return;
+
+        {
+            Lock lock(_renderThreadMutex);
+            _renderThreadShutDown = true;
+        }
+
+        _renderThreadSignal.notify_all();
+        _renderThread.join();
+
+        _renderThreadActive = false;
+    }
+
+    void CoreApplication::RenderThreadMain()
+    {
+        while (true)
+        {
+            {
+                Lock lock(_renderThreadMutex);
+                _renderThreadSignal.wait(lock, [this]() { return _frameInFlight || _renderThreadShutDown; });
+
+                // Shut down only once idle, a submitted frame is always rendered
+                if (!_frameInFlight)
+                    break;
+            }
+
+            RendererManager::Instance().GetRenderer()->RenderAll(*_perFrameData);
+
+            {
+                Lock lock(_renderThreadMutex);
+                _frameInFlight = false;
+            }
+
+            _renderThreadSignal.notify_all();
+        }
+    }
+
+    void CoreApplication::RenderFrame()
+    {
+        // Gui frames are built by the main thread during the simulation, and ImGui state can't be shared with another
+        // thread, so frames drawing any gui are rendered immediately
+        if (!_renderThreadActive || (_gui != nullptr && _gui->IsGuiStarted()))
+        {
+            RendererManager::Instance().GetRenderer()->RenderAll(*_perFrameData);
+            return;
+        }
+
+        {
+            Lock lock(_renderThreadMutex);
+            _frameInFlight = true;
+        }
+
+        _renderThreadSignal.notify_all();
+    }
+
+    void CoreApplication::WaitUntilFrameRendered()
+    {
+        if (!_renderThreadActive || TE_THREAD_CURRENT_ID == _renderThreadId)
+            return;
+
+        Lock lock(_renderThreadMutex);
+        _renderThreadSignal.wait(lock, [this]() { return !_frameInFlight; });
     }
 
     void CoreApplication::StopMainLoop()
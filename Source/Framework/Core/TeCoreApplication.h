@@ -20,6 +20,12 @@ namespace te
         RENDER_WINDOW_DESC WindowDesc; /** Describes the window to create during start-up. */
 
         Vector<String> Importers; /** A list of importer plugins to load. */
+
+        /**
+         * Renders each frame on a dedicated thread while the main thread simulates the next one. Ignored if the render
+         * API can't be used from another thread.
+         */
+        bool RenderThread = false;
     };
 
     /** Represents the current state of the application */
@@ -115,6 +121,16 @@ namespace te
         /** Returns data computed at each frame */
         const SPtr<PerFrameData> GetPerFrameData() const { return _perFrameData; }
 
+        /** Checks whether frames are rendered on a dedicated render thread. */
+        bool IsRenderThreadActive() const { return _renderThreadActive; }
+
+        /**
+         * Blocks until the render thread finishes the frame it is currently rendering, if any. Must be called from the
+         * main thread before modifying state the renderer reads while rendering, outside of the frame sync. Does nothing
+         * if called from the render thread itself, or if the render thread isn't active.
+         */
+        void WaitUntilFrameRendered();
+
         /**
          * Loads a plugin.
          *
@@ -150,6 +166,21 @@ namespace te
         /** Call before core shutdown */
         virtual void PreShutDown() { }
 
+        /** Starts the render thread, if requested in the start-up description and supported by the render API. */
+        void StartUpRenderThread();
+
+        /** Waits until the frame in flight is rendered, then stops and joins the render thread. */
+        void ShutDownRenderThread();
+
+        /** Entry point of the render thread. Renders each frame submitted by RenderFrame() until shut down. */
+        void RenderThreadMain();
+
+        /**
+         * Renders the frame that was just synced with the renderer. If the render thread is active, the frame is handed
+         * over to it and the method returns immediately.
+         */
+        void RenderFrame();
+
     protected:
         typedef void(*UpdatePluginFunc)();
 
@@ -175,6 +206,14 @@ namespace te
         ApplicationState _state;
 
         SPtr<PerFrameData> _perFrameData;
+
+        Thread _renderThread;
+        ThreadId _renderThreadId;
+        Mutex _renderThreadMutex;
+        Signal _renderThreadSignal;
+        bool _renderThreadActive = false;
+        bool _renderThreadShutDown = false;
+        bool _frameInFlight = false;
     };
 
     /**	Provides easy access to CoreApplication. */
@@ -112,6 +112,7 @@ namespace te
     class DepthStencilProperties;
     class GraphicsPipelineState;
     class ComputePipelineState;
+    class CommandBuffer;
     struct RASTERIZER_STATE_DESC;
     class RasterizerProperties;
     class RasterizerState;
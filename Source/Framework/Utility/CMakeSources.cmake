@@ -113,6 +113,7 @@ set(TE_UTILITY_INC_UTILITY
     "Utility/Utility/TeFileStream.h"
     "Utility/Utility/TeDataBlob.h"
     "Utility/Utility/TePoolAllocator.h"
+    "Utility/Utility/TeSlotMap.h"
     "Utility/Utility/TeFrameAllocator.h"
     "Utility/Utility/TeFileSystem.h"
 )
@@ -125,13 +126,16 @@ set(TE_UTILITY_SRC_UTILITY
     "Utility/Utility/TeUUID.cpp"
     "Utility/Utility/TeFileStream.cpp"
     "Utility/Utility/TeFrameAllocator.cpp"
+    "Utility/Utility/TePoolAllocator.cpp"
     "Utility/Utility/TeFileSystem.cpp"
 )
 
 set(TE_UTILITY_INC_THREADING
     "Utility/Threading/TeThreading.h"
+    "Utility/Threading/TeTaskScheduler.h"
 )
 set(TE_UTILITY_SRC_THREADING
+    "Utility/Threading/TeTaskScheduler.cpp"
 )
 
 set(TE_UTILITY_INC_WIN32
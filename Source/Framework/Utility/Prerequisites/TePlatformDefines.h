@@ -73,6 +73,19 @@
 #   define TE_ARCH_TYPE TE_ARCHITECTURE_x86_32
 #endif
 
+// Find the SIMD instruction sets the code is compiled for. Intrinsics headers are included where they are used.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define TE_SIMD_SSE2 1
+#else
+#   define TE_SIMD_SSE2 0
+#endif
+
+#if defined(__F16C__) || defined(__AVX2__)
+#   define TE_SIMD_F16C 1
+#else
+#   define TE_SIMD_F16C 0
+#endif
+
 // DLL export
 #if TE_PLATFORM == TE_PLATFORM_WIN32 // Windows
 #   if TE_COMPILER == TE_COMPILER_MSVC
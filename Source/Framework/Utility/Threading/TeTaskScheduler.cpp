@@ -0,0 +1,198 @@
+#include "Threading/TeTaskScheduler.h"
+
+namespace te
+{
+    TE_MODULE_STATIC_MEMBER(TaskScheduler)
+
+    Task::Task(std::function<void()> taskWorker)
+        : _taskWorker(std::move(taskWorker))
+        , _complete(false)
+    { }
+
+    SPtr<Task> Task::Create(std::function<void()> taskWorker)
+    {
+        return te_shared_ptr_new<Task>(std::move(taskWorker));
+    }
+
+    void Task::Execute()
+    {
+        if (_taskWorker)
+            _taskWorker();
+
+        {
+            Lock lock(_mutex);
+            _complete.store(true, std::memory_order_release);
+        }
+
+        _completeCond.notify_all();
+    }
+
+    void Task::Wait()
+    {
+        while (!IsComplete())
+        {
+            // Help with the queue instead of blocking, so waiting from a worker thread can't starve the pool
+            if (TaskScheduler::IsStarted() && gTaskScheduler().TryExecuteOne())
+                continue;
+
+            Lock lock(_mutex);
+            _completeCond.wait_for(lock, std::chrono::milliseconds(1), [this]() { return IsComplete(); });
+        }
+    }
+
+    TaskScheduler::TaskScheduler(UINT32 numWorkers)
+    {
+        if (numWorkers == 0)
+        {
+            UINT32 numCores = (UINT32)TE_THREAD_HARDWARE_CONCURRENCY;
+            numWorkers = numCores > 1 ? numCores - 1 : 1;
+        }
+
+        _workers.reserve(numWorkers);
+        for (UINT32 i = 0; i < numWorkers; i++)
+            _workers.push_back(Thread(&TaskScheduler::WorkerMain, this));
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        {
+            Lock lock(_mutex);
+            _shutdown = true;
+        }
+
+        _taskReadyCond.notify_all();
+
+        for (auto& worker : _workers)
+            worker.join();
+
+        // Execute anything that was queued after the workers stopped, so nobody waits forever
+        for (auto& task : _taskQueue)
+            task->Execute();
+
+        _taskQueue.clear();
+    }
+
+    void TaskScheduler::AddTask(const SPtr<Task>& task)
+    {
+        {
+            Lock lock(_mutex);
+            _taskQueue.push_back(task);
+        }
+
+        _taskReadyCond.notify_one();
+    }
+
+    SPtr<Task> TaskScheduler::AddTask(std::function<void()> taskWorker)
+    {
+        SPtr<Task> task = Task::Create(std::move(taskWorker));
+        AddTask(task);
+
+        return task;
+    }
+
+    void TaskScheduler::ParallelFor(UINT32 numJobs, const std::function<void(UINT32)>& job)
+    {
+        if (numJobs == 0)
+            return;
+
+        if (numJobs == 1 || _workers.empty())
+        {
+            for (UINT32 i = 0; i < numJobs; i++)
+                job(i);
+
+            return;
+        }
+
+        struct ParallelForState
+        {
+            std::atomic<UINT32> NextJob { 0 };
+            std::atomic<UINT32> NumFinished { 0 };
+            UINT32 NumJobs = 0;
+            const std::function<void(UINT32)>* Job = nullptr;
+            Mutex FinishedMutex;
+            Signal FinishedCond;
+        };
+
+        SPtr<ParallelForState> state = te_shared_ptr_new<ParallelForState>();
+        state->NumJobs = numJobs;
+        state->Job = &job;
+
+        // Helpers only ever touch the job function while there are unclaimed jobs left, and the calling thread does not
+        // return before all claimed jobs finish, so referencing the caller's function object is safe
+        auto runJobs = [](ParallelForState& state)
+        {
+            UINT32 jobIdx;
+            while ((jobIdx = state.NextJob.fetch_add(1, std::memory_order_relaxed)) < state.NumJobs)
+            {
+                (*state.Job)(jobIdx);
+
+                if (state.NumFinished.fetch_add(1, std::memory_order_acq_rel) + 1 == state.NumJobs)
+                {
+                    Lock lock(state.FinishedMutex);
+                    state.FinishedCond.notify_all();
+                }
+            }
+        };
+
+        UINT32 numHelpers = std::min(numJobs - 1, (UINT32)_workers.size());
+        {
+            Lock lock(_mutex);
+            for (UINT32 i = 0; i < numHelpers; i++)
+                _taskQueue.push_back(Task::Create([state, runJobs]() { runJobs(*state); }));
+        }
+
+        if (numHelpers == 1)
+            _taskReadyCond.notify_one();
+        else
+            _taskReadyCond.notify_all();
+
+        runJobs(*state);
+
+        Lock lock(state->FinishedMutex);
+        state->FinishedCond.wait(lock, [&state]()
+        {
+            return state->NumFinished.load(std::memory_order_acquire) == state->NumJobs;
+        });
+    }
+
+    bool TaskScheduler::TryExecuteOne()
+    {
+        SPtr<Task> task;
+        {
+            Lock lock(_mutex);
+            if (_taskQueue.empty())
+                return false;
+
+            task = _taskQueue.front();
+            _taskQueue.pop_front();
+        }
+
+        task->Execute();
+        return true;
+    }
+
+    void TaskScheduler::WorkerMain()
+    {
+        while (true)
+        {
+            SPtr<Task> task;
+            {
+                Lock lock(_mutex);
+                _taskReadyCond.wait(lock, [this]() { return _shutdown || !_taskQueue.empty(); });
+
+                if (_shutdown)
+                    return;
+
+                task = _taskQueue.front();
+                _taskQueue.pop_front();
+            }
+
+            task->Execute();
+        }
+    }
+
+    TaskScheduler& gTaskScheduler()
+    {
+        return TaskScheduler::Instance();
+    }
+}
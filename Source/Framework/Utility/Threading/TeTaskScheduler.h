@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Threading/TeThreading.h"
+#include "Utility/TeModule.h"
+
+namespace te
+{
+    class TaskScheduler;
+
+    /** Represents a single unit of work that is queued on the TaskScheduler and executed by one of its workers. */
+    class TE_UTILITY_EXPORT Task
+    {
+    public:
+        Task(std::function<void()> taskWorker);
+
+        /** Returns true if the task has finished executing. */
+        bool IsComplete() const { return _complete.load(std::memory_order_acquire); }
+
+        /**
+         * Blocks the calling thread until the task completes. While waiting, the calling thread will execute other
+         * queued tasks so it is safe to wait on a task from within a worker thread.
+         */
+        void Wait();
+
+        /** Creates a new task. Task must be passed to TaskScheduler::AddTask before it will be executed. */
+        static SPtr<Task> Create(std::function<void()> taskWorker);
+
+    private:
+        friend class TaskScheduler;
+
+        /** Runs the task worker and signals any waiting threads. */
+        void Execute();
+
+        std::function<void()> _taskWorker;
+        std::atomic<bool> _complete;
+        Mutex _mutex;
+        Signal _completeCond;
+    };
+
+    /**
+     * Keeps a fixed set of worker threads alive for the lifetime of the application and dispatches tasks to them.
+     * Intended for short, CPU bound jobs that can be split across cores (animation evaluation, culling, texture
+     * processing...).
+     *
+     * @note	Thread safe.
+     */
+    class TE_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
+    {
+    public:
+        /**
+         * Creates the scheduler.
+         *
+         * @param[in]	numWorkers	Number of worker threads to spawn. If zero, one worker per logical core (minus the
+         *							calling thread) will be created.
+         */
+        TaskScheduler(UINT32 numWorkers = 0);
+        ~TaskScheduler();
+
+        TE_MODULE_STATIC_HEADER_MEMBER(TaskScheduler)
+
+        /** Queues a task for execution on one of the worker threads. */
+        void AddTask(const SPtr<Task>& task);
+
+        /** Creates a new task from the provided worker and queues it for execution. */
+        SPtr<Task> AddTask(std::function<void()> taskWorker);
+
+        /**
+         * Executes @p job for each index in range [0, @p numJobs) distributing the work across worker threads. The
+         * calling thread participates in the work and the method returns only once every job has finished.
+         *
+         * @param[in]	numJobs		Number of jobs to execute.
+         * @param[in]	job			Function to call for each job. Receives the index of the job to execute.
+         */
+        void ParallelFor(UINT32 numJobs, const std::function<void(UINT32)>& job);
+
+        /** Returns the number of worker threads (not including the calling thread). */
+        UINT32 GetNumWorkers() const { return (UINT32)_workers.size(); }
+
+        /**
+         * Returns the number of threads that can execute work in parallel during a ParallelFor() call (workers and
+         * the calling thread).
+         */
+        UINT32 GetConcurrency() const { return (UINT32)_workers.size() + 1; }
+
+    protected:
+        friend class Task;
+
+        /** Main loop of a worker thread. */
+        void WorkerMain();
+
+        /**
+         * Pops a single task from the queue and executes it on the calling thread. Returns false if the queue was
+         * empty.
+         */
+        bool TryExecuteOne();
+
+    protected:
+        Vector<Thread> _workers;
+        Deque<SPtr<Task>> _taskQueue;
+        Mutex _mutex;
+        Signal _taskReadyCond;
+        bool _shutdown = false;
+    };
+
+    /** Provides easy access to TaskScheduler. */
+    TE_UTILITY_EXPORT TaskScheduler& gTaskScheduler();
+}
@@ -26,8 +26,21 @@ namespace te
         UINT16 HandleLinks = 0;
     };
 
+    /** Interface through which event handles release the connections they reference. */
+    class EventDataBase
+    {
+    public:
+        virtual ~EventDataBase() = default;
+
+        /** Disconnects the connection, ensuring the event doesn't call its callback again. */
+        virtual void Disconnect(BaseConnectionData* connection) = 0;
+
+        /** Called when an event handle no longer keeps a reference to the connection data. */
+        virtual void FreeHandle(BaseConnectionData* connection) = 0;
+    };
+
     /** Internal data for an Event, storing all connections. */
-    class InternalData
+    class InternalData : public EventDataBase
     {
     public:
         InternalData() = default;
@@ -80,7 +93,7 @@ namespace te
         /**
          * Disconnects the connection with the specified data, ensuring the event doesn't call its callback again.
          */
-        void Disconnect(BaseConnectionData* connection)
+        void Disconnect(BaseConnectionData* connection) override
         {
             RecursiveLock lock(_mutex);
 
@@ -120,7 +133,7 @@ namespace te
          * Called when the event handle no longer keeps a reference to the connection data. This means we might be able to
          * free (and reuse) its memory if the event is done with it too.
          */
-        void FreeHandle(BaseConnectionData* connection)
+        void FreeHandle(BaseConnectionData* connection) override
         {
             RecursiveLock lock(_mutex);
 
@@ -175,7 +188,7 @@ namespace te
     public:
         HEvent() = default;
 
-        HEvent(SPtr<InternalData> eventData, BaseConnectionData* connection)
+        HEvent(SPtr<EventDataBase> eventData, BaseConnectionData* connection)
             : _connection(connection)
             , _eventData(std::move(eventData))
         {
@@ -211,7 +224,7 @@ namespace te
 
     protected:
         BaseConnectionData* _connection = nullptr;
-        SPtr<InternalData> _eventData;
+        SPtr<EventDataBase> _eventData;
     };
 
     /**
@@ -356,4 +369,320 @@ namespace te
     template <class ReturnType, class... Args>
     class TE_UTILITY_EXPORT Event<ReturnType(Args...) > : public InternalEvent <ReturnType, Args...>
     { };
+
+    /**
+     * Internal data for a LockFreeEvent. Connections are kept in an immutable array that is replaced (under a lock)
+     * whenever a connection is added or removed, so triggering the event only needs to read the current array.
+     * Replaced arrays and removed connections are retired, and freed once no trigger is in progress.
+     */
+    class LockFreeInternalData : public EventDataBase
+    {
+    public:
+        /** Connection data for a lock free event. */
+        struct ConnectionData : BaseConnectionData
+        {
+            /** Read by triggering threads, the rest of the connection state is only touched under the lock. */
+            std::atomic<bool> Enabled { true };
+        };
+
+        /** Immutable list of connections a trigger iterates over. */
+        struct ConnectionArray
+        {
+            Vector<ConnectionData*> Connections;
+        };
+
+        LockFreeInternalData()
+            : _connections(te_new<ConnectionArray>())
+        { }
+
+        ~LockFreeInternalData()
+        {
+            // Handles keep the data alive, so by now nothing else can reference the connections
+            ConnectionArray* connections = _connections.load(std::memory_order_relaxed);
+            for (auto& connection : connections->Connections)
+                DeleteConnection(connection);
+
+            te_delete(connections);
+
+            for (auto& connection : _retiredConnections)
+                DeleteConnection(connection);
+
+            for (auto& retiredArray : _retiredArrays)
+                te_delete(retiredArray);
+        }
+
+        /** Adds a connection and publishes the new connection array. Caller must hold the lock. */
+        void Connect(ConnectionData* connection)
+        {
+            const ConnectionArray* oldArray = _connections.load(std::memory_order_relaxed);
+
+            ConnectionArray* newArray = te_new<ConnectionArray>();
+            newArray->Connections.reserve(oldArray->Connections.size() + 1);
+            newArray->Connections = oldArray->Connections;
+            newArray->Connections.push_back(connection);
+
+            Publish(newArray);
+        }
+
+        /** @copydoc EventDataBase::Disconnect */
+        void Disconnect(BaseConnectionData* connection) override
+        {
+            Vector<ConnectionData*> toDelete;
+            {
+                RecursiveLock lock(_mutex);
+
+                ConnectionData* lockFreeConnection = static_cast<ConnectionData*>(connection);
+                if (lockFreeConnection->IsActive)
+                {
+                    Deactivate(lockFreeConnection);
+
+                    const ConnectionArray* oldArray = _connections.load(std::memory_order_relaxed);
+
+                    ConnectionArray* newArray = te_new<ConnectionArray>();
+                    newArray->Connections.reserve(oldArray->Connections.size());
+                    for (auto& entry : oldArray->Connections)
+                    {
+                        if (entry != lockFreeConnection)
+                            newArray->Connections.push_back(entry);
+                    }
+
+                    Publish(newArray);
+                }
+
+                connection->HandleLinks--;
+                if (connection->HandleLinks == 0)
+                    Retire(lockFreeConnection);
+
+                CollectRetired(toDelete);
+            }
+
+            DeleteRetired(toDelete);
+        }
+
+        /** @copydoc EventDataBase::FreeHandle */
+        void FreeHandle(BaseConnectionData* connection) override
+        {
+            Vector<ConnectionData*> toDelete;
+            {
+                RecursiveLock lock(_mutex);
+
+                connection->HandleLinks--;
+                if (connection->HandleLinks == 0 && !connection->IsActive)
+                    Retire(static_cast<ConnectionData*>(connection));
+
+                CollectRetired(toDelete);
+            }
+
+            DeleteRetired(toDelete);
+        }
+
+        /** Disconnects all connections. */
+        void Clear()
+        {
+            Vector<ConnectionData*> toDelete;
+            {
+                RecursiveLock lock(_mutex);
+
+                const ConnectionArray* oldArray = _connections.load(std::memory_order_relaxed);
+                for (auto& connection : oldArray->Connections)
+                {
+                    Deactivate(connection);
+
+                    if (connection->HandleLinks == 0)
+                        Retire(connection);
+                }
+
+                Publish(te_new<ConnectionArray>());
+                CollectRetired(toDelete);
+            }
+
+            DeleteRetired(toDelete);
+        }
+
+        /**
+         * Marks the start of a trigger and returns the connections to notify. The array stays valid until the matching
+         * EndTrigger() call.
+         */
+        const ConnectionArray* BeginTrigger()
+        {
+            // Both operations are sequentially consistent, pairing with Publish() followed by the reader check in
+            // CollectRetired(): either the writer sees this trigger, or this trigger sees the new array
+            _activeTriggers.fetch_add(1, std::memory_order_seq_cst);
+            return _connections.load(std::memory_order_seq_cst);
+        }
+
+        /** Marks the end of a trigger started with BeginTrigger(). */
+        void EndTrigger()
+        {
+            if (_activeTriggers.fetch_sub(1, std::memory_order_seq_cst) != 1)
+                return;
+
+            // Last trigger out frees anything retired in the meantime, unless a writer is busy (it will do it instead)
+            if (!_hasRetired.load(std::memory_order_relaxed))
+                return;
+
+            Vector<ConnectionData*> toDelete;
+            {
+                RecursiveLock lock(_mutex, std::try_to_lock);
+                if (!lock.owns_lock())
+                    return;
+
+                CollectRetired(toDelete);
+            }
+
+            DeleteRetired(toDelete);
+        }
+
+        /** Checks are there any active connections. */
+        bool Empty() const { return _connections.load(std::memory_order_acquire)->Connections.empty(); }
+
+        RecursiveMutex _mutex;
+
+    private:
+        /** Marks the connection as inactive so triggers in progress skip it. Caller must hold the lock. */
+        void Deactivate(ConnectionData* connection)
+        {
+            connection->Enabled.store(false, std::memory_order_release);
+            connection->IsActive = false;
+        }
+
+        /** Replaces the current connection array, retiring the old one. Caller must hold the lock. */
+        void Publish(ConnectionArray* newArray)
+        {
+            ConnectionArray* oldArray = _connections.exchange(newArray, std::memory_order_seq_cst);
+            _retiredArrays.push_back(oldArray);
+            _hasRetired.store(true, std::memory_order_relaxed);
+        }
+
+        /** Queues a connection for deletion once no trigger can reference it. Caller must hold the lock. */
+        void Retire(ConnectionData* connection)
+        {
+            _retiredConnections.push_back(connection);
+            _hasRetired.store(true, std::memory_order_relaxed);
+        }
+
+        /**
+         * If no trigger is in progress, frees retired connection arrays and moves retired connections to @p toDelete.
+         * Caller must hold the lock. Connections are deleted once the lock is released, as destroying a callback can
+         * release handles to this same event.
+         */
+        void CollectRetired(Vector<ConnectionData*>& toDelete)
+        {
+            if (!_hasRetired.load(std::memory_order_relaxed) || _activeTriggers.load(std::memory_order_seq_cst) != 0)
+                return;
+
+            for (auto& retiredArray : _retiredArrays)
+                te_delete(retiredArray);
+
+            toDelete.insert(toDelete.end(), _retiredConnections.begin(), _retiredConnections.end());
+
+            _retiredArrays.clear();
+            _retiredConnections.clear();
+            _hasRetired.store(false, std::memory_order_relaxed);
+        }
+
+        /** Deletes connections collected by CollectRetired(). */
+        static void DeleteRetired(Vector<ConnectionData*>& toDelete)
+        {
+            for (auto& connection : toDelete)
+                DeleteConnection(connection);
+        }
+
+        /** Destroys the connection, including the callback it stores. */
+        static void DeleteConnection(ConnectionData* connection)
+        {
+            connection->IsActive = false;
+            connection->HandleLinks = 0;
+            te_delete(connection);
+        }
+
+    private:
+        std::atomic<ConnectionArray*> _connections;
+        std::atomic<UINT32> _activeTriggers { 0 };
+        std::atomic<bool> _hasRetired { false };
+
+        Vector<ConnectionArray*> _retiredArrays;
+        Vector<ConnectionData*> _retiredConnections;
+    };
+
+    /**
+     * Variant of Event meant for events that are triggered far more often than they are connected to or disconnected
+     * from. Triggering doesn't lock and iterates over a contiguous array of connections, while connecting and
+     * disconnecting copy that array.
+     *
+     * Semantics match Event: connections made while the event is being triggered are first notified on the next
+     * trigger, and connections broken during a trigger are not notified for the rest of it.
+     */
+    template <class ReturnType, class... Args>
+    class InternalLockFreeEvent
+    {
+    public:
+        struct ConnectionData : LockFreeInternalData::ConnectionData
+        {
+            std::function<ReturnType(Args...)> Function;
+        };
+
+        InternalLockFreeEvent()
+            : _internalData(te_shared_ptr_new<LockFreeInternalData>())
+        { }
+
+        ~InternalLockFreeEvent()
+        {
+            Clear();
+        }
+
+        /** Register a new callback that will get notified once the event is triggered. */
+        HEvent Connect(std::function<ReturnType(Args...)> function)
+        {
+            ConnectionData* connection = te_new<ConnectionData>();
+            connection->Function = std::move(function);
+
+            RecursiveLock lock(_internalData->_mutex);
+            _internalData->Connect(connection);
+
+            return HEvent(_internalData, connection);
+        }
+
+        /** Trigger the event, notifying all register callback methods. */
+        void operator() (Args... args)
+        {
+            // Increase ref count to ensure this event data isn't destroyed if one of the callbacks
+            // deletes the event itself.
+            SPtr<LockFreeInternalData> internalData = _internalData;
+
+            const LockFreeInternalData::ConnectionArray* connections = internalData->BeginTrigger();
+            for (auto& entry : connections->Connections)
+            {
+                // Might have been disconnected by an earlier callback, or from another thread
+                if (!entry->Enabled.load(std::memory_order_acquire))
+                    continue;
+
+                static_cast<ConnectionData*>(entry)->Function(std::forward<Args>(args)...);
+            }
+
+            internalData->EndTrigger();
+        }
+
+        /** Clear all callbacks from the event. */
+        void Clear()
+        {
+            if (_internalData)
+                _internalData->Clear();
+
+            _internalData = nullptr;
+        }
+
+        /** Check if event has any callbacks registered. */
+        bool Empty() const { return _internalData->Empty(); }
+
+    protected:
+        SPtr<LockFreeInternalData> _internalData;
+    };
+
+    template <typename Signature>
+    class LockFreeEvent;
+
+    template <class ReturnType, class... Args>
+    class TE_UTILITY_EXPORT LockFreeEvent<ReturnType(Args...) > : public InternalLockFreeEvent <ReturnType, Args...>
+    { };
 }
@@ -0,0 +1,66 @@
+#include "Utility/TePoolAllocator.h"
+
+namespace te
+{
+    static_assert(PoolAllocatorBase::MAX_THREAD_CACHES <= 64, "Thread slots are tracked using a 64-bit mask.");
+
+    namespace
+    {
+        /** One bit per thread slot, set while a live thread owns the slot. */
+        std::atomic<UINT64> gUsedThreadSlots { 0 };
+
+        /** Owns a thread slot for the lifetime of a thread, and releases it on thread exit. */
+        struct ThreadSlot
+        {
+            ~ThreadSlot()
+            {
+                if (Index != (UINT32)-1)
+                    gUsedThreadSlots.fetch_and(~(1ULL << Index), std::memory_order_release);
+            }
+
+            /** Attempts to claim a free slot. */
+            void Acquire()
+            {
+                UINT64 used = gUsedThreadSlots.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    UINT32 freeIdx = (UINT32)-1;
+                    for (UINT32 i = 0; i < PoolAllocatorBase::MAX_THREAD_CACHES; i++)
+                    {
+                        if ((used & (1ULL << i)) == 0)
+                        {
+                            freeIdx = i;
+                            break;
+                        }
+                    }
+
+                    if (freeIdx == (UINT32)-1)
+                        break;
+
+                    // Acquire, so we see everything the slot's previous owner wrote to its caches
+                    if (gUsedThreadSlots.compare_exchange_weak(used, used | (1ULL << freeIdx), std::memory_order_acquire,
+                        std::memory_order_relaxed))
+                    {
+                        Index = freeIdx;
+                        break;
+                    }
+                }
+
+                Initialized = true;
+            }
+
+            UINT32 Index = (UINT32)-1;
+            bool Initialized = false;
+        };
+
+        thread_local ThreadSlot tThreadSlot;
+    }
+
+    UINT32 PoolAllocatorBase::GetThreadSlot()
+    {
+        if (!tThreadSlot.Initialized)
+            tThreadSlot.Acquire();
+
+        return tThreadSlot.Index;
+    }
+}
@@ -3,37 +3,97 @@
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include "Threading/TeThreading.h"
 #include <climits>
+#include <atomic>
 
 namespace te
 {
+    /** Information about the state and usage of a PoolAllocator. */
+    struct PoolAllocatorStats
+    {
+        /** Total number of elements allocated over the lifetime of the pool. */
+        UINT64 NumAllocations = 0;
+
+        /** Total number of elements freed over the lifetime of the pool. */
+        UINT64 NumFrees = 0;
+
+        /** Number of elements currently in use. */
+        UINT32 NumActiveElems = 0;
+
+        /** Number of free elements currently held in per-thread caches. */
+        UINT32 NumCachedElems = 0;
+
+        /** Highest number of elements that were taken from the blocks at once (including cached elements). */
+        UINT32 PeakReservedElems = 0;
+
+        /** Number of memory blocks currently allocated. */
+        UINT32 NumBlocks = 0;
+
+        /** Number of elements a single memory block can hold. */
+        UINT32 ElemsPerBlock = 0;
+
+        /** Number of times a per-thread cache had to be refilled from the shared blocks. */
+        UINT64 NumCacheRefills = 0;
+
+        /** Number of times a per-thread cache had to return elements to the shared blocks. */
+        UINT64 NumCacheDrains = 0;
+    };
+
+    /** Non-templated functionality shared by all PoolAllocator specializations. */
+    class TE_UTILITY_EXPORT PoolAllocatorBase
+    {
+    public:
+        /** Maximum number of threads that can have their own element cache in a single pool. */
+        static constexpr UINT32 MAX_THREAD_CACHES = 64;
+
+        /** Maximum number of free elements held by a single thread cache. */
+        static constexpr UINT32 THREAD_CACHE_SIZE = 32;
+
+        /** Number of elements moved between a thread cache and the shared blocks at once. */
+        static constexpr UINT32 THREAD_CACHE_BATCH_SIZE = THREAD_CACHE_SIZE / 2;
+
+    protected:
+        /**
+         * Returns an index unique to the calling thread in range [0, MAX_THREAD_CACHES), or -1 if all indices are taken.
+         * The index is released when the thread exits and can then be reused by another thread, which inherits the
+         * contents of the caches that belonged to the old thread.
+         */
+        static UINT32 GetThreadSlot();
+    };
+
     /**
-     * A memory allocator that allocates elements of the same size. Allows for fairly quick allocations and deallocations.
+     * A memory allocator that allocates elements of the same size. Allocations and deallocations are O(1): elements are
+     * carved from blocks aligned to their own size, so the block owning an element is found by masking its address.
+     *
+     * Thread safe pools additionally keep a small cache of free elements per thread. Allocations and deallocations only
+     * touch the calling thread's cache and take the pool lock once per THREAD_CACHE_BATCH_SIZE elements, so the pool
+     * can be used from parallel jobs without contention.
      *
      * @tparam	ElemSize		Size of a single element in the pool. This will be the exact allocation size. 4 byte minimum.
      * @tparam	ElemsPerBlock	Determines how much space to reserve for elements. This determines the initial size of the
      *							pool, and the additional size the pool will be expanded by every time the number of elements
-     *							goes over the available storage limit.
+     *							goes over the available storage limit. Blocks are rounded up to a power of two size so they
+     *							may hold more elements than requested.
      * @tparam	Alignment		Memory alignment of each allocated element. Note that alignments that are larger than
      *							element size, or aren't a multiplier of element size will introduce additionally padding
      *							for each element, and therefore require more internal memory.
-     * @tparam	Lock			If true the pool allocator will be made thread safe (at the cost of performance).
+     * @tparam	Lock			If true the pool allocator will be made thread safe, using per-thread caches.
      */
     template <int ElemSize, int ElemsPerBlock = 512, int Alignment = 4, bool Lock = false>
-    class PoolAllocator
+    class PoolAllocator : public PoolAllocatorBase
     {
     private:
-        /** A single block able to hold ElemsPerBlock elements. */
+        /** Header placed at the start of every block, followed by storage for the block's elements. */
         class MemBlock
         {
         public:
-            MemBlock(UINT8* blockData)
-                : BlockData(blockData)
-                , FreePtr(0)
-                , FreeElems(ElemsPerBlock)
-                , NextBlock(nullptr)
+            MemBlock()
+                : FreePtr(0)
+                , FreeElems(NumBlockElems)
             {
+                UINT8* blockData = GetData();
+
                 UINT32 offset = 0;
-                for (UINT32 i = 0; i < ElemsPerBlock; i++)
+                for (UINT32 i = 0; i < NumBlockElems; i++)
                 {
                     UINT32* entryPtr = (UINT32*)&blockData[offset];
 
@@ -44,21 +104,24 @@ namespace te
 
             ~MemBlock()
             {
-                if (FreeElems != ElemsPerBlock)
+                if (FreeElems != NumBlockElems)
                 {
 #if TE_DEBUG_MODE == 1
-                    assert(FreeElems == ElemsPerBlock && "Not all elements were deallocated from a block.");
+                    assert(FreeElems == NumBlockElems && "Not all elements were deallocated from a block.");
 #endif
                 }
             }
 
+            /** Returns the start of the element storage. */
+            UINT8* GetData() { return (UINT8*)this + BlockDataOffset; }
+
             /**
              * Returns the first free address and increments the free pointer. Caller needs to ensure the remaining block
              * size is adequate before calling.
              */
             UINT8* Allocate()
             {
-                UINT8* freeEntry = &BlockData[FreePtr];
+                UINT8* freeEntry = &GetData()[FreePtr];
                 FreePtr = *(UINT32*)freeEntry;
                 --FreeElems;
 
@@ -72,13 +135,29 @@ namespace te
                 *entryPtr = FreePtr;
                 ++FreeElems;
 
-                FreePtr = (UINT32)(((UINT8*)data) - BlockData);
+                FreePtr = (UINT32)(((UINT8*)data) - GetData());
             }
 
-            UINT8* BlockData;
             UINT32 FreePtr;
             UINT32 FreeElems;
-            MemBlock* NextBlock;
+
+            MemBlock* PrevBlock = nullptr;
+            MemBlock* NextBlock = nullptr;
+
+            MemBlock* PrevFreeBlock = nullptr;
+            MemBlock* NextFreeBlock = nullptr;
+            bool InFreeList = false;
+        };
+
+        /** Free elements owned by a single thread. Only ever accessed by the thread that owns the slot. */
+        struct alignas(64) ThreadCache
+        {
+            UINT8* Elems[THREAD_CACHE_SIZE];
+            UINT32 NumElems = 0;
+
+            // Written only by the owning thread, atomic so statistics can be read from any thread
+            std::atomic<UINT64> NumAllocations { 0 };
+            std::atomic<UINT64> NumFrees { 0 };
         };
 
     public:
@@ -86,14 +165,39 @@ namespace te
         {
             static_assert(ElemSize >= 4, "Pool allocator minimum allowed element size is 4 bytes.");
             static_assert(ElemsPerBlock > 0, "Number of elements per block must be at least 1.");
-            static_assert(ElemsPerBlock * ActualElemSize <= UINT_MAX, "Pool allocator block size too large.");
+            static_assert(BlockSize <= (1U << 31), "Pool allocator block size too large.");
+
+            if constexpr (Lock)
+            {
+                _threadCaches = (ThreadCache*)te_allocate_aligned(sizeof(ThreadCache) * MAX_THREAD_CACHES,
+                    alignof(ThreadCache));
+
+                for (UINT32 i = 0; i < MAX_THREAD_CACHES; i++)
+                    new (&_threadCaches[i]) ThreadCache();
+            }
         }
 
         ~PoolAllocator()
         {
             ScopedLock<Lock> lock(_lockPolicy);
 
-            MemBlock* curBlock = _freeBlock;
+            if constexpr (Lock)
+            {
+                // Nobody may use the pool at this point, so return cached elements to make block validation work
+                for (UINT32 i = 0; i < MAX_THREAD_CACHES; i++)
+                {
+                    ThreadCache& cache = _threadCaches[i];
+                    for (UINT32 j = 0; j < cache.NumElems; j++)
+                        FreeToBlock(cache.Elems[j]);
+
+                    cache.NumElems = 0;
+                    cache.~ThreadCache();
+                }
+
+                te_free_aligned(_threadCaches);
+            }
+
+            MemBlock* curBlock = _blocks;
             while (curBlock != nullptr)
             {
                 MemBlock* nextBlock = curBlock->NextBlock;
@@ -106,51 +210,67 @@ namespace te
         /** Allocates enough memory for a single element in the pool. */
         UINT8* Allocate()
         {
-            ScopedLock<Lock> lock(_lockPolicy);
+            if constexpr (Lock)
+            {
+                UINT32 slot = GetThreadSlot();
+                if (slot != (UINT32)-1)
+                {
+                    ThreadCache& cache = _threadCaches[slot];
+                    if (cache.NumElems == 0)
+                    {
+                        ScopedLock<Lock> lock(_lockPolicy);
+                        for (UINT32 i = 0; i < THREAD_CACHE_BATCH_SIZE; i++)
+                            cache.Elems[cache.NumElems++] = AllocateFromBlock();
 
-            if (_freeBlock == nullptr || _freeBlock->FreeElems == 0)
-                AllocateBlock();
+                        _numCacheRefills++;
+                    }
 
-            _totalNumElems++;
-            UINT8* output = _freeBlock->Allocate();
+                    cache.NumAllocations.store(cache.NumAllocations.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
 
-            return output;
+                    return cache.Elems[--cache.NumElems];
+                }
+            }
+
+            ScopedLock<Lock> lock(_lockPolicy);
+
+            _numAllocations++;
+            return AllocateFromBlock();
         }
 
         /** Deallocates an element from the pool. */
         void Free(void* data)
         {
-            ScopedLock<Lock> lock(_lockPolicy);
-
-            MemBlock* curBlock = _freeBlock;
-            while (curBlock)
+            if constexpr (Lock)
             {
-                constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
-                if (data >= curBlock->BlockData && data < (curBlock->BlockData + blockDataSize))
+                UINT32 slot = GetThreadSlot();
+                if (slot != (UINT32)-1)
                 {
-                    curBlock->Deallocate(data);
-                    _totalNumElems--;
-
-                    if (curBlock->FreeElems == 0 && curBlock->NextBlock)
+                    ThreadCache& cache = _threadCaches[slot];
+                    if (cache.NumElems == THREAD_CACHE_SIZE)
                     {
-                        // Free the block, but only if there is some extra free space in other blocks
-                        const UINT32 totalSpace = (_numBlocks - 1) * ElemsPerBlock;
-                        const UINT32 freeSpace = totalSpace - _totalNumElems;
-
-                        if (freeSpace > ElemsPerBlock / 2)
-                        {
-                            _freeBlock = curBlock->NextBlock;
-                            DeallocateBlock(curBlock);
-                        }
+                        // Return the oldest half, keeping the most recently freed (and likely cache-hot) elements
+                        ScopedLock<Lock> lock(_lockPolicy);
+                        for (UINT32 i = 0; i < THREAD_CACHE_BATCH_SIZE; i++)
+                            FreeToBlock(cache.Elems[i]);
+
+                        for (UINT32 i = THREAD_CACHE_BATCH_SIZE; i < THREAD_CACHE_SIZE; i++)
+                            cache.Elems[i - THREAD_CACHE_BATCH_SIZE] = cache.Elems[i];
+
+                        cache.NumElems -= THREAD_CACHE_BATCH_SIZE;
+                        _numCacheDrains++;
                     }
 
+                    cache.NumFrees.store(cache.NumFrees.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    cache.Elems[cache.NumElems++] = (UINT8*)data;
                     return;
                 }
-
-                curBlock = curBlock->NextBlock;
             }
 
-            assert(false);
+            ScopedLock<Lock> lock(_lockPolicy);
+
+            _numFrees++;
+            FreeToBlock(data);
         }
 
         /** Allocates and constructs a single pool element. */
@@ -170,66 +290,180 @@ namespace te
             data->~T();
             Free(data);
         }
-    
-    private:
-        /** Allocates a new block of memory using a heap allocator. */
-        MemBlock* AllocateBlock()
+
+        /**
+         * Returns information about the pool usage. When other threads are using the pool at the same time the returned
+         * values are approximate.
+         */
+        PoolAllocatorStats GetStats()
         {
-            MemBlock* newBlock = nullptr;
-            MemBlock* curBlock = _freeBlock;
+            ScopedLock<Lock> lock(_lockPolicy);
 
-            while (curBlock != nullptr)
+            PoolAllocatorStats stats;
+            stats.NumAllocations = _numAllocations;
+            stats.NumFrees = _numFrees;
+            stats.PeakReservedElems = _peakNumElems;
+            stats.NumBlocks = _numBlocks;
+            stats.ElemsPerBlock = NumBlockElems;
+            stats.NumCacheRefills = _numCacheRefills;
+            stats.NumCacheDrains = _numCacheDrains;
+
+            if constexpr (Lock)
             {
-                MemBlock* nextBlock = curBlock->NextBlock;
-                if (nextBlock != nullptr && nextBlock->FreeElems > 0)
+                for (UINT32 i = 0; i < MAX_THREAD_CACHES; i++)
                 {
-                    // Found an existing block with free space
-                    newBlock = nextBlock;
+                    stats.NumAllocations += _threadCaches[i].NumAllocations.load(std::memory_order_relaxed);
+                    stats.NumFrees += _threadCaches[i].NumFrees.load(std::memory_order_relaxed);
+                }
+            }
 
-                    curBlock->NextBlock = newBlock->NextBlock;
-                    newBlock->NextBlock = _freeBlock;
+            INT64 numActive = (INT64)stats.NumAllocations - (INT64)stats.NumFrees;
+            stats.NumActiveElems = (UINT32)std::max((INT64)0, std::min(numActive, (INT64)_totalNumElems));
+            stats.NumCachedElems = _totalNumElems - stats.NumActiveElems;
 
-                    break;
-                }
+            return stats;
+        }
 
-                curBlock = nextBlock;
-            }
+    private:
+        /** Takes a single element from the first block with free space, allocating a new block if required. */
+        UINT8* AllocateFromBlock()
+        {
+            if (_freeBlocks == nullptr)
+                AllocateBlock();
 
-            if (newBlock == nullptr)
-            {
-                constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
-                size_t paddedBlockDataSize = blockDataSize + (Alignment - 1); // Padding for potential alignment correction
+            MemBlock* block = _freeBlocks;
+            UINT8* output = block->Allocate();
+
+            if (block->FreeElems == 0)
+                RemoveFromFreeList(block);
+
+            _totalNumElems++;
+            _peakNumElems = std::max(_peakNumElems, _totalNumElems);
+
+            return output;
+        }
 
-                UINT8* data = (UINT8*)te_allocate(sizeof(MemBlock) + (UINT32)paddedBlockDataSize);
+        /** Returns an element to the block it was allocated from. */
+        void FreeToBlock(void* data)
+        {
+            // Blocks are aligned to their size, so the header is found by masking off the element's offset
+            MemBlock* block = (MemBlock*)((std::uintptr_t)data & ~(std::uintptr_t)(BlockSize - 1));
+
+#if TE_DEBUG_MODE == 1
+            assert((UINT8*)data >= block->GetData() && (UINT8*)data < block->GetData() + NumBlockElems * ActualElemSize);
+#endif
 
-                void* blockData = data + sizeof(MemBlock);
-                blockData = std::align(Alignment, blockDataSize, blockData, paddedBlockDataSize);
+            block->Deallocate(data);
+            _totalNumElems--;
 
-                newBlock = new (data) MemBlock((UINT8*)blockData);
-                _numBlocks++;
+            if (!block->InFreeList)
+                AddToFreeList(block);
 
-                newBlock->NextBlock = _freeBlock;
+            if (block->FreeElems == NumBlockElems && _numBlocks > 1)
+            {
+                // Free the block, but only if there is some extra free space in other blocks
+                const UINT32 totalSpace = (_numBlocks - 1) * NumBlockElems;
+                const UINT32 freeSpace = totalSpace - _totalNumElems;
+
+                if (freeSpace > NumBlockElems / 2)
+                    DeallocateBlock(block);
             }
+        }
 
-            _freeBlock = newBlock;
+        /** Allocates a new block of memory using a heap allocator and makes it the first block with free space. */
+        MemBlock* AllocateBlock()
+        {
+            void* data = te_allocate_aligned(BlockSize, BlockSize);
+            MemBlock* newBlock = new (data) MemBlock();
+
+            newBlock->NextBlock = _blocks;
+            if (_blocks != nullptr)
+                _blocks->PrevBlock = newBlock;
+
+            _blocks = newBlock;
+            _numBlocks++;
+
+            AddToFreeList(newBlock);
             return newBlock;
         }
 
         /** Deallocates a block of memory. */
         void DeallocateBlock(MemBlock* block)
         {
+            if (block->InFreeList)
+                RemoveFromFreeList(block);
+
+            if (block->PrevBlock != nullptr)
+                block->PrevBlock->NextBlock = block->NextBlock;
+            else
+                _blocks = block->NextBlock;
+
+            if (block->NextBlock != nullptr)
+                block->NextBlock->PrevBlock = block->PrevBlock;
+
             block->~MemBlock();
-            te_free(block);
+            te_free_aligned(block);
 
             _numBlocks--;
         }
 
+        /** Registers a block as having free space. */
+        void AddToFreeList(MemBlock* block)
+        {
+            block->PrevFreeBlock = nullptr;
+            block->NextFreeBlock = _freeBlocks;
+
+            if (_freeBlocks != nullptr)
+                _freeBlocks->PrevFreeBlock = block;
+
+            _freeBlocks = block;
+            block->InFreeList = true;
+        }
+
+        /** Unregisters a block from the list of blocks with free space. */
+        void RemoveFromFreeList(MemBlock* block)
+        {
+            if (block->PrevFreeBlock != nullptr)
+                block->PrevFreeBlock->NextFreeBlock = block->NextFreeBlock;
+            else
+                _freeBlocks = block->NextFreeBlock;
+
+            if (block->NextFreeBlock != nullptr)
+                block->NextFreeBlock->PrevFreeBlock = block->PrevFreeBlock;
+
+            block->PrevFreeBlock = nullptr;
+            block->NextFreeBlock = nullptr;
+            block->InFreeList = false;
+        }
+
+        /** Returns the smallest power of two greater or equal to @p value. */
+        static constexpr size_t CeilPow2(size_t value)
+        {
+            size_t output = 1;
+            while (output < value)
+                output <<= 1;
+
+            return output;
+        }
+
         static constexpr int ActualElemSize = ((ElemSize + Alignment - 1) / Alignment) * Alignment;
+        static constexpr UINT32 BlockDataOffset = (UINT32)(((sizeof(MemBlock) + Alignment - 1) / Alignment) * Alignment);
+        static constexpr size_t BlockSize = CeilPow2(std::max<size_t>(BlockDataOffset + (size_t)ActualElemSize * ElemsPerBlock,
+            std::max<size_t>(Alignment, 64)));
+        static constexpr UINT32 NumBlockElems = (UINT32)((BlockSize - BlockDataOffset) / ActualElemSize);
 
         LockingPolicy<Lock> _lockPolicy;
-        MemBlock* _freeBlock = nullptr;
+        MemBlock* _blocks = nullptr;
+        MemBlock* _freeBlocks = nullptr;
+        ThreadCache* _threadCaches = nullptr;
+
         UINT32 _totalNumElems = 0;
+        UINT32 _peakNumElems = 0;
         UINT32 _numBlocks = 0;
+        UINT64 _numAllocations = 0;
+        UINT64 _numFrees = 0;
+        UINT64 _numCacheRefills = 0;
+        UINT64 _numCacheDrains = 0;
     };
 
     /**
@@ -295,4 +529,11 @@ namespace te
         ptr->~T();
         te_pool_free(ptr);
     }
+
+    /** Returns usage information about the global pool allocator of type T. */
+    template<class T>
+    PoolAllocatorStats te_pool_stats()
+    {
+        return GlobalPoolAllocator<T>::m.GetStats();
+    }
 }
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+namespace te
+{
+    /**
+     * Container that hands out 64-bit identifiers for the values it stores. Identifiers are made of a slot index and a
+     * generation, so lookups and removals are O(1) and identifiers of removed values are never mistaken for values
+     * stored later in the same slot. Values themselves are kept densely packed, for fast iteration.
+     *
+     * @note	Identifiers are never zero, so zero can be used to represent an invalid identifier.
+     * @note	Adding or removing values invalidates pointers to other values.
+     */
+    template<class T>
+    class SlotMap
+    {
+    private:
+        static constexpr UINT32 INVALID_INDEX = (UINT32)-1;
+
+        /** Indirection between identifiers and the dense value storage. */
+        struct Slot
+        {
+            UINT32 Generation = 1;
+            UINT32 DenseIdx = INVALID_INDEX; /**< Index of the value, or INVALID_INDEX if the slot is free. */
+            UINT32 NextFree = INVALID_INDEX;
+        };
+
+    public:
+        /** Stores a new value and returns the identifier it can be retrieved with. */
+        UINT64 Insert(T value)
+        {
+            UINT32 slotIdx;
+            if (_freeHead != INVALID_INDEX)
+            {
+                slotIdx = _freeHead;
+                _freeHead = _slots[slotIdx].NextFree;
+            }
+            else
+            {
+                slotIdx = (UINT32)_slots.size();
+                _slots.push_back(Slot());
+            }
+
+            Slot& slot = _slots[slotIdx];
+            slot.DenseIdx = (UINT32)_values.size();
+            slot.NextFree = INVALID_INDEX;
+
+            _values.push_back(std::move(value));
+            _valueSlots.push_back(slotIdx);
+
+            return MakeId(slotIdx, slot.Generation);
+        }
+
+        /** Removes the value with the provided identifier. Returns false if no such value exists. */
+        bool Remove(UINT64 id)
+        {
+            const UINT32 slotIdx = GetSlotIndex(id);
+            if (!IsValid(slotIdx, id))
+                return false;
+
+            Slot& slot = _slots[slotIdx];
+            const UINT32 denseIdx = slot.DenseIdx;
+            const UINT32 lastIdx = (UINT32)_values.size() - 1;
+
+            // Keep values packed by moving the last one into the hole
+            if (denseIdx != lastIdx)
+            {
+                _values[denseIdx] = std::move(_values[lastIdx]);
+                _valueSlots[denseIdx] = _valueSlots[lastIdx];
+                _slots[_valueSlots[denseIdx]].DenseIdx = denseIdx;
+            }
+
+            _values.pop_back();
+            _valueSlots.pop_back();
+
+            // Skip generation zero on wrap-around so identifiers stay non-zero
+            slot.Generation = slot.Generation == std::numeric_limits<UINT32>::max() ? 1 : slot.Generation + 1;
+            slot.DenseIdx = INVALID_INDEX;
+            slot.NextFree = _freeHead;
+            _freeHead = slotIdx;
+
+            return true;
+        }
+
+        /** Returns the value with the provided identifier, or null if no such value exists. */
+        T* Find(UINT64 id)
+        {
+            const UINT32 slotIdx = GetSlotIndex(id);
+            if (!IsValid(slotIdx, id))
+                return nullptr;
+
+            return &_values[_slots[slotIdx].DenseIdx];
+        }
+
+        /** @copydoc Find */
+        const T* Find(UINT64 id) const
+        {
+            const UINT32 slotIdx = GetSlotIndex(id);
+            if (!IsValid(slotIdx, id))
+                return nullptr;
+
+            return &_values[_slots[slotIdx].DenseIdx];
+        }
+
+        /** Checks does a value with the provided identifier exist. */
+        bool Contains(UINT64 id) const { return IsValid(GetSlotIndex(id), id); }
+
+        /** Removes all values. Identifiers handed out before the call remain invalid afterwards. */
+        void Clear()
+        {
+            for (UINT32 valueSlot : _valueSlots)
+            {
+                Slot& slot = _slots[valueSlot];
+                slot.Generation = slot.Generation == std::numeric_limits<UINT32>::max() ? 1 : slot.Generation + 1;
+                slot.DenseIdx = INVALID_INDEX;
+                slot.NextFree = _freeHead;
+                _freeHead = valueSlot;
+            }
+
+            _values.clear();
+            _valueSlots.clear();
+        }
+
+        /** Returns the number of stored values. */
+        UINT32 Size() const { return (UINT32)_values.size(); }
+
+        /** Checks are there no stored values. */
+        bool Empty() const { return _values.empty(); }
+
+        /** Returns all stored values, in no particular order. */
+        Vector<T>& GetValues() { return _values; }
+
+        /** @copydoc GetValues */
+        const Vector<T>& GetValues() const { return _values; }
+
+    private:
+        /** Builds an identifier from a slot index and its generation. */
+        static UINT64 MakeId(UINT32 slotIdx, UINT32 generation) { return ((UINT64)generation << 32) | slotIdx; }
+
+        /** Extracts the slot index from an identifier. */
+        static UINT32 GetSlotIndex(UINT64 id) { return (UINT32)(id & 0xFFFFFFFF); }
+
+        /** Checks does the identifier refer to the current occupant of the slot. */
+        bool IsValid(UINT32 slotIdx, UINT64 id) const
+        {
+            if (slotIdx >= (UINT32)_slots.size())
+                return false;
+
+            const Slot& slot = _slots[slotIdx];
+            return slot.DenseIdx != INVALID_INDEX && slot.Generation == (UINT32)(id >> 32);
+        }
+
+        Vector<Slot> _slots;
+        Vector<T> _values;
+        Vector<UINT32> _valueSlots;
+        UINT32 _freeHead = INVALID_INDEX;
+    };
+}
@@ -38,6 +38,14 @@ namespace te
 
             // Get feature options
             _D3D11Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &_D3D11FeatureOptions, sizeof(_D3D11FeatureOptions));
+
+            // DX11.1 context is only needed to bind ranges of constant buffers, so don't keep it around otherwise
+            if (_D3D11FeatureOptions.ConstantBufferOffsetting)
+            {
+                HRESULT hr = _immediateContext->QueryInterface(__uuidof(ID3D11DeviceContext1), (LPVOID*)&_immediateContext1);
+                if (FAILED(hr))
+                    _immediateContext1 = nullptr;
+            }
         }
     }
 
@@ -56,6 +64,7 @@ namespace te
 
         SAFE_RELEASE(_infoQueue);
         SAFE_RELEASE(_D3D11Device);
+        SAFE_RELEASE(_immediateContext1);
         SAFE_RELEASE(_immediateContext);
         SAFE_RELEASE(_classLinkage);
     }
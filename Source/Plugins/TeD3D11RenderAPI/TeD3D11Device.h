@@ -28,6 +28,12 @@ namespace te
         /** Returns DX11 immediate context object. */
         ID3D11DeviceContext* GetImmediateContext() const { return _immediateContext; }
 
+        /**
+         * Returns DX11.1 immediate context object. Only available if the device supports binding ranges of constant
+         * buffers, null otherwise.
+         */
+        ID3D11DeviceContext1* GetImmediateContext1() const { return _immediateContext1; }
+
         /** Returns DX11 class linkage object. */
         ID3D11ClassLinkage* GetClassLinkage() const { return _classLinkage; }
 
@@ -60,6 +66,7 @@ namespace te
 
         ID3D11Device* _D3D11Device = nullptr;
         ID3D11DeviceContext* _immediateContext = nullptr;
+        ID3D11DeviceContext1* _immediateContext1 = nullptr;
         ID3D11InfoQueue* _infoQueue = nullptr;
         ID3D11ClassLinkage* _classLinkage = nullptr;
         D3D11_FEATURE_DATA_D3D11_OPTIONS _D3D11FeatureOptions;
@@ -2,6 +2,7 @@
 #include "TeD3D11HardwareBuffer.h"
 #include "TeD3D11RenderAPI.h"
 #include "TeD3D11Device.h"
+#include "RenderAPI/TeHardwareBufferManager.h"
 
 namespace te
 {
@@ -22,12 +23,18 @@ namespace te
         D3D11RenderAPI* d3d11rs = static_cast<D3D11RenderAPI*>(RenderAPI::InstancePtr());
         D3D11Device& device = d3d11rs->GetPrimaryDevice();
 
-        _buffer = te_pool_new<D3D11HardwareBuffer>(D3D11HardwareBuffer::BT_CONSTANT, _usage, 1, _size, device);
+        // Transient buffers are sub-allocated from the shared upload buffer, so they only need their own buffer as a fallback
+        if (!IsTransient() || !HardwareBufferManager::Instance().IsTransientSupported())
+            _buffer = te_pool_new<D3D11HardwareBuffer>(D3D11HardwareBuffer::BT_CONSTANT, _usage, 1, _size, device);
+
         GpuParamBlockBuffer::Initialize();
     }
 
     ID3D11Buffer* D3D11GpuParamBlockBuffer::GetD3D11Buffer() const
     {
+        if (_buffer == nullptr)
+            return nullptr;
+
         return static_cast<D3D11HardwareBuffer*>(_buffer)->GetD3DBuffer();
     }
 }
@@ -12,7 +12,10 @@ namespace te
         D3D11GpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
         ~D3D11GpuParamBlockBuffer();
 
-        /** Returns internal DX11 buffer object. */
+        /**
+         * Returns internal DX11 buffer object. Null for transient buffers sub-allocated from the shared upload buffer, in
+         * which case GetTransientAllocation() should be used instead.
+         */
         ID3D11Buffer* GetD3D11Buffer() const;
     protected:
         /** @copydoc GpuParamBlockBuffer::initialize */
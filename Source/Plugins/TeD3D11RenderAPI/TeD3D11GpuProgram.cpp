@@ -40,6 +40,7 @@ namespace te
             desc.Source = _source;
             desc.Language = "hlsl";
             desc.IncludePath = _includePath;
+            desc.Defines = _defines;
 
             _bytecode = CompileBytecode(desc);
         }
@@ -4,6 +4,7 @@
 #include "TeD3D11HLSLParamParser.h"
 #include "RenderAPI/TeGpuParamDesc.h"
 #include "Utility/TeFileStream.h"
+#include "RenderAPI/TeGpuProgramManager.h"
 #include <regex>
 
 namespace te
@@ -153,38 +154,62 @@ namespace te
 
         ID3DBlob* microcode = nullptr;
         ID3DBlob* messages = nullptr;
+        HRESULT hr = S_OK;
 
         const String& source = desc.Source;
         const String& entryPoint = desc.EntryPoint;
-        D3D11HLSLInclude* include = nullptr;
 
-        if (desc.IncludePath != "")
-            include = te_new<D3D11HLSLInclude>(desc.IncludePath);
+        // Skip compilation entirely if this exact program was compiled during a previous run
+        GpuProgramCache& programCache = GpuProgramManager::Instance().GetProgramCache();
+        const String compilerSettings = String(DIRECTX_COMPILER_ID) + ":" + hlslProfile + ":" + ToString(compileFlags);
+        const UINT64 cacheKey = programCache.ComputeKey(desc, compilerSettings);
+
+        Vector<UINT8> cachedMicrocode;
+        if (programCache.Load(cacheKey, cachedMicrocode))
+        {
+            if (SUCCEEDED(D3DCreateBlob(cachedMicrocode.size(), &microcode)))
+                memcpy(microcode->GetBufferPointer(), cachedMicrocode.data(), cachedMicrocode.size());
+            else
+                microcode = nullptr;
+        }
+
+        D3D11HLSLInclude* include = nullptr;
 
-        const D3D_SHADER_MACRO defines[] =
+        if (microcode == nullptr)
         {
-            { "HLSL", "1" },
-            { nullptr, nullptr }
-        };
-
-        HRESULT hr = D3DCompile(
-            source.c_str(),		// [in] Pointer to the shader in memory.
-            source.size(),		// [in] Size of the shader in memory.
-            nullptr,			// [in] The name of the file that contains the shader code.
-            defines,			// [in] Optional. Pointer to a NULL-terminated array of macro definitions.
-                                //		See D3D_SHADER_MACRO. If not used, set this to NULL.
-            include,			// [in] Optional. Pointer to an ID3DInclude Interface interface for handling include files.
-                                //		Setting this to NULL will cause a compile error if a shader contains a #include.
-            entryPoint.c_str(),	// [in] Name of the shader-entrypoint function where shader execution begins.
-            hlslProfile.c_str(),// [in] A string that specifies the shader model; can be any profile in shader model 4 or higher.
-            compileFlags,		// [in] Effect compile flags - no D3DCOMPILE_ENABLE_BACKWARDS_COMPATIBILITY at the first try...
-            0,					// [in] Effect compile flags
-            &microcode,			// [out] A pointer to an ID3DBlob Interface which contains the compiled shader, as well as
-                                //		 any embedded debug and symbol-table information.
-            &messages			// [out] A pointer to an ID3DBlob Interface which contains a listing of errors and warnings
-                                //		 that occurred during compilation. These errors and warnings are identical to the
-                                //		 debug output from a debugger.
-        );
+            if (desc.IncludePath != "")
+                include = te_new<D3D11HLSLInclude>(desc.IncludePath);
+
+            Vector<D3D_SHADER_MACRO> defines;
+            defines.push_back({ "HLSL", "1" });
+
+            for (auto& define : desc.Defines)
+                defines.push_back({ define.first.c_str(), define.second.c_str() });
+
+            defines.push_back({ nullptr, nullptr });
+
+            hr = D3DCompile(
+                source.c_str(),		// [in] Pointer to the shader in memory.
+                source.size(),		// [in] Size of the shader in memory.
+                nullptr,			// [in] The name of the file that contains the shader code.
+                defines.data(),		// [in] Optional. Pointer to a NULL-terminated array of macro definitions.
+                                    //		See D3D_SHADER_MACRO. If not used, set this to NULL.
+                include,			// [in] Optional. Pointer to an ID3DInclude Interface interface for handling include files.
+                                    //		Setting this to NULL will cause a compile error if a shader contains a #include.
+                entryPoint.c_str(),	// [in] Name of the shader-entrypoint function where shader execution begins.
+                hlslProfile.c_str(),// [in] A string that specifies the shader model; can be any profile in shader model 4 or higher.
+                compileFlags,		// [in] Effect compile flags - no D3DCOMPILE_ENABLE_BACKWARDS_COMPATIBILITY at the first try...
+                0,					// [in] Effect compile flags
+                &microcode,			// [out] A pointer to an ID3DBlob Interface which contains the compiled shader, as well as
+                                    //		 any embedded debug and symbol-table information.
+                &messages			// [out] A pointer to an ID3DBlob Interface which contains a listing of errors and warnings
+                                    //		 that occurred during compilation. These errors and warnings are identical to the
+                                    //		 debug output from a debugger.
+            );
+
+            if (SUCCEEDED(hr) && microcode != nullptr)
+                programCache.Save(cacheKey, (const UINT8*)microcode->GetBufferPointer(), (UINT32)microcode->GetBufferSize());
+        }
 
         String compileMessage;
         if (messages != nullptr)
@@ -3,6 +3,8 @@
 #include "TeD3D11IndexBuffer.h"
 #include "TeD3D11GpuParamBlockBuffer.h"
 #include "TeD3D11GpuBuffer.h"
+#include "TeD3D11HardwareBuffer.h"
+#include "TeD3D11Device.h"
 
 namespace te
 {
@@ -63,4 +65,12 @@ namespace te
 
         return bufferPtr;
     }
+
+    SPtr<HardwareBuffer> D3D11HardwareBufferManager::CreateTransientBufferInternal(UINT32 size)
+    {
+        if (_device.GetImmediateContext1() == nullptr || !_device.GetFeatureOptions().MapNoOverwriteOnDynamicConstantBuffer)
+            return nullptr;
+
+        return te_shared_ptr_new<D3D11HardwareBuffer>(D3D11HardwareBuffer::BT_CONSTANT, GBU_DYNAMIC, 1, size, _device);
+    }
 }
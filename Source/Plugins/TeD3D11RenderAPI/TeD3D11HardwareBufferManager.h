@@ -33,6 +33,14 @@ namespace te
         SPtr<GpuBuffer> CreateGpuBufferInternal(const GPU_BUFFER_DESC& desc,
             SPtr<HardwareBuffer> underlyingBuffer) override;
 
+        /**
+         * @copydoc HardwareBufferManager::CreateTransientBufferInternal
+         *
+         * @note	Requires DX11.1 support for binding ranges of constant buffers, and for mapping dynamic constant buffers
+         *			without overwriting their previous contents.
+         */
+        SPtr<HardwareBuffer> CreateTransientBufferInternal(UINT32 size) override;
+
     protected:
         D3D11Device& _device;
     };
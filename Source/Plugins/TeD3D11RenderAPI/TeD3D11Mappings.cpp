@@ -182,6 +182,12 @@ namespace te
             return DXGI_FORMAT_R16G16_SINT;
         case VET_SHORT4:
             return DXGI_FORMAT_R16G16B16A16_SINT;
+        case VET_SHORT2_NORM:
+            return DXGI_FORMAT_R16G16_SNORM;
+        case VET_SHORT4_NORM:
+            return DXGI_FORMAT_R16G16B16A16_SNORM;
+        case VET_HALF2:
+            return DXGI_FORMAT_R16G16_FLOAT;
         case VET_UINT1:
             return DXGI_FORMAT_R32_UINT;
         case VET_UINT2:
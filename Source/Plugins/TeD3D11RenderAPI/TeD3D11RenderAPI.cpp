@@ -19,6 +19,9 @@
 #include "TeD3D11SamplerState.h"
 #include "TeD3D11GpuParamBlockBuffer.h"
 #include "TeD3D11GpuBuffer.h"
+#include "TeD3D11HardwareBuffer.h"
+
+#include <d3d10.h>
 
 namespace te
 {
@@ -157,7 +160,22 @@ namespace te
         RenderAPI::Destroy();
     }
 
-    void D3D11RenderAPI::SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState)
+    bool D3D11RenderAPI::EnableMultithreadedAccess()
+    {
+        // Device methods are already free threaded, the immediate context however isn't. Once protected, every context
+        // call is serialized, so the main thread can keep uploading resources while another thread renders.
+        ID3D10Multithread* multithread = nullptr;
+        HRESULT hr = _device->GetImmediateContext()->QueryInterface(__uuidof(ID3D10Multithread), (void**)&multithread);
+        if (FAILED(hr) || multithread == nullptr)
+            return false;
+
+        multithread->SetMultithreadProtected(TRUE);
+        SAFE_RELEASE(multithread);
+
+        return true;
+    }
+
+    void D3D11RenderAPI::SetGraphicsPipelineInternal(const SPtr<GraphicsPipelineState>& pipelineState)
     {
         D3D11RasterizerState* d3d11RasterizerState = nullptr;
         D3D11BlendState* d3d11BlendState = nullptr;
@@ -264,7 +282,7 @@ namespace te
         _lastFrameGraphicPipeline->d3d11ComputeProgram = nullptr;
     }
 
-    void D3D11RenderAPI::SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState)
+    void D3D11RenderAPI::SetComputePipelineInternal(const SPtr<ComputePipelineState>& pipelineState)
     {
         SPtr<GpuProgram> program;
         D3D11GpuComputeProgram* d3d11ComputeProgram = nullptr;
@@ -291,7 +309,7 @@ namespace te
         _lastFrameGraphicPipeline->d3d11ComputeProgram = d3d11ComputeProgram;
     }
 
-    void D3D11RenderAPI::SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags, 
+    void D3D11RenderAPI::SetGpuParamsInternal(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags, 
         UINT32 gpuParamsBlockBindFlags, const Vector<String>& paramBlocksToBind)
     {
         ID3D11DeviceContext* context = _device->GetImmediateContext();
@@ -318,6 +336,47 @@ namespace te
             }
         }
 
+        ID3D11DeviceContext1* context1 = _device->GetImmediateContext1();
+
+        auto IsParamBlockSelected = [&](const GpuParamBlockDesc& gpuParamBlockDesc)
+        {
+            if (gpuParamsBlockBindFlags & (UINT32)GPU_BIND_PARAM_BLOCK_ALL)
+                return true;
+
+            bool listed = std::find(paramBlocksToBind.begin(), paramBlocksToBind.end(), gpuParamBlockDesc.Name) != paramBlocksToBind.end();
+            return ((gpuParamsBlockBindFlags & (UINT32)GPU_BIND_PARAM_BLOCK_LISTED) && listed) ||
+                ((gpuParamsBlockBindFlags & (UINT32)GPU_BIND_PARAM_BLOCK_ALL_EXCEPT) && !listed);
+        };
+
+        // Transient blocks live in the shared upload buffer. If it wraps around while flushing, blocks flushed before the
+        // wrap lose their contents, so flush until all of them end up in the same epoch before binding anything.
+        if (gpuParamsBindFlags & (UINT32)GPU_BIND_PARAM_BLOCK)
+        {
+            HardwareBufferManager& bufferManager = HardwareBufferManager::Instance();
+
+            UINT32 epoch = 0;
+            do
+            {
+                epoch = bufferManager.GetTransientEpoch();
+                for (UINT32 i = 0; i < GPT_COUNT; i++)
+                {
+                    SPtr<GpuParamDesc> paramDesc = gpuParams->GetParamDesc((GpuProgramType)i);
+                    if (paramDesc == nullptr)
+                        continue;
+
+                    for (auto& entry : paramDesc->ParamBlocks)
+                    {
+                        if (!IsParamBlockSelected(entry.second))
+                            continue;
+
+                        SPtr<GpuParamBlockBuffer> buffer = gpuParams->GetParamBlockBuffer(entry.second.Set, entry.second.Slot);
+                        if (buffer != nullptr)
+                            buffer->FlushToGPU();
+                    }
+                }
+            } while (epoch != bufferManager.GetTransientEpoch());
+        }
+
         auto PopulateParamBlocks = [&](GpuParamBlockDesc& gpuParamBlockDesc)
         {
             UINT32 slot = gpuParamBlockDesc.Slot;
@@ -326,10 +385,60 @@ namespace te
             if(!buffer)
                 TE_ASSERT_ERROR(false, "EMPTY BUFFER, slot : " + ToString(gpuParamBlockDesc.Slot) + ", set : " + ToString(gpuParamBlockDesc.Set));
 
-            buffer->FlushToGPU();
-            const D3D11GpuParamBlockBuffer* d3d11paramBlockBuffer =
-                static_cast<const D3D11GpuParamBlockBuffer*>(buffer.get());
-            _gpuResContainer.constBuffers.push_back(d3d11paramBlockBuffer->GetD3D11Buffer());
+            const TransientAllocation& allocation = buffer->GetTransientAllocation();
+            if (allocation.Buffer != nullptr)
+            {
+                // Offsets and sizes are in 16 byte constants, and already aligned to multiples of 16 constants
+                _gpuResContainer.constBuffers.push_back(static_cast<D3D11HardwareBuffer*>(allocation.Buffer)->GetD3DBuffer());
+                _gpuResContainer.constBufferFirstConstants.push_back(allocation.Offset / 16);
+                _gpuResContainer.constBufferNumConstants.push_back(allocation.Size / 16);
+            }
+            else
+            {
+                const D3D11GpuParamBlockBuffer* d3d11paramBlockBuffer =
+                    static_cast<const D3D11GpuParamBlockBuffer*>(buffer.get());
+                _gpuResContainer.constBuffers.push_back(d3d11paramBlockBuffer->GetD3D11Buffer());
+                _gpuResContainer.constBufferFirstConstants.push_back(0);
+                _gpuResContainer.constBufferNumConstants.push_back(D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT);
+            }
+        };
+
+        // Ranges can only be bound through the DX11.1 context, and only blocks in the upload buffer need them
+        auto SetConstantBuffers = [&](GpuProgramType type, UINT32 slot, UINT32 num)
+        {
+            ID3D11Buffer** buffers = _gpuResContainer.constBuffers.data();
+            const UINT* firstConstants = _gpuResContainer.constBufferFirstConstants.data();
+            const UINT* numConstants = _gpuResContainer.constBufferNumConstants.data();
+
+            switch (type)
+            {
+            case GPT_VERTEX_PROGRAM:
+                if (context1) context1->VSSetConstantBuffers1(slot, num, buffers, firstConstants, numConstants);
+                else context->VSSetConstantBuffers(slot, num, buffers);
+                break;
+            case GPT_PIXEL_PROGRAM:
+                if (context1) context1->PSSetConstantBuffers1(slot, num, buffers, firstConstants, numConstants);
+                else context->PSSetConstantBuffers(slot, num, buffers);
+                break;
+            case GPT_GEOMETRY_PROGRAM:
+                if (context1) context1->GSSetConstantBuffers1(slot, num, buffers, firstConstants, numConstants);
+                else context->GSSetConstantBuffers(slot, num, buffers);
+                break;
+            case GPT_HULL_PROGRAM:
+                if (context1) context1->HSSetConstantBuffers1(slot, num, buffers, firstConstants, numConstants);
+                else context->HSSetConstantBuffers(slot, num, buffers);
+                break;
+            case GPT_DOMAIN_PROGRAM:
+                if (context1) context1->DSSetConstantBuffers1(slot, num, buffers, firstConstants, numConstants);
+                else context->DSSetConstantBuffers(slot, num, buffers);
+                break;
+            case GPT_COMPUTE_PROGRAM:
+                if (context1) context1->CSSetConstantBuffers1(slot, num, buffers, firstConstants, numConstants);
+                else context->CSSetConstantBuffers(slot, num, buffers);
+                break;
+            default:
+                break;
+            }
         };
 
         auto PopulateViews = [&](GpuProgramType type, UINT32& slotConstBuffers)
@@ -337,6 +446,8 @@ namespace te
             _gpuResContainer.srvs.clear();
             _gpuResContainer.uavs.clear();
             _gpuResContainer.constBuffers.clear();
+            _gpuResContainer.constBufferFirstConstants.clear();
+            _gpuResContainer.constBufferNumConstants.clear();
             _gpuResContainer.samplers.clear();
 
             SPtr<GpuParamDesc> paramDesc = gpuParams->GetParamDesc(type);
@@ -508,7 +619,7 @@ namespace te
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
             if (numSRVs > 0) context->VSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numConstBuffers > 0) context->VSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
+            if (numConstBuffers > 0) SetConstantBuffers(GPT_VERTEX_PROGRAM, slotConstBuffers, numConstBuffers);
             if (numSamplers > 0) context->VSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
         }
 
@@ -530,7 +641,7 @@ namespace te
                 _PSUAVsBound = true;
             }
 
-            if (numConstBuffers > 0) context->PSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
+            if (numConstBuffers > 0) SetConstantBuffers(GPT_PIXEL_PROGRAM, slotConstBuffers, numConstBuffers);
             if (numSamplers > 0) context->PSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
         }
 
@@ -542,7 +653,7 @@ namespace te
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
             if (numSRVs > 0) context->GSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numConstBuffers > 0) context->GSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
+            if (numConstBuffers > 0) SetConstantBuffers(GPT_GEOMETRY_PROGRAM, slotConstBuffers, numConstBuffers);
             if (numSamplers > 0) context->GSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
         }
 
@@ -554,7 +665,7 @@ namespace te
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
             if (numSRVs > 0) context->HSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numConstBuffers > 0) context->HSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
+            if (numConstBuffers > 0) SetConstantBuffers(GPT_HULL_PROGRAM, slotConstBuffers, numConstBuffers);
             if (numSamplers > 0) context->HSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
         }
 
@@ -566,7 +677,7 @@ namespace te
             numSamplers = (UINT32)_gpuResContainer.samplers.size();
 
             if (numSRVs > 0) context->DSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
-            if (numConstBuffers > 0) context->DSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
+            if (numConstBuffers > 0) SetConstantBuffers(GPT_DOMAIN_PROGRAM, slotConstBuffers, numConstBuffers);
             if (numSamplers > 0) context->DSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
         }
 
@@ -579,7 +690,7 @@ namespace te
 
             if (numSRVs > 0) context->CSSetShaderResources(0, numSRVs, _gpuResContainer.srvs.data());
             if (numUAVs > 0) context->CSSetUnorderedAccessViews(0, numUAVs, _gpuResContainer.uavs.data(), nullptr);
-            if (numConstBuffers > 0) context->CSSetConstantBuffers(slotConstBuffers, numConstBuffers, _gpuResContainer.constBuffers.data());
+            if (numConstBuffers > 0) SetConstantBuffers(GPT_COMPUTE_PROGRAM, slotConstBuffers, numConstBuffers);
             if (numSamplers > 0) context->CSSetSamplers(0, numSamplers, _gpuResContainer.samplers.data());
         }
     }
@@ -600,7 +711,7 @@ namespace te
         _device->GetImmediateContext()->RSSetScissorRects(1, &_scissorRect);
     }
 
-    void D3D11RenderAPI::SetStencilRef(UINT32 value)
+    void D3D11RenderAPI::SetStencilRefInternal(UINT32 value)
     {
         _stencilRef = value;
 
@@ -610,7 +721,7 @@ namespace te
             _device->GetImmediateContext()->OMSetDepthStencilState(nullptr, _stencilRef);
     }
 
-    void D3D11RenderAPI::SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
+    void D3D11RenderAPI::SetVertexBuffersInternal(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
     {
         UINT32 maxBoundVertexBuffers = D3D11_MAX_BOUND_VERTEX_BUFFER;
         if (index < 0 || (index + numBuffers) >= maxBoundVertexBuffers)
@@ -645,7 +756,7 @@ namespace te
         }
     }
 
-    void D3D11RenderAPI::SetIndexBuffer(const SPtr<IndexBuffer>& buffer)
+    void D3D11RenderAPI::SetIndexBufferInternal(const SPtr<IndexBuffer>& buffer)
     {
         SPtr<D3D11IndexBuffer> indexBuffer = std::static_pointer_cast<D3D11IndexBuffer>(buffer);
 
@@ -660,12 +771,12 @@ namespace te
         _device->GetImmediateContext()->IASetIndexBuffer(indexBuffer->GetD3DIndexBuffer(), indexFormat, 0);
     }
 
-    void D3D11RenderAPI::SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration)
+    void D3D11RenderAPI::SetVertexDeclarationInternal(const SPtr<VertexDeclaration>& vertexDeclaration)
     {
         _activeVertexDeclaration = vertexDeclaration;
     }
 
-    void D3D11RenderAPI::SetDrawOperation(DrawOperationType op)
+    void D3D11RenderAPI::SetDrawOperationInternal(DrawOperationType op)
     {
         if (!_lastFrameGraphicPipeline || _lastFrameGraphicPipeline->drawOperationType != op)
         {
@@ -728,7 +839,7 @@ namespace te
         target->SwapBuffers();
     }
 
-    void D3D11RenderAPI::SetRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags)
+    void D3D11RenderAPI::SetRenderTargetInternal(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags)
     {
         _activeRenderTarget = target;
         _activeRenderTargetModified = false;
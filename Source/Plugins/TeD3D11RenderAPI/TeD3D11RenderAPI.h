@@ -43,12 +43,16 @@ namespace te
                 srvs.reserve(8);
                 uavs.reserve(8);
                 constBuffers.reserve(8);
+                constBufferFirstConstants.reserve(8);
+                constBufferNumConstants.reserve(8);
                 samplers.reserve(8);
             }
 
             Vector<ID3D11ShaderResourceView*> srvs;
             Vector<ID3D11UnorderedAccessView*> uavs;
             Vector<ID3D11Buffer*> constBuffers;
+            Vector<UINT> constBufferFirstConstants; /**< Only used when binding ranges of constant buffers. */
+            Vector<UINT> constBufferNumConstants; /**< Only used when binding ranges of constant buffers. */
             Vector<ID3D11SamplerState*> samplers;
         };
 
@@ -70,15 +74,8 @@ namespace te
 
         void Destroy() override;
 
-        /** @copydoc RenderAPI::SetGraphicsPipeline */
-        void SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState) override;
-
-        /** @copydoc RenderAPI::SetComputePipeline */
-        void SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState) override;
-
-        /** @copydoc RenderAPI::SetGpuParams */
-        void SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags = (UINT32)GPU_BIND_ALL, 
-            UINT32 gpuParamsBlockBindFlags = (UINT32)GPU_BIND_PARAM_BLOCK_ALL, const Vector<String>& paramBlocksToBind = {}) override;
+        /** @copydoc RenderAPI::EnableMultithreadedAccess */
+        bool EnableMultithreadedAccess() override;
 
         /** @copydoc RenderAPI::SetViewport */
         void SetViewport(const Rect2& area) override;
@@ -86,21 +83,6 @@ namespace te
         /** @copydoc RenderAPI::SetScissorRect */
         void SetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom) override;
 
-        /** @copydoc RenderAPI::SetStencilRef */
-        void SetStencilRef(UINT32 value) override;
-
-        /** @copydoc RenderAPI::SetVertexBuffers */
-        void SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers) override;
-
-        /** @copydoc RenderAPI::SetIndexBuffer */
-        void SetIndexBuffer(const SPtr<IndexBuffer>& buffer) override;
-
-        /** @copydoc RenderAPI::SetVertexDeclaration */
-        void SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration) override;
-
-        /** @copydoc RenderAPI::SetDrawOperation */
-        void SetDrawOperation(DrawOperationType op) override;
-
         /** @copydoc RenderAPI::Draw */
         void Draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount = 0) override;
 
@@ -113,9 +95,6 @@ namespace te
         /** @copydoc RenderAPI::SwapBuffers */
         void SwapBuffers(const SPtr<RenderTarget>& target) override;
 
-        /** @copydoc RenderAPI::SetRenderTarget */
-        void SetRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags) override;
-
         /** @copydoc RenderAPI::ClearRenderTarget */
         void ClearRenderTarget(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f, UINT16 stencil = 0, UINT8 targetMask = 0xFF) override;
 
@@ -131,6 +110,35 @@ namespace te
          */
         void DetermineMultisampleSettings(UINT32 multisampleCount, DXGI_FORMAT format, DXGI_SAMPLE_DESC* outputSampleDesc);
 
+    protected:
+        /** @copydoc RenderAPI::SetGpuParamsInternal */
+        void SetGpuParamsInternal(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+            UINT32 gpuParamsBlockBindFlags, const Vector<String>& paramBlocksToBind) override;
+
+        /** @copydoc RenderAPI::SetGraphicsPipelineInternal */
+        void SetGraphicsPipelineInternal(const SPtr<GraphicsPipelineState>& pipelineState) override;
+
+        /** @copydoc RenderAPI::SetComputePipelineInternal */
+        void SetComputePipelineInternal(const SPtr<ComputePipelineState>& pipelineState) override;
+
+        /** @copydoc RenderAPI::SetStencilRefInternal */
+        void SetStencilRefInternal(UINT32 value) override;
+
+        /** @copydoc RenderAPI::SetVertexBuffersInternal */
+        void SetVertexBuffersInternal(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers) override;
+
+        /** @copydoc RenderAPI::SetIndexBufferInternal */
+        void SetIndexBufferInternal(const SPtr<IndexBuffer>& buffer) override;
+
+        /** @copydoc RenderAPI::SetVertexDeclarationInternal */
+        void SetVertexDeclarationInternal(const SPtr<VertexDeclaration>& vertexDeclaration) override;
+
+        /** @copydoc RenderAPI::SetDrawOperationInternal */
+        void SetDrawOperationInternal(DrawOperationType op) override;
+
+        /** @copydoc RenderAPI::SetRenderTargetInternal */
+        void SetRenderTargetInternal(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags) override;
+
     private:
         /**
          * Creates or retrieves a proper input layout depending on the currently set vertex shader and vertex buffer.
@@ -4,13 +4,21 @@
 #include "Image/TeTexture.h"
 #include "Image/TePixelData.h"
 #include "Image/TePixelUtil.h"
+#include "Image/TeIBLUtility.h"
 #include "Utility/TeBitwise.h"
 #include "Utility/TeFileStream.h"
 #include "Utility/TeFileSystem.h"
+#include "Threading/TeTaskScheduler.h"
 #include "FreeImage.h"
 
 namespace te
 {
+    /** Number of pixel rows compressed by a single job. Must be a multiple of the 4 pixels high compression blocks. */
+    static constexpr UINT32 COMPRESSION_TILE_HEIGHT = 64;
+
+    /** Number of pixel rows remapped by a single job when generating cubemap faces. */
+    static constexpr UINT32 CUBEMAP_REMAP_ROWS_PER_JOB = 16;
+
     void FreeImageLoadErrorHandler(FREE_IMAGE_FORMAT fif, const char* message)
     {
         // Callback method as required by FreeImage to report problems
@@ -143,23 +151,24 @@ namespace te
             faceData.push_back(imgData);
         }
 
+        // Prefiltered environments store increasingly rough reflections in their mips, down to a single texel
+        bool prefilter = texType == TEX_TYPE_CUBE_MAP && textureImportOptions->PrefilterEnvironment;
+
         UINT32 numMips = 0;
-        if (textureImportOptions->GenerateMips)
+        if (prefilter)
         {
-            if (Bitwise::IsPow2(faceData[0]->GetWidth()) && Bitwise::IsPow2(faceData[0]->GetHeight()))
-            {
-                UINT32 maxPossibleMip = PixelUtil::GetMaxMipmaps(faceData[0]->GetWidth(), faceData[0]->GetHeight(),
-                    faceData[0]->GetDepth(), faceData[0]->GetFormat());
+            numMips = PixelUtil::GetMaxMipmaps(faceData[0]->GetWidth(), faceData[0]->GetHeight(),
+                faceData[0]->GetDepth(), faceData[0]->GetFormat());
+        }
+        else if (textureImportOptions->GenerateMips)
+        {
+            UINT32 maxPossibleMip = PixelUtil::GetMaxMipmaps(faceData[0]->GetWidth(), faceData[0]->GetHeight(),
+                faceData[0]->GetDepth(), faceData[0]->GetFormat());
 
-                if (textureImportOptions->MaxMip == 0)
-                    numMips = maxPossibleMip;
-                else
-                    numMips = std::min(maxPossibleMip, textureImportOptions->MaxMip);
-            }
+            if (textureImportOptions->MaxMip == 0)
+                numMips = maxPossibleMip;
             else
-            {
-                TE_DEBUG("Width and height of your image must be a power of 2");
-            }
+                numMips = std::min(maxPossibleMip, textureImportOptions->MaxMip);
         }
 
         int usage = TU_DEFAULT;
@@ -168,47 +177,204 @@ namespace te
 
         bool sRGB = textureImportOptions->SRGB;
 
+        PixelFormat format = textureImportOptions->Format;
+        if (textureImportOptions->Compress && !PixelUtil::IsCompressed(format))
+            format = SelectCompressedFormat(*faceData[0], *textureImportOptions);
+
+        // Block compressed textures are made of 4x4 blocks, the top level must be made of whole blocks
+        bool compress = PixelUtil::IsCompressed(format);
+        if (compress && (faceData[0]->GetWidth() % 4 != 0 || faceData[0]->GetHeight() % 4 != 0))
+        {
+            TE_DEBUG("Width and height of your image must be a multiple of 4 to be compressed");
+
+            compress = false;
+            format = textureImportOptions->Format;
+            if (PixelUtil::IsCompressed(format))
+                format = PixelUtil::IsFloatingPoint(faceData[0]->GetFormat()) ? PF_RGBA16F : PF_RGBA8;
+        }
+
         TEXTURE_DESC texDesc;
         texDesc.Type = texType;
         texDesc.Width = faceData[0]->GetWidth();
         texDesc.Height = faceData[0]->GetHeight();
         texDesc.NumMips = numMips;
-        texDesc.Format = textureImportOptions->Format;
+        texDesc.Format = format;
         texDesc.Usage = usage;
         texDesc.HwGamma = sRGB;
 
         SPtr<Texture> texture = Texture::_createPtr(texDesc);
 
+        // Faces are independent, mip chains are generated in parallel
         UINT32 numFaces = (UINT32)faceData.size();
-        for (UINT32 i = 0; i < numFaces; i++)
+        Vector<Vector<SPtr<PixelData>>> mipLevels(numFaces);
+        if (prefilter)
+        {
+            // Both filters split their work across all cores internally, and share the source converted to floats
+            SPtr<IBLCubemap> source = IBLUtility::CreateCubemap(faceData, sRGB);
+            mipLevels = IBLUtility::FilterRadiance(*source, numMips);
+            texture->SetIrradiance(IBLUtility::FilterIrradiance(*source));
+        }
+        else
         {
-            Vector<SPtr<PixelData>> mipLevels;
-            if (numMips > 0)
+            auto generateMipmaps = [&](UINT32 face)
             {
-                MipMapGenOptions mipOptions;
-                mipOptions.isSRGB = sRGB;
+                if (numMips > 0)
+                {
+                    MipMapGenOptions mipOptions;
+                    mipOptions.isSRGB = sRGB;
+                    mipOptions.isNormalMap = textureImportOptions->IsNormalMap;
+                    mipOptions.normalizeMipmaps = textureImportOptions->IsNormalMap;
 
-                mipLevels = PixelUtil::GenMipmaps(*faceData[i], mipOptions, numMips);
-            }
+                    mipLevels[face] = PixelUtil::GenMipmaps(*faceData[face], mipOptions, numMips);
+                }
+                else
+                {
+                    mipLevels[face].push_back(faceData[face]);
+                }
+            };
+
+            if (TaskScheduler::IsStarted())
+                gTaskScheduler().ParallelFor(numFaces, generateMipmaps);
             else
             {
-                mipLevels.push_back(faceData[i]);
+                for (UINT32 face = 0; face < numFaces; face++)
+                    generateMipmaps(face);
             }
+        }
+
+        Vector<Vector<SPtr<PixelData>>> dstLevels(numFaces);
+        for (UINT32 face = 0; face < numFaces; face++)
+        {
+            for (UINT32 mip = 0; mip < (UINT32)mipLevels[face].size(); ++mip)
+                dstLevels[face].push_back(texture->GetProperties().AllocBuffer(face, mip));
+        }
 
-            for (UINT32 mip = 0; mip < (UINT32)mipLevels.size(); ++mip)
+        if (compress)
+        {
+            CompressionOptions compressionOptions;
+            compressionOptions.format = format;
+            compressionOptions.alphaMode = PixelUtil::HasAlpha(format) ? AlphaMode::Transparency : AlphaMode::None;
+            compressionOptions.isNormalMap = textureImportOptions->IsNormalMap;
+            compressionOptions.isSRGB = sRGB;
+            compressionOptions.quality = textureImportOptions->Quality;
+
+            // Blocks are compressed independently, so every face and mip is split into strips of whole block rows, each
+            // compressed straight into its part of the destination buffer. This keeps all cores busy even with a single
+            // large image.
+            struct CompressionTile
             {
-                SPtr<PixelData> dst = texture->GetProperties().AllocBuffer(0, mip);
+                UINT32 Face;
+                UINT32 Mip;
+                UINT32 Top;
+                UINT32 Height;
+            };
 
-                PixelUtil::BulkPixelConversion(*mipLevels[mip], *dst);
-                texture->WriteData(*dst, mip, i); //BUG in original version
+            Vector<CompressionTile> tiles;
+            for (UINT32 face = 0; face < numFaces; face++)
+            {
+                for (UINT32 mip = 0; mip < (UINT32)mipLevels[face].size(); ++mip)
+                {
+                    const UINT32 height = mipLevels[face][mip]->GetHeight();
+                    for (UINT32 top = 0; top < height; top += COMPRESSION_TILE_HEIGHT)
+                        tiles.push_back({ face, mip, top, std::min(COMPRESSION_TILE_HEIGHT, height - top) });
+                }
+            }
+
+            auto compressTile = [&](UINT32 tileIdx)
+            {
+                const CompressionTile& tile = tiles[tileIdx];
+                const PixelData& src = *mipLevels[tile.Face][tile.Mip];
+                PixelData& dst = *dstLevels[tile.Face][tile.Mip];
+
+                PixelData srcTile = src.GetSubVolume(PixelVolume(0, tile.Top, src.GetWidth(), tile.Top + tile.Height));
+
+                PixelData dstTile(src.GetWidth(), tile.Height, 1, format);
+                dstTile.SetExternalBuffer(dst.GetData() + PixelUtil::GetMemorySize(src.GetWidth(), tile.Top, 1, format));
+
+                PixelUtil::Compress(srcTile, dstTile, compressionOptions);
+            };
+
+            if (TaskScheduler::IsStarted())
+                gTaskScheduler().ParallelFor((UINT32)tiles.size(), compressTile);
+            else
+            {
+                for (UINT32 i = 0; i < (UINT32)tiles.size(); i++)
+                    compressTile(i);
             }
         }
+        else
+        {
+            for (UINT32 face = 0; face < numFaces; face++)
+            {
+                for (UINT32 mip = 0; mip < (UINT32)mipLevels[face].size(); ++mip)
+                    PixelUtil::BulkPixelConversion(*mipLevels[face][mip], *dstLevels[face][mip]);
+            }
+        }
+
+        for (UINT32 face = 0; face < numFaces; face++)
+        {
+            for (UINT32 mip = 0; mip < (UINT32)dstLevels[face].size(); ++mip)
+                texture->WriteData(*dstLevels[face][mip], mip, face);
+        }
 
         texture->SetName(filePath);
         texture->SetPath(filePath);
         return texture;
     }
 
+    PixelFormat FreeImgImporter::SelectCompressedFormat(const PixelData& source, const TextureImportOptions& options) const
+    {
+        if (options.IsNormalMap)
+            return PF_BC5;
+
+        if (PixelUtil::IsFloatingPoint(source.GetFormat()))
+            return PF_BC6H;
+
+        if (PixelUtil::GetNumElemBytes(source.GetFormat()) == 1 && !PixelUtil::HasAlpha(source.GetFormat()))
+            return PF_BC4;
+
+        if (options.Quality == CompressionQuality::Production || options.Quality == CompressionQuality::Highest)
+            return PF_BC7;
+
+        if (!PixelUtil::HasAlpha(source.GetFormat()))
+            return PF_BC1;
+
+        // A single transparent pixel is enough to require BC3, so every pixel is checked. The common 8-bit formats read
+        // the alpha channel directly, going through GetColorAt() is slow on large images.
+        const PixelFormat format = source.GetFormat();
+        const bool isRGBA8 = format == PF_RGBA8 || format == PF_BGRA8;
+
+        for (UINT32 z = 0; z < source.GetDepth(); z++)
+        {
+            for (UINT32 y = 0; y < source.GetHeight(); y++)
+            {
+                if (isRGBA8)
+                {
+                    const UINT8* row = source.GetData() + (size_t)z * source.GetSlicePitch() +
+                        (size_t)y * source.GetRowPitch();
+                    for (UINT32 x = 0; x < source.GetWidth(); x++)
+                    {
+                        UINT32 pixel;
+                        memcpy(&pixel, row + x * 4, sizeof(pixel));
+
+                        if ((pixel & 0xFF000000) != 0xFF000000)
+                            return PF_BC3;
+                    }
+                }
+                else
+                {
+                    for (UINT32 x = 0; x < source.GetWidth(); x++)
+                    {
+                        if (source.GetColorAt(x, y, z).a < 1.0f)
+                            return PF_BC3;
+                    }
+                }
+            }
+        }
+
+        return PF_BC1;
+    }
+
     SPtr<PixelData> FreeImgImporter::ImportRawImage(const String& filePath)
     {
         uint8_t* data = nullptr;
@@ -532,10 +698,20 @@ namespace te
     /** Resizes the provided cubemap faces and outputs a new set of resized faces. */
     void DownsampleCubemap(const std::array<SPtr<PixelData>, 6>& input, std::array<SPtr<PixelData>, 6>& output, UINT32 size)
     {
-        for(UINT32 i = 0; i < 6; i++)
-        {
+        for (UINT32 i = 0; i < 6; i++)
             output[i] = PixelData::Create(size, size, 1, input[i]->GetFormat());
+
+        auto scaleFace = [&](UINT32 i)
+        {
             PixelUtil::Scale(*input[i], *output[i]);
+        };
+
+        if (TaskScheduler::IsStarted())
+            gTaskScheduler().ParallelFor(6, scaleFace);
+        else
+        {
+            for (UINT32 i = 0; i < 6; i++)
+                scaleFace(i);
         }
     }
 
@@ -568,13 +744,20 @@ namespace te
             { {0, 1, 2}, { -1.0f, -1.0f, -1.0f }}  // Z-
         };
 
-        float invSize = 1.0f / faceSize;
         for (UINT32 faceIdx = 0; faceIdx < 6; faceIdx++)
-        {
             output[faceIdx] = PixelData::Create(faceSize, faceSize, 1, source->GetFormat());
 
+        // Every output pixel is independent, faces are split into groups of rows remapped in parallel
+        float invSize = 1.0f / faceSize;
+        UINT32 jobsPerFace = Math::DivideAndRoundUp(faceSize, CUBEMAP_REMAP_ROWS_PER_JOB);
+        auto remapRows = [&](UINT32 job)
+        {
+            UINT32 faceIdx = job / jobsPerFace;
+            UINT32 top = (job % jobsPerFace) * CUBEMAP_REMAP_ROWS_PER_JOB;
+            UINT32 bottom = std::min(faceSize, top + CUBEMAP_REMAP_ROWS_PER_JOB);
+
             const RemapInfo& remapInfo = remapLookup[faceIdx];
-            for (UINT32 y = 0; y < faceSize; y++)
+            for (UINT32 y = top; y < bottom; y++)
             {
                 for (UINT32 x = 0; x < faceSize; x++)
                 {
@@ -598,6 +781,14 @@ namespace te
                     output[faceIdx]->SetColorAt(color, x, y);
                 }
             }
+        };
+
+        if (TaskScheduler::IsStarted())
+            gTaskScheduler().ParallelFor(6 * jobsPerFace, remapRows);
+        else
+        {
+            for (UINT32 job = 0; job < 6 * jobsPerFace; job++)
+                remapRows(job);
         }
     }
 
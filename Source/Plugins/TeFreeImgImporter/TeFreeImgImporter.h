@@ -25,6 +25,9 @@ namespace te
         /** Converts a magic number into an extension name. */
         String MagicNumToExtension(const UINT8* magic, UINT32 maxBytes) const;
 
+        /** Chooses the block compressed format best suited to the provided image. */
+        PixelFormat SelectCompressedFormat(const PixelData& source, const TextureImportOptions& options) const;
+
         /** Imports an image from the provided data stream. */
         SPtr<PixelData> ImportRawImage(const String& filePath);
 
@@ -38,6 +38,7 @@ namespace te
             desc.EntryPoint = _entryPoint;
             desc.Source = _source;
             desc.Language = "glsl";
+            desc.Defines = _defines;
 
             _bytecode = CompileBytecode(desc);
         }
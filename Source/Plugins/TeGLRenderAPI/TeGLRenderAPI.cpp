@@ -67,17 +67,17 @@ namespace te
         RenderAPI::Destroy();
     }
 
-    void GLRenderAPI::SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState)
+    void GLRenderAPI::SetGraphicsPipelineInternal(const SPtr<GraphicsPipelineState>& pipelineState)
     {
         // TODO
     }
 
-    void GLRenderAPI::SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState)
+    void GLRenderAPI::SetComputePipelineInternal(const SPtr<ComputePipelineState>& pipelineState)
     {
         // TODO
     }
 
-    void GLRenderAPI::SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+    void GLRenderAPI::SetGpuParamsInternal(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
         UINT32 gpuParamsBlockBindFlags, const Vector<String>& paramBlocksToBind)
     {
         // TODO
@@ -93,27 +93,27 @@ namespace te
         // TODO
     }
 
-    void GLRenderAPI::SetStencilRef(UINT32 value)
+    void GLRenderAPI::SetStencilRefInternal(UINT32 value)
     {
         // TODO
     }
 
-    void GLRenderAPI::SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
+    void GLRenderAPI::SetVertexBuffersInternal(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
     {
         // TODO
     }
 
-    void GLRenderAPI::SetIndexBuffer(const SPtr<IndexBuffer>& buffer)
+    void GLRenderAPI::SetIndexBufferInternal(const SPtr<IndexBuffer>& buffer)
     {
         // TODO
     }
 
-    void GLRenderAPI::SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration)
+    void GLRenderAPI::SetVertexDeclarationInternal(const SPtr<VertexDeclaration>& vertexDeclaration)
     {
         // TODO
     }
 
-    void GLRenderAPI::SetDrawOperation(DrawOperationType op)
+    void GLRenderAPI::SetDrawOperationInternal(DrawOperationType op)
     {
         // TODO
     }
@@ -138,7 +138,7 @@ namespace te
         // TODO
     }
 
-    void GLRenderAPI::SetRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags)
+    void GLRenderAPI::SetRenderTargetInternal(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags)
     {
         // TODO
     }
@@ -16,37 +16,12 @@ namespace te
         void Initialize() override;
         void Destroy() override;
 
-        /** @copydoc RenderAPI::setGraphicsPipeline */
-        void SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState) override;
-
-        /** @copydoc RenderAPI::SetComputePipeline */
-        void SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState) override;
-
-        /** @copydoc RenderAPI::SetGpuParams */
-        void SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags = (UINT32)GPU_BIND_ALL,
-            UINT32 gpuParamsBlockBindFlags = (UINT32)GPU_BIND_PARAM_BLOCK_ALL, const Vector<String>& paramBlocksToBind = {}) override;
-        
         /** @copydoc RenderAPI::SetViewport */
         void SetViewport(const Rect2& area) override;
 
         /** @copydoc RenderAPI::SetScissorRect */
         void SetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom) override;
 
-        /** @copydoc RenderAPI::SetStencilRef */
-        void SetStencilRef(UINT32 value) override;
-
-        /** @copydoc RenderAPI::SetVertexBuffers */
-        void SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers) override;
-
-        /** @copydoc RenderAPI::SetIndexBuffer */
-        void SetIndexBuffer(const SPtr<IndexBuffer>& buffer) override;
-
-        /** @copydoc RenderAPI::SetVertexDeclaration */
-        void SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration) override;
-
-        /** @copydoc RenderAPI::SetDrawOperation */
-        void SetDrawOperation(DrawOperationType op) override;
-
         /** @copydoc RenderAPI::Draw */
         void Draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount = 0) override;
 
@@ -59,9 +34,6 @@ namespace te
         /** @copydoc RenderAPI::SwapBuffers */
         void SwapBuffers(const SPtr<RenderTarget>& target) override;
 
-        /** @copydoc RenderAPI::SetRenderTarget */
-        void SetRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags) override;
-
         /** @copydoc RenderAPI::ClearRenderTarget */
         void ClearRenderTarget(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f, UINT16 stencil = 0, UINT8 targetMask = 0xFF) override;
 
@@ -77,6 +49,35 @@ namespace te
         /**	Creates render system capabilities that specify which features are or aren't supported. */
         void InitCapabilities(RenderAPICapabilities& caps) const;
 
+    protected:
+        /** @copydoc RenderAPI::SetGpuParamsInternal */
+        void SetGpuParamsInternal(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+            UINT32 gpuParamsBlockBindFlags, const Vector<String>& paramBlocksToBind) override;
+
+        /** @copydoc RenderAPI::SetGraphicsPipelineInternal */
+        void SetGraphicsPipelineInternal(const SPtr<GraphicsPipelineState>& pipelineState) override;
+
+        /** @copydoc RenderAPI::SetComputePipelineInternal */
+        void SetComputePipelineInternal(const SPtr<ComputePipelineState>& pipelineState) override;
+
+        /** @copydoc RenderAPI::SetStencilRefInternal */
+        void SetStencilRefInternal(UINT32 value) override;
+
+        /** @copydoc RenderAPI::SetVertexBuffersInternal */
+        void SetVertexBuffersInternal(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers) override;
+
+        /** @copydoc RenderAPI::SetIndexBufferInternal */
+        void SetIndexBufferInternal(const SPtr<IndexBuffer>& buffer) override;
+
+        /** @copydoc RenderAPI::SetVertexDeclarationInternal */
+        void SetVertexDeclarationInternal(const SPtr<VertexDeclaration>& vertexDeclaration) override;
+
+        /** @copydoc RenderAPI::SetDrawOperationInternal */
+        void SetDrawOperationInternal(DrawOperationType op) override;
+
+        /** @copydoc RenderAPI::SetRenderTargetInternal */
+        void SetRenderTargetInternal(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags) override;
+
     private:
         GLGLSLProgramFactory* _GLSLFactory = nullptr;
     };
@@ -2,6 +2,7 @@
 #include "Importer/TeMeshImportOptions.h"
 #include "Mesh/TeMesh.h"
 #include "Mesh/TeMeshData.h"
+#include "Mesh/TeMeshUtility.h"
 #include "Image/TeColor.h"
 #include "Animation/TeSkeleton.h"
 #include "Animation/TeAnimationUtility.h"
@@ -161,6 +162,49 @@ namespace te
 
         SPtr<RendererMeshData> rendererMeshData = GenerateMeshData(importedScene, assimpImportOptions, subMeshes);
 
+        // Levels of detail are generated first, so they are optimized along with the full detail mesh
+        if (rendererMeshData && !meshImportOptions->LodReductionRatios.empty())
+        {
+            SPtr<MeshData> meshData = MeshUtility::GenerateLods(rendererMeshData->GetData(), subMeshes,
+                meshImportOptions->LodReductionRatios, meshImportOptions->LodMaxError);
+
+            if (meshData != rendererMeshData->GetData())
+            {
+                TE_PRINT("Generated levels of detail for mesh '" + filePath + "' : indices " +
+                    ToString(rendererMeshData->GetData()->GetNumIndices()) + " -> " + ToString(meshData->GetNumIndices()));
+
+                rendererMeshData = RendererMeshData::Create(meshData);
+            }
+        }
+
+        if (rendererMeshData && meshImportOptions->OptimizeMesh)
+        {
+            VertexCacheStatistics before;
+            VertexCacheStatistics after;
+            SPtr<MeshData> meshData = MeshUtility::OptimizeMesh(rendererMeshData->GetData(), subMeshes, &before, &after);
+
+            TE_PRINT("Optimized mesh '" + filePath + "' : ACMR " + ToString(before.ACMR) + " -> " + ToString(after.ACMR) +
+                ", ATVR " + ToString(before.ATVR) + " -> " + ToString(after.ATVR) + ", vertices " +
+                ToString(rendererMeshData->GetData()->GetNumVertices()) + " -> " + ToString(meshData->GetNumVertices()));
+
+            rendererMeshData = RendererMeshData::Create(meshData);
+        }
+
+        // Quantization comes last, as the steps above work on floating point positions
+        if (rendererMeshData && meshImportOptions->QuantizeVertices)
+        {
+            SPtr<MeshData> meshData = MeshUtility::QuantizeVertices(rendererMeshData->GetData());
+
+            if (meshData != rendererMeshData->GetData())
+            {
+                TE_PRINT("Quantized mesh '" + filePath + "' : vertex size " +
+                    ToString(rendererMeshData->GetData()->GetVertexDesc()->GetVertexStride()) + " -> " +
+                    ToString(meshData->GetVertexDesc()->GetVertexStride()) + " bytes");
+
+                rendererMeshData = RendererMeshData::Create(meshData);
+            }
+        }
+
         skeleton = CreateSkeleton(importedScene, subMeshes.size() > 1);
 
         // Import animation clips
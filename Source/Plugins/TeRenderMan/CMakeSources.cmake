@@ -6,6 +6,7 @@ set (TE_RENDERMAN_INC_NOFILTER
     "TeRendererScene.h"
     "TeRendererView.h"
     "TeRendererRenderable.h"
+    "TeRendererInstanceBuffer.h"
     "TeRendererLight.h"
     "TeRenderCompositor.h"
 )
@@ -17,6 +18,7 @@ set (TE_RENDERERMAN_SRC_NOFILTER
     "TeRendererScene.cpp"
     "TeRendererView.cpp"
     "TeRendererRenderable.cpp"
+    "TeRendererInstanceBuffer.cpp"
     "TeRendererLight.cpp"
     "TeRenderCompositor.cpp"
 )
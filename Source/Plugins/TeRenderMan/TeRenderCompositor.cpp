@@ -15,59 +15,189 @@
 #include "TeRendererLight.h"
 #include "Gui/TeGuiAPI.h"
 #include "Utility/TeFrameAllocator.h"
+#include "RenderAPI/TeCommandBuffer.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
     UnorderedMap<String, RenderCompositor::NodeType*> RenderCompositor::_nodeTypes;
 
-    /** Renders all elements in a render queue. */
-    void RenderQueueElements(const Vector<RenderQueueElement>& elements, const RendererView& view, const SceneInfo& scene, const RendererViewGroup& viewGroup)
+    /**
+     * Minimum number of render queue elements recorded by a single command buffer. Smaller queues are rendered
+     * immediately, as the cost of recording and replaying would outweigh the gain of doing it in parallel.
+     */
+    static constexpr UINT32 MIN_ELEMENTS_PER_COMMAND_BUFFER = 256;
+
+    /** Helpers that forward to the immediate or recording variants of RendererUtility methods. */
+    static void SetPass(RenderAPI& /*rapi*/, const SPtr<Material>& material, UINT32 passIdx, UINT32 techniqueIdx)
+    {
+        gRendererUtility().SetPass(material, passIdx, techniqueIdx);
+    }
+
+    static void SetPass(CommandBuffer& commandBuffer, const SPtr<Material>& material, UINT32 passIdx, UINT32 techniqueIdx)
+    {
+        gRendererUtility().SetPass(commandBuffer, material, passIdx, techniqueIdx);
+    }
+
+    static void SetPassParams(RenderAPI& /*rapi*/, const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags, bool isInstanced)
+    {
+        gRendererUtility().SetPassParams(gpuParams, gpuParamsBindFlags, isInstanced);
+    }
+
+    static void SetPassParams(CommandBuffer& commandBuffer, const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags, bool isInstanced)
+    {
+        gRendererUtility().SetPassParams(commandBuffer, gpuParams, gpuParamsBindFlags, isInstanced);
+    }
+
+    static void DrawElement(RenderAPI& /*rapi*/, const RenderElement& element, UINT32 lod)
+    {
+        element.Draw(lod);
+    }
+
+    static void DrawElement(CommandBuffer& commandBuffer, const RenderElement& element, UINT32 lod)
+    {
+        element.Draw(commandBuffer, lod);
+    }
+
+    /**
+     * Calls @p func for every element of a range of render queue elements, together with a flag telling if the element
+     * uses a different material than the previous one and needs all of its GPU params bound. Each range starts with a
+     * full bind, so ranges can be recorded independently.
+     */
+    template<class Func>
+    void ForEachQueueElement(const RenderQueueElement* begin, const RenderQueueElement* end, Func func)
     {
-        RenderAPI& rapi = RenderAPI::Instance();
         SPtr<Material> lastMaterial = nullptr;
-        UINT32 gpuParamsBindFlags = 0;
 
-        for(auto& entry : elements)
+        for(const RenderQueueElement* iter = begin; iter != end; ++iter)
         {
-            if(entry.ApplyPass)
-                gRendererUtility().SetPass(entry.RenderElem->MaterialElem, entry.TechniqueIdx, entry.PassIdx);
+            const RenderQueueElement& entry = *iter;
 
             // If Material is the same as the previous object, we only set constant buffer params
             // Instead, we set full gpu params
+            const bool bindAll = !lastMaterial || lastMaterial != entry.RenderElem->MaterialElem;
+            lastMaterial = entry.RenderElem->MaterialElem;
+
+            func(entry, bindAll);
+        }
+    }
+
+    /** 
+     * Updates the GPU params of a render queue element before it is bound. Params and param block buffers are shared
+     * between elements, so this must not run while other threads record elements.
+     */
+    void UpdateQueueElementParams(const RenderQueueElement& entry, bool bindAll, const RendererView& view,
+        const SceneInfo& scene)
+    {
+        const SPtr<GpuParams>& gpuParams = entry.RenderElem->GpuParamsElem[entry.PassIdx];
+
+        if (bindAll)
+        {
+            gpuParams->SetParamBlockBuffer("PerLightsBuffer", gPerLightsParamBuffer);
+            gpuParams->SetParamBlockBuffer("PerCameraBuffer", view.GetPerViewBuffer());
+            gpuParams->SetParamBlockBuffer("PerFrameBuffer", scene.PerFrameParamBuffer);
+        }
+        else
+        {
+            entry.RenderElem->MaterialElem->SetGpuParam(gpuParams);
+        }
+    }
+
+    /**
+     * Binds and draws a render queue element using either the RenderAPI directly, or by recording it into a
+     * CommandBuffer. Only reads the element's GPU params, see UpdateQueueElementParams().
+     */
+    template<class Context>
+    void DrawQueueElement(Context& context, const RenderQueueElement& entry, bool bindAll)
+    {
+        const SPtr<GpuParams>& gpuParams = entry.RenderElem->GpuParamsElem[entry.PassIdx];
+
+        if(entry.ApplyPass)
+            SetPass(context, entry.RenderElem->MaterialElem, entry.TechniqueIdx, entry.PassIdx);
+
+        UINT32 gpuParamsBindFlags;
+        if (bindAll)
+        {
+            gpuParamsBindFlags = GPU_BIND_ALL;
+
             // We also set camera buffer view here (because it will set PerCameraBuffer correctly for the current pass on this material only once)
-            if (!lastMaterial || lastMaterial != entry.RenderElem->MaterialElem)
+            context.SetGpuParams(gpuParams, GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, { "PerLightsBuffer" });
+            context.SetGpuParams(gpuParams, GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, { "PerCameraBuffer" });
+            context.SetGpuParams(gpuParams, GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, { "PerFrameBuffer" });
+        }
+        else
+        {
+            gpuParamsBindFlags = GPU_BIND_PARAM_BLOCK | GPU_BIND_BUFFER;
+        }
+
+        bool isInstanced = (entry.RenderElem->InstanceCount > 0) ? true : false;
+
+        SetPassParams(context, gpuParams, gpuParamsBindFlags, isInstanced);
+        DrawElement(context, *entry.RenderElem, entry.Lod);
+    }
+
+    /** 
+     * Renders all elements in a render queue. Large queues are split into slices that are recorded into command buffers
+     * by the task scheduler workers in parallel, and then executed in queue order. 
+     */
+    void RenderQueueElements(const Vector<RenderQueueElement>& elements, const RendererView& view, const SceneInfo& scene, const RendererViewGroup& viewGroup)
+    {
+        RenderAPI& rapi = RenderAPI::Instance();
+        const UINT32 numElements = (UINT32)elements.size();
+        const RenderQueueElement* elementData = elements.data();
+
+        UINT32 numSlices = 1;
+        if (TaskScheduler::IsStarted())
+        {
+            numSlices = std::min(gTaskScheduler().GetConcurrency(),
+                (numElements + MIN_ELEMENTS_PER_COMMAND_BUFFER - 1) / MIN_ELEMENTS_PER_COMMAND_BUFFER);
+        }
+
+        if (numSlices <= 1)
+        {
+            ForEachQueueElement(elementData, elementData + numElements, [&](const RenderQueueElement& entry, bool bindAll)
             {
-                gpuParamsBindFlags = GPU_BIND_ALL;
-                lastMaterial = entry.RenderElem->MaterialElem;
+                UpdateQueueElementParams(entry, bindAll, view, scene);
+                DrawQueueElement(rapi, entry, bindAll);
+            });
 
-                entry.RenderElem->GpuParamsElem[entry.PassIdx]
-                    ->SetParamBlockBuffer("PerLightsBuffer", gPerLightsParamBuffer);
+            return;
+        }
 
-                rapi.SetGpuParams(entry.RenderElem->GpuParamsElem[entry.PassIdx],
-                    GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, { "PerLightsBuffer" });
+        // Only ever used from the rendering thread, kept around so command memory is reused between frames
+        static Vector<CommandBuffer> commandBuffers;
+        if (commandBuffers.size() < numSlices)
+            commandBuffers.resize(numSlices);
 
-                entry.RenderElem->GpuParamsElem[entry.PassIdx]
-                    ->SetParamBlockBuffer("PerCameraBuffer", view.GetPerViewBuffer());
-                
-                rapi.SetGpuParams(entry.RenderElem->GpuParamsElem[entry.PassIdx],
-                    GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, { "PerCameraBuffer" });
+        const UINT32 elementsPerSlice = (numElements + numSlices - 1) / numSlices;
 
-                entry.RenderElem->GpuParamsElem[entry.PassIdx]
-                    ->SetParamBlockBuffer("PerFrameBuffer", scene.PerFrameParamBuffer);
+        // Update params up front, so workers only read them while recording
+        for (UINT32 i = 0; i < numSlices; i++)
+        {
+            const UINT32 start = i * elementsPerSlice;
+            const UINT32 end = std::min(start + elementsPerSlice, numElements);
 
-                rapi.SetGpuParams(entry.RenderElem->GpuParamsElem[entry.PassIdx],
-                    GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, { "PerFrameBuffer" });
-            }
-            else
+            ForEachQueueElement(elementData + start, elementData + end, [&](const RenderQueueElement& entry, bool bindAll)
             {
-                entry.RenderElem->MaterialElem->SetGpuParam(entry.RenderElem->GpuParamsElem[entry.PassIdx]);
-                gpuParamsBindFlags = GPU_BIND_PARAM_BLOCK | GPU_BIND_BUFFER;
-            }
+                UpdateQueueElementParams(entry, bindAll, view, scene);
+            });
+        }
 
-            bool isInstanced = (entry.RenderElem->InstanceCount > 0) ? true : false;
+        gTaskScheduler().ParallelFor(numSlices, [&](UINT32 sliceIdx)
+        {
+            const UINT32 start = sliceIdx * elementsPerSlice;
+            const UINT32 end = std::min(start + elementsPerSlice, numElements);
+
+            ForEachQueueElement(elementData + start, elementData + end, [&](const RenderQueueElement& entry, bool bindAll)
+            {
+                DrawQueueElement(commandBuffers[sliceIdx], entry, bindAll);
+            });
+        });
 
-            gRendererUtility().SetPassParams(entry.RenderElem->GpuParamsElem[entry.PassIdx], gpuParamsBindFlags, isInstanced);
-            entry.RenderElem->Draw();
+        for (UINT32 i = 0; i < numSlices; i++)
+        {
+            rapi.ExecuteCommands(commandBuffers[i]);
+            commandBuffers[i].Reset();
         }
     }
 
@@ -326,7 +456,7 @@ namespace te
         const auto numRenderables = (UINT32)inputs.Scene.Renderables.size();
         for (UINT32 i = 0; i < numRenderables; i++)
         {
-            if (!inputs.Scene.Renderables[i]->RenderablePtr->GetCastLight())
+            if (!inputs.Scene.Renderables[i]->CastLight)
                 continue;
 
             // Compute list of lights that influence renderables
@@ -394,7 +524,7 @@ namespace te
         else
             return;
 
-        SPtr<Texture> radiance = skybox ? skybox->GetTexture() : nullptr;
+        SPtr<Texture> radiance = skybox ? inputs.Scene.SkyboxTexture : nullptr;
         float brightness = skybox ? skybox->GetBrightness() : 0.0f;
 
         if (radiance != nullptr)
@@ -592,13 +722,13 @@ namespace te
         {
             auto& texProps = ppLastFrame->GetProperties();
             motionBlur->Execute(ppLastFrame, ppOutput, depth, velocity, inputs.View.GetPerViewBuffer(),
-                settings, texProps.GetNumSamples());
+                settings, inputs.FrameInfos.Timings.TimeDelta, texProps.GetNumSamples());
         }
         else
         {
             auto& texProps = gpuInitializationPassNode->SceneTex->Tex->GetProperties();
             motionBlur->Execute(gpuInitializationPassNode->SceneTex->Tex, ppOutput, depth, velocity, inputs.View.GetPerViewBuffer(),
-                settings, texProps.GetNumSamples());
+                settings, inputs.FrameInfos.Timings.TimeDelta, texProps.GetNumSamples());
         }
     }
 
@@ -796,7 +926,7 @@ namespace te
         SPtr<Texture> input;
         if (viewProps.RunPostProcessing && viewProps.Target.NumSamples == 1)
         {
-            switch (inputs.View.GetSceneCamera()->GetRenderSettings()->OutputType)
+            switch (inputs.View.GetRenderSettings().OutputType)
             {
             case RenderOutputType::Final:
                 input = postProcessNode->GetLastOutput();
@@ -841,7 +971,7 @@ namespace te
 
         gRendererUtility().Blit(input, Rect2I::EMPTY, viewProps.FlipView, false);
 
-        if (inputs.View.GetSceneCamera()->IsMain() && GuiAPI::Instance().IsGuiInitialized())
+        if (viewProps.MainView && GuiAPI::Instance().IsGuiInitialized())
         {
             GuiAPI::Instance().EndFrame();
         }
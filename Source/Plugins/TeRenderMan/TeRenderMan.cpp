@@ -1,18 +1,16 @@
  #include "TeRenderMan.h"
 #include "RenderAPI/TeRenderAPI.h"
 #include "Manager/TeRendererManager.h"
-#include "CoreUtility/TeCoreObjectManager.h"
 #include "Renderer/TeRendererUtility.h"
 #include "Renderer/TeGpuResourcePool.h"
 #include "Renderer/TeCamera.h"
 #include "TeRenderCompositor.h"
-#include "Utility/TeTime.h"
+#include "TeCoreApplication.h"
 #include "Gui/TeGuiAPI.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
-    SPtr<GpuParamBlockBuffer> gPerInstanceParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER];
-
     RenderMan::RenderMan()
     { }
 
@@ -20,12 +18,6 @@ namespace te
     {
         if (gPerLightsParamBuffer)
             gPerLightsParamBuffer = nullptr;
-
-        for (UINT32 i = 0; i < STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER; i++)
-        {
-            if (gPerInstanceParamBuffer[i])
-                gPerInstanceParamBuffer[i] = nullptr;
-        }
     }
 
     void RenderMan::Initialize()
@@ -34,18 +26,11 @@ namespace te
         RendererUtility::StartUp();
         GpuResourcePool::StartUp();
 
-        for (UINT32 i = 0; i < STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER; i++)
-        {
-            gPerInstanceParamBuffer[i] = gPerInstanceParamDef.CreateBuffer();
-        }
-
         _options = te_shared_ptr_new<RenderManOptions>();
         _options->InstancingMode = RenderManInstancing::Manual;
 
         _scene = te_shared_ptr_new<RendererScene>(_options);
 
-        _mainViewGroup = te_new<RendererViewGroup>(nullptr, 0, _options);
-
         RenderCompositor::RegisterNodeType<RCNodeGpuInitializationPass>();
         RenderCompositor::RegisterNodeType<RCNodeForwardPass>();
         RenderCompositor::RegisterNodeType<RCNodeSkybox>();
@@ -63,17 +48,15 @@ namespace te
 
     void RenderMan::Destroy()
     {
-        for (UINT32 i = 0; i < STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER; i++)
-        {
-            gPerInstanceParamBuffer[i]->Destroy();
-        }
-
         Renderer::Destroy();
         _scene = nullptr;
 
         RenderCompositor::CleanUp();
 
-        te_delete(_mainViewGroup);
+        for (auto& viewGroup : _viewGroups)
+            te_delete(viewGroup);
+
+        _viewGroups.clear();
 
         GpuResourcePool::ShutDown();
         RendererUtility::ShutDown();
@@ -90,14 +73,12 @@ namespace te
 
     void RenderMan::RenderAll(PerFrameData& perFrameData)
     {
-        CoreObjectManager::Instance().FrameSync();
-
         const SceneInfo& sceneInfo = _scene->GetSceneInfo();
 
         FrameTimings timings;
-        timings.Time = gTime().GetTime();
-        timings.TimeDelta = gTime().GetFrameDelta();
-        timings.FrameIdx = gTime().GetFrameIdx();
+        timings.Time = perFrameData.Time;
+        timings.TimeDelta = perFrameData.TimeDelta;
+        timings.FrameIdx = perFrameData.FrameIdx;
 
         // Update global per-frame hardware buffers
         _scene->SetParamFrameParams(timings.Time, timings.TimeDelta);
@@ -111,46 +92,94 @@ namespace te
         for (UINT32 i = 0; i < sceneInfo.Renderables.size(); i++)
             _scene->PrepareRenderable(i, frameInfo);
 
-        // Gather all views
-        for (auto& rtInfo : sceneInfo.RenderTargets)
+        // Upload instance data of renderables that changed since last frame
+        sceneInfo.InstanceBuffer->Update(sceneInfo.Renderables);
+
+        // Gather all views, grouped by render target
+        const UINT32 numTargets = (UINT32)sceneInfo.RenderTargets.size();
+        while ((UINT32)_viewGroups.size() < numTargets)
+            _viewGroups.push_back(te_new<RendererViewGroup>(nullptr, 0, _options));
+
+        _frameViews.clear();
+
+        Vector<RendererView*> views;
+        for (UINT32 i = 0; i < numTargets; i++)
         {
-            bool anythingDrawn = false;
-            Vector<RendererView*> views;
-            SPtr<RenderTarget> target = rtInfo.Target;
-            const Vector<Camera*>& cameras = rtInfo.Cameras;
+            const Vector<Camera*>& cameras = sceneInfo.RenderTargets[i].Cameras;
+            views.clear();
 
             UINT32 numCameras = (UINT32)cameras.size();
-            for (UINT32 i = 0; i < numCameras; i++)
+            for (UINT32 j = 0; j < numCameras; j++)
             {
+                UINT32 viewIdx = sceneInfo.CameraToView.at(cameras[j]);
+                RendererView* viewInfo = sceneInfo.Views[viewIdx];
+
                 //If we have a camera without any render target, don't process it at all
-                if (!cameras[i]->GetViewport()->GetTarget())
+                if (!viewInfo->GetProperties().Target.Target)
                     continue;
 
-                UINT32 viewIdx = sceneInfo.CameraToView.at(cameras[i]);
-                RendererView* viewInfo = sceneInfo.Views[viewIdx];
                 views.push_back(viewInfo);
+                _frameViews.push_back(std::make_pair(_viewGroups[i], viewInfo));
             }
 
-            _mainViewGroup->SetViews(views.data(), (UINT32)views.size());
+            _viewGroups[i]->SetViews(views.data(), (UINT32)views.size());
+        }
 
+        // Visibility and render queues only depend on data owned by each group and view, so independent render
+        // targets and views are processed concurrently
+        auto determineVisibility = [&](UINT32 groupIdx)
+        {
             if (_options->CullingFlags & (UINT32)RenderManCulling::Frustum ||
                 _options->CullingFlags & (UINT32)RenderManCulling::Occlusion)
             {
-                _mainViewGroup->DetermineVisibility(sceneInfo);
+                _viewGroups[groupIdx]->DetermineVisibility(sceneInfo);
             }
             else // Set all objects as visible
             {
-                _mainViewGroup->SetAllObjectsAsVisible(sceneInfo);
+                _viewGroups[groupIdx]->SetAllObjectsAsVisible(sceneInfo);
             }
+        };
+
+        auto generateRenderQueue = [&](UINT32 viewIdx)
+        {
+            _frameViews[viewIdx].first->GenerateRenderQueue(sceneInfo, *_frameViews[viewIdx].second, _options->InstancingMode);
+        };
+
+        const UINT32 numViews = (UINT32)_frameViews.size();
+        if (TaskScheduler::IsStarted())
+        {
+            gTaskScheduler().ParallelFor(numTargets, determineVisibility);
+            gTaskScheduler().ParallelFor(numViews, generateRenderQueue);
+        }
+        else
+        {
+            for (UINT32 i = 0; i < numTargets; i++)
+                determineVisibility(i);
+
+            for (UINT32 i = 0; i < numViews; i++)
+                generateRenderQueue(i);
+        }
 
-            for (auto& view : views)
+        // All views are now up to date with the changes made since the last frame
+        _scene->EndFrame();
+
+        // Instanced elements, GPU buffers and command submission stay ordered
+        UINT32 viewIdx = 0;
+        for (UINT32 i = 0; i < numTargets; i++)
+        {
+            const RendererRenderTarget& rtInfo = sceneInfo.RenderTargets[i];
+            RendererViewGroup& viewGroup = *_viewGroups[i];
+            bool anythingDrawn = false;
+
+            for (UINT32 j = 0; j < viewGroup.GetNumViews(); j++, viewIdx++)
             {
-                _mainViewGroup->GenerateInstanced(sceneInfo, _options->InstancingMode);
-                _mainViewGroup->GenerateRenderQueue(sceneInfo, *view, _options->InstancingMode);
+                RendererView* view = _frameViews[viewIdx].second;
 
-                _scene->SetParaCameraParams(view->GetSceneCamera()->GetRenderSettings()->SceneLightColor);
+                viewGroup.FinalizeRenderQueue(sceneInfo, *view, _options->InstancingMode);
 
-                if (RenderSingleView(*_mainViewGroup, *view, frameInfo))
+                _scene->SetParaCameraParams(view->GetRenderSettings().SceneLightColor);
+
+                if (RenderSingleView(viewGroup, *view, frameInfo))
                     anythingDrawn = true;
             }
 
@@ -163,23 +192,10 @@ namespace te
         GpuResourcePool::Instance().Update();
     }
 
-    /** Renders all views in the provided view group. Returns true if anything has been draw to any of the views. */
+    /** Renders the provided view of the view group. Returns true if anything has been draw to the view. */
     bool RenderMan::RenderSingleView(RendererViewGroup& viewGroup, RendererView& view, const FrameInfo& frameInfo)
     {
-        bool needs3DRender = false;
-        UINT32 numViews = viewGroup.GetNumViews();
-        for (UINT32 i = 0; i < numViews; i++)
-        {
-            RendererView* view = viewGroup.GetView(i);
-
-            if (view->ShouldDraw3D())
-            {
-                needs3DRender = true;
-                break;
-            }
-        }
-
-        if (needs3DRender)
+        if (view.ShouldDraw3D())
         {
             const SceneInfo& sceneInfo = _scene->GetSceneInfo();
             const VisibilityInfo& visibility = viewGroup.GetVisibilityInfo();
@@ -195,30 +211,15 @@ namespace te
             }
         }
 
-        bool anythingDrawn = false;
-        for (UINT32 i = 0; i < numViews; i++)
-        {
-            RendererView* view = viewGroup.GetView(i);
-
-            if (!view->ShouldDraw())
-            {
-                continue;
-            }
+        if (!view.ShouldDraw())
+            return false;
 
-            const RenderSettings& settings = view->GetRenderSettings();
-            if (settings.OverlayOnly)
-            {
-                if (RenderOverlay(*view, frameInfo))
-                    anythingDrawn = true;
-            }
-            else
-            {
-                RenderSingleViewInternal(viewGroup, *view, frameInfo);
-                anythingDrawn = true;
-            }
-        }
+        const RenderSettings& settings = view.GetRenderSettings();
+        if (settings.OverlayOnly)
+            return RenderOverlay(view, frameInfo);
 
-        return anythingDrawn;
+        RenderSingleViewInternal(viewGroup, view, frameInfo);
+        return true;
     }
 
     /** Renders all objects visible by the provided view. */
@@ -245,28 +246,26 @@ namespace te
         view.BeginFrame(frameInfo);
 
         auto& viewProps = view.GetProperties();
-        Camera* camera = view.GetSceneCamera();
         SPtr<RenderTarget> target = viewProps.Target.Target;
-        SPtr<Viewport> viewport = camera->GetViewport();
 
-        UINT32 clearFlags = viewport->GetClearFlags();
+        UINT32 clearFlags = viewProps.Target.ClearFlags;
 
         RenderAPI& rapi = RenderAPI::Instance();
         if (clearFlags != 0)
         {
             rapi.SetRenderTarget(target);
-            rapi.ClearViewport(clearFlags, viewport->GetClearColorValue(),
-                viewport->GetClearDepthValue(), viewport->GetClearStencilValue());
+            rapi.ClearViewport(clearFlags, viewProps.Target.ClearColor,
+                viewProps.Target.ClearDepthValue, viewProps.Target.ClearStencilValue);
         }
         else
         {
             rapi.SetRenderTarget(target, 0);
         }
 
-        rapi.SetViewport(viewport->GetArea());
+        rapi.SetViewport(viewProps.Target.NrmViewRect);
 
         // The only overlay we can manage currently
-        if(view.GetSceneCamera()->IsMain() && GuiAPI::Instance().IsGuiInitialized())
+        if(viewProps.MainView && GuiAPI::Instance().IsGuiInitialized())
         {
             GuiAPI::Instance().EndFrame();
         }
@@ -278,6 +277,8 @@ namespace te
 
     void RenderMan::SetOptions(const SPtr<RendererOptions>& options)
     {
+        gCoreApplication().WaitUntilFrameRendered();
+
         _options = std::static_pointer_cast<RenderManOptions>(options);
         _scene->SetOptions(_options);
     }
@@ -289,61 +290,92 @@ namespace te
 
     void RenderMan::NotifyCameraAdded(Camera* camera)
     {
+        // Scene objects can be created and destroyed outside of the frame sync, the scene must never change while
+        // a frame is rendered
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->RegisterCamera(camera);
     }
 
     void RenderMan::NotifyCameraUpdated(Camera* camera, UINT32 updateFlag)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->UpdateCamera(camera, updateFlag);
     }
 
     void RenderMan::NotifyCameraRemoved(Camera* camera)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->UnregisterCamera(camera);
     }
 
     void RenderMan::NotifyRenderableAdded(Renderable* renderable)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->RegisterRenderable(renderable);
     }
 
     void RenderMan::NotifyRenderableUpdated(Renderable* renderable)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->UpdateRenderable(renderable);
     }
 
     void RenderMan::NotifyRenderableRemoved(Renderable* renderable)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->UnregisterRenderable(renderable);
     }
 
+    void RenderMan::NotifyMaterialShaderChanged(Material* material)
+    {
+        // Renderables dirtied during the sync are synced later in the same frame, which rebuilds their elements
+        for (auto& rendererRenderable : _scene->GetSceneInfo().Renderables)
+        {
+            Renderable* renderable = rendererRenderable->RenderablePtr;
+            for (auto& entry : renderable->GetMaterials())
+            {
+                if (entry.get() == material)
+                {
+                    renderable->UpdateMaterials();
+                    break;
+                }
+            }
+        }
+    }
+
     void RenderMan::NotifyLightAdded(Light* light)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->RegisterLight(light);
     }
 
     void RenderMan::NotifyLightUpdated(Light* light)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->UpdateLight(light);
     }
 
     void RenderMan::NotifyLightRemoved(Light* light)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->UnregisterLight(light);
     }
 
     void RenderMan::NotifySkyboxAdded(Skybox* skybox)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->RegisterSkybox(skybox);
     }
 
     void RenderMan::NotifySkyboxRemoved(Skybox* skybox)
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->UnregisterSkybox(skybox);
     }
 
     void RenderMan::BatchRenderables()
     {
+        gCoreApplication().WaitUntilFrameRendered();
         _scene->BatchRenderables();
     }
 
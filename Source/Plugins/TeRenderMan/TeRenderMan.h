@@ -51,7 +51,7 @@ namespace te
 
         bool RenderOverlay(RendererView& view, const FrameInfo& frameInfo);
 
-        /** Renders all views in the provided view group. Returns true if anything has been draw to any of the views. */
+        /** Renders the provided view of the view group. Returns true if anything has been draw to the view. */
         bool RenderSingleView(RendererViewGroup& viewGroup, RendererView& view, const FrameInfo& frameInfo);
 
         /** Renders all objects visible by the provided view. */
@@ -84,6 +84,9 @@ namespace te
         /** @copydoc Renderer::NotifyRenderableRemoved */
         void NotifyRenderableRemoved(Renderable* renderable) override;
 
+        /** @copydoc Renderer::NotifyMaterialShaderChanged */
+        void NotifyMaterialShaderChanged(Material* material) override;
+
         /** @copydoc Renderer::NotifySkyboxAdded */
         void NotifySkyboxAdded(Skybox* skybox) override;
 
@@ -97,8 +100,9 @@ namespace te
         SPtr<RendererScene> _scene;
         SPtr<RenderManOptions> _options;
 
-        // Helpers to avoid memory allocations
-        RendererViewGroup* _mainViewGroup = nullptr;
+        // Helpers to avoid memory allocations, one view group per render target so they can be processed concurrently
+        Vector<RendererViewGroup*> _viewGroups;
+        Vector<std::pair<RendererViewGroup*, RendererView*>> _frameViews;
     };
 
     /** Provides easy access to the RenderBeast renderer. */
@@ -5,16 +5,17 @@
 #include "Material/TeMaterial.h"
 #include "Math/TeMatrix4.h"
 
-#define STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE 128
 #define STANDARD_FORWARD_MIN_INSTANCED_BLOCK_SIZE 16
-#define STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER 128
 
 #define STANDARD_FORWARD_MAX_VERTICES_COMBINED_MESH 4096
 
 #define STANDARD_FORWARD_MAX_NUM_LIGHTS 16
 
+#define STANDARD_FORWARD_LOD_HYSTERESIS 0.2f
+
 namespace te
 {
+    /** Layout must match PerInstanceData in ForwardBase.hlsli, records are read from a structured buffer. */
     struct PerInstanceData
     {
         Matrix4 gMatWorld;
@@ -25,6 +26,7 @@ namespace te
         UINT32  gLayer;
         UINT32  gHasAnimation;
         UINT32  gWriteVelocity;
+        float   gPadding1;
     };
 
     struct MaterialData
@@ -103,6 +105,11 @@ namespace te
         TE_PARAM_BLOCK_ENTRY(INT32, gLayer)
         TE_PARAM_BLOCK_ENTRY(INT32, gHasAnimation)
         TE_PARAM_BLOCK_ENTRY(INT32, gWriteVelocity)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gBoneOffset)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gPrevBoneOffset)
+        TE_PARAM_BLOCK_ENTRY(INT32, gQuantized)
+        TE_PARAM_BLOCK_ENTRY(Vector4, gPositionScale)
+        TE_PARAM_BLOCK_ENTRY(Vector4, gPositionOffset)
     TE_PARAM_BLOCK_END
 
     extern PerObjectParamDef gPerObjectParamDef;
@@ -133,16 +140,17 @@ namespace te
         TE_PARAM_BLOCK_ENTRY(float, gBumpScale)
         TE_PARAM_BLOCK_ENTRY(float, gParallaxScale)
         TE_PARAM_BLOCK_ENTRY(float, gAlphaThreshold)
+        TE_PARAM_BLOCK_ENTRY(INT32, gUsePrefilteredEnvironment)
+        TE_PARAM_BLOCK_ENTRY_ARRAY(Vector4, gIrradiance, 9)
     TE_PARAM_BLOCK_END
 
     extern PerMaterialParamDef gPerMaterialParamDef;
 
     TE_PARAM_BLOCK_BEGIN(PerInstanceParamDef)
-        TE_PARAM_BLOCK_ENTRY_ARRAY(PerInstanceData, gInstances, STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gInstanceOffset)
     TE_PARAM_BLOCK_END
 
     extern PerInstanceParamDef gPerInstanceParamDef;
-    extern SPtr<GpuParamBlockBuffer> gPerInstanceParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER];
 
     TE_PARAM_BLOCK_BEGIN(PerLightsParamDef)
         TE_PARAM_BLOCK_ENTRY_ARRAY(LightData, gLights, STANDARD_FORWARD_MAX_NUM_LIGHTS)
@@ -223,4 +231,5 @@ namespace te
     class RendererLight;
     class RenderableElement;
     struct RendererRenderable;
+    class RendererInstanceBuffer;
 }
@@ -0,0 +1,141 @@
+#include "TeRendererInstanceBuffer.h"
+#include "TeRendererRenderable.h"
+#include "Utility/TeBitwise.h"
+
+namespace te
+{
+    PerInstanceParamDef gPerInstanceParamDef;
+
+    /** Minimum number of records and indices the GPU buffers are created with. */
+    static constexpr UINT32 MIN_INSTANCE_BUFFER_SIZE = 256;
+
+    void RendererInstanceBuffer::MarkDirty(UINT32 idx)
+    {
+        if (idx >= (UINT32)_isDirty.size())
+            _isDirty.resize(idx + 1, false);
+
+        if (_isDirty[idx])
+            return;
+
+        _isDirty[idx] = true;
+        _dirtyRecords.push_back(idx);
+    }
+
+    void RendererInstanceBuffer::Update(const Vector<RendererRenderable*>& renderables)
+    {
+        const UINT32 numRenderables = (UINT32)renderables.size();
+        if ((UINT32)_records.size() < numRenderables)
+            _records.resize(numRenderables);
+
+        // Process records in index order, so neighbouring records can be uploaded with a single write
+        std::sort(_dirtyRecords.begin(), _dirtyRecords.end());
+
+        UINT32 numBuilt = 0;
+        for (auto idx : _dirtyRecords)
+        {
+            _isDirty[idx] = false;
+
+            // Records of removed renderables, and of renderables that are never instanced, are never read
+            if (idx >= numRenderables || !renderables[idx]->Instancing)
+                continue;
+
+            BuildRecord(idx, *renderables[idx]);
+            _dirtyRecords[numBuilt++] = idx;
+        }
+
+        _dirtyRecords.resize(numBuilt);
+
+        if (numRenderables == 0)
+        {
+            _dirtyRecords.clear();
+            return;
+        }
+
+        if (_recordBuffer == nullptr || _recordBuffer->GetProperties().GetElementCount() < numRenderables)
+        {
+            // Round up, so scenes that change size slightly don't reallocate every frame
+            GPU_BUFFER_DESC desc;
+            desc.ElementCount = std::max(MIN_INSTANCE_BUFFER_SIZE, Bitwise::NextPow2(numRenderables));
+            desc.ElementSize = sizeof(PerInstanceData);
+            desc.Type = GBT_STRUCTURED;
+            desc.Format = BF_UNKNOWN;
+            desc.Usage = GBU_STATIC;
+
+            _recordBuffer = GpuBuffer::Create(desc);
+            _recordBuffer->WriteData(0, numRenderables * sizeof(PerInstanceData), _records.data());
+
+            _dirtyRecords.clear();
+            return;
+        }
+
+        UINT32 runStart = 0;
+        for (UINT32 i = 1; i <= numBuilt; i++)
+        {
+            if (i < numBuilt && _dirtyRecords[i] == _dirtyRecords[i - 1] + 1)
+                continue;
+
+            const UINT32 first = _dirtyRecords[runStart];
+            const UINT32 count = i - runStart;
+            _recordBuffer->WriteData(first * sizeof(PerInstanceData), count * sizeof(PerInstanceData), &_records[first]);
+
+            runStart = i;
+        }
+
+        _dirtyRecords.clear();
+    }
+
+    void RendererInstanceBuffer::BeginBatches()
+    {
+        _indices.clear();
+        _numBatches = 0;
+    }
+
+    const SPtr<GpuParamBlockBuffer>& RendererInstanceBuffer::AddBatch(const UINT32* indices, UINT32 count)
+    {
+        if (_numBatches == (UINT32)_batchBuffers.size())
+            _batchBuffers.push_back(gPerInstanceParamDef.CreateBuffer(GBU_TRANSIENT));
+
+        const SPtr<GpuParamBlockBuffer>& buffer = _batchBuffers[_numBatches++];
+        gPerInstanceParamDef.gInstanceOffset.Set(buffer, (UINT32)_indices.size());
+
+        _indices.insert(_indices.end(), indices, indices + count);
+        return buffer;
+    }
+
+    void RendererInstanceBuffer::EndBatches()
+    {
+        const UINT32 numIndices = (UINT32)_indices.size();
+        if (numIndices == 0)
+            return;
+
+        if (_indexBuffer == nullptr || _indexBuffer->GetProperties().GetElementCount() < numIndices)
+        {
+            GPU_BUFFER_DESC desc;
+            desc.ElementCount = std::max(MIN_INSTANCE_BUFFER_SIZE, Bitwise::NextPow2(numIndices));
+            desc.ElementSize = 0;
+            desc.Type = GBT_STANDARD;
+            desc.Format = BF_32X1U;
+            desc.Usage = GBU_DYNAMIC;
+
+            _indexBuffer = GpuBuffer::Create(desc);
+        }
+
+        _indexBuffer->WriteData(0, numIndices * sizeof(UINT32), _indices.data(), BWT_DISCARD);
+    }
+
+    void RendererInstanceBuffer::BuildRecord(UINT32 idx, const RendererRenderable& renderable)
+    {
+        const Matrix4& tfrmNoScale = renderable.WorldNoScaleTfrm;
+
+        PerInstanceData& data = _records[idx];
+        data.gMatWorld = renderable.WorldTfrm;
+        data.gMatInvWorld = renderable.WorldTfrm.InverseAffine();
+        data.gMatWorldNoScale = tfrmNoScale;
+        data.gMatInvWorldNoScale = tfrmNoScale.InverseAffine();
+        data.gMatPrevWorld = renderable.PrevWorldTfrm;
+        data.gLayer = (UINT32)renderable.Layer;
+        data.gHasAnimation = renderable.Animated ? 1 : 0;
+        data.gWriteVelocity = renderable.WriteVelocity ? 1 : 0;
+        data.gPadding1 = 0.0f;
+    }
+}
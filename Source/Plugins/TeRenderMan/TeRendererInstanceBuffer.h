@@ -0,0 +1,67 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "RenderAPI/TeGpuBuffer.h"
+
+namespace te
+{
+    /**
+     * Stores per-instance data of all renderables that can be instanced, in a single persistent structured buffer.
+     * The record of a renderable lives at the index matching its renderer id. Records are only rebuilt and uploaded
+     * when marked dirty, and buffers grow on demand, so there is no limit on the number of instances.
+     *
+     * Instanced draws read their records through a list of record indices, rebuilt every time a render queue is
+     * generated. Each draw receives the offset of its first index through its own PerInstanceBuffer.
+     */
+    class RendererInstanceBuffer
+    {
+    public:
+        RendererInstanceBuffer() = default;
+        ~RendererInstanceBuffer() = default;
+
+        /** Marks the record of the renderable with the provided renderer id as requiring an update. */
+        void MarkDirty(UINT32 idx);
+
+        /**
+         * Rebuilds records of all dirty renderables and uploads them to the GPU. Must be called once per frame, before
+         * any render queue is generated.
+         */
+        void Update(const Vector<RendererRenderable*>& renderables);
+
+        /** Removes all batches added since the last call. To be called before generating a new render queue. */
+        void BeginBatches();
+
+        /**
+         * Registers a new instanced draw.
+         *
+         * @param[in]	indices		Renderer ids of all instances to draw.
+         * @param[in]	count		Number of entries in @p indices.
+         * @return					Parameter block buffer to bind as PerInstanceBuffer for the draw.
+         */
+        const SPtr<GpuParamBlockBuffer>& AddBatch(const UINT32* indices, UINT32 count);
+
+        /** Uploads the record indices of all batches added since BeginBatches(). */
+        void EndBatches();
+
+        /** Returns the buffer containing the records of all renderables, to bind as gInstanceData. */
+        const SPtr<GpuBuffer>& GetRecordBuffer() const { return _recordBuffer; }
+
+        /** Returns the buffer containing record indices of the current batches, to bind as gInstanceIndices. */
+        const SPtr<GpuBuffer>& GetIndexBuffer() const { return _indexBuffer; }
+
+    private:
+        /** Fills the record at the provided index using the current state of the renderable. */
+        void BuildRecord(UINT32 idx, const RendererRenderable& renderable);
+
+        Vector<PerInstanceData> _records;
+        Vector<UINT32> _dirtyRecords;
+        Vector<bool> _isDirty;
+        SPtr<GpuBuffer> _recordBuffer;
+
+        Vector<UINT32> _indices;
+        SPtr<GpuBuffer> _indexBuffer;
+
+        Vector<SPtr<GpuParamBlockBuffer>> _batchBuffers;
+        UINT32 _numBatches = 0;
+    };
+}
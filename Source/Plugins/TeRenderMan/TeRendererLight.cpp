@@ -22,13 +22,17 @@ namespace te
 
     RendererLight::RendererLight(Light* light)
         : _internal(light)
-    { }
+    {
+        UpdateParameters();
+    }
 
     RendererLight::~RendererLight()
     { }
 
-    void RendererLight::GetParameters(LightData& output) const
+    void RendererLight::UpdateParameters()
     {
+        LightData& output = _parameters;
+
         Radian spotAngle = Math::Clamp(_internal->GetSpotAngle() * 0.5f, Degree(0), Degree(89));
         Color color = _internal->GetColor();
 
@@ -61,6 +65,8 @@ namespace te
         output.LinearAttenuation = _internal->GetLinearAttenuation();
         output.QuadraticAttenuation = _internal->GetQuadraticAttenuation();
         output.Type = type;
+
+        _castsShadow = _internal->GetCastsShadow();
     }
 
     VisibleLightData::VisibleLightData()
@@ -114,7 +120,7 @@ namespace te
             int first = -1;
             for (UINT32 i = 0; i < (UINT32)entries.size(); ++i)
             {
-                if (entries[i]->_internal->GetCastsShadow())
+                if (entries[i]->GetCastsShadow())
                 {
                     first = i;
                     break;
@@ -127,7 +133,7 @@ namespace te
             {
                 for (UINT32 i = first + 1; i < (UINT32)entries.size(); ++i)
                 {
-                    if (!entries[i]->_internal->GetCastsShadow())
+                    if (!entries[i]->GetCastsShadow())
                     {
                         std::swap(entries[i], entries[first]);
                         ++numUnshadowed;
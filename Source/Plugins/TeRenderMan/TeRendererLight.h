@@ -31,10 +31,23 @@ namespace te
         RendererLight(Light* light);
         ~RendererLight();
 
+        /**
+         * Copies the parameters of the light read while rendering. Must be called whenever the light is updated, as it
+         * may be modified by the simulation while a frame renders.
+         */
+        void UpdateParameters();
+
         /** Populates the structure with light parameters. */
-        void GetParameters(LightData& output) const;
+        void GetParameters(LightData& output) const { output = _parameters; }
+
+        /** Checks whether the light casts shadows. */
+        bool GetCastsShadow() const { return _castsShadow; }
 
         Light* _internal;
+
+    private:
+        LightData _parameters;
+        bool _castsShadow = false;
     };
 
     /**
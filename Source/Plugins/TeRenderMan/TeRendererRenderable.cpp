@@ -1,19 +1,20 @@
 #include "TeRendererRenderable.h"
 #include "Mesh/TeMesh.h"
+#include "Image/TeTexture.h"
+#include "Material/TeMaterial.h"
 #include "Utility/TeBitwise.h"
 #include "Renderer/TeRendererUtility.h"
 
 namespace te
 { 
-    PerInstanceParamDef gPerInstanceParamDef;
     PerMaterialParamDef gPerMaterialParamDef;
     PerObjectParamDef gPerObjectParamDef;
 
     void PerObjectBuffer::UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const Matrix4& tfrm,
-        const Matrix4& prevTfrm, Renderable* renderable)
+        const Matrix4& prevTfrm, const RendererRenderable& renderable)
     {
-        const Matrix4& tfrmNoScale = renderable->GetMatrixNoScale();
-        const UINT32 layer = Bitwise::mostSignificantBit(renderable->GetLayer());
+        const Matrix4& tfrmNoScale = renderable.WorldNoScaleTfrm;
+        const UINT32 layer = Bitwise::mostSignificantBit(renderable.Layer);
 
         gPerObjectParamDef.gMatWorld.Set(buffer, tfrm);
         gPerObjectParamDef.gMatInvWorld.Set(buffer, tfrm.InverseAffine());
@@ -21,15 +22,41 @@ namespace te
         gPerObjectParamDef.gMatInvWorldNoScale.Set(buffer, tfrmNoScale.InverseAffine());
         gPerObjectParamDef.gMatPrevWorld.Set(buffer, prevTfrm);
         gPerObjectParamDef.gLayer.Set(buffer, (INT32)layer);
-        gPerObjectParamDef.gHasAnimation.Set(buffer, (UINT32)renderable->IsAnimated() ? 1 : 0);
-        gPerObjectParamDef.gWriteVelocity.Set(buffer, (UINT32)renderable->GetWriteVelocity() ? 1 : 0);
+        gPerObjectParamDef.gWriteVelocity.Set(buffer, (UINT32)renderable.WriteVelocity ? 1 : 0);
+
+        UpdatePerObjectAnimation(buffer, renderable);
+        UpdatePerObjectMesh(buffer, renderable);
+    }
+
+    void PerObjectBuffer::UpdatePerObjectAnimation(SPtr<GpuParamBlockBuffer>& buffer, const RendererRenderable& renderable)
+    {
+        // Until its pose is evaluated, a skinned object renders in bind pose
+        const UINT32 boneOffset = renderable.RenderablePtr->GetBoneMatrixOffset();
+        const UINT32 prevBoneOffset = renderable.RenderablePtr->GetBonePrevMatrixOffset();
+        const bool hasAnimation = renderable.Animated && boneOffset != (UINT32)-1;
+
+        gPerObjectParamDef.gHasAnimation.Set(buffer, hasAnimation ? 1 : 0);
+        gPerObjectParamDef.gBoneOffset.Set(buffer, hasAnimation ? boneOffset : 0);
+        gPerObjectParamDef.gPrevBoneOffset.Set(buffer, (hasAnimation && prevBoneOffset != (UINT32)-1) ? prevBoneOffset : boneOffset);
     }
 
-    void PerObjectBuffer::UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perObjectBuffer, 
-        SPtr<GpuParamBlockBuffer>& perInstanceBuffer, PerInstanceData* instanceData, UINT32 instanceCounter)
+    void PerObjectBuffer::UpdatePerObjectMesh(SPtr<GpuParamBlockBuffer>& buffer, const RendererRenderable& renderable)
     {
-        for (size_t i = 0; i < instanceCounter; i++)
-            gPerInstanceParamDef.gInstances.Set(perInstanceBuffer, instanceData[i], (UINT32)i);
+        bool quantized = false;
+        Vector3 scale = Vector3::ONE;
+        Vector3 offset = Vector3::ZERO;
+
+        if (renderable.MeshElem)
+        {
+            const MeshProperties& meshProps = renderable.MeshElem->GetProperties();
+            quantized = meshProps.IsQuantized();
+            scale = meshProps.GetPositionScale();
+            offset = meshProps.GetPositionOffset();
+        }
+
+        gPerObjectParamDef.gQuantized.Set(buffer, quantized ? 1 : 0);
+        gPerObjectParamDef.gPositionScale.Set(buffer, Vector4(scale.x, scale.y, scale.z, 0.0f));
+        gPerObjectParamDef.gPositionOffset.Set(buffer, Vector4(offset.x, offset.y, offset.z, 0.0f));
     }
 
     void PerObjectBuffer::UpdatePerMaterial(SPtr<GpuParamBlockBuffer>& perMaterialBuffer, const MaterialProperties& properties)
@@ -63,6 +90,22 @@ namespace te
         gPerMaterialParamDef.gAlphaThreshold.Set(perMaterialBuffer, data.gAlphaThreshold);
     }
 
+    void PerObjectBuffer::UpdatePerMaterialEnvironment(SPtr<GpuParamBlockBuffer>& perMaterialBuffer, Material& material)
+    {
+        SPtr<Texture> environmentMap;
+        if (material.GetProperties().UseEnvironmentMap)
+            environmentMap = material.GetTexture("EnvironmentMap");
+
+        const bool prefiltered = environmentMap != nullptr && environmentMap->HasIrradiance();
+        gPerMaterialParamDef.gUsePrefilteredEnvironment.Set(perMaterialBuffer, prefiltered ? 1 : 0);
+
+        for (UINT32 i = 0; i < 9; i++)
+        {
+            const Vector4 coefficient = prefiltered ? environmentMap->GetIrradiance().Coefficients[i] : Vector4::ZERO;
+            gPerMaterialParamDef.gIrradiance.Set(perMaterialBuffer, coefficient, i);
+        }
+    }
+
     MaterialData PerObjectBuffer::ConvertMaterialProperties(const MaterialProperties& properties)
     {
         MaterialData data;
@@ -97,17 +140,22 @@ namespace te
     RenderableElement::RenderableElement()
         : RenderElement()
     {
-        PerMaterialParamBuffer = gPerMaterialParamDef.CreateBuffer();
+        PerMaterialParamBuffer = gPerMaterialParamDef.CreateBuffer(GBU_TRANSIENT);
+    }
+
+    void RenderableElement::Draw(UINT32 lod) const
+    {
+        gRendererUtility().Draw(MeshElem, SubMeshElem, InstanceCount, lod);
     }
 
-    void RenderableElement::Draw() const
+    void RenderableElement::Draw(CommandBuffer& commandBuffer, UINT32 lod) const
     {
-        gRendererUtility().Draw(MeshElem, SubMeshElem, InstanceCount);
+        gRendererUtility().Draw(commandBuffer, MeshElem, SubMeshElem, InstanceCount, lod);
     }
 
     RendererRenderable::RendererRenderable()
     {
-        PerObjectParamBuffer = gPerObjectParamDef.CreateBuffer();
+        PerObjectParamBuffer = gPerObjectParamDef.CreateBuffer(GBU_TRANSIENT);
     }
 
     RendererRenderable::~RendererRenderable()
@@ -115,11 +163,16 @@ namespace te
 
     void RendererRenderable::UpdatePerObjectBuffer()
     {
-        PerObjectBuffer::UpdatePerObject(PerObjectParamBuffer, WorldTfrm, PrevWorldTfrm, RenderablePtr);
+        PerObjectBuffer::UpdatePerObject(PerObjectParamBuffer, WorldTfrm, PrevWorldTfrm, *this);
     }
 
-    void RendererRenderable::UpdatePerInstanceBuffer(PerInstanceData* instanceData, UINT32 instanceCounter, UINT32 blockId)
+    void RendererRenderable::UpdateProperties()
     {
-        PerObjectBuffer::UpdatePerInstance(PerObjectParamBuffer, gPerInstanceParamBuffer[blockId], instanceData, instanceCounter);
+        WorldNoScaleTfrm = RenderablePtr->GetMatrixNoScale();
+        Layer = RenderablePtr->GetLayer();
+        WriteVelocity = RenderablePtr->GetWriteVelocity();
+        Instancing = RenderablePtr->GetInstancing();
+        CastLight = RenderablePtr->GetCastLight();
+        Animated = RenderablePtr->IsAnimated();
     }
 }
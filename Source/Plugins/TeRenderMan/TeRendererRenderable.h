@@ -18,20 +18,26 @@ namespace te
          *  @param[in]	buffer	      Buffer which will be filled with data
          *  @param[in]	tfrm	      World matrix of current object
          *  @param[in]	prevTfrm	  Previous World matrix of current object
-         *  @param[in]	RenderablePtr Pointer to the current Renderable we want to update
+         *  @param[in]	renderable    Renderer information of the object we want to update
          */
         static void UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const Matrix4& tfrm,
-            const Matrix4& prevTfrm, Renderable* RenderablePtr);
+            const Matrix4& prevTfrm, const RendererRenderable& renderable);
 
-        /** 
-         * Update the provided instance buffer
-         * 
-         *  @param[in]	perObjectBuffer	    Per object Buffer which will be filled with data
-         *  @param[in]	perInstanceBuffer	Per instance Buffer which will be filled with data
-         *  @param[in]	instanceData	    data list we want to store inside instance buffer
+        /**
+         * Updates the animation related entries of the provided buffer (offsets into the bone palette)
+         *
+         *  @param[in]	buffer	      Buffer which will be filled with data
+         *  @param[in]	renderable    Renderer information of the object we want to update
+         */
+        static void UpdatePerObjectAnimation(SPtr<GpuParamBlockBuffer>& buffer, const RendererRenderable& renderable);
+
+        /**
+         * Updates the mesh related entries of the provided buffer (parameters used to decode quantized vertices)
+         *
+         *  @param[in]	buffer	      Buffer which will be filled with data
+         *  @param[in]	renderable    Renderer information of the object we want to update
          */
-        static void UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perObjectBuffer,
-            SPtr<GpuParamBlockBuffer>& perInstanceBuffer, PerInstanceData* instanceData, UINT32 instanceCounter);
+        static void UpdatePerObjectMesh(SPtr<GpuParamBlockBuffer>& buffer, const RendererRenderable& renderable);
 
         /**
          * Update the provided material buffer
@@ -41,6 +47,15 @@ namespace te
          */
         static void UpdatePerMaterial(SPtr<GpuParamBlockBuffer>& perMaterialBuffer, const MaterialProperties& properties);
 
+        /**
+         * Updates the environment lighting entries of the provided material buffer (prefiltered radiance and irradiance
+         * of the material environment map)
+         *
+         *  @param[in]	perMaterialBuffer	    Per object Buffer which will be filled with data
+         *  @param[in]	material                Material whose environment map to use
+         */
+        static void UpdatePerMaterialEnvironment(SPtr<GpuParamBlockBuffer>& perMaterialBuffer, Material& material);
+
         /*
          * Create MaterialData based on MaterialProperties
          *
@@ -59,7 +74,10 @@ namespace te
         RenderableElement();
 
         /** @copydoc RenderElement::Draw */
-        void Draw() const override;
+        void Draw(UINT32 lod = 0) const override;
+
+        /** @copydoc RenderElement::Draw(CommandBuffer&, UINT32) */
+        void Draw(CommandBuffer& commandBuffer, UINT32 lod = 0) const override;
 
         UINT64 AnimationId;
         RenderableAnimType AnimType;
@@ -77,19 +95,34 @@ namespace te
         /** Updates the per-object GPU buffer according to the currently set properties. */
         void UpdatePerObjectBuffer();
 
-        /** 
-         * Updates the per-instance GPU buffer according to the currently set properties. 
-         *
-         * @param[in]	instanceData	Array with max with of 64
-         * @param[in]	instanceCounter	Number of valid element to store in array
-         * @param[in]	blockId	        We create only 8 instance buffer, we need to know in which we want to register data
+        /**
+         * Copies the properties of the Renderable read while rendering. Must be called whenever the Renderable is
+         * registered or updated, as it may be modified by the simulation while a frame renders.
          */
-        void UpdatePerInstanceBuffer(PerInstanceData* instanceData, UINT32 instanceCounter, UINT32 blockId);
+        void UpdateProperties();
 
         Matrix4 WorldTfrm = Matrix4::IDENTITY;
         Matrix4 PrevWorldTfrm = Matrix4::IDENTITY;
         PrevFrameDirtyState PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
 
+        Matrix4 WorldNoScaleTfrm = Matrix4::IDENTITY;
+        UINT64 Layer = 0;
+        bool WriteVelocity = false;
+        bool Instancing = false;
+        bool CastLight = true;
+        bool Animated = false;
+
+        /** Mesh and materials the elements were built from, used to group instanced draws. */
+        SPtr<Mesh> MeshElem;
+        Vector<SPtr<Material>> Materials;
+
+        /**
+         * Error of each simplified level of detail of the mesh, relative to the radius of its bounds. All sub-meshes
+         * switch level together, so each entry is the largest error of that level among the sub-meshes. Empty if the
+         * mesh has no simplified levels.
+         */
+        Vector<float> LodErrors;
+
         Renderable* RenderablePtr;
         Vector<RenderableElement> Elements;
 
@@ -69,6 +69,7 @@ namespace te
         : _options(options)
     { 
         _info.PerFrameParamBuffer = gPerFrameParamDef.CreateBuffer();
+        _info.InstanceBuffer = te_shared_ptr_new<RendererInstanceBuffer>();
     }
 
     RendererScene::~RendererScene()
@@ -190,6 +191,8 @@ namespace te
                 _info.SpotLightWorldBounds.push_back(light->GetBounds());
             }
         }
+
+        _info.LightCullInfosDirty = true;
     }
 
     /** Updates information about a previously registered light. */
@@ -197,10 +200,20 @@ namespace te
     {
         UINT32 lightId = light->GetRendererId();
 
-        if (light->GetType() == LightType::Radial)
+        if (light->GetType() == LightType::Directional)
+            _info.DirectionalLights[lightId].UpdateParameters();
+        else if (light->GetType() == LightType::Radial)
+        {
+            _info.RadialLights[lightId].UpdateParameters();
             _info.RadialLightWorldBounds[lightId] = light->GetBounds();
+        }
         else if (light->GetType() == LightType::Spot)
+        {
+            _info.SpotLights[lightId].UpdateParameters();
             _info.SpotLightWorldBounds[lightId] = light->GetBounds();
+        }
+
+        _info.LightCullInfosDirty = true;
     }
 
     /** Removes a light from the scene. */
@@ -261,6 +274,8 @@ namespace te
                 _info.SpotLightWorldBounds.erase(_info.SpotLightWorldBounds.end() - 1);
             }
         }
+
+        _info.LightCullInfosDirty = true;
     }
 
     /** Registers a new renderable object in the scene. */
@@ -277,7 +292,10 @@ namespace te
         rendererRenderable->WorldTfrm = renderable->GetMatrix();
         rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
         rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
+        rendererRenderable->UpdateProperties();
         rendererRenderable->UpdatePerObjectBuffer();
+        _info.InstanceBuffer->MarkDirty(renderableId);
+        _info.DirtyRenderableCullInfos.push_back(renderableId);
 
         SetMeshData(rendererRenderable, renderable);
 
@@ -312,11 +330,14 @@ namespace te
 
         rendererRenderable->WorldTfrm = renderable->GetMatrix();
         rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Updated;
+        rendererRenderable->UpdateProperties();
 
         _info.Renderables[renderableId]->UpdatePerObjectBuffer();
+        _info.InstanceBuffer->MarkDirty(renderableId);
         _info.RenderableCullInfos[renderableId].Layer = renderable->GetLayer();
         _info.RenderableCullInfos[renderableId].Boundaries = renderable->GetBounds();
         _info.RenderableCullInfos[renderableId].CullDistanceFactor = renderable->GetCullDistanceFactor();
+        _info.DirtyRenderableCullInfos.push_back(renderableId);
 
         if (_options->InstancingMode == RenderManInstancing::Manual)
         {
@@ -358,8 +379,13 @@ namespace te
             std::swap(_info.RenderableCullInfos[renderableId], _info.RenderableCullInfos[lastRenderableId]);
 
             lastRenderable->SetRendererId(renderableId);
+            _info.InstanceBuffer->MarkDirty(renderableId);
+            _info.DirtyRenderableCullInfos.push_back(renderableId);
         }
 
+        for (auto& view : _info.Views)
+            view->NotifyRenderableRemoved(renderableId, lastRenderableId);
+
         if (_options->InstancingMode == RenderManInstancing::Manual)
         {
             auto iter = std::find(_info.RenderablesInstanced.begin(), _info.RenderablesInstanced.end(), rendererRenderable);
@@ -380,6 +406,10 @@ namespace te
     void RendererScene::SetMeshData(RendererRenderable* rendererRenderable, Renderable* renderable)
     {
         SPtr<Mesh> mesh = renderable->GetMesh();
+        rendererRenderable->MeshElem = mesh;
+        rendererRenderable->Materials = renderable->GetMaterials();
+        PerObjectBuffer::UpdatePerObjectMesh(rendererRenderable->PerObjectParamBuffer, *rendererRenderable);
+
         if (mesh != nullptr)
         {
             MeshProperties& meshProps = mesh->GetProperties();
@@ -397,8 +427,8 @@ namespace te
                 renElement->Type = (UINT32)RenderElementType::Renderable;
                 renElement->MeshElem = mesh;
                 renElement->SubMeshElem = meshProps.GetSubMesh(i);
-                renElement->BoneMatrixBuffer = renderable->GetBoneMatrixBuffer();
-                renElement->BonePrevMatrixBuffer = renderable->GetBonePrevMatrixBuffer();
+                renElement->BoneMatrixBuffer = nullptr;
+                renElement->BonePrevMatrixBuffer = nullptr;
                 renElement->AnimType = renderable->GetAnimType();
                 renElement->AnimationId = renderable->GetAnimationId();
 
@@ -422,6 +452,7 @@ namespace te
 
                 // We update gpu paremeters such as diffuse or specular defined for this material
                 PerObjectBuffer::UpdatePerMaterial(renElement->PerMaterialParamBuffer, renElement->MaterialElem->GetProperties());
+                PerObjectBuffer::UpdatePerMaterialEnvironment(renElement->PerMaterialParamBuffer, *renElement->MaterialElem);
 
                 // Set renderable properties to renderElement
                 renElement->Properties = &renderable->GetProperties();
@@ -445,13 +476,29 @@ namespace te
                 {
                     gpuParams->SetParamBlockBuffer("PerObjectBuffer", rendererRenderable->PerObjectParamBuffer);
                     gpuParams->SetParamBlockBuffer("PerMaterialBuffer", element.PerMaterialParamBuffer);
+                }
+            }
+        }
 
-                    if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices"))
-                        gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices", element.BoneMatrixBuffer);
+        // Sub-meshes with fewer levels keep drawing their least detailed one, see RendererUtility::Draw
+        rendererRenderable->LodErrors.clear();
+        for (auto& element : rendererRenderable->Elements)
+        {
+            const Vector<SubMeshLod>& lods = element.SubMeshElem.Lods;
+            if (lods.size() > rendererRenderable->LodErrors.size())
+                rendererRenderable->LodErrors.resize(lods.size(), 0.0f);
+        }
 
-                    if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "PrevBoneMatrices"))
-                        gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "PrevBoneMatrices", element.BonePrevMatrixBuffer);
-                }
+        for (auto& element : rendererRenderable->Elements)
+        {
+            const Vector<SubMeshLod>& lods = element.SubMeshElem.Lods;
+            if (lods.empty())
+                continue;
+
+            for (size_t i = 0; i < rendererRenderable->LodErrors.size(); i++)
+            {
+                float& error = rendererRenderable->LodErrors[i];
+                error = std::max(error, lods[std::min(i, lods.size() - 1)].Error);
             }
         }
     }
@@ -459,12 +506,16 @@ namespace te
     void RendererScene::RegisterSkybox(Skybox* skybox)
     {
         _info.SkyboxElem = skybox;
+        _info.SkyboxTexture = skybox->GetTexture();
     }
 
     void RendererScene::UnregisterSkybox(Skybox* skybox)
     {
         if (_info.SkyboxElem == skybox)
+        {
             _info.SkyboxElem = nullptr;
+            _info.SkyboxTexture = nullptr;
+        }
     }
 
     void RendererScene::SetOptions(const SPtr<RenderManOptions>& options)
@@ -486,6 +537,13 @@ namespace te
         gPerFrameParamDef.gSceneLightColor.Set(_info.PerFrameParamBuffer, sceneLightColor.GetAsVector4());
     }
 
+    void RendererScene::EndFrame()
+    {
+        _info.DirtyRenderableCullInfos.clear();
+        _info.LightCullInfosDirty = false;
+        _info.VisibilityFrameIdx++;
+    }
+
     void RendererScene::PrepareRenderable(UINT32 idx, const FrameInfo& frameInfo)
     {
         RendererRenderable* rendererRenderable = _info.Renderables[idx];
@@ -499,6 +557,7 @@ namespace te
                 rendererRenderable->PrevWorldTfrm = _info.Renderables[idx]->WorldTfrm;
                 rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
                 rendererRenderable->UpdatePerObjectBuffer();
+                _info.InstanceBuffer->MarkDirty(idx);
             }
         }
     }
@@ -510,8 +569,35 @@ namespace te
 
         RendererRenderable* rendererRenderable = _info.Renderables[idx];
 
-        if(frameInfo.PerFrameDatas.Animation != nullptr)
-            rendererRenderable->RenderablePtr->UpdateAnimationBuffers(*frameInfo.PerFrameDatas.Animation);
+        Renderable* renderable = rendererRenderable->RenderablePtr;
+        if (frameInfo.PerFrameDatas.Animation != nullptr && renderable->GetAnimType() == RenderableAnimType::Skinned)
+        {
+            renderable->UpdateAnimationBuffers(*frameInfo.PerFrameDatas.Animation);
+            PerObjectBuffer::UpdatePerObjectAnimation(rendererRenderable->PerObjectParamBuffer, *rendererRenderable);
+
+            // All skinned objects share the same two palettes, which only change when the animation manager swaps
+            // or grows them
+            const SPtr<GpuBuffer>& boneMatrixBuffer = renderable->GetBoneMatrixBuffer();
+            const SPtr<GpuBuffer>& bonePrevMatrixBuffer = renderable->GetBonePrevMatrixBuffer();
+
+            for (auto& element : rendererRenderable->Elements)
+            {
+                if (element.BoneMatrixBuffer == boneMatrixBuffer && element.BonePrevMatrixBuffer == bonePrevMatrixBuffer)
+                    continue;
+
+                element.BoneMatrixBuffer = boneMatrixBuffer;
+                element.BonePrevMatrixBuffer = bonePrevMatrixBuffer;
+
+                for (auto& gpuParams : element.GpuParamsElem)
+                {
+                    if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices"))
+                        gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices", boneMatrixBuffer);
+
+                    if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "PrevBoneMatrices"))
+                        gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "PrevBoneMatrices", bonePrevMatrixBuffer);
+                }
+            }
+        }
 
         _info.RenderableReady[idx] = true;
     }
@@ -11,6 +11,7 @@
 #include "TeRendererView.h"
 #include "TeRendererLight.h"
 #include "TeRendererRenderable.h"
+#include "TeRendererInstanceBuffer.h"
 
 namespace te
 {
@@ -28,6 +29,7 @@ namespace te
         Vector<RendererRenderable*> Renderables;
         Vector<RendererRenderable*> RenderablesInstanced;
         Vector<CullInfo> RenderableCullInfos;
+        SPtr<RendererInstanceBuffer> InstanceBuffer;
 
         // Lights
         Vector<RendererLight> DirectionalLights;
@@ -40,12 +42,18 @@ namespace te
         //// Rebuilt every frame
         //mutable Vector<bool> RenderableReady; TODO
 
-        // Sky
+        // Sky, its texture is captured on registration as the skybox may be modified while a frame renders
         Skybox* SkyboxElem = nullptr;
+        SPtr<Texture> SkyboxTexture;
 
         // FrameBuffer data
         SPtr<GpuParamBlockBuffer> PerFrameParamBuffer;
 
+        // Changes since the last rendered frame, used by views to only cull again what changed
+        Vector<UINT32> DirtyRenderableCullInfos;
+        bool LightCullInfosDirty = true;
+        UINT64 VisibilityFrameIdx = 0;
+
         // Buffers for various transient data that gets rebuilt every frame
         //// Rebuilt every frame
         mutable Vector<bool> RenderableReady;
@@ -112,6 +120,12 @@ namespace te
         /** Update data relative to current rendering camera */
         void SetParaCameraParams(const Color& sceneLightColor);
 
+        /**
+         * Clears the list of scene changes accumulated since the last frame. To be called once every view determined
+         * its visibility for the current frame.
+         */
+        void EndFrame();
+
         /**
          * Performs necessary per-frame updates to a renderable. This must be called once every frame for every renderable.
          *
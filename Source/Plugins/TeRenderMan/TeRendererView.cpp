@@ -11,9 +11,6 @@ namespace te
 {
     PerCameraParamDef gPerCameraParamDef;
 
-    PerInstanceData RendererView::_instanceDataPool[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER][STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE];
-    Vector<InstancedBuffer> RendererView::_instancedBuffersPool(8);
-
     /** Struct used to compare two instanced buffer */
     bool operator==(const InstancedBuffer& lhs, const InstancedBuffer& rhs)
     {
@@ -21,6 +18,7 @@ namespace te
         size_t rhsSize = rhs.MaterialCount;
 
         if (lhs.MeshElem != rhs.MeshElem) return false;
+        if (lhs.Lod != rhs.Lod) return false;
         if (lhsSize != rhsSize) return false;
 
         if (lhsSize == rhsSize)
@@ -68,7 +66,8 @@ namespace te
 
     RendererView::~RendererView()
     { 
-        _instancedBuffersPool.clear();
+        for (auto& element : _instancedElements)
+            te_pool_delete<RenderableElement>(static_cast<RenderableElement*>(element));
     }
 
     void RendererView::SetStateReductionMode(StateReduction reductionMode)
@@ -90,6 +89,9 @@ namespace te
         if (settings != nullptr)
             *_renderSettings = *settings;
 
+        // Cull distance and lighting affect visibility
+        _visibilityCacheValid = false;
+
         _compositor.Build(*this, RCNodeFinalResolve::GetNodeId());
     }
 
@@ -103,6 +105,8 @@ namespace te
         _properties.ProjTransformNoAA = proj;
         _properties.CullFrustum = worldFrustum;
         _properties.ViewProjTransform = proj * view;
+
+        _visibilityCacheValid = false;
     }
 
     void RendererView::SetView(const RENDERER_VIEW_DESC& desc)
@@ -114,6 +118,8 @@ namespace te
         _properties.PrevViewProjTransform = _properties.ViewProjTransform;
         _properties.Target = desc.Target;
 
+        _visibilityCacheValid = false;
+
         SetStateReductionMode(desc.ReductionMode);
     }
 
@@ -122,26 +128,29 @@ namespace te
         bool perViewBufferDirty = false;
         if (_camera)
         {
-            const SPtr<Viewport>& viewport = _camera->GetViewport();
-            if (viewport)
+            UINT32 newTargetWidth = 0;
+            UINT32 newTargetHeight = 0;
+            if (_properties.Target.Target != nullptr)
             {
-                UINT32 newTargetWidth = 0;
-                UINT32 newTargetHeight = 0;
-                if (_properties.Target.Target != nullptr)
-                {
-                    newTargetWidth = _properties.Target.Target->GetProperties().Width;
-                    newTargetHeight = _properties.Target.Target->GetProperties().Height;
-                }
-
-                if (newTargetWidth != _properties.Target.TargetWidth ||
-                    newTargetHeight != _properties.Target.TargetHeight)
-                {
-                   _properties.Target.ViewRect = viewport->GetPixelArea();
-                    _properties.Target.TargetWidth = newTargetWidth;
-                    _properties.Target.TargetHeight = newTargetHeight;
+                newTargetWidth = _properties.Target.Target->GetProperties().Width;
+                newTargetHeight = _properties.Target.Target->GetProperties().Height;
+            }
 
-                    perViewBufferDirty = true;
-                }
+            if (newTargetWidth != _properties.Target.TargetWidth ||
+                newTargetHeight != _properties.Target.TargetHeight)
+            {
+                // Same as Viewport::GetPixelArea(), but from our own copy of the area as the camera may be modified
+                // while the frame renders
+                const Rect2& nrmArea = _properties.Target.NrmViewRect;
+                _properties.Target.ViewRect = Rect2I(
+                    (INT32)(nrmArea.x * newTargetWidth),
+                    (INT32)(nrmArea.y * newTargetHeight),
+                    (UINT32)(nrmArea.width * newTargetWidth),
+                    (UINT32)(nrmArea.height * newTargetHeight));
+                _properties.Target.TargetWidth = newTargetWidth;
+                _properties.Target.TargetHeight = newTargetHeight;
+
+                perViewBufferDirty = true;
             }
         }
 
@@ -196,15 +205,36 @@ namespace te
     }
 
     void RendererView::DetermineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-        Vector<RenderableVisibility>* visibility)
+        Vector<RenderableVisibility>* visibility, const Vector<UINT32>* dirtyRenderables)
     {
-        _visibility.Renderables.clear();
-        _visibility.Renderables.resize(renderables.size(), RenderableVisibility());
+        const UINT32 numRenderables = (UINT32)renderables.size();
 
         if (!ShouldDraw3D())
+        {
+            _visibility.Renderables.clear();
+            _visibility.Renderables.resize(numRenderables, RenderableVisibility());
             return;
+        }
 
-        CalculateVisibility(cullInfos, _visibility.Renderables);
+        if (dirtyRenderables != nullptr)
+        {
+            // Renderables registered since the last update are part of the dirty list, and removed ones are at the end
+            _cachedRenderableVisibility.resize(numRenderables, RenderableVisibility());
+
+            for (auto idx : *dirtyRenderables)
+            {
+                if (idx < numRenderables)
+                    _cachedRenderableVisibility[idx].Visible = IsVisible(cullInfos[idx]);
+            }
+        }
+        else
+        {
+            _cachedRenderableVisibility.assign(numRenderables, RenderableVisibility());
+            CalculateVisibility(cullInfos, _cachedRenderableVisibility);
+        }
+
+        // Render queue generation flags instanced renderables in the per-view visibility, so the cache is kept separate
+        _visibility.Renderables = _cachedRenderableVisibility;
 
         if (visibility != nullptr)
         {
@@ -217,7 +247,7 @@ namespace te
     }
 
     void RendererView::DetermineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>* bounds,
-        LightType lightType, Vector<bool>* visibility)
+        LightType lightType, Vector<bool>* visibility, bool useCachedVisibility)
     {
         if (!_renderSettings->EnableLighting)
         {
@@ -237,25 +267,22 @@ namespace te
 
         Vector<bool>* perViewVisibility;
         if (lightType == LightType::Radial)
-        {
-            _visibility.RadialLights.clear();
-            _visibility.RadialLights.resize(lights.size(), false);
-
             perViewVisibility = &_visibility.RadialLights;
-        }
         else // Spot
-        {
-            _visibility.SpotLights.clear();
-            _visibility.SpotLights.resize(lights.size(), false);
-
             perViewVisibility = &_visibility.SpotLights;
-        }
 
-        if (!ShouldDraw3D())
-            return;
+        const bool cacheUsable = useCachedVisibility && ShouldDraw3D() && perViewVisibility->size() == lights.size();
+        if (!cacheUsable)
+        {
+            perViewVisibility->clear();
+            perViewVisibility->resize(lights.size(), false);
 
-        if (_renderSettings->EnableLighting)
-            CalculateVisibility(*bounds, *perViewVisibility);
+            if (!ShouldDraw3D())
+                return;
+
+            if (_renderSettings->EnableLighting)
+                CalculateVisibility(*bounds, *perViewVisibility);
+        }
 
         if (visibility != nullptr)
         {
@@ -269,39 +296,40 @@ namespace te
 
     void RendererView::CalculateVisibility(const Vector<CullInfo>& cullInfos, Vector<RenderableVisibility>& visibility) const
     {
-        UINT64 cameraLayers = _properties.VisibleLayers;
-        const ConvexVolume& worldFrustum = _properties.CullFrustum;
-        const Vector3& worldCameraPosition = _properties.ViewOrigin;
-        float baseCullDistance = _renderSettings->CullDistance;
-
         for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
         {
-            if ((cullInfos[i].Layer & cameraLayers) == 0)
-                continue;
+            if (IsVisible(cullInfos[i]))
+                visibility[i].Visible = true;
+        }
+    }
 
-            // Do distance culling
-            const Sphere& boundingSphere = cullInfos[i].Boundaries.GetSphere();
-            const Vector3& worldRenderablePosition = boundingSphere.GetCenter();
+    bool RendererView::IsVisible(const CullInfo& cullInfo) const
+    {
+        if ((cullInfo.Layer & _properties.VisibleLayers) == 0)
+            return false;
 
-            float distanceToCameraSq = worldCameraPosition.SquaredDistance(worldRenderablePosition);
-            float correctedCullDistance = cullInfos[i].CullDistanceFactor * baseCullDistance;
-            float maxDistanceToCamera = correctedCullDistance + boundingSphere.GetRadius();
+        const ConvexVolume& worldFrustum = _properties.CullFrustum;
+        const Vector3& worldCameraPosition = _properties.ViewOrigin;
 
-            if (distanceToCameraSq > maxDistanceToCamera* maxDistanceToCamera)
-                continue;
+        // Do distance culling
+        const Sphere& boundingSphere = cullInfo.Boundaries.GetSphere();
+        const Vector3& worldRenderablePosition = boundingSphere.GetCenter();
 
-            // Do frustum culling
-            // Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-            // operations, as it is trivial to update them. Also consider spatial partitioning.
-            if (worldFrustum.Intersects(boundingSphere))
-            {
-                // More precise with the box
-                const AABox& boundingBox = cullInfos[i].Boundaries.GetBox();
+        float distanceToCameraSq = worldCameraPosition.SquaredDistance(worldRenderablePosition);
+        float correctedCullDistance = cullInfo.CullDistanceFactor * _renderSettings->CullDistance;
+        float maxDistanceToCamera = correctedCullDistance + boundingSphere.GetRadius();
 
-                if (worldFrustum.Intersects(boundingBox))
-                    visibility[i].Visible = true;
-            }
-        }
+        if (distanceToCameraSq > maxDistanceToCamera* maxDistanceToCamera)
+            return false;
+
+        // Do frustum culling
+        // Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
+        // operations, as it is trivial to update them. Also consider spatial partitioning.
+        if (!worldFrustum.Intersects(boundingSphere))
+            return false;
+
+        // More precise with the box
+        return worldFrustum.Intersects(cullInfo.Boundaries.GetBox());
     }
 
     void RendererView::CalculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
@@ -350,112 +378,131 @@ namespace te
 
                 // Note: I could keep renderables in multiple separate arrays, so I don't need to do the check here
                 if (shaderFlags & (UINT32)ShaderFlag::Transparent)
-                    _forwardTransparentQueue->Add(&renderElem, distanceToCamera, techniqueIdx);
+                    _forwardTransparentQueue->Add(&renderElem, distanceToCamera, techniqueIdx, _renderableLods[i]);
                 else
-                    _forwardOpaqueQueue->Add(&renderElem, distanceToCamera, techniqueIdx);
+                    _forwardOpaqueQueue->Add(&renderElem, distanceToCamera, techniqueIdx, _renderableLods[i]);
 
                 CheckIfDynamicEnvMappingNeeded(renderElem);
             }
         }
-
-        _forwardOpaqueQueue->Sort();
-        _forwardTransparentQueue->Sort();
     }
 
-    void RendererView::QueueRenderInstancedElements(const SceneInfo& sceneInfo, InstancedBuffer& instancedBuffer)
+    void RendererView::UpdateLods(const SceneInfo& sceneInfo)
     {
-        // We now have a list of similar objects to render
-        // However, each instance can't be bigger than 128 elements
-        // So we divide the size of the list by 128 to know how many instance blocks we will render
-        UINT32 instBlockCount = ((UINT32)instancedBuffer.Idx.size() / STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE) + 1;
-        UINT32 instancedObjectCounter = 0;
+        const UINT32 numRenderables = (UINT32)sceneInfo.Renderables.size();
+        _renderableLods.resize(numRenderables, 0);
 
-        if (instBlockCount > STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
+        const float maxPixelError = _renderSettings->LodPixelError;
+        if (maxPixelError <= 0.0f)
         {
-            instBlockCount = STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER;
-            TE_DEBUG("Maximum number of instanced block reached : " + ToString(instBlockCount));
+            std::fill(_renderableLods.begin(), _renderableLods.end(), (UINT8)0);
+            return;
         }
 
-        // For each instance block we retrieve all necessary data
-        for (UINT32 currInstBlock = 0; currInstBlock < instBlockCount; currInstBlock++)
-        {
-            // We need to know start and end of element for this instance block
-            UINT32 lowerBlockBound = currInstBlock * STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE;
-            UINT32 upperBlockBound = (currInstBlock + 1) * STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE;
-
-            if (upperBlockBound > (UINT32)instancedBuffer.Idx.size())
-                upperBlockBound = (UINT32)instancedBuffer.Idx.size();
+        // Converts a length at unit distance from the camera into pixels
+        const float pixelScale = _properties.ProjTransform[1][1] * 0.5f * (float)_properties.Target.ViewRect.height;
+        const bool perspective = _properties.ProjType == PT_PERSPECTIVE;
 
-            if (lowerBlockBound == upperBlockBound)
-                break;
+        for (UINT32 i = 0; i < numRenderables; i++)
+        {
+            const Vector<float>& lodErrors = sceneInfo.Renderables[i]->LodErrors;
+            if (lodErrors.empty())
+            {
+                _renderableLods[i] = 0;
+                continue;
+            }
 
-            // We will use first element of this block for its data (each element has same internal data)
-            UINT32 idx = instancedBuffer.Idx[lowerBlockBound];
+            const Sphere& boundingSphere = sceneInfo.RenderableCullInfos[i].Boundaries.GetSphere();
+            float projectedRadius = boundingSphere.GetRadius() * pixelScale;
 
-            const AABox& boundingBox = sceneInfo.RenderableCullInfos[idx].Boundaries.GetBox();
-            const float distanceToCamera = (_properties.ViewOrigin - boundingBox.GetCenter()).Length();
+            if (perspective)
+            {
+                // Use the closest point of the bounds, so the camera being inside an object keeps it at full detail
+                float distance = _properties.ViewOrigin.Distance(boundingSphere.GetCenter()) - boundingSphere.GetRadius();
+                projectedRadius /= std::max(distance, _properties.NearPlane);
+            }
 
-            PerInstanceData data;
+            // Moving to a less detailed level requires the error to be below the threshold by some margin, while the
+            // current level is kept until the error is above it by the same margin
+            const UINT32 numLods = std::min((UINT32)lodErrors.size(), (UINT32)std::numeric_limits<UINT8>::max());
+            const UINT32 currentLod = _renderableLods[i];
+            UINT32 lod = 0;
 
-            for (auto subElemIdx = lowerBlockBound; subElemIdx < upperBlockBound; subElemIdx++)
+            for (UINT32 j = numLods; j > 0; j--)
             {
-                UINT32 elemId = instancedBuffer.Idx[subElemIdx];
-                const Renderable* renderable = sceneInfo.Renderables[elemId]->RenderablePtr;
-                const Matrix4& tfrmNoScale = renderable->GetMatrixNoScale();
-                
-                //Once all this stuff is done, we need to write into perinstance buffer
-                GpuParamBlockBuffer* buffer = sceneInfo.Renderables[elemId]->PerObjectParamBuffer.get();
-
-                data.gMatWorld = sceneInfo.Renderables[elemId]->WorldTfrm;
-                data.gMatInvWorld = sceneInfo.Renderables[elemId]->WorldTfrm.InverseAffine();
-                data.gMatWorldNoScale = tfrmNoScale;
-                data.gMatInvWorldNoScale = tfrmNoScale.InverseAffine();
-                data.gMatPrevWorld = sceneInfo.Renderables[elemId]->PrevWorldTfrm;
-                data.gLayer = (UINT32)renderable->GetLayer();
-                data.gHasAnimation = (renderable->IsAnimated()) ? 1 : 0;
-                data.gWriteVelocity = (renderable->GetWriteVelocity()) ? 1 : 0;
-
-                _instanceDataPool[currInstBlock][subElemIdx - lowerBlockBound] = data;
-                instancedObjectCounter++;
-
-                if (instancedObjectCounter > STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE* STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
+                float margin = j <= currentLod ? STANDARD_FORWARD_LOD_HYSTERESIS : -STANDARD_FORWARD_LOD_HYSTERESIS;
+                if (lodErrors[j - 1] * projectedRadius <= maxPixelError * (1.0f + margin))
+                {
+                    lod = j;
                     break;
+                }
             }
 
-            // We update per object and per instance buffer
-            sceneInfo.Renderables[idx]->UpdatePerInstanceBuffer(_instanceDataPool[currInstBlock], upperBlockBound - lowerBlockBound, currInstBlock);
+            _renderableLods[i] = (UINT8)lod;
+        }
+    }
 
-            // We create all instanced render element using first RendererRenderable data
-            for (auto& renderElem : sceneInfo.Renderables[idx]->Elements)
-            {
-                RenderableElement* elem = te_pool_new<RenderableElement>();
-                elem->MeshElem = renderElem.MeshElem;
-                elem->SubMeshElem = renderElem.SubMeshElem;
-                elem->MaterialElem = renderElem.MaterialElem;
-                elem->DefaultTechniqueIdx = renderElem.DefaultTechniqueIdx;
-                elem->Type = renderElem.Type;
-                elem->InstanceCount = (UINT32)(upperBlockBound - lowerBlockBound);
-                elem->GpuParamsElem = renderElem.GpuParamsElem;
+    void RendererView::NotifyRenderableRemoved(UINT32 renderableId, UINT32 lastRenderableId)
+    {
+        // Renderables added since the last update have no state yet, it is created by UpdateLods()
+        if (renderableId >= (UINT32)_renderableLods.size())
+            return;
 
-                UINT32 shaderFlags = renderElem.MaterialElem->GetShader()->GetFlags();
-                UINT32 techniqueIdx = renderElem.DefaultTechniqueIdx;
+        if (lastRenderableId < (UINT32)_renderableLods.size())
+        {
+            _renderableLods[renderableId] = _renderableLods[lastRenderableId];
+            _renderableLods.resize(lastRenderableId);
+        }
+        else
+            _renderableLods[renderableId] = 0;
+    }
 
-                _instancedElements.push_back(elem);
+    void RendererView::SortRenderQueues()
+    {
+        _forwardOpaqueQueue->Sort();
+        _forwardTransparentQueue->Sort();
+    }
 
-                // Note: I could keep renderables in multiple separate arrays, so I don't need to do the check here
-                if (shaderFlags & (UINT32)ShaderFlag::Transparent)
-                    _forwardTransparentQueue->Add(elem, distanceToCamera, techniqueIdx);
-                else
-                    _forwardOpaqueQueue->Add(elem, distanceToCamera, techniqueIdx);
+    void RendererView::QueueRenderInstancedElements(const SceneInfo& sceneInfo, InstancedBuffer& instancedBuffer)
+    {
+        // We now have a list of similar objects to render, they are all drawn at once
+        // Instance data is read from the persistent instance buffer, only the indices of the instances are written here
+        // We will use first element for its data (each element has same internal data)
+        UINT32 idx = instancedBuffer.Idx[0];
 
-                for (auto& gpuParams : renderElem.GpuParamsElem)
-                    gpuParams->SetParamBlockBuffer("PerInstanceBuffer", gPerInstanceParamBuffer[currInstBlock]);
+        const AABox& boundingBox = sceneInfo.RenderableCullInfos[idx].Boundaries.GetBox();
+        const float distanceToCamera = (_properties.ViewOrigin - boundingBox.GetCenter()).Length();
 
-                CheckIfDynamicEnvMappingNeeded(renderElem);
-            }
+        const SPtr<GpuParamBlockBuffer>& perInstanceBuffer =
+            sceneInfo.InstanceBuffer->AddBatch(instancedBuffer.Idx.data(), (UINT32)instancedBuffer.Idx.size());
 
-            if (instancedObjectCounter > STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE* STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
-                break;
+        // We create all instanced render element using first RendererRenderable data
+        for (auto& renderElem : sceneInfo.Renderables[idx]->Elements)
+        {
+            RenderableElement* elem = te_pool_new<RenderableElement>();
+            elem->MeshElem = renderElem.MeshElem;
+            elem->SubMeshElem = renderElem.SubMeshElem;
+            elem->MaterialElem = renderElem.MaterialElem;
+            elem->DefaultTechniqueIdx = renderElem.DefaultTechniqueIdx;
+            elem->Type = renderElem.Type;
+            elem->InstanceCount = (UINT32)instancedBuffer.Idx.size();
+            elem->GpuParamsElem = renderElem.GpuParamsElem;
+
+            UINT32 shaderFlags = renderElem.MaterialElem->GetShader()->GetFlags();
+            UINT32 techniqueIdx = renderElem.DefaultTechniqueIdx;
+
+            _instancedElements.push_back(elem);
+
+            // Note: I could keep renderables in multiple separate arrays, so I don't need to do the check here
+            if (shaderFlags & (UINT32)ShaderFlag::Transparent)
+                _forwardTransparentQueue->Add(elem, distanceToCamera, techniqueIdx, instancedBuffer.Lod);
+            else
+                _forwardOpaqueQueue->Add(elem, distanceToCamera, techniqueIdx, instancedBuffer.Lod);
+
+            for (auto& gpuParams : renderElem.GpuParamsElem)
+                gpuParams->SetParamBlockBuffer("PerInstanceBuffer", perInstanceBuffer);
+
+            CheckIfDynamicEnvMappingNeeded(renderElem);
         }
     }
 
@@ -623,12 +670,6 @@ namespace te
         _visibility.Renderables.resize(sceneInfo.Renderables.size(), RenderableVisibility());
         _visibility.Renderables.assign(sceneInfo.Renderables.size(), RenderableVisibility());
 
-        for (UINT32 i = 0; i < numViews; i++)
-        {
-            _views[i]->DetermineVisible(sceneInfo.Renderables, sceneInfo.RenderableCullInfos, &_visibility.Renderables);
-        }
-
-        // Calculate light visibility for all views
         const auto numRadialLights = (UINT32)sceneInfo.RadialLights.size();
         _visibility.RadialLights.resize(numRadialLights, false);
         _visibility.RadialLights.assign(numRadialLights, false);
@@ -643,16 +684,30 @@ namespace te
 
         for (UINT32 i = 0; i < numViews; i++)
         {
-            if (!_views[i]->ShouldDraw3D())
+            RendererView& view = *_views[i];
+
+            // Cached results can only be updated incrementally if they were computed the previous frame, otherwise
+            // changes made in between were never seen by the view. Only what changed since then needs testing.
+            const bool cacheValid = view._visibilityCacheValid &&
+                view._visibilityCacheFrameIdx + 1 == sceneInfo.VisibilityFrameIdx;
+            const bool lightCacheValid = cacheValid && !sceneInfo.LightCullInfosDirty;
+
+            view.DetermineVisible(sceneInfo.Renderables, sceneInfo.RenderableCullInfos, &_visibility.Renderables,
+                cacheValid ? &sceneInfo.DirtyRenderableCullInfos : nullptr);
+
+            view._visibilityCacheValid = view.ShouldDraw3D();
+            view._visibilityCacheFrameIdx = sceneInfo.VisibilityFrameIdx;
+
+            if (!view.ShouldDraw3D())
                 continue;
 
-            _views[i]->DetermineVisible(sceneInfo.RadialLights, &sceneInfo.RadialLightWorldBounds, LightType::Radial,
-                &_visibility.RadialLights);
+            view.DetermineVisible(sceneInfo.RadialLights, &sceneInfo.RadialLightWorldBounds, LightType::Radial,
+                &_visibility.RadialLights, lightCacheValid);
 
-            _views[i]->DetermineVisible(sceneInfo.SpotLights, &sceneInfo.SpotLightWorldBounds, LightType::Spot,
-                &_visibility.SpotLights);
+            view.DetermineVisible(sceneInfo.SpotLights, &sceneInfo.SpotLightWorldBounds, LightType::Spot,
+                &_visibility.SpotLights, lightCacheValid);
 
-            _views[i]->DetermineVisible(sceneInfo.DirectionalLights, nullptr, LightType::Directional,
+            view.DetermineVisible(sceneInfo.DirectionalLights, nullptr, LightType::Directional,
                 &_visibility.DirectionalLights);
         }
 
@@ -690,92 +745,101 @@ namespace te
         {
             _visibility.Renderables[i].Visible = true;
         }
+
+        // Render queues are generated from per-view visibility
+        for (UINT32 i = 0; i < numViews; i++)
+        {
+            if (!_views[i]->ShouldDraw3D())
+                continue;
+
+            _views[i]->_visibility.Renderables = _visibility.Renderables;
+        }
     }
 
-    void RendererViewGroup::GenerateInstanced(const SceneInfo& sceneInfo, RenderManInstancing instancingMode)
+    void RendererViewGroup::GenerateInstanced(const SceneInfo& sceneInfo, RendererView& view, RenderManInstancing instancingMode)
     {
+        Vector<InstancedBuffer>& instancedBuffers = view._instancedBuffers;
+        const Vector<RenderableVisibility>& visibility = view._visibility.Renderables;
         InstancedBuffer key;
 
-        auto PopulateInstanceBuffer = [&](Renderable* renderable, UINT32 current)
+        auto PopulateInstanceBuffer = [&](const RendererRenderable* renderable, UINT32 current)
         {
-            if (!renderable->GetInstancing())
+            if (!renderable->Instancing)
                 return;
 
-            key.MeshElem = renderable->GetMesh().get();
-            key.Materials = renderable->GetMaterialsPtr();
-            key.MaterialCount = renderable->GetNumMaterials();
+            key.MeshElem = renderable->MeshElem.get();
+            key.Materials = renderable->Materials.data();
+            key.MaterialCount = (UINT32)renderable->Materials.size();
+            key.Lod = view._renderableLods[current];
             if(key.Idx.size() > 0) key.Idx.clear();
 
-            auto iter = find(RendererView::_instancedBuffersPool.begin(), RendererView::_instancedBuffersPool.end(), key);
+            auto iter = find(instancedBuffers.begin(), instancedBuffers.end(), key);
 
-            if (iter == RendererView::_instancedBuffersPool.end())
+            if (iter == instancedBuffers.end())
             {
                 key.Idx.reserve(32);
                 key.Idx.push_back(current);
-                RendererView::_instancedBuffersPool.push_back(key);
+                instancedBuffers.push_back(key);
             }
             else
                 iter->Idx.push_back(current);
         };
 
+        instancedBuffers.clear();
+
         if (instancingMode == RenderManInstancing::Automatic)
         {
             const auto numRenderables = (UINT32)sceneInfo.Renderables.size();
-            RendererView::_instancedBuffersPool.clear();
 
             // We will separate renderables based on <Material*> and <Renderable*>
             for (UINT32 i = 0; i < numRenderables; i++)
             {
-                if (!_visibility.Renderables[sceneInfo.Renderables[i]->RenderablePtr->GetRendererId()].Visible &&
+                if (!visibility[sceneInfo.Renderables[i]->RenderablePtr->GetRendererId()].Visible &&
                     (_options->CullingFlags & (UINT32)RenderManCulling::Frustum ||
                         _options->CullingFlags & (UINT32)RenderManCulling::Occlusion))
                 {
                     continue;
                 }
 
-                PopulateInstanceBuffer(sceneInfo.Renderables[i]->RenderablePtr, i);
+                PopulateInstanceBuffer(sceneInfo.Renderables[i], i);
             }
         }
         else if (instancingMode == RenderManInstancing::Manual)
         {
-            RendererView::_instancedBuffersPool.clear();
-
             // We will separate renderables based on <Material*> and <Renderable*>
             for (auto& renderable : sceneInfo.RenderablesInstanced)
             {
-                if (!_visibility.Renderables[renderable->RenderablePtr->GetRendererId()].Visible &&
+                if (!visibility[renderable->RenderablePtr->GetRendererId()].Visible &&
                     (_options->CullingFlags & (UINT32)RenderManCulling::Frustum ||
                         _options->CullingFlags & (UINT32)RenderManCulling::Occlusion))
                 {
                     continue;
                 }
 
-                PopulateInstanceBuffer(renderable->RenderablePtr, renderable->RenderablePtr->GetRendererId());
+                PopulateInstanceBuffer(renderable, renderable->RenderablePtr->GetRendererId());
             }
         }
     }
 
     void RendererViewGroup::GenerateRenderQueue(const SceneInfo& sceneInfo, RendererView& view, RenderManInstancing instancingMode)
     {
-        if (instancingMode == RenderManInstancing::Automatic || instancingMode == RenderManInstancing::Manual)
-        {
-            const UINT32 maxInstElement = STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE * STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER;
-            UINT32 totalInstElem = 0;
+        view._instancedBuffers.clear();
 
-            for (auto& element : view._instancedElements)
-                te_pool_delete<RenderableElement>(static_cast<RenderableElement*>(element));
+        if (!view.ShouldDraw3D())
+            return;
 
-            view._instancedElements.clear();
+        // Renderables are only instanced with others drawn at the same level of detail
+        view.UpdateLods(sceneInfo);
 
-            for (auto& instancedBuffer : RendererView::_instancedBuffersPool)
-            {
-                totalInstElem += ((UINT32)instancedBuffer.Idx.size() / STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE + 1) * STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE;
-                if (totalInstElem > maxInstElement)
-                {
-                    UINT32 amountInstToRemove = totalInstElem - maxInstElement;
-                    instancedBuffer.Idx.resize(instancedBuffer.Idx.size() - amountInstToRemove);
-                }
+        if (instancingMode == RenderManInstancing::Automatic || instancingMode == RenderManInstancing::Manual)
+        {
+            GenerateInstanced(sceneInfo, view, instancingMode);
 
+            // Only keep groups large enough to be worth an instanced draw, their elements are created once the view is
+            // about to be rendered
+            UINT32 numInstanced = 0;
+            for (auto& instancedBuffer : view._instancedBuffers)
+            {
                 bool hasTransparentElement = false;
 
                 for (UINT32 i = 0; i < instancedBuffer.MaterialCount; i++)
@@ -796,21 +860,50 @@ namespace te
                         view._visibility.Renderables[idx].Instanced = true;
                     }
 
-                    view.QueueRenderInstancedElements(sceneInfo, instancedBuffer);
-                }
+                    if (&instancedBuffer != &view._instancedBuffers[numInstanced])
+                        view._instancedBuffers[numInstanced] = std::move(instancedBuffer);
 
-                if (totalInstElem > maxInstElement)
-                    break;
+                    numInstanced++;
+                }
             }
 
-            if (view.ShouldDraw3D())
-                view.QueueRenderElements(sceneInfo);
+            view._instancedBuffers.resize(numInstanced);
         }
-        else
+
+        view.QueueRenderElements(sceneInfo);
+    }
+
+    void RendererViewGroup::FinalizeRenderQueue(const SceneInfo& sceneInfo, RendererView& view, RenderManInstancing instancingMode)
+    {
+        if (instancingMode == RenderManInstancing::Automatic || instancingMode == RenderManInstancing::Manual)
         {
-            if (view.ShouldDraw3D())
-                view.QueueRenderElements(sceneInfo);
+            for (auto& element : view._instancedElements)
+                te_pool_delete<RenderableElement>(static_cast<RenderableElement*>(element));
+
+            view._instancedElements.clear();
+            sceneInfo.InstanceBuffer->BeginBatches();
+
+            for (auto& instancedBuffer : view._instancedBuffers)
+                view.QueueRenderInstancedElements(sceneInfo, instancedBuffer);
+
+            // Index buffer might have been reallocated while uploading, so instance buffers are bound once all batches
+            // are known
+            sceneInfo.InstanceBuffer->EndBatches();
+
+            for (auto& element : view._instancedElements)
+            {
+                for (auto& gpuParams : element->GpuParamsElem)
+                {
+                    if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "gInstanceData"))
+                        gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "gInstanceData", sceneInfo.InstanceBuffer->GetRecordBuffer());
+
+                    if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "gInstanceIndices"))
+                        gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "gInstanceIndices", sceneInfo.InstanceBuffer->GetIndexBuffer());
+                }
+            }
         }
+
+        view.SortRenderQueues();
     }
 
     bool RendererView::RequiresVelocityWrites() const
@@ -125,6 +125,7 @@ namespace te
         Mesh* MeshElem;
         const SPtr<Material>* Materials;
         UINT32 MaterialCount = 0;
+        UINT32 Lod = 0;
         Vector<UINT32> Idx;
     };
 
@@ -205,9 +206,12 @@ namespace te
          *									object. If the bit for an object is already set to true, the method will never
          *									change it to false which allows the same bitfield to be provided to multiple
          *									renderer views. Must be the same size as the @p renderables array.
+         * @param[in]	dirtyRenderables	Optional list of renderables whose culling information changed since the
+         *									last call. If provided, only those are tested and visibility of the others
+         *									is taken from the previous call.
          */
         void DetermineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-            Vector<RenderableVisibility>* visibility = nullptr);
+            Vector<RenderableVisibility>* visibility = nullptr, const Vector<UINT32>* dirtyRenderables = nullptr);
 
         /**
          * Calculates the visibility masks for all the lights of the provided type.
@@ -223,9 +227,11 @@ namespace te
          *
          *									As a side-effect, per-view visibility data is also calculated and can be
          *									retrieved by calling getVisibilityMask().
+         * @param[in]	useCachedVisibility	If true, per-view visibility calculated by the previous call is reused. Only
+         *									valid if neither the lights nor the view changed since.
          */
         void DetermineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>* bounds, LightType type,
-            Vector<bool>* visibility = nullptr);
+            Vector<bool>* visibility = nullptr, bool useCachedVisibility = false);
 
         /**
          * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
@@ -247,18 +253,37 @@ namespace te
 
         /**
          * Inserts all visible renderable elements into render queues. Assumes visibility has been calculated beforehand
-         * by calling determineVisible(). After the call render elements can be retrieved from the queues using
-         * getOpaqueQueue or getTransparentQueue() calls.
+         * by calling determineVisible(). Queues must be sorted with SortRenderQueues() before render elements are
+         * retrieved using getOpaqueQueue or getTransparentQueue() calls. Only touches data owned by this view, so
+         * different views can be queued concurrently.
          */
         void QueueRenderElements(const SceneInfo& sceneInfo);
 
         /**
          * Inserts all visible instanced renderable elements into render queues. Assumes visibility has been calculated beforehand
-         * by calling determineVisible(). After the call render elements can be retrieved from the queues using
-         * getOpaqueQueue or getTransparentQueue() calls.
+         * by calling determineVisible(). Allocates render elements and GPU buffers, so it must not be called concurrently.
          */
         void QueueRenderInstancedElements(const SceneInfo& sceneInfo, InstancedBuffer& instancedBuffers);
 
+        /**
+         * Selects the level of detail of each renderable, from the error its simplified meshes would cause on screen.
+         * A renderable only changes level once the error crosses the threshold by some margin, so objects sitting at a
+         * transition distance don't alternate between two levels. Only touches data owned by this view.
+         */
+        void UpdateLods(const SceneInfo& sceneInfo);
+
+        /**
+         * Notifies the view that a renderable was removed from the scene, and that the last renderable was moved into its
+         * place, so per renderable state kept between frames follows it.
+         *
+         * @param[in]	renderableId		Renderer ID of the removed renderable.
+         * @param[in]	lastRenderableId	Renderer ID the last renderable had before being moved to @p renderableId.
+         */
+        void NotifyRenderableRemoved(UINT32 renderableId, UINT32 lastRenderableId);
+
+        /** Sorts render queues once all elements have been queued. */
+        void SortRenderQueues();
+
         /** Returns the visibility mask calculated with the last call to determineVisible(). */
 		const VisibilityInfo& GetVisibilityInfo() const { return _visibility; }
 
@@ -317,6 +342,9 @@ namespace te
 
         void CheckIfDynamicEnvMappingNeeded(const RenderElement& element);
 
+        /** Culls a single object against the view, using the same rules as CalculateVisibility(). */
+        bool IsVisible(const CullInfo& cullInfo) const;
+
     private:
         RendererViewProperties _properties;
         mutable RendererViewContext _context;
@@ -329,6 +357,12 @@ namespace te
         VisibilityInfo _visibility;
         UINT32 _viewIdx = 0;
 
+        // Renderable visibility kept between frames, so only objects that moved need to be culled again. Invalidated
+        // whenever the view changes, or if the view didn't determine its visibility during the previous frame
+        Vector<RenderableVisibility> _cachedRenderableVisibility;
+        UINT64 _visibilityCacheFrameIdx = 0;
+        bool _visibilityCacheValid = false;
+
         // On-demand drawing 
         // _redrawForFrames, _redrawForSeconds and _waitingOnAutoExposureFrame are not used because I don't manage auto exposure yet
         // TODO need to be used with auto exposure
@@ -345,8 +379,12 @@ namespace te
 
         Vector<RenderableElement*> _instancedElements; //Elements are updated every frame
 
-        static PerInstanceData _instanceDataPool[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER][STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE];
-        static Vector<InstancedBuffer> _instancedBuffersPool;
+        // Level of detail selected for each renderable, kept between frames to apply hysteresis
+        Vector<UINT8> _renderableLods;
+
+        // Groups of renderables drawn with a single instanced draw, rebuilt every frame. Kept per view so queues of
+        // different views can be generated concurrently
+        Vector<InstancedBuffer> _instancedBuffers;
 
         // Exposure
         float _previousEyeAdaptation = 0.0f;
@@ -397,15 +435,24 @@ namespace te
         void SetAllObjectsAsVisible(const SceneInfo& sceneInfo);
 
         /**
-        * Before creating render queue, we look for all possibly instanced elements
+        * Before creating render queue, we look for all possibly instanced elements visible from the provided view
         */
-        void GenerateInstanced(const SceneInfo& sceneInfo, RenderManInstancing instancingMode);
+        void GenerateInstanced(const SceneInfo& sceneInfo, RendererView& view, RenderManInstancing instancingMode);
     
         /**
-        * Once we have set visibility information for all Renderables, we wil decide if some of them can be instanced
+        * Once we have set visibility information for all Renderables, we wil decide if some of them can be instanced and
+        * queue all the others. Only touches data owned by the view, so it can run concurrently for different views, once
+        * visibility of the group has been determined.
         */
         void GenerateRenderQueue(const SceneInfo& sceneInfo, RendererView& view, RenderManInstancing instancingMode);
 
+        /**
+        * Creates instanced render elements of the view, uploads their batches and sorts its render queues. Allocates
+        * render elements and GPU buffers, and batch data is overwritten by the next view, so it must be called from the
+        * rendering thread, right before the view is rendered.
+        */
+        void FinalizeRenderQueue(const SceneInfo& sceneInfo, RendererView& view, RenderManInstancing instancingMode);
+
     private:
         friend class RenderView;
 
@@ -417,5 +464,5 @@ namespace te
         VisibleLightData _visibleLightData;
     };
 
-    IMPLEMENT_GLOBAL_POOL(RenderableElement, STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE)
+    IMPLEMENT_GLOBAL_POOL(RenderableElement, 128)
 }
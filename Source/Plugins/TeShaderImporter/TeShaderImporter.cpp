@@ -15,6 +15,7 @@ namespace te
     const String ShaderImporter::TypeSampler = "samplers";
     const String ShaderImporter::TypeOptions = "options";
     const String ShaderImporter::TypeTextures = "textures";
+    const String ShaderImporter::TypePermutations = "permutations";
 
     ShaderImporter::ShaderImporter()
     {
@@ -61,12 +62,13 @@ namespace te
         data[size] = (uint8_t)'\0';
 
         String dataStr((char*)data);
+        ParserData parsedData;
 
 #if (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)) && !defined(JSON_NOEXCEPTION)
         try 
         {
             jsonDocument = nlohmann::json::parse(dataStr);
-            ParserData parsedData = Parse(jsonDocument);
+            parsedData = Parse(jsonDocument);
         }
         catch (...)
         {
@@ -74,10 +76,10 @@ namespace te
         }
 #else
         jsonDocument = nlohmann::json::parse(dataStr);
-        ParserData parsedData = Parse(jsonDocument);
+        parsedData = Parse(jsonDocument);
 #endif
 
-        SPtr<Shader> shader = Shader::_createPtr("shader", SHADER_DESC());
+        SPtr<Shader> shader = Shader::_createPtr("shader", parsedData.ShaderDesc);
         shader->SetName(filePath);
         shader->SetPath(filePath);
 
@@ -138,6 +140,10 @@ namespace te
             {
                 ParseSamplersBlock(doc, data);
             }
+            else if (type == TypePermutations)
+            {
+                ParsePermutationsBlock(doc, data);
+            }
         }
     }
 
@@ -320,4 +326,19 @@ namespace te
             doc["priority"].get<UINT64>()
         };
     }
+
+    void ShaderImporter::ParsePermutationsBlock(nlohmann::json& doc, ParserData& data)
+    {
+        // "permutations": [ "USE_NORMAL_MAP", ... ], each key maps to a bit of the permutation mask, in order
+        for (auto it = doc.begin(); it != doc.end(); ++it)
+        {
+            if (data.ShaderDesc.PermutationKeys.size() == 32)
+            {
+                TE_DEBUG("Shaders can't have more than 32 permutation keys, ignoring: " + it.value().get<String>());
+                continue;
+            }
+
+            data.ShaderDesc.PermutationKeys.push_back(it.value().get<String>());
+        }
+    }
 }
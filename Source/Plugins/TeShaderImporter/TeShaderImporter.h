@@ -22,6 +22,7 @@ namespace te
         static const String TypeSampler;
         static const String TypeOptions;
         static const String TypeTextures;
+        static const String TypePermutations;
 
         enum Language
         {
@@ -193,6 +194,7 @@ namespace te
         void ParseTexturesBlock(nlohmann::json& doc, ParserData& data);
         void ParseTextureBlock(nlohmann::json& doc, ParserData& data);
         void ParseOptionsBlock(nlohmann::json& doc, ParserData& data);
+        void ParsePermutationsBlock(nlohmann::json& doc, ParserData& data);
 
     private:
         Vector<String> _extensions;